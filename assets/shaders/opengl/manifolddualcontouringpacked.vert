@@ -0,0 +1,28 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#include "packedcommon.glsl"
+
+// Note: Position is unorm16 relative to the chunk, the model matrix carries the chunk offset and size
+layout(binding = 0) uniform ManifoldDualContouringUniformBufferObject {
+  mat4 model;
+  mat4 view;
+  mat4 proj;
+  vec3 camera;
+} dcubo;
+
+layout(location = 0) in vec4 in_position;
+layout(location = 1) in vec4 in_color;
+layout(location = 2) in vec2 in_normal;
+
+layout(location = 0) out vec3 out_normal;
+layout(location = 1) out vec3 out_frag_pos;
+
+void main() {
+  vec4 position = vec4(in_position.xyz, 1.0);
+  gl_Position = dcubo.proj * dcubo.view * dcubo.model * position;
+  out_normal = octahedral_decode(in_normal);
+
+  out_frag_pos = vec3(dcubo.model * position);
+}
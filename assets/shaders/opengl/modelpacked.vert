@@ -0,0 +1,55 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_GOOGLE_include_directive : enable
+
+#include "packedcommon.glsl"
+
+const int MAX_JOINTS = 50;
+const int MAX_WEIGHTS = 3;
+
+layout(binding = 0) uniform ModelUniformBufferObject {
+  mat4 model;
+  mat4 view;
+  mat4 proj;
+	vec3 camera_pos;
+} ubo;
+
+layout(binding = 7) uniform ModelAnimationUniformBufferObject {
+	mat4 joint_transforms[MAX_JOINTS];
+} uboa;
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 normal;
+layout(location = 2) in vec2 tex_coord;
+layout(location = 3) in vec4 color;
+layout(location = 4) in uvec4 joints_ids;
+layout(location = 5) in vec4 weights;
+
+layout(location = 0) out vec2 out_texture_coords;
+layout(location = 1) out vec3 out_normal;
+layout(location = 2) out vec3 out_frag_color;
+layout(location = 3) out vec3 out_frag_pos;
+
+void main(void){
+	vec4 total_local_pos = vec4(0.0);
+	vec4 total_normal = vec4(0.0);
+	vec3 model_normal = octahedral_decode(normal);
+	// Note: Weights were rounded to 8 bits, renormalizing keeps the pose from shrinking or growing slightly
+	vec3 model_weights = weights.xyz / max(weights.x + weights.y + weights.z, 1e-4);
+	
+	for(int i = 0; i < MAX_WEIGHTS; i++){
+		mat4 joint_transform = uboa.joint_transforms[joints_ids[i]];
+		vec4 pose_position = joint_transform * vec4(position, 1.0);
+		total_local_pos += pose_position * model_weights[i];
+		
+		vec4 world_normal = joint_transform * vec4(model_normal, 0.0);
+		total_normal += world_normal * model_weights[i];
+	}
+
+	gl_Position = ubo.proj * ubo.view * ubo.model * total_local_pos;
+	out_normal = total_normal.xyz;
+	out_texture_coords = tex_coord;
+
+	out_frag_color = color.rgb;
+	out_frag_pos = vec3(ubo.model * vec4(position, 1.0));
+}
@@ -0,0 +1,8 @@
+// Inverse of mesh_pack_octahedral, the lower hemisphere was folded over the diagonals
+vec3 octahedral_decode(vec2 e) {
+  vec3 n = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+  float t = max(-n.z, 0.0);
+  n.x += n.x >= 0.0 ? -t : t;
+  n.y += n.y >= 0.0 ? -t : t;
+  return normalize(n);
+}
@@ -0,0 +1,28 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(binding = 0) uniform SpriteBatchUniformBufferObject {
+  mat4 view;
+  mat4 proj;
+} ubo;
+
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec2 in_tex_coord;
+
+layout(location = 2) in vec3 in_instance_position;
+layout(location = 3) in vec2 in_instance_size;
+layout(location = 4) in vec4 in_instance_rotation;
+layout(location = 5) in vec4 in_instance_uv_rect;
+
+layout(location = 0) out vec2 frag_tex_coord;
+
+vec3 rotate(vec4 q, vec3 v) {
+  return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
+}
+
+void main() {
+  vec3 local_position = vec3(in_position.xy * in_instance_size, in_position.z);
+  vec3 world_position = in_instance_position + rotate(normalize(in_instance_rotation), local_position);
+  gl_Position = ubo.proj * ubo.view * vec4(world_position, 1.0);
+  frag_tex_coord = in_instance_uv_rect.xy + in_tex_coord * in_instance_uv_rect.zw;
+}
@@ -0,0 +1,291 @@
+// Runs the classic and manifold dual contouring pipelines without a window or GPU and reports every stage
+// DualContouringBenchmark [--resolutions 32,64,128] [--threads 1,2,4] [--octaves 4] [--frequencies 1.0] [--repeats 5] [--threshold 0.0] [--format csv|json] [--output path]
+
+#include <mana/core/memoryallocator.h>
+//
+#include <mana/graphics/dualcontouring/dualcontouring.h>
+#include <mana/graphics/dualcontouring/manifold/manifoldoctree.h>
+#include <mana/graphics/utilities/meshoptimize.h>
+
+#define BENCHMARK_MAX_VALUES 16
+#define BENCHMARK_MAX_REPEATS 256
+#define BENCHMARK_MAX_STAGES 5
+
+enum BenchmarkFormat {
+  BENCHMARK_FORMAT_CSV,
+  BENCHMARK_FORMAT_JSON
+};
+
+struct BenchmarkSettings {
+  int resolutions[BENCHMARK_MAX_VALUES];
+  int resolution_count;
+  int threads[BENCHMARK_MAX_VALUES];
+  int thread_count;
+  int octaves[BENCHMARK_MAX_VALUES];
+  int octave_count;
+  float frequencies[BENCHMARK_MAX_VALUES];
+  int frequency_count;
+  int repeats;
+  float threshold;
+  enum BenchmarkFormat format;
+  const char* output_path;
+};
+
+struct BenchmarkCase {
+  const char* pipeline;
+  int resolution;
+  int threads;
+  int octaves;
+  float frequency;
+};
+
+// Note: Counts are from the last repeat, every repeat builds the same mesh so they only differ if something is broken
+struct BenchmarkResult {
+  int stage_count;
+  const char* stage_names[BENCHMARK_MAX_STAGES];
+  double stage_times[BENCHMARK_MAX_STAGES][BENCHMARK_MAX_REPEATS];
+  int vertices;
+  int indices;
+};
+
+static const char* CLASSIC_STAGES[] = {"noise", "build", "mesh", "optimize"};
+static const char* MANIFOLD_STAGES[] = {"construct", "cluster", "vertex", "process", "optimize"};
+
+static int benchmark_parse_ints(const char* list, int* values) {
+  int count = 0;
+  for (const char* value = list; value != NULL && count < BENCHMARK_MAX_VALUES; value = strchr(value, ',')) {
+    if (*value == ',')
+      value++;
+    values[count++] = atoi(value);
+  }
+
+  return count;
+}
+
+static int benchmark_parse_floats(const char* list, float* values) {
+  int count = 0;
+  for (const char* value = list; value != NULL && count < BENCHMARK_MAX_VALUES; value = strchr(value, ',')) {
+    if (*value == ',')
+      value++;
+    values[count++] = (float)atof(value);
+  }
+
+  return count;
+}
+
+static int benchmark_parse_settings(struct BenchmarkSettings* settings, int argc, char* argv[]) {
+  *settings = (struct BenchmarkSettings){.resolutions = {32, 64, 128}, .resolution_count = 3, .threads = {1, omp_get_max_threads()}, .thread_count = omp_get_max_threads() > 1 ? 2 : 1, .octaves = {4}, .octave_count = 1, .frequencies = {1.0f}, .frequency_count = 1, .repeats = 5, .threshold = 0.0f, .format = BENCHMARK_FORMAT_CSV, .output_path = NULL};
+
+  for (int arg_num = 1; arg_num < argc; arg_num++) {
+    const char* value = arg_num + 1 < argc ? argv[arg_num + 1] : NULL;
+    if (value == NULL) {
+      fprintf(stderr, "Missing value for %s\n", argv[arg_num]);
+      return 0;
+    }
+
+    if (strcmp(argv[arg_num], "--resolutions") == 0)
+      settings->resolution_count = benchmark_parse_ints(value, settings->resolutions);
+    else if (strcmp(argv[arg_num], "--threads") == 0)
+      settings->thread_count = benchmark_parse_ints(value, settings->threads);
+    else if (strcmp(argv[arg_num], "--octaves") == 0)
+      settings->octave_count = benchmark_parse_ints(value, settings->octaves);
+    else if (strcmp(argv[arg_num], "--frequencies") == 0)
+      settings->frequency_count = benchmark_parse_floats(value, settings->frequencies);
+    else if (strcmp(argv[arg_num], "--repeats") == 0)
+      settings->repeats = MAX(1, MIN(atoi(value), BENCHMARK_MAX_REPEATS));
+    else if (strcmp(argv[arg_num], "--threshold") == 0)
+      settings->threshold = (float)atof(value);
+    else if (strcmp(argv[arg_num], "--format") == 0)
+      settings->format = strcmp(value, "json") == 0 ? BENCHMARK_FORMAT_JSON : BENCHMARK_FORMAT_CSV;
+    else if (strcmp(argv[arg_num], "--output") == 0)
+      settings->output_path = value;
+    else {
+      fprintf(stderr, "Unknown option %s\n", argv[arg_num]);
+      return 0;
+    }
+    arg_num++;
+  }
+
+  return 1;
+}
+
+// Note: Goes through the engine's ridged sum a z slice at a time so the grid sums every noise from the given origin, the same densities the single sample path sees
+static float* benchmark_density_set(struct Vector* noises, float x, float y, float z, int x_size, int y_size, int z_size) {
+  const int slice_size = x_size * y_size;
+  float* density_set = malloc(sizeof(float) * slice_size * z_size);
+  float(*positions)[3] = malloc(sizeof(float) * 3 * slice_size);
+  for (int z_num = 0; z_num < z_size; z_num++) {
+    for (int y_num = 0; y_num < y_size; y_num++) {
+      for (int x_num = 0; x_num < x_size; x_num++) {
+        float* position = positions[x_num + (y_num * x_size)];
+        position[0] = x + (float)x_num;
+        position[1] = y + (float)y_num;
+        position[2] = z + (float)z_num;
+      }
+    }
+
+    dual_contouring_density_ridged_sum_batch_avx2(noises, positions, density_set + (z_num * slice_size), slice_size);
+  }
+  free(positions);
+
+  return density_set;
+}
+
+static void benchmark_run_classic(struct BenchmarkCase* bench_case, struct Vector* noises, struct BenchmarkSettings* settings, struct BenchmarkResult* result) {
+  struct DualContouring dual_contouring;
+  dual_contouring_setup(&dual_contouring, bench_case->resolution, NULL, noises, dual_contouring_density_ridged_sum_single, benchmark_density_set, dual_contouring_density_ridged_sum_batch_avx2);
+  const ivec3 min = (ivec3){.data[0] = -bench_case->resolution / 2, .data[1] = -bench_case->resolution / 2, .data[2] = -bench_case->resolution / 2};
+
+  result->stage_count = BENCHMARK_MAX_STAGES - 1;
+  memcpy(result->stage_names, CLASSIC_STAGES, sizeof(CLASSIC_STAGES));
+  for (int repeat_num = 0; repeat_num < settings->repeats; repeat_num++) {
+    double stage_times[BENCHMARK_MAX_STAGES];
+    stage_times[0] = engine_get_time();
+    dual_contouring.noise_set = dual_contouring.density_func_set(noises, 0.0f, 0.0f, 0.0f, bench_case->resolution, bench_case->resolution, bench_case->resolution);
+    stage_times[1] = engine_get_time();
+    dual_contouring.head = octree_build_octree(min, bench_case->resolution, dual_contouring.simplify_threshold, &dual_contouring);
+    stage_times[2] = engine_get_time();
+    octree_generate_mesh_from_octree(dual_contouring.head, &dual_contouring);
+    stage_times[3] = engine_get_time();
+    mesh_optimize(dual_contouring.mesh, true, &dual_contouring.optimize_stats);
+    stage_times[4] = engine_get_time();
+
+    for (int stage_num = 0; stage_num < result->stage_count; stage_num++)
+      result->stage_times[stage_num][repeat_num] = stage_times[stage_num + 1] - stage_times[stage_num];
+    result->vertices = vector_size(dual_contouring.mesh->vertices);
+    result->indices = vector_size(dual_contouring.mesh->indices);
+
+    // Note: The arenas are kept like a rebuild in game would, the mesh is recreated since optimizing may have narrowed its indices
+    free(dual_contouring.noise_set);
+    dual_contouring.noise_set = NULL;
+    mesh_delete(dual_contouring.mesh);
+    mesh_dual_contouring_init(dual_contouring.mesh);
+  }
+
+  dual_contouring_release_build_data(&dual_contouring);
+  mesh_delete(dual_contouring.mesh);
+  free(dual_contouring.mesh);
+}
+
+static void benchmark_run_manifold(struct BenchmarkCase* bench_case, struct Vector* noises, struct BenchmarkSettings* settings, struct BenchmarkResult* result) {
+  struct ManifoldOctreeLevels levels = {0};
+  struct Mesh mesh = {0};
+  mesh_manifold_dual_contouring_init(&mesh);
+
+  result->stage_count = BENCHMARK_MAX_STAGES;
+  memcpy(result->stage_names, MANIFOLD_STAGES, sizeof(MANIFOLD_STAGES));
+  for (int repeat_num = 0; repeat_num < settings->repeats; repeat_num++) {
+    double stage_times[BENCHMARK_MAX_STAGES + 1];
+    stage_times[0] = engine_get_time();
+    manifold_octree_construct_base(&levels, bench_case->resolution, noises, NULL);
+    stage_times[1] = engine_get_time();
+    manifold_octree_cluster_cell_base(&levels, 0);
+    stage_times[2] = engine_get_time();
+    manifold_octree_generate_vertex_buffer(&levels, mesh.vertices);
+    stage_times[3] = engine_get_time();
+    manifold_octree_process_cell(&levels, mesh.indices, settings->threshold, levels.index_offsets);
+    stage_times[4] = engine_get_time();
+    manifold_octree_optimize_mesh(&levels, &mesh, NULL);
+    stage_times[5] = engine_get_time();
+
+    for (int stage_num = 0; stage_num < result->stage_count; stage_num++)
+      result->stage_times[stage_num][repeat_num] = stage_times[stage_num + 1] - stage_times[stage_num];
+    result->vertices = vector_size(mesh.vertices);
+    result->indices = vector_size(mesh.indices);
+
+    manifold_octree_reset(&levels);
+    mesh_clear(&mesh);
+  }
+
+  manifold_octree_destroy_octree(&levels);
+  mesh_delete(&mesh);
+}
+
+static int benchmark_compare_times(const void* a, const void* b) {
+  const double time_a = *(const double*)a;
+  const double time_b = *(const double*)b;
+  return (time_a > time_b) - (time_a < time_b);
+}
+
+// Note: Sorts in place, p95 is nearest rank so with few repeats it's simply the slowest run
+static void benchmark_summarize(double* times, int count, double* median, double* p95) {
+  qsort(times, count, sizeof(double), benchmark_compare_times);
+  *median = (count % 2 == 1) ? times[count / 2] : (times[(count / 2) - 1] + times[count / 2]) * 0.5;
+  *p95 = times[MAX(0, (int)ceil(0.95 * count) - 1)];
+}
+
+static void benchmark_write_result(FILE* output, struct BenchmarkSettings* settings, struct BenchmarkCase* bench_case, struct BenchmarkResult* result, bool* first_row) {
+  for (int stage_num = 0; stage_num < result->stage_count; stage_num++) {
+    double median, p95;
+    benchmark_summarize(result->stage_times[stage_num], settings->repeats, &median, &p95);
+    if (settings->format == BENCHMARK_FORMAT_CSV)
+      fprintf(output, "%s,%d,%d,%d,%f,%s,%d,%.9f,%.9f,%d,%d\n", bench_case->pipeline, bench_case->resolution, bench_case->threads, bench_case->octaves, bench_case->frequency, result->stage_names[stage_num], settings->repeats, median, p95, result->vertices, result->indices);
+    else
+      fprintf(output, "%s\n  {\"pipeline\": \"%s\", \"resolution\": %d, \"threads\": %d, \"octaves\": %d, \"frequency\": %f, \"stage\": \"%s\", \"repeats\": %d, \"median\": %.9f, \"p95\": %.9f, \"vertices\": %d, \"indices\": %d}", *first_row ? "" : ",", bench_case->pipeline, bench_case->resolution, bench_case->threads, bench_case->octaves, bench_case->frequency, result->stage_names[stage_num], settings->repeats, median, p95, result->vertices, result->indices);
+    *first_row = false;
+  }
+}
+
+int main(int argc, char* argv[]) {
+  struct BenchmarkSettings settings;
+  if (!benchmark_parse_settings(&settings, argc, argv))
+    return 1;
+
+  FILE* output = settings.output_path != NULL ? fopen(settings.output_path, "w") : stdout;
+  if (output == NULL) {
+    fprintf(stderr, "Failed to open %s\n", settings.output_path);
+    return 1;
+  }
+
+  if (settings.format == BENCHMARK_FORMAT_CSV)
+    fprintf(output, "pipeline,resolution,threads,octaves,frequency,stage,repeats,median,p95,vertices,indices\n");
+  else
+    fprintf(output, "[");
+
+  struct BenchmarkResult* result = malloc(sizeof(struct BenchmarkResult));
+  const int max_threads = omp_get_max_threads();
+  bool first_row = true;
+  for (int resolution_num = 0; resolution_num < settings.resolution_count; resolution_num++) {
+    for (int octave_num = 0; octave_num < settings.octave_count; octave_num++) {
+      for (int frequency_num = 0; frequency_num < settings.frequency_count; frequency_num++) {
+        struct Noise noise = {0};
+        noise.noise_type = RIDGED_FRACTAL_NOISE;
+        ridged_fractal_noise_init(&noise.ridged_fractal_noise);
+        noise.ridged_fractal_noise.octave_count = settings.octaves[octave_num];
+        noise.ridged_fractal_noise.frequency = settings.frequencies[frequency_num];
+        noise.ridged_fractal_noise.step = 1.0f / settings.resolutions[resolution_num];
+
+        struct Vector noises = {0};
+        vector_init(&noises, sizeof(struct Noise));
+        vector_push_back(&noises, &noise);
+
+        for (int thread_num = 0; thread_num < settings.thread_count; thread_num++) {
+          omp_set_num_threads(MAX(1, settings.threads[thread_num]));
+          struct BenchmarkCase bench_case = {.resolution = settings.resolutions[resolution_num], .threads = MAX(1, settings.threads[thread_num]), .octaves = settings.octaves[octave_num], .frequency = settings.frequencies[frequency_num]};
+
+          bench_case.pipeline = "classic";
+          benchmark_run_classic(&bench_case, &noises, &settings, result);
+          benchmark_write_result(output, &settings, &bench_case, result, &first_row);
+
+          bench_case.pipeline = "manifold";
+          benchmark_run_manifold(&bench_case, &noises, &settings, result);
+          benchmark_write_result(output, &settings, &bench_case, result, &first_row);
+          fflush(output);
+        }
+
+        vector_delete(&noises);
+      }
+    }
+  }
+
+  if (settings.format == BENCHMARK_FORMAT_JSON)
+    fprintf(output, "\n]\n");
+
+  fprintf(stderr, "Peak memory usage: %zu bytes\n", engine_get_peak_memory_usage());
+  free(result);
+  omp_set_num_threads(max_threads);
+  if (output != stdout)
+    fclose(output);
+
+  return 0;
+}
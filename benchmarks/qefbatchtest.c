@@ -0,0 +1,163 @@
+// Solves the same systems with the scalar QEF solver and the AVX2 batch and fails if positions or errors drift apart
+// QefBatchTest [--seed 1] [--systems 4096]
+
+#include <mana/core/memoryallocator.h>
+//
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mana/graphics/dualcontouring/qef.h>
+
+#define QEF_TEST_SVD_TOL 1e-6f
+#define QEF_TEST_SVD_SWEEPS 4
+#define QEF_TEST_PINV_TOL 1e-6f
+// Note: The batch does the same sweeps in a different operation order so it only has to agree to float noise. Error is x^T A x - 2 x^T b + b^T b evaluated far from the origin, that cancels so it's compared relative to the size of the terms
+#define QEF_TEST_POSITION_TOLERANCE 1e-3f
+#define QEF_TEST_ERROR_TOLERANCE 1e-6f
+
+struct QefTestStats {
+  int systems;
+  int failures;
+  float max_position_diff;
+  float max_error_diff;
+};
+
+static float qef_test_random(float min, float max) {
+  return min + (max - min) * ((float)rand() / (float)RAND_MAX);
+}
+
+static vec3 qef_test_random_direction(void) {
+  vec3 direction = VEC3_ZERO;
+  float length = 0.0f;
+  while (length < 1e-3f) {
+    direction = (vec3){.x = qef_test_random(-1.0f, 1.0f), .y = qef_test_random(-1.0f, 1.0f), .z = qef_test_random(-1.0f, 1.0f)};
+    length = sqrtf(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+  }
+  return (vec3){.x = direction.x / length, .y = direction.y / length, .z = direction.z / length};
+}
+
+// Note: Intersection points on the faces of a unit cell at origin with normals around a feature inside it, like construct_base produces
+static void qef_test_random_system(struct QefData* qef_data, vec3 origin) {
+  struct QefSolver qef = {0};
+  qef_solver_init(&qef);
+  const int point_count = 1 + rand() % 12;
+  for (int point_num = 0; point_num < point_count; point_num++) {
+    vec3 normal = qef_test_random_direction();
+    qef_solver_add(&qef, origin.x + qef_test_random(0.0f, 1.0f), origin.y + qef_test_random(0.0f, 1.0f), origin.z + qef_test_random(0.0f, 1.0f), normal.x, normal.y, normal.z);
+  }
+  *qef_data = qef.data;
+}
+
+// Note: Rank deficient systems are where the pseudo inverse truncation decides the answer, a single plane, two planes meeting on a line, repeated identical samples and a lone point
+static void qef_test_degenerate_system(struct QefData* qef_data, vec3 origin, int kind) {
+  struct QefSolver qef = {0};
+  qef_solver_init(&qef);
+  const vec3 first = qef_test_random_direction();
+  const vec3 second = qef_test_random_direction();
+  const int point_count = 2 + rand() % 8;
+  for (int point_num = 0; point_num < point_count; point_num++) {
+    const vec3 point = {.x = origin.x + qef_test_random(0.0f, 1.0f), .y = origin.y + qef_test_random(0.0f, 1.0f), .z = origin.z + qef_test_random(0.0f, 1.0f)};
+    switch (kind % 4) {
+      case 0:
+        qef_solver_add(&qef, point.x, point.y, point.z, first.x, first.y, first.z);
+        break;
+      case 1: {
+        const vec3 normal = (point_num % 2 == 0) ? first : second;
+        qef_solver_add(&qef, point.x, point.y, point.z, normal.x, normal.y, normal.z);
+        break;
+      }
+      case 2:
+        qef_solver_add(&qef, origin.x + 0.5f, origin.y + 0.5f, origin.z + 0.5f, first.x, first.y, first.z);
+        break;
+      default:
+        if (point_num == 0)
+          qef_solver_add(&qef, point.x, point.y, point.z, first.x, first.y, first.z);
+        break;
+    }
+  }
+  *qef_data = qef.data;
+}
+
+static float qef_test_diff(vec3 a, vec3 b) {
+  return fmaxf(fabsf(a.x - b.x), fmaxf(fabsf(a.y - b.y), fabsf(a.z - b.z)));
+}
+
+// Note: Solves count systems as one batch so any lanes past count are padding, then checks every real lane against the scalar solver
+static void qef_test_compare(struct QefData* systems, int count, const char* kind, struct QefTestStats* stats) {
+  struct QefBatch qef_batch;
+  qef_batch_init(&qef_batch);
+  for (int lane = 0; lane < count; lane++)
+    qef_batch_add(&qef_batch, &systems[lane]);
+
+  vec3 positions[QEF_BATCH_WIDTH];
+  float errors[QEF_BATCH_WIDTH];
+  qef_batch_solve(&qef_batch, positions, errors, QEF_TEST_SVD_TOL, QEF_TEST_SVD_SWEEPS, QEF_TEST_PINV_TOL);
+
+  for (int lane = 0; lane < count; lane++) {
+    struct QefSolver qef = {0};
+    qef_solver_init(&qef);
+    qef_solver_add_copy(&qef, &systems[lane]);
+    vec3 position = VEC3_ZERO;
+    qef_solver_solve(&qef, &position, QEF_TEST_SVD_TOL, QEF_TEST_SVD_SWEEPS, QEF_TEST_PINV_TOL);
+    const float error = qef_solver_get_error_pos(&qef, position);
+
+    const float position_diff = qef_test_diff(position, positions[lane]);
+    const float trace = systems[lane].ata_00 + systems[lane].ata_11 + systems[lane].ata_22;
+    const float error_scale = trace * (position.x * position.x + position.y * position.y + position.z * position.z) + systems[lane].btb;
+    const float error_diff = fabsf(error - errors[lane]) / fmaxf(1.0f, error_scale);
+    stats->systems++;
+    stats->max_position_diff = fmaxf(stats->max_position_diff, position_diff);
+    stats->max_error_diff = fmaxf(stats->max_error_diff, error_diff);
+    if (!(position_diff <= QEF_TEST_POSITION_TOLERANCE) || !(error_diff <= QEF_TEST_ERROR_TOLERANCE)) {
+      stats->failures++;
+      fprintf(stderr, "%s lane %d of %d: scalar (%f, %f, %f) error %f, batch (%f, %f, %f) error %f\n", kind, lane, count, position.x, position.y, position.z, error, positions[lane].x, positions[lane].y, positions[lane].z, errors[lane]);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  unsigned int seed = 1;
+  int system_count = 4096;
+  for (int arg_num = 1; arg_num < argc - 1; arg_num++) {
+    if (strcmp(argv[arg_num], "--seed") == 0)
+      seed = (unsigned int)atoi(argv[++arg_num]);
+    else if (strcmp(argv[arg_num], "--systems") == 0)
+      system_count = atoi(argv[++arg_num]);
+  }
+  srand(seed);
+
+  struct QefTestStats stats = {0};
+  struct QefData systems[QEF_BATCH_WIDTH];
+
+  for (int batch_start = 0; batch_start < system_count; batch_start += QEF_BATCH_WIDTH) {
+    for (int lane = 0; lane < QEF_BATCH_WIDTH; lane++)
+      qef_test_random_system(&systems[lane], (vec3){.x = (float)(rand() % 128), .y = (float)(rand() % 128), .z = (float)(rand() % 128)});
+    qef_test_compare(systems, QEF_BATCH_WIDTH, "random", &stats);
+  }
+
+  // Note: Degenerate kinds are mixed into one batch so lanes that stop rotating early sit next to ones that keep going
+  for (int batch_start = 0; batch_start < system_count; batch_start += QEF_BATCH_WIDTH) {
+    for (int lane = 0; lane < QEF_BATCH_WIDTH; lane++)
+      qef_test_degenerate_system(&systems[lane], (vec3){.x = (float)(rand() % 128), .y = (float)(rand() % 128), .z = (float)(rand() % 128)}, batch_start / QEF_BATCH_WIDTH + lane);
+    qef_test_compare(systems, QEF_BATCH_WIDTH, "degenerate", &stats);
+  }
+
+  // Note: Every partial batch size, the tail of each level's solve is one of these
+  for (int count = 1; count < QEF_BATCH_WIDTH; count++) {
+    for (int repeat = 0; repeat < 64; repeat++) {
+      for (int lane = 0; lane < count; lane++) {
+        const vec3 origin = {.x = (float)(rand() % 128), .y = (float)(rand() % 128), .z = (float)(rand() % 128)};
+        if (lane % 2 == 0)
+          qef_test_random_system(&systems[lane], origin);
+        else
+          qef_test_degenerate_system(&systems[lane], origin, rand());
+      }
+      qef_test_compare(systems, count, "padded", &stats);
+    }
+  }
+
+  printf("%d systems, %d failures, max position difference %g, max relative error difference %g\n", stats.systems, stats.failures, stats.max_position_diff, stats.max_error_diff);
+  return (stats.failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -3,9 +3,9 @@
 #include <mana/core/memoryallocator.h>
 //
 #include <mana/core/inputmanager.h>
-#include <mana/graphics/entities/sprite.h>
+#include <mana/graphics/entities/spritebatch.h>
 #include <mana/graphics/shaders/modelstaticshader.h>
-#include <mana/graphics/shaders/spriteshader.h>
+#include <mana/graphics/shaders/spritebatchshader.h>
 #include <mana/graphics/utilities/camera.h>
 #include <mana/graphics/utilities/modelcache.h>
 #include <mana/graphics/utilities/texturecache.h>
@@ -17,7 +17,8 @@ struct Game {
 
   struct Camera camera;
   struct TextureCache texture_cache;
-  struct SpriteShader sprite_shader;
+  struct SpriteBatchShader sprite_batch_shader;
+  struct SpriteBatch sprite_batch;
   struct ModelCache model_cache;
   struct ModelStaticShader model_static_shader;
   vec3 light_pos;
@@ -86,11 +87,13 @@ int game_init(struct Game* game) {
   texture_cache_init(&game->texture_cache);
   texture_cache_add(&game->texture_cache, gpu_api, 2, texture1, texture2);
 
-  sprite_shader_init(&game->sprite_shader, gpu_api);
+  // Note: Sprites only hold a transform, the batch draws all of them with one instanced draw per texture
+  sprite_batch_shader_init(&game->sprite_batch_shader, gpu_api, 1);
+  sprite_batch_init(&game->sprite_batch, gpu_api, &game->sprite_batch_shader.shader, SPRITE_BATCH_DEFAULT_INSTANCES);
   array_list_init(&game->sprites);
   for (int loop_num = 0; loop_num < 10; loop_num++) {
     struct Sprite* sprite = malloc(sizeof(struct Sprite));
-    sprite_init(sprite, gpu_api, &game->sprite_shader.shader, texture_cache_get(&game->texture_cache, "./assets/textures/alpha.png"));
+    sprite_setup(sprite, texture_cache_get(&game->texture_cache, "./assets/textures/alpha.png"));
     sprite->position = (vec3){.x = loop_num, .y = loop_num, .z = loop_num};
     sprite->rotation = (quat){.data[0] = loop_num / 3.0f, .data[1] = loop_num / 3.0f, .data[2] = loop_num / 3.0f, .data[3] = 1.0f};
     array_list_add(&game->sprites, sprite);
@@ -111,7 +114,7 @@ int game_init(struct Game* game) {
 void game_delete(struct Game* game) {
   struct GPUAPI* gpu_api = &game->mana.engine.gpu_api;
   // Wait for command buffers to finish before deleting desciptor sets
-  vkWaitForFences(gpu_api->vulkan_state->device, 2, gpu_api->vulkan_state->swap_chain->in_flight_fences, VK_TRUE, UINT64_MAX);
+  vkWaitForFences(gpu_api->vulkan_state->device, MAX_FRAMES_IN_FLIGHT, gpu_api->vulkan_state->swap_chain->in_flight_fences, VK_TRUE, UINT64_MAX);
 
   for (int model_num = 0; model_num < array_list_size(&game->models); model_num++) {
     struct Model* model = array_list_get(&game->models, model_num);
@@ -123,16 +126,14 @@ void game_delete(struct Game* game) {
   model_static_shader_delete(&game->model_static_shader, gpu_api);
 
   model_cache_delete(&game->model_cache, gpu_api);
-  texture_cache_delete(&game->texture_cache, gpu_api);
 
-  for (int sprite_num = 0; sprite_num < array_list_size(&game->sprites); sprite_num++) {
-    struct Sprite* sprite = array_list_get(&game->sprites, sprite_num);
-    sprite_delete(sprite, gpu_api);
-    free(sprite);
-  }
+  for (int sprite_num = 0; sprite_num < array_list_size(&game->sprites); sprite_num++)
+    free(array_list_get(&game->sprites, sprite_num));
 
   array_list_delete(&game->sprites);
-  sprite_shader_delete(&game->sprite_shader, gpu_api);
+  sprite_batch_delete(&game->sprite_batch, gpu_api);
+  sprite_batch_shader_delete(&game->sprite_batch_shader, gpu_api);
+  texture_cache_delete(&game->texture_cache, gpu_api);
 
   window_delete(&game->window);
   mana_cleanup(&game->mana);
@@ -189,17 +190,14 @@ void game_update(struct Game* game, struct Mana* mana, double delta_time) {
     model_static_shader_delete(&game->model_static_shader, gpu_api);
     model_static_shader_init(&game->model_static_shader, gpu_api);
 
-    sprite_shader_delete(&game->sprite_shader, gpu_api);
-    sprite_shader_init(&game->sprite_shader, gpu_api);
+    sprite_batch_shader_delete(&game->sprite_batch_shader, gpu_api);
+    sprite_batch_shader_init(&game->sprite_batch_shader, gpu_api, 1);
 
     for (int model_num = 0; model_num < array_list_size(&game->models); model_num++) {
       struct Model* model = array_list_get(&game->models, model_num);
       model_recreate(model, gpu_api);
     }
-    for (int sprite_num = 0; sprite_num < array_list_size(&game->sprites); sprite_num++) {
-      struct Sprite* sprite = array_list_get(&game->sprites, sprite_num);
-      sprite_recreate(sprite, gpu_api);
-    }
+    sprite_batch_recreate(&game->sprite_batch, gpu_api);
   }
 
   game->light_pos = game->camera.position;
@@ -209,6 +207,12 @@ void game_update(struct Game* game, struct Mana* mana, double delta_time) {
   camera_update_vectors(&game->camera);
   gpu_api->vulkan_state->gbuffer->projection_matrix = camera_get_projection_matrix(&game->camera, &game->window);
   gpu_api->vulkan_state->gbuffer->view_matrix = camera_get_view_matrix(&game->camera);
+
+  for (int sprite_num = array_list_size(&game->sprites) - 1; sprite_num >= 0; sprite_num--) {
+    struct Sprite* sprite = array_list_get(&game->sprites, sprite_num);
+    float rot_val = (sprite_num + 1) * delta_time;
+    sprite->rotation = quaternion_mul(sprite->rotation, (quat){.data[0] = rot_val / 3.0f, .data[1] = rot_val / 3.0f, .data[2] = rot_val / 3.0f, .data[3] = 1.0f});
+  }
   game_update_uniform_buffers(game, &mana->engine);
 
   gbuffer_start(gpu_api->vulkan_state->gbuffer, gpu_api->vulkan_state);
@@ -219,12 +223,7 @@ void game_update(struct Game* game, struct Mana* mana, double delta_time) {
     model->rotation = quaternion_mul(model->rotation, (quat){.data[0] = rot_val / 3.0f, .data[1] = rot_val / 3.0f, .data[2] = rot_val / 3.0f, .data[3] = 1.0f});
     model_render(model, gpu_api, delta_time);
   }
-  for (int sprite_num = array_list_size(&game->sprites) - 1; sprite_num >= 0; sprite_num--) {
-    struct Sprite* sprite = array_list_get(&game->sprites, sprite_num);
-    float rot_val = (sprite_num + 1) * delta_time;
-    sprite->rotation = quaternion_mul(sprite->rotation, (quat){.data[0] = rot_val / 3.0f, .data[1] = rot_val / 3.0f, .data[2] = rot_val / 3.0f, .data[3] = 1.0f});
-    sprite_render(sprite, gpu_api, delta_time);
-  }
+  sprite_batch_render(&game->sprite_batch, gpu_api);
 
   gbuffer_stop(gpu_api->vulkan_state->gbuffer, gpu_api->vulkan_state);
   blit_post_process_render(gpu_api->vulkan_state->post_process->blit_post_process, gpu_api);
@@ -353,10 +352,13 @@ void game_update_input(struct Game* game, struct Engine* engine) {
 }
 
 void game_update_uniform_buffers(struct Game* game, struct Engine* engine) {
+  // Note: Instances are copied out here so every sprite has to be added before it
+  sprite_batch_begin(&game->sprite_batch);
   for (int entity_num = 0; entity_num < array_list_size(&game->sprites); entity_num++) {
     struct Sprite* sprite = (struct Sprite*)array_list_get(&game->sprites, entity_num);
-    sprite_update_uniforms(sprite, &engine->gpu_api);
+    sprite_batch_add_sprite(&game->sprite_batch, &engine->gpu_api, sprite);
   }
+  sprite_batch_update_uniforms(&game->sprite_batch, &engine->gpu_api);
 
   for (int model_num = 0; model_num < array_list_size(&game->models); model_num++) {
     struct Model* model = array_list_get(&game->models, model_num);
@@ -9,6 +9,7 @@
 
 #include "mana/core/gpuapi.h"
 #include "mana/core/graphicslibrary.h"
+#include "mana/core/jobsystem.h"
 #include "mana/core/vulkancore.h"
 #include "mana/graphics/render/window.h"
 
@@ -19,6 +20,7 @@ enum ENGINE_STATUS {
   ENGINE_SUCCESS = 0,
   ENGINE_GRAPHICS_LIBRARY_ERROR,
   ENGINE_GPU_API_ERROR,
+  ENGINE_JOB_SYSTEM_ERROR,
   ENGINE_LAST_ERROR
 };
 
@@ -53,11 +55,13 @@ struct Engine {
   struct FPSCounter fps_counter;
   struct GraphicsLibrary graphics_library;
   struct GPUAPI gpu_api;
+  struct JobSystem job_system;
 };
 
 int engine_init(struct Engine* engine, struct EngineSettings engine_settings);
 void engine_delete(struct Engine* engine);
 double engine_get_time();
+size_t engine_get_peak_memory_usage();
 int engine_get_max_omp_threads();
 
 #endif  // ENGINE_H
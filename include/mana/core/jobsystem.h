@@ -0,0 +1,73 @@
+#pragma once
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <threads/threads.h>
+
+#include "mana/core/corecommon.h"
+
+// Note: Capacity must be a power of two, it also caps how many jobs can be in flight at once
+#define JOB_QUEUE_CAPACITY 256
+#define JOB_SYSTEM_MAX_WORKERS 16
+#define JOB_SYSTEM_DEFAULT_WORKERS 2
+#define JOB_SYSTEM_CACHE_LINE 64
+// Note: Finish callbacks usually upload to the GPU so only a few run per frame to keep frame times flat
+#define JOB_SYSTEM_FINISHES_PER_FRAME 4
+
+enum JOB_SYSTEM_STATUS {
+  JOB_SYSTEM_SUCCESS = 0,
+  JOB_SYSTEM_THREAD_ERROR,
+  JOB_SYSTEM_FULL_ERROR,
+  JOB_SYSTEM_LAST_ERROR
+};
+
+// Note: execute runs on a worker thread, finish runs on whichever thread calls job_system_process_completed
+struct Job {
+  void (*execute)(void*);
+  void (*finish)(void*);
+  void* data;
+};
+
+struct JobQueueCell {
+  atomic_size_t sequence;
+  struct Job job;
+};
+
+// Note: Bounded multi producer multi consumer ring, each cell carries a sequence number so push and pop only ever race on one atomic counter
+struct JobQueue {
+  struct JobQueueCell cells[JOB_QUEUE_CAPACITY];
+  alignas(JOB_SYSTEM_CACHE_LINE) atomic_size_t enqueue_pos;
+  alignas(JOB_SYSTEM_CACHE_LINE) atomic_size_t dequeue_pos;
+};
+
+void job_queue_init(struct JobQueue* job_queue);
+bool job_queue_push(struct JobQueue* job_queue, struct Job* job);
+bool job_queue_pop(struct JobQueue* job_queue, struct Job* job);
+
+// Note: Jobs and results only ever move through the lock free queues, the mutex is just for parking idle workers
+struct JobSystem {
+  thrd_t workers[JOB_SYSTEM_MAX_WORKERS];
+  int worker_count;
+  struct JobQueue pending;
+  struct JobQueue completed;
+  atomic_int queued;
+  atomic_int in_flight;
+  atomic_bool alive;
+  mtx_t wake_mutex;
+  cnd_t wake_condition;
+};
+
+int job_system_init(struct JobSystem* job_system, int worker_count);
+void job_system_delete(struct JobSystem* job_system);
+int job_system_submit(struct JobSystem* job_system, struct Job job);
+int job_system_process_completed(struct JobSystem* job_system, int max_jobs);
+void job_system_flush(struct JobSystem* job_system);
+
+#endif  // JOB_SYSTEM_H
@@ -0,0 +1,37 @@
+#pragma once
+#ifndef MEMORY_ARENA_H
+#define MEMORY_ARENA_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mana/core/corecommon.h"
+
+#define MEMORY_ARENA_DEFAULT_PAGE_SIZE 262144
+#define MEMORY_ARENA_ALIGNMENT 16
+
+// Note: Pages are chained so pointers handed out stay valid until reset/delete, nothing is ever moved
+struct MemoryArenaPage {
+  struct MemoryArenaPage* next;
+  size_t capacity;
+  size_t used;
+};
+
+struct MemoryArena {
+  struct MemoryArenaPage* pages;
+  struct MemoryArenaPage* free_pages;
+  size_t page_size;
+  size_t bytes_used;
+  size_t bytes_reserved;
+  int page_count;
+};
+
+void memory_arena_init(struct MemoryArena* memory_arena, size_t page_size);
+void memory_arena_delete(struct MemoryArena* memory_arena);
+void memory_arena_reset(struct MemoryArena* memory_arena);
+void* memory_arena_alloc(struct MemoryArena* memory_arena, size_t size);
+
+#endif  // MEMORY_ARENA_H
@@ -10,6 +10,7 @@
 #include <vulkan/vulkan.h>
 
 #include "mana/core/corecommon.h"
+#include "mana/graphics/utilities/gpuallocator.h"
 
 #ifdef NDEBUG
 static const bool enable_validation_layers = false;
@@ -37,6 +38,8 @@ enum VULKAN_CORE_STATUS {
 struct QueueFamilyIndices {
   uint32_t graphics_family;
   uint32_t present_family;
+  // Note: Same as graphics_family when the device has no queue family that only does transfers
+  uint32_t transfer_family;
 };
 
 struct VulkanState {
@@ -46,15 +49,19 @@ struct VulkanState {
   VkDevice device;
   VkQueue graphics_queue;
   VkQueue present_queue;
+  VkQueue transfer_queue;
   VkDebugUtilsMessengerEXT debug_messenger;
   VkCommandPool command_pool;
   VkSampleCountFlagBits msaa_samples;
   struct QueueFamilyIndices indices;
+  struct GPUAllocator* gpu_allocator;
   bool framebuffer_resized;
   bool reset_shaders;
   struct SwapChain* swap_chain;
   struct GBuffer* gbuffer;
   struct PostProcess* post_process;
+  struct UniformRing* uniform_ring;
+  struct UploadManager* upload_manager;
 };
 
 int vulkan_core_init(struct VulkanState* vulkan_state, const char** graphics_lbrary_extensions, uint32_t* graphics_library_extension_count);
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef CHUNK_FILE_H
+#define CHUNK_FILE_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <cstorage/cstorage.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mana/core/corecommon.h"
+#include "mana/graphics/utilities/mesh.h"
+
+// Note: "CHNK" read as little endian, files are only ever read back on the machine type that wrote them
+#define CHUNK_FILE_MAGIC 0x4B4E4843
+// Note: Bump whenever the header or a vertex layout changes, older files are then rebuilt instead of loaded
+#define CHUNK_FILE_VERSION 3
+#define CHUNK_FILE_DATA_ALIGNMENT 64
+
+enum CHUNK_FILE_STATUS {
+  CHUNK_FILE_SUCCESS = 0,
+  CHUNK_FILE_OPEN_ERROR,
+  CHUNK_FILE_MAP_ERROR,
+  CHUNK_FILE_WRITE_ERROR,
+  CHUNK_FILE_FORMAT_ERROR,
+  CHUNK_FILE_MISMATCH_ERROR,
+  CHUNK_FILE_EDITED_ERROR,
+  CHUNK_FILE_LAST_ERROR
+};
+
+enum ChunkFileVertexType {
+  CHUNK_FILE_VERTEX_DUAL_CONTOURING,
+  CHUNK_FILE_VERTEX_MANIFOLD_DUAL_CONTOURING
+};
+
+// Note: Names for density functions, a new one gets the next number and an existing one a new number whenever its function changes what it returns
+enum ChunkFileDensityId {
+  CHUNK_FILE_DENSITY_UNNAMED = 0,
+  CHUNK_FILE_DENSITY_RIDGED_SUM = 1
+};
+
+// Note: Everything a mesh depends on, a file is only loaded when all of it matches what the caller would build. Edited meshes depend on more than this and are never written
+struct ChunkFileParams {
+  enum ChunkFileVertexType vertex_type;
+  uint64_t noise_hash;
+  // Note: Names the density function on top of the noises since function pointers can't be hashed across runs, see ChunkFileDensityId
+  uint32_t density_id;
+  int resolution;
+  float threshold;
+};
+
+// Note: Fixed size fields only so the layout is the same across compilers, vertices start at data_offset and indices follow them
+struct ChunkFileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t vertex_type;
+  uint32_t vertex_size;
+  uint32_t index_size;
+  int32_t resolution;
+  uint64_t noise_hash;
+  uint32_t density_id;
+  float threshold;
+  float bounds_min[3];
+  float bounds_max[3];
+  uint32_t data_offset;
+  uint64_t vertex_count;
+  uint64_t index_count;
+};
+
+// Note: A read only view of a mapped file, vertices and indices point into the mapping and stay valid until chunk_file_close
+struct ChunkFile {
+  void* data;
+  size_t size;
+  const struct ChunkFileHeader* header;
+  const void* vertices;
+  const void* indices;
+#ifdef IS_WINDOWS
+  void* file_handle;
+  void* mapping_handle;
+#endif
+};
+
+int chunk_file_write(const char* path, struct ChunkFileParams* params, struct Mesh* mesh);
+int chunk_file_open(struct ChunkFile* chunk_file, const char* path, struct ChunkFileParams* params, struct Mesh* mesh);
+void chunk_file_close(struct ChunkFile* chunk_file);
+int chunk_file_load_mesh(const char* path, struct ChunkFileParams* params, struct Mesh* mesh);
+
+#endif  // CHUNK_FILE_H
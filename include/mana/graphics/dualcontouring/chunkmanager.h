@@ -0,0 +1,63 @@
+#pragma once
+#ifndef CHUNK_MANAGER_H
+#define CHUNK_MANAGER_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <mana/core/gpuapi.h>
+#include <ubermath/ubermath.h>
+
+#include "mana/graphics/dualcontouring/dualcontouring.h"
+#include "mana/graphics/utilities/camera.h"
+
+// Note: Every chunk covers the same world size, LOD only changes how many cells it is split into
+#define CHUNK_MANAGER_RESOLUTION 32
+#define CHUNK_MANAGER_CHUNK_SIZE 32.0f
+#define CHUNK_MANAGER_VIEW_DISTANCE 4
+#define CHUNK_MANAGER_RING_WIDTH 1
+#define CHUNK_MANAGER_MAX_LOD 3
+#define CHUNK_MANAGER_BUILDS_PER_UPDATE 2
+#define CHUNK_MANAGER_SLOT_COUNT (((CHUNK_MANAGER_VIEW_DISTANCE * 2) + 1) * ((CHUNK_MANAGER_VIEW_DISTANCE * 2) + 1) * ((CHUNK_MANAGER_VIEW_DISTANCE * 2) + 1))
+
+struct Chunk {
+  bool active;
+  bool empty;
+  ivec3 coord;
+  int lod;
+  struct DualContouring dual_contouring;
+};
+
+// Note: A descriptor set of an evicted chunk, freed back to the shader's pool once the frames in flight that could bind it have finished
+struct ChunkRetiredDescriptorSet {
+  VkDescriptorSet descriptor_set;
+  uint64_t frame;
+};
+
+// Note: Each chunk also builds the first cell of its far neighbours and leaves the quads inside it to them, so borders at the same LOD share vertices and LOD borders overlap by a cell instead of cracking
+// Note: Chunks live in a (2 * view_distance + 1) ^ 3 grid of slots addressed by chunk coordinate modulo the grid width, so memory is bounded by view distance and a lookup is one index
+struct ChunkManager {
+  struct Chunk* chunks;
+  int slot_width;
+  int view_distance;
+  float chunk_size;
+  vec3 position;
+  struct Shader* shader;
+  struct Vector* noises;
+  float (*density_func_single)(struct Vector*, float, float, float);
+  float* (*density_func_set)(struct Vector*, float, float, float, int, int, int);
+  void (*density_func_batch)(struct Vector*, float (*)[3], float*, int);
+  // Note: A chunk moving to a coarser ring has every other sample of the field it was built from, so it's downsampled from here without touching the noise
+  struct DensityCache density_cache;
+  // Note: ChunkRetiredDescriptorSet in the order they were retired, stamped with the upload manager's frame count like its retired buffers
+  struct Vector retired_descriptor_sets;
+  // Note: Counts from the last chunk_manager_render
+  struct CullingStats culling_stats;
+};
+
+void chunk_manager_init(struct ChunkManager* chunk_manager, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int));
+void chunk_manager_delete(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api);
+void chunk_manager_update(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api, struct Camera* camera);
+void chunk_manager_render(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api);
+mat4 chunk_manager_get_chunk_model(struct ChunkManager* chunk_manager, struct Chunk* chunk);
+
+#endif  // CHUNK_MANAGER_H
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef DENSITY_CACHE_H
+#define DENSITY_CACHE_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <cnoise/cnoise.h>
+#include <cstorage/cstorage.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads/threads.h>
+#include <ubermath/ubermath.h>
+
+#include "mana/core/corecommon.h"
+
+#define DENSITY_CACHE_DEFAULT_BUDGET (256 * 1024 * 1024)
+
+// Note: A field is samples ^ 3 floats laid out x fastest, sample (x, y, z) taken at origin + (x, y, z) * step. noise_hash covers everything else the values depend on
+struct DensityCacheKey {
+  uint64_t noise_hash;
+  vec3 origin;
+  float step;
+  int samples;
+};
+
+struct DensityCacheEntry {
+  struct DensityCacheKey key;
+  float* density;
+  size_t bytes;
+  uint64_t last_used;
+  int references;
+  // Note: Fields straight from the noise library go back through noise_free, ones the cache or a caller filled are plain allocations
+  bool noise_allocated;
+};
+
+// Note: Fields stay cached while referenced and after that until the budget needs the room, least recently used first. The mutex only guards the entry list so lookups from worker builds and the main thread can overlap with noise evaluation
+struct DensityCache {
+  struct Vector entries;
+  size_t budget;
+  size_t bytes_used;
+  uint64_t clock;
+  mtx_t mutex;
+  int hits;
+  int downsamples;
+  int misses;
+};
+
+void density_cache_init(struct DensityCache* density_cache, size_t budget);
+void density_cache_delete(struct DensityCache* density_cache);
+uint64_t density_cache_hash_bytes(uint64_t hash, const void* bytes, size_t size);
+uint64_t density_cache_hash_noises(struct Vector* noises, bool skip_step);
+float* density_cache_acquire(struct DensityCache* density_cache, struct DensityCacheKey key);
+float* density_cache_insert(struct DensityCache* density_cache, struct DensityCacheKey key, float* density, bool noise_allocated);
+void density_cache_release(struct DensityCache* density_cache, float* density);
+
+#endif  // DENSITY_CACHE_H
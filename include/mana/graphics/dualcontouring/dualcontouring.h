@@ -5,10 +5,36 @@
 #include "mana/core/memoryallocator.h"
 //
 #include "mana/core/corecommon.h"
+#include "mana/core/engine.h"
+#include "mana/core/memoryarena.h"
+#include "mana/graphics/dualcontouring/chunkfile.h"
+#include "mana/graphics/dualcontouring/densitycache.h"
 #include "mana/graphics/dualcontouring/octree.h"
 #include "mana/graphics/graphicscommon.h"
 #include "mana/graphics/shaders/shader.h"
+#include "mana/graphics/utilities/culling.h"
 #include "mana/graphics/utilities/mesh.h"
+#include "mana/graphics/utilities/meshoptimize.h"
+
+#define DUAL_CONTOURING_BENCHMARK false
+#define DUAL_CONTOURING_CROSSING_ITERATIONS 3
+#define DUAL_CONTOURING_THRESHOLD_INDEX 1
+#define DUAL_CONTOURING_DYNAMIC_UNIFORMS 2
+
+// Note: Step search is 9 density calls per edge, interpolation uses the cached corners for free, secant refines that with an iteration budget
+enum DualContouringCrossingMode {
+  CROSSING_STEP_SEARCH,
+  CROSSING_CORNER_INTERPOLATION,
+  CROSSING_SECANT,
+};
+
+// Note: vertices_before is the leaf count, so the vertex count an unsimplified mesh would have
+struct DualContouringSimplifyStats {
+  int nodes_collapsed;
+  int vertices_before;
+  int vertices_after;
+  int indices_after;
+};
 
 struct DualContouringUniformBufferObject {
   alignas(32) mat4 model;
@@ -20,26 +46,102 @@ struct DualContouringUniformBufferObject {
 struct DualContouring {
   int octree_size;
   struct OctreeNode *head;
+  // Note: One arena per OpenMP thread so construction tasks never contend on allocation
+  struct MemoryArena *octree_arenas;
+  int octree_arena_count;
   struct Vector *noises;
   float (*density_func_single)(struct Vector *, float, float, float);
   float *(*density_func_set)(struct Vector *, float, float, float, int, int, int);
+  // Note: Optional, evaluates count positions at once and falls back to density_func_single when NULL. Has to give the same densities as density_func_single
+  void (*density_func_batch)(struct Vector *, float (*)[3], float *, int);
+  // Note: Set automatically for the ridged sum, other density functions have to be given their own to save or load chunk files
+  uint32_t density_id;
   float *noise_set;
+  // Note: Optional, when set the noise set is borrowed from it and left cached after release
+  struct DensityCache *density_cache;
+  // Note: Chunks sample a (octree_size + 1) ^ 3 grid at sample_offset + grid * sample_scale so their far faces have corners too
+  bool is_chunk;
+  // Note: Chunks also build the first cell of their far neighbours, the shell one sample past the noise set holds its far corners
+  float *seam_set;
+  vec3 sample_offset;
+  float sample_scale;
+  enum DualContouringCrossingMode crossing_mode;
+  int crossing_iterations;
+  // Note: QEF error a parent may reach and still collapse its children, negative disables simplification
+  float simplify_threshold;
+  struct DualContouringSimplifyStats simplify_stats;
+  struct MeshOptimizeStats optimize_stats;
+  // Note: Mesh space, refreshed on every upload so it always matches what's drawn
+  struct CullingBounds bounds;
 
   struct Shader *shader;
   struct Mesh *mesh;
   VkBuffer vertex_buffer;
-  VkDeviceMemory vertex_buffer_memory;
+  struct GPUAllocation vertex_buffer_memory;
   VkBuffer index_buffer;
-  VkDeviceMemory index_buffer_memory;
-  VkBuffer dc_uniform_buffer;
-  VkDeviceMemory dc_uniform_buffer_memory;
-  VkBuffer lighting_uniform_buffer;
-  VkDeviceMemory lighting_uniform_buffer_memory;
+  struct GPUAllocation index_buffer_memory;
+  // Note: Terrain then lighting, where the owner pushed this frame's uniforms in the uniform ring
+  uint32_t uniform_offsets[DUAL_CONTOURING_DYNAMIC_UNIFORMS];
   VkDescriptorSet descriptor_set;
 };
 
-int dual_contouring_init(struct DualContouring *dual_contouring, struct GPUAPI *gpu_api, int octree_size, struct Shader *shader, struct Vector *noises, float (*density_func_single)(struct Vector *, float, float, float), float *(*density_func_set)(struct Vector *, float, float, float, int, int, int));
+void dual_contouring_setup(struct DualContouring *dual_contouring, int octree_size, struct Shader *shader, struct Vector *noises, float (*density_func_single)(struct Vector *, float, float, float), float *(*density_func_set)(struct Vector *, float, float, float, int, int, int), void (*density_func_batch)(struct Vector *, float (*)[3], float *, int));
+void dual_contouring_build(struct DualContouring *dual_contouring);
+int dual_contouring_upload(struct DualContouring *dual_contouring, struct GPUAPI *gpu_api);
+void dual_contouring_release_build_data(struct DualContouring *dual_contouring);
+int dual_contouring_init(struct DualContouring *dual_contouring, struct GPUAPI *gpu_api, int octree_size, struct Shader *shader, struct Vector *noises, float (*density_func_single)(struct Vector *, float, float, float), float *(*density_func_set)(struct Vector *, float, float, float, int, int, int), void (*density_func_batch)(struct Vector *, float (*)[3], float *, int));
 void dual_contouring_delete(struct DualContouring *dual_contouring, struct GPUAPI *gpu_api);
+int dual_contouring_save_mesh(struct DualContouring *dual_contouring, const char *path);
+int dual_contouring_load_mesh(struct DualContouring *dual_contouring, const char *path);
 void dual_contouring_recreate(struct DualContouring *dual_contouring, struct GPUAPI *gpu_api);
+float dual_contouring_density_ridged_sum_single(struct Vector *noises, float x, float y, float z);
+void dual_contouring_density_ridged_sum_batch_avx2(struct Vector *noises, float (*positions)[3], float *dest, int count);
+
+static inline int dual_contouring_noise_set_size(struct DualContouring *dual_contouring) {
+  return dual_contouring->is_chunk ? dual_contouring->octree_size + 1 : dual_contouring->octree_size;
+}
+
+// Note: The shell is the far face of a (octree_size + 2) ^ 3 grid on each axis, one full face per axis with the edges stored more than once
+static inline int dual_contouring_seam_index(int seam_size, int x, int y, int z) {
+  const int slice_size = seam_size * seam_size;
+  if (x == seam_size - 1)
+    return y + (seam_size * z);
+  if (y == seam_size - 1)
+    return slice_size + x + (seam_size * z);
+
+  return (2 * slice_size) + x + (seam_size * y);
+}
+
+// Note: Grid coordinates run from 0 to octree_size, the octree itself is centered so callers add half the size. Chunks reach one further into the seam shell
+static inline float dual_contouring_get_density(struct DualContouring *dual_contouring, int x, int y, int z) {
+  const int noise_set_size = dual_contouring_noise_set_size(dual_contouring);
+  if (dual_contouring->is_chunk) {
+    if (x < noise_set_size && y < noise_set_size && z < noise_set_size)
+      return dual_contouring->noise_set[x + (noise_set_size * (y + (noise_set_size * z)))];
+
+    return dual_contouring->seam_set[dual_contouring_seam_index(noise_set_size + 1, x, y, z)];
+  }
+
+  return noise_get(dual_contouring->noise_set, noise_set_size, noise_set_size, noise_set_size, x, y, z);
+}
+
+// Note: Positions are scratch grid coordinates, chunks move them into world space in place before sampling
+static inline void dual_contouring_density_batch(struct DualContouring *dual_contouring, float (*positions)[3], float *dest, int count) {
+  if (dual_contouring->is_chunk) {
+    for (int position_num = 0; position_num < count; position_num++) {
+      positions[position_num][0] = dual_contouring->sample_offset.x + (positions[position_num][0] * dual_contouring->sample_scale);
+      positions[position_num][1] = dual_contouring->sample_offset.y + (positions[position_num][1] * dual_contouring->sample_scale);
+      positions[position_num][2] = dual_contouring->sample_offset.z + (positions[position_num][2] * dual_contouring->sample_scale);
+    }
+  }
+
+  if (dual_contouring->density_func_batch != NULL) {
+    dual_contouring->density_func_batch(dual_contouring->noises, positions, dest, count);
+    return;
+  }
+
+  for (int position_num = 0; position_num < count; position_num++)
+    dest[position_num] = dual_contouring->density_func_single(dual_contouring->noises, positions[position_num][0], positions[position_num][1], positions[position_num][2]);
+}
 
 #endif  // DUAL_CONTOURING_H
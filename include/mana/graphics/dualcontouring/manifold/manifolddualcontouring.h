@@ -9,12 +9,40 @@
 #include <ubermath/ubermath.h>
 
 #include "mana/core/engine.h"
+#include "mana/core/jobsystem.h"
+#include "mana/graphics/dualcontouring/chunkfile.h"
 #include "mana/graphics/dualcontouring/manifold/manifoldoctree.h"
 #include "mana/graphics/dualcontouring/manifold/manifoldtables.h"
 #include "mana/graphics/dualcontouring/qef.h"
+#include "mana/graphics/utilities/culling.h"
 #include "mana/graphics/utilities/mesh.h"
 
 #define MANIFOLD_BENCHMARK true
+// Note: Rebuilds every contour at 1, 2, 4, 8 and 16 threads to see how each stage scales, slow so off by default
+#define MANIFOLD_BENCHMARK_SCALING false
+// Note: Packed positions cover the octree plus this many cells either side, QEF solutions on the boundary can land slightly outside it
+#define MANIFOLD_PACKED_POSITION_MARGIN 1.0f
+#define MANIFOLD_DUAL_CONTOURING_DYNAMIC_UNIFORMS 2
+// Note: Buffers of a mesh with a tree get this many times its size so brush edits append into them, once either is full the mesh goes up again compacted
+#define MANIFOLD_DUAL_CONTOURING_BUFFER_GROWTH 2
+
+enum ManifoldBrushShape {
+  MANIFOLD_BRUSH_SPHERE,
+  MANIFOLD_BRUSH_BOX
+};
+
+enum ManifoldBrushOperation {
+  MANIFOLD_BRUSH_ADD,
+  MANIFOLD_BRUSH_SUBTRACT
+};
+
+// Note: Center and extent are in octree cells, extent.x is the radius of a sphere and a box uses all three as half sizes
+struct ManifoldBrush {
+  enum ManifoldBrushShape shape;
+  enum ManifoldBrushOperation operation;
+  vec3 center;
+  vec3 extent;
+};
 
 struct ManifoldDualContouringUniformBufferObject {
   alignas(32) mat4 model;
@@ -23,22 +51,52 @@ struct ManifoldDualContouringUniformBufferObject {
   alignas(32) vec3 camera_pos;
 };
 
+// Note: While building, the worker only touches the build tree and mesh, the rendered ones are swapped out on the main thread in the finish callback
 struct ManifoldDualContouring {
   int resolution;
   int octree_size;
-  struct ManifoldOctreeNode* tree;
+  struct ManifoldOctreeLevels tree;
   struct ArrayList* vertice_list;
+  int stale_vertices;
+  // Note: Counts brushes applied since the last contour or load, a mesh with edits is never saved since the file couldn't say which
+  uint32_t edit_generation;
+
+  struct GPUAPI* gpu_api;
+  struct JobSystem* job_system;
+  struct Vector* noises;
+  float threshold;
+  bool building;
+  bool uploaded;
+  // Note: The newest contour_async request made while building, it starts when the running build finishes and replaces any older one
+  bool rebuild_pending;
+  struct Vector* pending_noises;
+  float pending_threshold;
+  struct ManifoldOctreeLevels build_tree;
+  struct Mesh* build_mesh;
+  // Note: Storage of the last replaced tree, the next build takes it over so rebuilding the same size reuses its level arrays and vertex pool
+  struct ManifoldOctreeLevels spare_tree;
+  // Note: Rebuilds at a new threshold or a coarser resolution borrow the density from here instead of sampling the noise again
+  struct DensityCache density_cache;
 
   struct Shader* shader;
   struct Mesh* mesh;
+  // Note: One bound per index range of the tree so a root child out of view is skipped, a loaded mesh has no ranges and is bound as one
+  int cull_range_count;
+  int cull_range_offsets[MANIFOLD_OCTREE_INDEX_RANGES + 1];
+  struct CullingBounds cull_bounds[MANIFOLD_OCTREE_INDEX_RANGES];
   VkBuffer vertex_buffer;
-  VkDeviceMemory vertex_buffer_memory;
+  struct GPUAllocation vertex_buffer_memory;
   VkBuffer index_buffer;
-  VkDeviceMemory index_buffer_memory;
-  VkBuffer dc_uniform_buffer;
-  VkDeviceMemory dc_uniform_buffer_memory;
-  VkBuffer lighting_uniform_buffer;
-  VkDeviceMemory lighting_uniform_buffer_memory;
+  struct GPUAllocation index_buffer_memory;
+  // Note: In elements, everything past uploaded_vertex_count and index_tail is free for the next edit since no frame in flight reads it
+  int vertex_capacity;
+  int uploaded_vertex_count;
+  int index_capacity;
+  int index_tail;
+  // Note: Where each cull range starts in the index buffer, edits write a range's new indices at the tail and move it there
+  int index_range_starts[MANIFOLD_OCTREE_INDEX_RANGES];
+  // Note: Terrain then lighting, where the owner pushed this frame's uniforms in the uniform ring
+  uint32_t uniform_offsets[MANIFOLD_DUAL_CONTOURING_DYNAMIC_UNIFORMS];
   VkDescriptorSet descriptor_set;
 };
 
@@ -46,7 +104,20 @@ void manifold_dual_contouring_init(struct ManifoldDualContouring* manifold_dual_
 void manifold_dual_contouring_delete(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api);
 void manifold_dual_contouring_recreate(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api);
 void manifold_dual_contouring_contour(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api, struct Vector* noises, float threshold);
+int manifold_dual_contouring_contour_async(struct ManifoldDualContouring* manifold_dual_contouring, struct JobSystem* job_system, struct Vector* noises, float threshold);
+int manifold_dual_contouring_save_mesh(struct ManifoldDualContouring* manifold_dual_contouring, const char* path);
+int manifold_dual_contouring_load_mesh(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api, struct Vector* noises, float threshold, const char* path);
+void manifold_dual_contouring_apply_brush(struct ManifoldDualContouring* manifold_dual_contouring, struct ManifoldBrush brush);
 void manifold_dual_contouring_construct_tree_grid(struct ManifoldOctreeNode* node);
 vec3 manifold_dual_contouring_get_normal_q(struct Vector* verts, int indexes[6], int index_length);
 
+// Note: Range packed positions are quantized over, the model matrix is translated by the offset and scaled by the scale to undo it
+static inline float manifold_dual_contouring_packed_offset(struct ManifoldDualContouring* manifold_dual_contouring) {
+  return -MANIFOLD_PACKED_POSITION_MARGIN;
+}
+
+static inline float manifold_dual_contouring_packed_scale(struct ManifoldDualContouring* manifold_dual_contouring) {
+  return (float)manifold_dual_contouring->resolution + (2.0f * MANIFOLD_PACKED_POSITION_MARGIN);
+}
+
 #endif  // MANIFOLD_DUAL_CONTOURING_H
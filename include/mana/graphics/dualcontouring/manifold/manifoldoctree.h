@@ -6,12 +6,16 @@
 //
 #include <cnoise/cnoise.h>
 #include <cstorage/cstorage.h>
+#include <immintrin.h>
+#include <omp.h>
 #include <ubermath/ubermath.h>
 
-#include "mana/graphics/dualcontouring/manifold/manifolddualcontouring.h"
+#include "mana/core/corecommon.h"
+#include "mana/graphics/dualcontouring/densitycache.h"
 #include "mana/graphics/dualcontouring/manifold/manifoldtables.h"
 #include "mana/graphics/dualcontouring/qef.h"
 #include "mana/graphics/utilities/mesh.h"
+#include "mana/graphics/utilities/meshoptimize.h"
 
 enum NodeType {
   MANIFOLD_NODE_NONE,
@@ -20,51 +24,85 @@ enum NodeType {
   MANIFOLD_NODE_COLLAPSED
 };
 
-struct Vertex {
-  struct Vertex* parent;
-  int index;
-  bool collapsible;
-  struct QefSolver qef;
-  vec3 normal;
-  int surface_index;
-  float error;
-  int euler;
-  int eis[12];
-  int in_cell;
-  bool face_prop2;
+// Note: Vertices are pooled as a structure of arrays and referred to by index, the fields the contour and cluster passes walk sit apart from the QEF data that is only read when clustering and solving
+struct ManifoldVertexPool {
+  int count;
+  int capacity;
+  // Note: -1 until the vertex is clustered into a vertex of the node above
+  int* parent;
+  int* index;
+  int* surface_index;
+  float* error;
+  int* euler;
+  bool* face_prop2;
+  unsigned char* in_cell;
+  vec3* normal;
+  int (*eis)[12];
+  struct QefData* qef;
 };
 
-static inline void vertex_init(struct Vertex* vertex) {
-  vertex->parent = NULL;
-  vertex->index = -1;
-  vertex->collapsible = true;
-  qef_solver_init(&vertex->qef);
-  vertex->normal = VEC3_ZERO;
-  vertex->surface_index = -1;
-  vertex->error = 0.0f;
-  vertex->euler = 0;
-  memset(vertex->eis, 0, sizeof(int) * 12);
-  vertex->face_prop2 = false;
-}
+void manifold_vertex_pool_init(struct ManifoldVertexPool* vertex_pool);
+void manifold_vertex_pool_delete(struct ManifoldVertexPool* vertex_pool);
+int manifold_vertex_pool_reserve(struct ManifoldVertexPool* vertex_pool, int count);
 
+// Note: Children are the 8 nodes from first_child on the next level and child_mask says which of them are linked, a node's vertices are vertex_count pool entries from vertex_start
 struct ManifoldOctreeNode {
-  int index;
   vec3 position;
   int size;
-  struct ManifoldOctreeNode* children[8];
   enum NodeType type;
-  struct ArrayList* vertices;
+  int first_child;
+  int vertex_start;
+  int vertex_count;
+  unsigned char child_mask;
   unsigned char corners;
-  int child_index;
+  unsigned char child_index;
+  unsigned char level;
+  bool dirty;
+};
+
+#define MANIFOLD_OCTREE_MAX_LEVELS 12
+// Note: One range of the index buffer per root child plus one for the faces and edges between them
+#define MANIFOLD_OCTREE_INDEX_RANGES 9
+
+// Note: Bricks are 2 ^ MANIFOLD_OCTREE_BRICK_LEVELS cells a side, only the ones the surface passes through get nodes below them
+#define MANIFOLD_OCTREE_BRICK_LEVELS 2
+// Note: The vertex and index passes hand out one work item per node down to this many levels below the root, capped at the brick level
+#define MANIFOLD_OCTREE_SPLIT_LEVELS 3
+
+// Note: Levels down to brick_level are dense, level l being one array of 8 ^ l nodes. Below it each brick with a slot owns 8 ^ j nodes of level brick_level + j, so memory follows the surface instead of the volume. Either way child i of a node is first_child + i on the next level and a cell is found from its position without walking pointers
+struct ManifoldOctreeLevels {
+  int level_count;
+  int size;
+  // Note: (size + 1) ^ 3 samples so cells on the far faces have all 8 corners, kept around so edits don't need the noise again
+  float* density;
+  // Note: Set while the density is borrowed from a cache, otherwise it's owned and density_noise_allocated says how to free it
+  struct DensityCache* density_cache;
+  bool density_noise_allocated;
+  struct ManifoldOctreeNode* nodes[MANIFOLD_OCTREE_MAX_LEVELS];
+  int node_counts[MANIFOLD_OCTREE_MAX_LEVELS];
+  int brick_level;
+  int brick_count;
+  int brick_capacity;
+  // Note: Brick level node that owns each slot, a brick node without one has first_child set to -1
+  int* brick_nodes;
+  struct ManifoldVertexPool vertices;
+  struct Vector dirty_nodes[MANIFOLD_OCTREE_MAX_LEVELS];
+  int index_offsets[MANIFOLD_OCTREE_INDEX_RANGES + 1];
 };
 
 static inline void octree_node_init(struct ManifoldOctreeNode* octree_node, vec3 position, int size, enum NodeType type) {
-  octree_node->index = 0;
   octree_node->position = position;
   octree_node->size = size;
   octree_node->type = type;
 }
 
+static inline struct ManifoldOctreeNode* manifold_octree_get_child(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* octree_node, int child) {
+  if ((octree_node->child_mask & (1 << child)) == 0)
+    return NULL;
+
+  return &levels->nodes[octree_node->level + 1][octree_node->first_child + child];
+}
+
 /*static inline float Sphere(vec3 pos) {
   float STEP = 1.0 / 64.0f;
   struct RidgedFractalNoise noise = {0};
@@ -130,10 +168,18 @@ static inline vec3 planet_normal(vec3 v, struct Vector* noises, int scale) {
 #endif
 }
 
-void manifold_octree_construct_base(struct ManifoldOctreeNode* octree_node, int size, struct Vector* noises);
-void manifold_octree_destroy_octree(struct ManifoldOctreeNode* octree_node, struct Map* vertice_map);
-void manifold_octree_generate_vertex_buffer(struct ManifoldOctreeNode* octree_node, struct Vector* vertices);
-void manifold_octree_process_cell(struct ManifoldOctreeNode* octree_node, struct Vector* indexes, float threshold);
-void manifold_octree_cluster_cell_base(struct ManifoldOctreeNode* octree_node, float error, struct Vector* noises);
+void manifold_octree_construct_base(struct ManifoldOctreeLevels* levels, int size, struct Vector* noises, struct DensityCache* density_cache);
+void manifold_octree_destroy_octree(struct ManifoldOctreeLevels* levels);
+void manifold_octree_reset(struct ManifoldOctreeLevels* levels);
+void manifold_octree_own_density(struct ManifoldOctreeLevels* levels);
+void manifold_octree_generate_vertex_buffer(struct ManifoldOctreeLevels* levels, struct Vector* vertices);
+void manifold_octree_process_cell(struct ManifoldOctreeLevels* levels, struct Vector* indexes, float threshold, int index_offsets[MANIFOLD_OCTREE_INDEX_RANGES + 1]);
+void manifold_octree_cluster_cell_base(struct ManifoldOctreeLevels* levels, float error);
+int manifold_octree_rebuild_region(struct ManifoldOctreeLevels* levels, ivec3 min, ivec3 max, float error, struct Vector* noises);
+void manifold_octree_append_dirty_vertices(struct ManifoldOctreeLevels* levels, struct Vector* vertices);
+void manifold_octree_patch_indexes(struct ManifoldOctreeLevels* levels, struct Vector* indexes, float threshold);
+void manifold_octree_clear_dirty(struct ManifoldOctreeLevels* levels);
+void manifold_octree_compact_vertices(struct ManifoldOctreeLevels* levels);
+void manifold_octree_optimize_mesh(struct ManifoldOctreeLevels* levels, struct Mesh* mesh, struct MeshOptimizeStats* stats);
 
 #endif  // MANIFOLD_OCTREE_H
@@ -5,12 +5,20 @@
 #include "mana/core/memoryallocator.h"
 //
 #include <cnoise/cnoise.h>
+#include <omp.h>
 #include <ubermath/ubermath.h>
 
+#include "mana/core/memoryarena.h"
 #include "mana/graphics/dualcontouring/dualcontouring.h"
 #include "mana/graphics/dualcontouring/qef.h"
 #include "mana/graphics/utilities/mesh.h"
 
+// Note: Levels from the root that are split into OpenMP tasks, 2 gives 64 independent subtrees
+#define OCTREE_TASK_DEPTH 2
+#define OCTREE_MAX_CROSSINGS 6
+#define OCTREE_CROSSING_STEPS 8
+#define OCTREE_CROSSING_SAMPLES (OCTREE_CROSSING_STEPS + 1)
+
 struct DualContouring;
 
 enum OctreeNodeType {
@@ -40,8 +48,9 @@ struct OctreeNode {
 
 void octree_init(struct OctreeNode* octree_node, enum OctreeNodeType type);
 void octree_init_none(struct OctreeNode* octree_node);
-void octree_destroy_octree(struct OctreeNode* node);
-struct OctreeNode* octree_simplify_octree(struct OctreeNode* node, float threshold);
+void octree_arenas_init(struct DualContouring* dual_contouring);
+void octree_destroy_octree(struct DualContouring* dual_contouring);
+struct OctreeNode* octree_simplify_octree(struct OctreeNode* node, float threshold, struct DualContouring* dual_contouring, int task_size);
 void octree_generate_vertex_indices(struct OctreeNode* node, struct DualContouring* dual_contouring);
 void octree_contour_process_edge(struct OctreeNode* node[4], int dir, struct DualContouring* dual_contouring);
 void octree_contour_edge_proc(struct OctreeNode* node[4], int dir, struct DualContouring* dual_contouring);
@@ -49,8 +58,11 @@ void octree_contour_face_proc(struct OctreeNode* node[2], int dir, struct DualCo
 void octree_contour_cell_proc(struct OctreeNode* node, struct DualContouring* dual_contouring);
 vec3 octree_approximate_zero_crossing_position(const vec3 p0, const vec3 p1, struct DualContouring* dual_contouring);
 vec3 octree_calculate_surface_normal(const vec3 p, struct DualContouring* dual_contouring);
+int octree_approximate_zero_crossing_positions(vec3 edge_points[][2], float edge_densities[][2], vec3* dest, int edge_count, struct DualContouring* dual_contouring);
+void octree_calculate_surface_normals(vec3* points, vec3* dest, int point_count, struct DualContouring* dual_contouring);
 struct OctreeNode* octree_construct_leaf(struct OctreeNode* leaf, struct DualContouring* dual_contouring);
-struct OctreeNode* octree_construct_octree_nodes(struct OctreeNode* node, struct DualContouring* dual_contouring);
+struct OctreeNode* octree_construct_octree_nodes(struct OctreeNode* node, struct DualContouring* dual_contouring, int task_size);
+void octree_benchmark_crossing_modes(struct DualContouring* dual_contouring);
 struct OctreeNode* octree_build_octree(const ivec3 min, const int size, const float threshold, struct DualContouring* dual_contouring);
 void octree_generate_mesh_from_octree(struct OctreeNode* node, struct DualContouring* dual_contouring);
 
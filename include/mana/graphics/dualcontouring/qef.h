@@ -2,6 +2,7 @@
 #ifndef QEF_H
 #define QEF_H
 
+#include <stdalign.h>
 #include <string.h>
 #include <ubermath/ubermath.h>
 
@@ -40,4 +41,29 @@ void qef_solver_set_ata(struct QefSolver *qef_solver);
 void qef_solver_set_atb(struct QefSolver *qef_solver);
 float qef_solver_solve(struct QefSolver *qef_solver, vec3 *outx, const float svd_tol, const int svd_sweeps, const float pinv_tol);
 
+#define QEF_BATCH_WIDTH 8
+
+// Note: Structure of arrays so one AVX2 register holds the same term of every system, unused lanes are padded with the last system on solve
+struct QefBatch {
+  alignas(32) float ata_00[QEF_BATCH_WIDTH];
+  alignas(32) float ata_01[QEF_BATCH_WIDTH];
+  alignas(32) float ata_02[QEF_BATCH_WIDTH];
+  alignas(32) float ata_11[QEF_BATCH_WIDTH];
+  alignas(32) float ata_12[QEF_BATCH_WIDTH];
+  alignas(32) float ata_22[QEF_BATCH_WIDTH];
+  alignas(32) float atb_x[QEF_BATCH_WIDTH];
+  alignas(32) float atb_y[QEF_BATCH_WIDTH];
+  alignas(32) float atb_z[QEF_BATCH_WIDTH];
+  alignas(32) float btb[QEF_BATCH_WIDTH];
+  alignas(32) float mass_point_x[QEF_BATCH_WIDTH];
+  alignas(32) float mass_point_y[QEF_BATCH_WIDTH];
+  alignas(32) float mass_point_z[QEF_BATCH_WIDTH];
+  alignas(32) float num_points[QEF_BATCH_WIDTH];
+  int count;
+};
+
+void qef_batch_init(struct QefBatch *qef_batch);
+void qef_batch_add(struct QefBatch *qef_batch, struct QefData *qef_data);
+void qef_batch_solve(struct QefBatch *qef_batch, vec3 *outx, float *out_error, const float svd_tol, const int svd_sweeps, const float pinv_tol);
+
 #endif  // QEF_H
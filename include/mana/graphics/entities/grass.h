@@ -21,8 +21,8 @@ struct Grass {
 
   VkBuffer vertex_buffer;
   VkBuffer index_buffer;
-  VkBuffer uniform_buffer;
-  VkDeviceMemory uniform_buffers_memory;
+  // Note: Where grass_update_uniforms pushed this frame's uniforms in the uniform ring
+  uint32_t uniform_offset;
   VkDescriptorSet descriptor_set;
 
   struct Vector grass_nodes;
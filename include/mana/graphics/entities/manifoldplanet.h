@@ -22,11 +22,16 @@ struct ManifoldPlanet {
   struct Shader* terrain_shader;
   struct Vector* noises;
   vec3 position;
+  // Note: Counts from the last manifold_planet_render, each index range of the tree is tested on its own
+  struct CullingStats culling_stats;
 };
 
 void manifold_planet_init(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, struct Vector* noises, vec3 position);
+void manifold_planet_init_cached(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, struct Vector* noises, vec3 position, const char* mesh_path);
+void manifold_planet_init_async(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, struct JobSystem* job_system, size_t octree_size, struct Shader* shader, struct Vector* noises, vec3 position);
 void manifold_planet_delete(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api);
 void manifold_planet_render(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api);
 void manifold_planet_update_uniforms(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, struct Camera* camera, vec3 light_pos);
+mat4 manifold_planet_get_model(struct ManifoldPlanet* planet);
 
 #endif  // MANIFOLD_PLANET_H
@@ -20,6 +20,8 @@
 #include "xmlparser.h"
 
 #define MAX_JOINTS 50
+// Note: Model, lighting then joints, the binding order vkCmdBindDescriptorSets takes dynamic offsets in. Static models only use the first two
+#define MODEL_DYNAMIC_UNIFORMS 3
 
 struct GPUAPI;
 struct Shader;
@@ -103,17 +105,11 @@ struct Model {
   vec3 scale;
 
   VkBuffer vertex_buffer;
-  VkDeviceMemory vertex_buffer_memory;
+  struct GPUAllocation vertex_buffer_memory;
   VkBuffer index_buffer;
-  VkDeviceMemory index_buffer_memory;
-  VkBuffer uniform_buffer;
-  VkDeviceMemory uniform_buffers_memory;
-
-  VkBuffer uniform_animation_buffer;
-  VkDeviceMemory uniform_animation_buffers_memory;
-
-  VkBuffer lighting_uniform_buffer;
-  VkDeviceMemory lighting_uniform_buffers_memory;
+  struct GPUAllocation index_buffer_memory;
+  // Note: Where model_update_uniforms pushed this frame's uniforms in the uniform ring
+  uint32_t uniform_offsets[MODEL_DYNAMIC_UNIFORMS];
   VkDescriptorSet descriptor_set;
 };
 
@@ -6,24 +6,31 @@
 //
 #include <mana/core/gpuapi.h>
 
+#include "mana/graphics/dualcontouring/chunkmanager.h"
 #include "mana/graphics/dualcontouring/dualcontouring.h"
 #include "mana/graphics/utilities/camera.h"
 
-// TODO: Should take care of LOD
-
+// Note: Round planets are one octree built up front, chunked planets stream LOD rings around the camera in planet_update
 enum PlanetType {
-  ROUND_PLANET
+  ROUND_PLANET,
+  CHUNKED_PLANET
 };
 
 struct Planet {
   enum PlanetType planet_type;
   struct DualContouring dual_contouring;
+  struct ChunkManager chunk_manager;
   struct Shader* terrain_shader;
   vec3 position;
+  // Note: Counts from the last planet_render, a round planet is tested as one mesh
+  struct CullingStats culling_stats;
 };
 
-void planet_init(struct Planet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int));
+void planet_init(struct Planet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int));
+void planet_init_cached(struct Planet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int), const char* mesh_path);
+void planet_init_chunked(struct Planet* planet, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int));
 void planet_delete(struct Planet* planet, struct GPUAPI* gpu_api);
+void planet_update(struct Planet* planet, struct GPUAPI* gpu_api, struct Camera* camera);
 void planet_render(struct Planet* planet, struct GPUAPI* gpu_api);
 void planet_update_uniforms(struct Planet* planet, struct GPUAPI* gpu_api, struct Camera* camera, vec3 light_pos);
 
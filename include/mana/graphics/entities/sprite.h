@@ -29,11 +29,11 @@ struct Sprite {
 
   struct Shader* shader;
   VkBuffer vertex_buffer;
-  VkDeviceMemory vertex_buffer_memory;
+  struct GPUAllocation vertex_buffer_memory;
   VkBuffer index_buffer;
-  VkDeviceMemory index_buffer_memory;
-  VkBuffer uniform_buffer;
-  VkDeviceMemory uniform_buffers_memory;
+  struct GPUAllocation index_buffer_memory;
+  // Note: Where sprite_update_uniforms pushed this frame's uniforms in the uniform ring
+  uint32_t uniform_offset;
   VkDescriptorSet descriptor_set;
 };
 
@@ -41,6 +41,7 @@ enum {
   SPRITE_SUCCESS = 1
 };
 
+void sprite_setup(struct Sprite* sprite, struct Texture* texture);
 int sprite_init(struct Sprite* sprite, struct GPUAPI* gpu_api, struct Shader* shader, struct Texture* texture);
 void sprite_delete(struct Sprite* sprite, struct GPUAPI* gpu_api);
 void sprite_render(struct Sprite* sprite, struct GPUAPI* gpu_api);
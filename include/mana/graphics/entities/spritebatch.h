@@ -0,0 +1,78 @@
+#pragma once
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <mana/core/gpuapi.h>
+
+#include "mana/core/vulkancore.h"
+#include "mana/graphics/entities/sprite.h"
+#include "mana/graphics/graphicscommon.h"
+#include "mana/graphics/shaders/shader.h"
+#include "mana/graphics/shaders/spritebatchshader.h"
+#include "mana/graphics/utilities/spriteanimation.h"
+#include "mana/graphics/utilities/texture.h"
+
+// Note: Instances per frame a batch usually starts with, the instance buffer holds this many for every frame in flight and doubles at the next update that needs more
+#define SPRITE_BATCH_DEFAULT_INSTANCES 131072
+// Note: Instances per frame the buffer never grows past, about 128mb across both frames in flight. Sprites beyond it, or beyond a buffer that failed to grow, are dropped and reported once
+#define SPRITE_BATCH_MAX_INSTANCES 1048576
+#define SPRITE_BATCH_BENCHMARK false
+
+struct SpriteBatchUniformBufferObject {
+  alignas(16) mat4 view;
+  alignas(16) mat4 proj;
+};
+
+// Note: Instances queued against one texture this frame, drawn with a single instanced draw
+struct SpriteBatchTexture {
+  struct Texture* texture;
+  VkDescriptorSet descriptor_set;
+  struct Vector instances;
+};
+
+// Note: Everything in a batch shares its shader, so batching is by texture only. Use a batch per pipeline
+struct SpriteBatch {
+  struct Mesh* quad_mesh;
+  struct Shader* shader;
+  VkBuffer vertex_buffer;
+  struct GPUAllocation vertex_buffer_memory;
+  VkBuffer index_buffer;
+  struct GPUAllocation index_buffer_memory;
+  // Note: Host visible and mapped for its lifetime, split into a region per frame in flight like the uniform ring
+  VkBuffer instance_buffer;
+  struct GPUAllocation instance_buffer_memory;
+  char* mapped_instances;
+  // Note: Current per frame capacity of the instance buffer, grows up to SPRITE_BATCH_MAX_INSTANCES
+  size_t max_instances;
+  // Note: SpriteBatchTexture, kept across frames so descriptor sets are only written the first time a texture is seen
+  struct Vector textures;
+  size_t last_texture;
+  size_t instance_count;
+  size_t dropped_instances;
+  // Note: Set by the first frame that dropped sprites so the error is only printed once
+  bool drop_reported;
+  VkDeviceSize instance_offset;
+  uint32_t uniform_offset;
+  int draw_count;
+};
+
+enum {
+  SPRITE_BATCH_SUCCESS = 1,
+  SPRITE_BATCH_CREATE_BUFFER_ERROR,
+  SPRITE_BATCH_MAP_MEMORY_ERROR,
+  SPRITE_BATCH_DESCRIPTOR_ERROR
+};
+
+int sprite_batch_init(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct Shader* shader, size_t max_instances);
+void sprite_batch_delete(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api);
+void sprite_batch_begin(struct SpriteBatch* sprite_batch);
+void sprite_batch_add(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct Texture* texture, struct VertexSpriteInstance* instance);
+void sprite_batch_add_sprite(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct Sprite* sprite);
+void sprite_batch_add_sprite_animation(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct SpriteAnimation* sprite_animation);
+void sprite_batch_update_uniforms(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api);
+void sprite_batch_render(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api);
+void sprite_batch_recreate(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api);
+
+#endif  // SPRITE_BATCH_H
@@ -13,30 +13,33 @@
 
 struct VulkanState;
 
+// Note: Images are shared by every frame in flight, the render pass dependencies already order one frame's writes after the last frame's reads on the queue
 struct GBuffer {
+  // Note: Whichever of gbuffer_command_buffers belongs to the frame being recorded, gbuffer_start points it there so entities keep recording into the same field
   VkCommandBuffer gbuffer_command_buffer;
+  VkCommandBuffer gbuffer_command_buffers[MAX_FRAMES_IN_FLIGHT];
   VkFramebuffer gbuffer_framebuffer;
   VkRenderPass render_pass;
   VkSampler texture_sampler;
-  VkSemaphore gbuffer_semaphore;
+  VkSemaphore gbuffer_semaphores[MAX_FRAMES_IN_FLIGHT];
 
   // Resolve or standard
   VkImage color_image;
-  VkDeviceMemory color_image_memory;
+  struct GPUAllocation color_image_memory;
   VkImageView color_image_view;
   VkImage normal_image;
-  VkDeviceMemory normal_image_memory;
+  struct GPUAllocation normal_image_memory;
   VkImageView normal_image_view;
   VkImage depth_image;
-  VkDeviceMemory depth_image_memory;
+  struct GPUAllocation depth_image_memory;
   VkImageView depth_image_view;
 
   // Multisample
   VkImage multisample_color_image;
-  VkDeviceMemory multisample_color_image_memory;
+  struct GPUAllocation multisample_color_image_memory;
   VkImageView multisample_color_image_view;
   VkImage multisample_normal_image;
-  VkDeviceMemory multisample_normal_image_memory;
+  struct GPUAllocation multisample_normal_image_memory;
   VkImageView multisample_normal_image_view;
 
   mat4 projection_matrix;
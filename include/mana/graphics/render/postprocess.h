@@ -19,15 +19,19 @@ struct BlitPostProcess {
   struct FullscreenTriangle* fullscreen_triangle;
 };
 
+// Note: Every frame in flight gets its own pair of command buffers and semaphores, the ping pong images are shared and ordered by the render pass dependencies
 struct PostProcess {
+  // Note: The pair belonging to the frame being recorded, blit_post_process_render points them there since it's always the first stage of a frame
   VkCommandBuffer post_process_command_buffers[2];
+  VkCommandBuffer frame_command_buffers[MAX_FRAMES_IN_FLIGHT][2];
   struct VkFramebuffer_T* post_process_framebuffers[2];
   VkRenderPass render_pass;
   VkSemaphore post_process_semaphores[2];
+  VkSemaphore frame_semaphores[MAX_FRAMES_IN_FLIGHT][2];
   VkSampler texture_sampler;
 
   struct VkImage_T* color_images[2];
-  struct VkDeviceMemory_T* color_image_memories[2];
+  struct GPUAllocation color_image_memories[2];
   struct VkImageView_T* color_image_views[2];
 
   bool ping_pong;
@@ -37,6 +41,7 @@ struct PostProcess {
 
 int post_process_init(struct PostProcess* post_process, struct GPUAPI* gpu_api);
 int post_process_delete(struct PostProcess* post_process, struct GPUAPI* gpu_api);
+void post_process_select_frame(struct PostProcess* post_process, size_t frame_num);
 int post_process_start(struct PostProcess* post_process, struct GPUAPI* gpu_api);
 int post_process_stop(struct PostProcess* post_process, struct GPUAPI* gpu_api);
 
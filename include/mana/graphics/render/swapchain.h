@@ -33,9 +33,12 @@ struct SwapChain {
   VkExtent2D swap_chain_extent;
   VkRenderPass render_pass;
   size_t current_frame;
+  // Note: Image acquired for the frame being recorded, set in window_prepare_frame
+  uint32_t image_index;
   float supersample_scale;
 
-  VkCommandBuffer swap_chain_command_buffers[MAX_SWAP_CHAIN_FRAMES];
+  // Note: One per frame in flight rather than per image, each frame records its own against whichever image it acquired
+  VkCommandBuffer swap_chain_command_buffers[MAX_FRAMES_IN_FLIGHT];
   VkImage swap_chain_images[MAX_SWAP_CHAIN_FRAMES];
   VkImageView swap_chain_image_views[MAX_SWAP_CHAIN_FRAMES];
   VkFramebuffer swap_chain_framebuffers[MAX_SWAP_CHAIN_FRAMES];
@@ -45,8 +48,8 @@ struct SwapChain {
 
 int swap_chain_init(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, int width, int height);
 void swap_chain_delete(struct SwapChain* swap_chain, struct GPUAPI* gpu_api);
-int swap_chain_start(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, int swap_chain_num);
-int swap_chain_stop(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, int swap_chain_num);
+int swap_chain_start(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, uint32_t image_index);
+int swap_chain_stop(struct SwapChain* swap_chain, struct GPUAPI* gpu_api);
 
 int blit_swap_chain_init(struct BlitSwapChain* blit_swap_chain, struct GPUAPI* gpu_api);
 void blit_swap_chain_delete(struct BlitSwapChain* blit_swap_chain, struct GPUAPI* gpu_api);
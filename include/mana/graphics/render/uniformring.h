@@ -0,0 +1,50 @@
+#pragma once
+#ifndef UNIFORM_RING_H
+#define UNIFORM_RING_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include "mana/graphics/render/vulkanrenderer.h"
+
+// Note: Bytes each frame in flight can push, an animated model takes about 3.5kb so this covers a thousand of them. The ring never grows since every descriptor set points at its buffer, pushes past this fail instead
+#define UNIFORM_RING_FRAME_SIZE 4194304
+// Note: Offset uniform_ring_push hands back once the frame's region is full, whatever holds it skips its draw for that frame
+#define UNIFORM_RING_FULL UINT32_MAX
+
+struct VulkanState;
+
+// Note: One persistently mapped buffer split into a region per frame in flight. Entities bind it once as a dynamic uniform buffer and pass the offset of this frame's copy when drawing
+struct UniformRing {
+  VkBuffer uniform_buffer;
+  struct GPUAllocation uniform_buffer_memory;
+  char* mapped_memory;
+  VkDeviceSize alignment;
+  VkDeviceSize frame_size;
+  VkDeviceSize frame_start;
+  VkDeviceSize frame_offset;
+  // Note: Highest frame_offset reached since init, for sizing UNIFORM_RING_FRAME_SIZE
+  VkDeviceSize peak_frame_offset;
+  // Note: Set by the first push that didn't fit so the error is only printed once
+  bool full_reported;
+};
+
+enum {
+  UNIFORM_RING_SUCCESS = 1,
+  UNIFORM_RING_CREATE_BUFFER_ERROR,
+  UNIFORM_RING_MAP_MEMORY_ERROR
+};
+
+int uniform_ring_init(struct UniformRing* uniform_ring, struct VulkanState* vulkan_renderer, VkDeviceSize frame_size);
+void uniform_ring_delete(struct UniformRing* uniform_ring, struct VulkanState* vulkan_renderer);
+void uniform_ring_begin_frame(struct UniformRing* uniform_ring, size_t frame_num);
+uint32_t uniform_ring_push(struct UniformRing* uniform_ring, const void* data, size_t memory_size);
+VkDescriptorBufferInfo uniform_ring_get_descriptor_buffer_info(struct UniformRing* uniform_ring, size_t memory_size);
+
+static inline bool uniform_ring_offsets_full(const uint32_t* offsets, size_t offset_count) {
+  for (size_t offset_num = 0; offset_num < offset_count; offset_num++)
+    if (offsets[offset_num] == UNIFORM_RING_FULL)
+      return true;
+  return false;
+}
+
+#endif  // UNIFORM_RING_H
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef UPLOAD_MANAGER_H
+#define UPLOAD_MANAGER_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <cstorage/cstorage.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+
+#include "mana/core/corecommon.h"
+#include "mana/graphics/utilities/gpuallocator.h"
+
+// Note: Batches in flight before recording has to wait on the oldest one, each owns UPLOAD_MANAGER_SEGMENT_SIZE of the staging buffer
+#define UPLOAD_MANAGER_BATCHES 4
+// Note: Uploads bigger than a segment like 2048x2048 textures get a staging buffer of their own that is freed when the batch retires
+#define UPLOAD_MANAGER_SEGMENT_SIZE 16777216
+// Note: Covers optimalBufferCopyOffsetAlignment and the texel size of every format uploaded
+#define UPLOAD_MANAGER_STAGING_ALIGNMENT 256
+
+struct VulkanState;
+
+// Note: Buffer copies go on the transfer queue, anything touching image layouts or blitting needs the graphics queue. Both are the same queue without a dedicated transfer family
+enum UploadQueue {
+  UPLOAD_QUEUE_TRANSFER = 0,
+  UPLOAD_QUEUE_GRAPHICS,
+  UPLOAD_QUEUE_COUNT
+};
+
+struct UploadStaging {
+  VkBuffer buffer;
+  struct GPUAllocation memory;
+};
+
+struct UploadBatch {
+  VkCommandBuffer command_buffers[UPLOAD_QUEUE_COUNT];
+  VkFence fences[UPLOAD_QUEUE_COUNT];
+  bool recording[UPLOAD_QUEUE_COUNT];
+  bool submitted[UPLOAD_QUEUE_COUNT];
+  // Note: Signalled by the transfer submission on a dedicated queue, pending until a graphics submission has waited on it
+  VkSemaphore semaphore;
+  bool semaphore_pending;
+  VkDeviceSize staging_offset;
+  // Note: UploadStaging for uploads too big for the segment
+  struct Vector oversized_staging;
+};
+
+// Note: A buffer replaced while frames in flight may still read it, freed once the last frame that could have drawn with it has finished
+struct UploadRetiredBuffer {
+  VkBuffer buffer;
+  struct GPUAllocation memory;
+  uint64_t frame;
+};
+
+struct UploadManager {
+  VkQueue queues[UPLOAD_QUEUE_COUNT];
+  VkCommandPool command_pools[UPLOAD_QUEUE_COUNT];
+  int queue_count;
+  VkBuffer staging_buffer;
+  struct GPUAllocation staging_memory;
+  char* mapped_memory;
+  struct UploadBatch batches[UPLOAD_MANAGER_BATCHES];
+  int current_batch;
+  int batches_submitted;
+  VkDeviceSize bytes_uploaded;
+  // Note: UploadRetiredBuffer in the order they were retired
+  struct Vector retired_buffers;
+  uint64_t frame_count;
+};
+
+enum {
+  UPLOAD_MANAGER_SUCCESS = 1,
+  UPLOAD_MANAGER_CREATE_COMMAND_POOL_ERROR,
+  UPLOAD_MANAGER_CREATE_BUFFER_ERROR,
+  UPLOAD_MANAGER_MAP_MEMORY_ERROR,
+  UPLOAD_MANAGER_CREATE_SYNC_ERROR
+};
+
+int upload_manager_init(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer);
+void upload_manager_delete(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer);
+void upload_manager_upload_buffer(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer, VkBuffer dst_buffer, VkDeviceSize dst_offset, const void* data, VkDeviceSize size);
+void upload_manager_upload_image(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mip_levels, const void* pixels, VkDeviceSize size);
+int upload_manager_flush(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer, VkSemaphore* wait_semaphores, VkPipelineStageFlags* wait_stages);
+void upload_manager_wait_idle(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer);
+void upload_manager_begin_frame(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer);
+void upload_manager_retire_buffer(struct UploadManager* upload_manager, VkBuffer buffer, struct GPUAllocation* memory);
+
+#endif  // UPLOAD_MANAGER_H
@@ -19,6 +19,8 @@
 #include "mana/graphics/render/gbuffer.h"
 #include "mana/graphics/render/postprocess.h"
 #include "mana/graphics/render/swapchain.h"
+#include "mana/graphics/render/uniformring.h"
+#include "mana/graphics/render/uploadmanager.h"
 #include "mana/graphics/utilities/graphicsutils.h"
 
 struct GraphicsLibrary;
@@ -11,6 +11,10 @@
 #include "mana/core/vulkancore.h"
 #include "mana/graphics/render/vulkanrenderer.h"
 
+// Note: Prints the average CPU time of a frame next to the time spent blocked on its fence, with frames overlapping the wait stays near max(cpu, gpu) - cpu instead of the whole GPU time
+#define WINDOW_BENCHMARK false
+#define WINDOW_BENCHMARK_FRAMES 120
+
 struct Engine;
 
 struct Window {
@@ -36,9 +36,9 @@ struct AtmosphericScatteringShader {
   struct FullscreenTriangle* fullscreen_triangle;
 
   VkBuffer uniform_buffer;
-  VkDeviceMemory uniform_buffer_memory;
+  struct GPUAllocation uniform_buffer_memory;
   VkBuffer uniform_buffer_settings;
-  VkDeviceMemory uniform_buffer_settings_memory;
+  struct GPUAllocation uniform_buffer_settings_memory;
 
   float sun_angle;
 };
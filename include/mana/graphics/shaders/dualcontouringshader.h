@@ -2,12 +2,15 @@
 #ifndef DUAL_CONTOURING_SHADER_H
 #define DUAL_CONTOURING_SHADER_H
 
+#include "mana/graphics/dualcontouring/chunkmanager.h"
 #include "mana/graphics/shaders/shader.h"
 
 // Effect for blitting dual contouring
 
 #define DUAL_CONTOURING_COLOR_ATTACHEMENTS 2
 #define DUAL_CONTOURING_VERTEX_ATTRIBUTES 2
+// Note: Every chunk slot can hold a set while the chunks rebuilt on the side hold a second one until the old is freed
+#define DUAL_CONTOURING_MAX_DESCRIPTOR_SETS (CHUNK_MANAGER_SLOT_COUNT + CHUNK_MANAGER_BUILDS_PER_UPDATE)
 
 struct DualContouringShader {
   struct Shader shader;
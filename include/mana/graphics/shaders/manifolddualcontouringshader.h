@@ -3,11 +3,16 @@
 #define MANIFOLD_DUAL_CONTOURING_SHADER_H
 
 #include "mana/graphics/shaders/shader.h"
+#include "mana/graphics/utilities/mesh.h"
 
 // Effect for blitting dual contouring
 
 #define MANIFOLD_DUAL_CONTOURING_COLOR_ATTACHEMENTS 2
+#if MESH_PACKED_VERTICES
+#define MANIFOLD_DUAL_CONTOURING_VERTEX_ATTRIBUTES 3
+#else
 #define MANIFOLD_DUAL_CONTOURING_VERTEX_ATTRIBUTES 4
+#endif
 
 struct ManifoldDualContouringShader {
   struct Shader shader;
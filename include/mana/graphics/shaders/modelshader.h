@@ -3,6 +3,7 @@
 #define MODEL_SHADER_H
 
 #include "mana/graphics/shaders/shader.h"
+#include "mana/graphics/utilities/mesh.h"
 
 // Effect for blitting model to gbuffer
 
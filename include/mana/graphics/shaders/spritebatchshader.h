@@ -0,0 +1,22 @@
+#pragma once
+#ifndef SPRITE_BATCH_SHADER_H
+#define SPRITE_BATCH_SHADER_H
+
+#include "mana/graphics/shaders/shader.h"
+
+// Effect for blitting instanced sprite batches to gbuffer
+
+#define SPRITE_BATCH_SHADER_COLOR_ATTACHEMENTS 2
+#define SPRITE_BATCH_SHADER_VERTEX_ATTRIBUTES 2
+#define SPRITE_BATCH_SHADER_INSTANCE_ATTRIBUTES 4
+// Note: Descriptor sets in the pool, one per texture in each batch drawn with this shader. Textures past it are dropped by the batch
+#define SPRITE_BATCH_SHADER_MAX_TEXTURES 256
+
+struct SpriteBatchShader {
+  struct Shader shader;
+};
+
+int sprite_batch_shader_init(struct SpriteBatchShader* sprite_batch_shader, struct GPUAPI* gpu_api, int depth_test);
+void sprite_batch_shader_delete(struct SpriteBatchShader* sprite_batch_shader, struct GPUAPI* gpu_api);
+
+#endif  // SPRITE_BATCH_SHADER_H
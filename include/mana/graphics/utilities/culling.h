@@ -0,0 +1,57 @@
+#pragma once
+#ifndef CULLING_H
+#define CULLING_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <cstorage/cstorage.h>
+#include <float.h>
+#include <immintrin.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <ubermath/ubermath.h>
+
+#include "mana/core/corecommon.h"
+#include "mana/graphics/utilities/mesh.h"
+
+// Note: Six planes padded out to eight so one AVX register holds each component of every plane
+#define CULLING_FRUSTUM_PLANES 8
+// Note: Cones wider than this many radians either side of the axis always have a face toward the camera so aren't worth testing
+#define CULLING_MAX_CONE_ANGLE 1.5f
+
+// Note: Planes are stored as a structure of arrays, a point is inside a plane when x * plane_x + y * plane_y + z * plane_z + plane_w >= 0
+struct Frustum {
+  alignas(32) float plane_x[CULLING_FRUSTUM_PLANES];
+  alignas(32) float plane_y[CULLING_FRUSTUM_PLANES];
+  alignas(32) float plane_z[CULLING_FRUSTUM_PLANES];
+  alignas(32) float plane_w[CULLING_FRUSTUM_PLANES];
+  vec3 camera_position;
+};
+
+// Note: Cone cutoff is the sine of the widest angle between the axis and a face normal, a cluster is backfacing when the camera is behind every face plane
+struct CullingBounds {
+  vec3 min;
+  vec3 max;
+  vec3 center;
+  float radius;
+  vec3 cone_axis;
+  float cone_cutoff;
+  bool cone_valid;
+};
+
+struct CullingStats {
+  int tested;
+  int frustum_culled;
+  int cone_culled;
+  int drawn;
+};
+
+void frustum_init(struct Frustum* frustum, mat4 projection, mat4 view);
+bool frustum_test_box(struct Frustum* frustum, vec3 min, vec3 max);
+void culling_bounds_from_mesh(struct CullingBounds* bounds, struct Mesh* mesh, size_t normal_offset, int first_index, int index_count);
+struct CullingBounds culling_bounds_transform(struct CullingBounds* bounds, mat4 model);
+bool culling_test_cone(struct CullingBounds* bounds, vec3 camera_position);
+bool culling_test_bounds(struct Frustum* frustum, struct CullingBounds* bounds, mat4 model, struct CullingStats* stats);
+
+#endif  // CULLING_H
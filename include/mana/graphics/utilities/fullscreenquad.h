@@ -9,9 +9,9 @@
 struct FullscreenQuad {
   struct Mesh* mesh;
   VkBuffer vertex_buffer;
-  VkDeviceMemory vertex_buffer_memory;
+  struct GPUAllocation vertex_buffer_memory;
   VkBuffer index_buffer;
-  VkDeviceMemory index_buffer_memory;
+  struct GPUAllocation index_buffer_memory;
 };
 
 void fullscreen_quad_init(struct FullscreenQuad* fullscreen_quad, struct VulkanState* vulkan_renderer);
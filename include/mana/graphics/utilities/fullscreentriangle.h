@@ -9,9 +9,9 @@
 struct FullscreenTriangle {
   struct Mesh* mesh;
   VkBuffer vertex_buffer;
-  VkDeviceMemory vertex_buffer_memory;
+  struct GPUAllocation vertex_buffer_memory;
   VkBuffer index_buffer;
-  VkDeviceMemory index_buffer_memory;
+  struct GPUAllocation index_buffer_memory;
 };
 
 void fullscreen_triangle_init(struct FullscreenTriangle* fullscreen_triangle, struct GPUAPI* gpu_api);
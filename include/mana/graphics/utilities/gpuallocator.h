@@ -0,0 +1,88 @@
+#pragma once
+#ifndef GPU_ALLOCATOR_H
+#define GPU_ALLOCATOR_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <cstorage/cstorage.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <vulkan/vulkan.h>
+
+#include "mana/core/corecommon.h"
+
+// Note: Size of every vkAllocateMemory the allocator makes for sub-allocation, has to be a power of two for the buddy strategy
+#define GPU_ALLOCATOR_BLOCK_SIZE 33554432
+// Note: Smallest buddy split, 256 bytes covers the offset alignment of uniform and storage buffers on every device
+#define GPU_ALLOCATOR_MIN_ORDER 8
+#define GPU_ALLOCATOR_ORDERS 18
+// Note: Anything bigger than half a block gets its own vkAllocateMemory like large render targets
+#define GPU_ALLOCATOR_DEDICATED_SIZE (GPU_ALLOCATOR_BLOCK_SIZE / 2)
+
+// Note: Buddy for long lived resources. Linear bumps through a block and only reuses it once everything in it is freed, for staging buffers that live a few lines
+enum GPUAllocationStrategy {
+  GPU_ALLOCATION_BUDDY = 0,
+  GPU_ALLOCATION_LINEAR
+};
+
+// Note: Buffers and optimal images never share a block so bufferImageGranularity never has to be padded for
+struct GPUMemoryBlock {
+  VkDeviceMemory memory;
+  char* mapped_memory;
+  uint32_t memory_type;
+  enum GPUAllocationStrategy strategy;
+  bool optimal_image;
+  VkDeviceSize used;
+  int allocation_count;
+  // Note: Buddy offsets free at each order, order 0 is GPU_ALLOCATOR_MIN_ORDER
+  struct Vector free_lists[GPU_ALLOCATOR_ORDERS];
+  // Note: Order + 1 at the first minimum unit of every live buddy allocation, 0 everywhere else
+  uint8_t* allocated_orders;
+  VkDeviceSize linear_offset;
+};
+
+// Note: Memory and offset to bind at, block is NULL for dedicated allocations
+struct GPUAllocation {
+  VkDeviceMemory memory;
+  VkDeviceSize offset;
+  VkDeviceSize size;
+  struct GPUMemoryBlock* block;
+};
+
+// Note: Fragmentation is how much of the free space in blocks can't be handed out as one piece, 0 when the largest free range is all of it
+struct GPUAllocatorStats {
+  VkDeviceSize bytes_used;
+  VkDeviceSize bytes_reserved;
+  VkDeviceSize largest_free_range;
+  float fragmentation;
+  int allocation_count;
+  int block_count;
+  int device_allocation_count;
+};
+
+struct GPUAllocator {
+  VkDevice device;
+  VkPhysicalDeviceMemoryProperties memory_properties;
+  struct ArrayList blocks;
+  VkDeviceSize dedicated_bytes;
+  int dedicated_count;
+  VkDeviceSize bytes_used;
+  int allocation_count;
+};
+
+enum {
+  GPU_ALLOCATOR_SUCCESS = 0,
+  GPU_ALLOCATOR_NO_MEMORY_TYPE_ERROR,
+  GPU_ALLOCATOR_ALLOCATE_MEMORY_ERROR,
+  GPU_ALLOCATOR_MAP_MEMORY_ERROR
+};
+
+int gpu_allocator_init(struct GPUAllocator* gpu_allocator, VkDevice device, VkPhysicalDevice physical_device);
+void gpu_allocator_delete(struct GPUAllocator* gpu_allocator);
+int gpu_allocator_allocate(struct GPUAllocator* gpu_allocator, VkMemoryRequirements memory_requirements, VkMemoryPropertyFlags properties, enum GPUAllocationStrategy strategy, bool optimal_image, struct GPUAllocation* allocation);
+void gpu_allocator_free(struct GPUAllocator* gpu_allocator, struct GPUAllocation* allocation);
+void* gpu_allocator_map(struct GPUAllocator* gpu_allocator, struct GPUAllocation* allocation);
+void gpu_allocator_unmap(struct GPUAllocator* gpu_allocator, struct GPUAllocation* allocation);
+struct GPUAllocatorStats gpu_allocator_get_stats(struct GPUAllocator* gpu_allocator);
+
+#endif  // GPU_ALLOCATOR_H
@@ -7,6 +7,8 @@
 #include <vulkan/vulkan.h>
 
 #include "mana/graphics/graphicscommon.h"
+#include "mana/graphics/render/uploadmanager.h"
+#include "mana/graphics/utilities/gpuallocator.h"
 
 struct SamplerSettings {
   uint32_t mip_levels;
@@ -15,30 +17,35 @@ struct SamplerSettings {
 };
 
 static inline void graphics_utils_create_image_view(struct VkDevice_T *device, VkImage image, VkFormat format, VkImageAspectFlags aspect_flags, uint32_t mip_levels, VkImageView *image_view);
-static inline int graphics_utils_create_image(struct VkDevice_T *device, struct VkPhysicalDevice_T *physical_device, uint32_t width, uint32_t height, uint32_t mip_levels, VkSampleCountFlagBits num_samples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage *image, VkDeviceMemory *image_memory);
-static inline int graphics_utils_create_buffer(struct VkDevice_T *device, struct VkPhysicalDevice_T *physical_device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer *buffer, VkDeviceMemory *buffer_memory);
+static inline int graphics_utils_create_image(struct VulkanState *vulkan_state, uint32_t width, uint32_t height, uint32_t mip_levels, VkSampleCountFlagBits num_samples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage *image, struct GPUAllocation *image_memory);
+static inline int graphics_utils_create_buffer(struct VulkanState *vulkan_state, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer *buffer, struct GPUAllocation *buffer_memory);
 static inline int graphics_utils_transition_image_layout(struct VkDevice_T *device, struct VkQueue_T *graphics_queue, struct VkCommandPool_T *command_pool, VkImage image, VkFormat format, VkImageLayout old_layout, VkImageLayout new_layout, uint32_t mip_levels);
+static inline int graphics_utils_record_transition_image_layout(VkCommandBuffer command_buffer, VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, uint32_t mip_levels);
 static inline uint32_t graphics_utils_find_memory_type(struct VkPhysicalDevice_T *physical_device, uint32_t typeFilter, VkMemoryPropertyFlags properties);
 static inline VkCommandBuffer graphics_utils_begin_single_time_commands(struct VkDevice_T *device, struct VkCommandPool_T *command_pool);
 static inline void graphics_utils_end_single_time_commands(struct VkDevice_T *device, struct VkQueue_T *graphics_queue, struct VkCommandPool_T *command_pool, VkCommandBuffer command_buffer);
 static inline int graphics_utils_create_sampler(struct VkDevice_T *device, VkSampler *texture_sampler, struct SamplerSettings sampler_settings);
 static inline void graphics_utils_copy_buffer_to_image(struct VkDevice_T *device, struct VkQueue_T *graphics_queue, struct VkCommandPool_T *command_pool, VkBuffer *buffer, VkImage *image, uint32_t width, uint32_t height);
+static inline void graphics_utils_record_copy_buffer_to_image(VkCommandBuffer command_buffer, VkBuffer buffer, VkDeviceSize buffer_offset, VkImage image, uint32_t width, uint32_t height);
 static inline void graphics_utils_generate_mipmaps(struct VkDevice_T *device, VkPhysicalDevice physical_device, struct VkQueue_T *graphics_queue, struct VkCommandPool_T *command_pool, VkImage image, VkFormat format, int32_t tex_width, int32_t tex_height, uint32_t mip_levels);
+static inline bool graphics_utils_can_generate_mipmaps(VkPhysicalDevice physical_device, VkFormat format);
+static inline void graphics_utils_record_generate_mipmaps(VkCommandBuffer command_buffer, VkImage image, int32_t tex_width, int32_t tex_height, uint32_t mip_levels);
 static inline VkFormat graphics_utils_find_depth_format(VkPhysicalDevice physical_device);
 static inline void graphics_utils_create_color_attachment(VkFormat image_format, struct VkAttachmentDescription *color_attachment);
 static inline void graphics_utils_create_depth_attachment(VkPhysicalDevice physical_device, struct VkAttachmentDescription *depth_attachment);
 static inline void graphics_utisl_copy_buffer(struct VulkanState *vulkan_state, VkBuffer src_buffer, VkBuffer dst_buffer, VkDeviceSize size);
 static inline void graphics_utisl_copy_buffer_offset(struct VulkanState *vulkan_state, VkBuffer src_buffer, VkBuffer dst_buffer, VkDeviceSize size, unsigned int offset);
-static inline void graphics_utils_setup_vertex_buffer(struct VulkanState *vulkan_state, struct Vector *vertices, VkBuffer *vertex_buffer, VkDeviceMemory *vertex_buffer_memory);
-static inline void graphics_utils_setup_vertex_buffer_pool(struct VulkanState *vulkan_state, struct Vector *vertices, int total_pool_elements, VkBuffer *vertex_buffer, VkDeviceMemory *vertex_buffer_memory);
-static inline void graphics_utils_update_vertex_buffer(struct VulkanState *vulkan_state, struct Vector *vertices, VkBuffer *vertex_buffer, VkDeviceMemory *vertex_buffer_memory);
-static inline void graphics_utils_setup_index_buffer(struct VulkanState *vulkan_state, struct Vector *indices, VkBuffer *index_buffer, VkDeviceMemory *index_buffer_memory);
-static inline void graphics_utils_setup_index_buffer_pool(struct VulkanState *vulkan_state, struct Vector *indices, int total_pool_elements, VkBuffer *index_buffer, VkDeviceMemory *index_buffer_memory);
-static inline void graphics_utils_update_index_buffer(struct VulkanState *vulkan_state, struct Vector *indices, VkBuffer *index_buffer, VkDeviceMemory *index_buffer_memory);
-static inline void graphics_utils_setup_uniform_buffer(struct VulkanState *vulkan_state, size_t memory_size, VkBuffer *uniform_buffer, VkDeviceMemory *uniform_buffer_memory);
+static inline void graphics_utils_setup_vertex_buffer(struct VulkanState *vulkan_state, struct Vector *vertices, VkBuffer *vertex_buffer, struct GPUAllocation *vertex_buffer_memory);
+static inline void graphics_utils_setup_vertex_buffer_pool(struct VulkanState *vulkan_state, struct Vector *vertices, int total_pool_elements, VkBuffer *vertex_buffer, struct GPUAllocation *vertex_buffer_memory);
+static inline void graphics_utils_update_vertex_buffer(struct VulkanState *vulkan_state, struct Vector *vertices, VkBuffer *vertex_buffer, struct GPUAllocation *vertex_buffer_memory);
+static inline void graphics_utils_setup_index_buffer(struct VulkanState *vulkan_state, struct Vector *indices, VkBuffer *index_buffer, struct GPUAllocation *index_buffer_memory);
+static inline void graphics_utils_setup_index_buffer_pool(struct VulkanState *vulkan_state, struct Vector *indices, int total_pool_elements, VkBuffer *index_buffer, struct GPUAllocation *index_buffer_memory);
+static inline void graphics_utils_update_index_buffer(struct VulkanState *vulkan_state, struct Vector *indices, VkBuffer *index_buffer, struct GPUAllocation *index_buffer_memory);
+static inline void graphics_utils_setup_uniform_buffer(struct VulkanState *vulkan_state, size_t memory_size, VkBuffer *uniform_buffer, struct GPUAllocation *uniform_buffer_memory);
 static inline int graphics_utils_setup_descriptor(struct VulkanState *vulkan_state, struct VkDescriptorSetLayout_T *descriptor_set_layout, struct VkDescriptorPool_T *descriptor_pool, VkDescriptorSet *descriptor_set);
 static inline VkDescriptorBufferInfo graphics_utils_setup_descriptor_buffer_info(size_t memory_size, VkBuffer *uniform_buffer);
 static inline void graphics_utils_setup_descriptor_buffer(struct VulkanState *vulkan_state, VkWriteDescriptorSet *dcs, size_t index, VkDescriptorSet *descriptor_set, VkDescriptorBufferInfo *buffer_info);
+static inline void graphics_utils_setup_descriptor_dynamic_buffer(struct VulkanState *vulkan_state, VkWriteDescriptorSet *dcs, size_t index, VkDescriptorSet *descriptor_set, VkDescriptorBufferInfo *buffer_info);
 static inline VkDescriptorImageInfo graphics_utils_setup_descriptor_image_info(VkImageView *texture_image_view, VkSampler *texture_sampler);
 static inline void graphics_utils_setup_descriptor_image(struct VulkanState *vulkan_state, VkWriteDescriptorSet *dcs, size_t index, VkDescriptorSet *descriptor_set, VkDescriptorImageInfo *image_info);
 
@@ -58,7 +65,7 @@ static inline void graphics_utils_create_image_view(struct VkDevice_T *device, V
     fprintf(stderr, "failed to create texture image view!");
 }
 
-static inline int graphics_utils_create_image(struct VkDevice_T *device, struct VkPhysicalDevice_T *physical_device, uint32_t width, uint32_t height, uint32_t mip_levels, VkSampleCountFlagBits num_samples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage *image, VkDeviceMemory *image_memory) {
+static inline int graphics_utils_create_image(struct VulkanState *vulkan_state, uint32_t width, uint32_t height, uint32_t mip_levels, VkSampleCountFlagBits num_samples, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage *image, struct GPUAllocation *image_memory) {
   VkImageCreateInfo image_info = {0};
   image_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
   image_info.imageType = VK_IMAGE_TYPE_2D;
@@ -74,54 +81,53 @@ static inline int graphics_utils_create_image(struct VkDevice_T *device, struct
   image_info.samples = num_samples;
   image_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-  if (vkCreateImage(device, &image_info, NULL, image) != VK_SUCCESS)
+  if (vkCreateImage(vulkan_state->device, &image_info, NULL, image) != VK_SUCCESS)
     return -1;
   // printf("failed to create image!");
 
   VkMemoryRequirements mem_mequirements;
-  vkGetImageMemoryRequirements(device, *image, &mem_mequirements);
+  vkGetImageMemoryRequirements(vulkan_state->device, *image, &mem_mequirements);
 
-  VkMemoryAllocateInfo alloc_info = {0};
-  alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-  alloc_info.allocationSize = mem_mequirements.size;
-  alloc_info.memoryTypeIndex = graphics_utils_find_memory_type(physical_device, mem_mequirements.memoryTypeBits, properties);
-
-  if (vkAllocateMemory(device, &alloc_info, NULL, image_memory) !=
-      VK_SUCCESS)
+  if (gpu_allocator_allocate(vulkan_state->gpu_allocator, mem_mequirements, properties, GPU_ALLOCATION_BUDDY, tiling == VK_IMAGE_TILING_OPTIMAL, image_memory) != GPU_ALLOCATOR_SUCCESS)
     return -1;
   // printf("failed to allocate image memory!");
 
-  vkBindImageMemory(device, *image, *image_memory, 0);
+  vkBindImageMemory(vulkan_state->device, *image, image_memory->memory, image_memory->offset);
 
   return 0;
 }
 
-static inline int graphics_utils_create_buffer(struct VkDevice_T *device, struct VkPhysicalDevice_T *physical_device, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer *buffer, VkDeviceMemory *buffer_memory) {
+static inline int graphics_utils_create_buffer(struct VulkanState *vulkan_state, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer *buffer, struct GPUAllocation *buffer_memory) {
   VkBufferCreateInfo buffer_info = {0};
   buffer_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
   buffer_info.size = size;
   buffer_info.usage = usage;
   buffer_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
 
-  if (vkCreateBuffer(device, &buffer_info, NULL, buffer) != VK_SUCCESS) {
+  // Note: With a dedicated transfer queue, anything copied to or from is shared with it rather than handing ownership back and forth every upload
+  const uint32_t queue_family_indices[2] = {vulkan_state->indices.graphics_family, vulkan_state->indices.transfer_family};
+  if ((usage & (VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)) && queue_family_indices[0] != queue_family_indices[1]) {
+    buffer_info.sharingMode = VK_SHARING_MODE_CONCURRENT;
+    buffer_info.queueFamilyIndexCount = 2;
+    buffer_info.pQueueFamilyIndices = queue_family_indices;
+  }
+
+  if (vkCreateBuffer(vulkan_state->device, &buffer_info, NULL, buffer) != VK_SUCCESS) {
     fprintf(stderr, "failed to create buffer!\n");
     return -1;
   }
 
   VkMemoryRequirements mem_requirements;
-  vkGetBufferMemoryRequirements(device, *buffer, &mem_requirements);
+  vkGetBufferMemoryRequirements(vulkan_state->device, *buffer, &mem_requirements);
 
-  VkMemoryAllocateInfo alloc_info = {0};
-  alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-  alloc_info.allocationSize = mem_requirements.size;
-  alloc_info.memoryTypeIndex = graphics_utils_find_memory_type(physical_device, mem_requirements.memoryTypeBits, properties);
-
-  if (vkAllocateMemory(device, &alloc_info, NULL, buffer_memory) != VK_SUCCESS) {
+  // Note: Buffers that are only ever copied from are staging buffers freed a few lines later, linear blocks hand those out without splitting
+  const enum GPUAllocationStrategy strategy = (usage == VK_BUFFER_USAGE_TRANSFER_SRC_BIT) ? GPU_ALLOCATION_LINEAR : GPU_ALLOCATION_BUDDY;
+  if (gpu_allocator_allocate(vulkan_state->gpu_allocator, mem_requirements, properties, strategy, false, buffer_memory) != GPU_ALLOCATOR_SUCCESS) {
     fprintf(stderr, "failed to allocate buffer memory!\n");
     return -1;
   }
 
-  vkBindBufferMemory(device, *buffer, *buffer_memory, 0);
+  vkBindBufferMemory(vulkan_state->device, *buffer, buffer_memory->memory, buffer_memory->offset);
 
   return 0;
 }
@@ -129,6 +135,14 @@ static inline int graphics_utils_create_buffer(struct VkDevice_T *device, struct
 static inline int graphics_utils_transition_image_layout(struct VkDevice_T *device, struct VkQueue_T *graphics_queue, struct VkCommandPool_T *command_pool, VkImage image, VkFormat format, VkImageLayout old_layout, VkImageLayout new_layout, uint32_t mip_levels) {
   VkCommandBuffer commandBuffer = graphics_utils_begin_single_time_commands(device, command_pool);
 
+  int transition_status = graphics_utils_record_transition_image_layout(commandBuffer, image, old_layout, new_layout, mip_levels);
+
+  graphics_utils_end_single_time_commands(device, graphics_queue, command_pool, commandBuffer);
+
+  return transition_status;
+}
+
+static inline int graphics_utils_record_transition_image_layout(VkCommandBuffer command_buffer, VkImage image, VkImageLayout old_layout, VkImageLayout new_layout, uint32_t mip_levels) {
   VkImageMemoryBarrier barrier = {0};
   barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
   barrier.oldLayout = old_layout;
@@ -162,9 +176,7 @@ static inline int graphics_utils_transition_image_layout(struct VkDevice_T *devi
     return -1;
   }
 
-  vkCmdPipelineBarrier(commandBuffer, source_stage, destination_stage, 0, 0, NULL, 0, NULL, 1, &barrier);
-
-  graphics_utils_end_single_time_commands(device, graphics_queue, command_pool, commandBuffer);
+  vkCmdPipelineBarrier(command_buffer, source_stage, destination_stage, 0, 0, NULL, 0, NULL, 1, &barrier);
 
   return 0;
 }
@@ -246,8 +258,14 @@ static inline int graphics_utils_create_sampler(struct VkDevice_T *device, VkSam
 static inline void graphics_utils_copy_buffer_to_image(struct VkDevice_T *device, struct VkQueue_T *graphics_queue, struct VkCommandPool_T *command_pool, VkBuffer *buffer, VkImage *image, uint32_t width, uint32_t height) {
   VkCommandBuffer command_buffer = graphics_utils_begin_single_time_commands(device, command_pool);
 
+  graphics_utils_record_copy_buffer_to_image(command_buffer, *buffer, 0, *image, width, height);
+
+  graphics_utils_end_single_time_commands(device, graphics_queue, command_pool, command_buffer);
+}
+
+static inline void graphics_utils_record_copy_buffer_to_image(VkCommandBuffer command_buffer, VkBuffer buffer, VkDeviceSize buffer_offset, VkImage image, uint32_t width, uint32_t height) {
   VkBufferImageCopy region = {0};
-  region.bufferOffset = 0;
+  region.bufferOffset = buffer_offset;
   region.bufferRowLength = 0;
   region.bufferImageHeight = 0;
   region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -257,21 +275,30 @@ static inline void graphics_utils_copy_buffer_to_image(struct VkDevice_T *device
   region.imageOffset = (VkOffset3D){0, 0, 0};
   region.imageExtent = (VkExtent3D){width, height, 1};
 
-  vkCmdCopyBufferToImage(command_buffer, *buffer, *image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-  graphics_utils_end_single_time_commands(device, graphics_queue, command_pool, command_buffer);
+  vkCmdCopyBufferToImage(command_buffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 }
 
 static inline void graphics_utils_generate_mipmaps(struct VkDevice_T *device, VkPhysicalDevice physical_device, struct VkQueue_T *graphics_queue, struct VkCommandPool_T *command_pool, VkImage image, VkFormat format, int32_t tex_width, int32_t tex_height, uint32_t mip_levels) {
-  VkFormatProperties format_properties;
-  vkGetPhysicalDeviceFormatProperties(physical_device, format, &format_properties);
-
-  if (!(format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+  if (!graphics_utils_can_generate_mipmaps(physical_device, format))
     return;
   //throw std::runtime_error("texture image format does not support linear blitting!");
 
   VkCommandBuffer command_buffer = graphics_utils_begin_single_time_commands(device, command_pool);
 
+  graphics_utils_record_generate_mipmaps(command_buffer, image, tex_width, tex_height, mip_levels);
+
+  graphics_utils_end_single_time_commands(device, graphics_queue, command_pool, command_buffer);
+}
+
+static inline bool graphics_utils_can_generate_mipmaps(VkPhysicalDevice physical_device, VkFormat format) {
+  VkFormatProperties format_properties;
+  vkGetPhysicalDeviceFormatProperties(physical_device, format, &format_properties);
+
+  return (format_properties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT) != 0;
+}
+
+// Note: Expects every level in TRANSFER_DST_OPTIMAL with level 0 filled, leaves every level in SHADER_READ_ONLY_OPTIMAL
+static inline void graphics_utils_record_generate_mipmaps(VkCommandBuffer command_buffer, VkImage image, int32_t tex_width, int32_t tex_height, uint32_t mip_levels) {
   VkImageMemoryBarrier barrier = {0};
   barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
   barrier.image = image;
@@ -328,7 +355,6 @@ static inline void graphics_utils_generate_mipmaps(struct VkDevice_T *device, Vk
   barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 
   vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 1, &barrier);
-  graphics_utils_end_single_time_commands(device, graphics_queue, command_pool, command_buffer);
 }
 
 #define TOTAL_CANDIDIATES 3
@@ -395,77 +421,41 @@ static inline void graphics_utisl_copy_buffer_offset(struct VulkanState *vulkan_
   graphics_utils_end_single_time_commands(vulkan_state->device, vulkan_state->graphics_queue, vulkan_state->command_pool, command_buffer);
 }
 
-static inline void graphics_utils_setup_vertex_buffer(struct VulkanState *vulkan_state, struct Vector *vertices, VkBuffer *vertex_buffer, VkDeviceMemory *vertex_buffer_memory) {
+static inline void graphics_utils_setup_vertex_buffer(struct VulkanState *vulkan_state, struct Vector *vertices, VkBuffer *vertex_buffer, struct GPUAllocation *vertex_buffer_memory) {
   VkDeviceSize vertex_buffer_size = vertices->memory_size * vertices->size;
-  VkBuffer vertex_staging_buffer = {0};
-  VkDeviceMemory vertex_staging_buffer_memory = {0};
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, vertex_buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &vertex_staging_buffer, &vertex_staging_buffer_memory);
-  void *vertex_data;
-  vkMapMemory(vulkan_state->device, vertex_staging_buffer_memory, 0, vertex_buffer_size, 0, &vertex_data);
-  memcpy(vertex_data, vertices->items, vertex_buffer_size);
-  vkUnmapMemory(vulkan_state->device, vertex_staging_buffer_memory);
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, vertex_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertex_buffer, vertex_buffer_memory);
-  graphics_utisl_copy_buffer(vulkan_state, vertex_staging_buffer, *vertex_buffer, vertex_buffer_size);
-  vkDestroyBuffer(vulkan_state->device, vertex_staging_buffer, NULL);
-  vkFreeMemory(vulkan_state->device, vertex_staging_buffer_memory, NULL);
-}
-
-static inline void graphics_utils_setup_vertex_buffer_pool(struct VulkanState *vulkan_state, struct Vector *vertices, int total_pool_elements, VkBuffer *vertex_buffer, VkDeviceMemory *vertex_buffer_memory) {
+  graphics_utils_create_buffer(vulkan_state, vertex_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertex_buffer, vertex_buffer_memory);
+  upload_manager_upload_buffer(vulkan_state->upload_manager, vulkan_state, *vertex_buffer, 0, vertices->items, vertex_buffer_size);
+}
+
+static inline void graphics_utils_setup_vertex_buffer_pool(struct VulkanState *vulkan_state, struct Vector *vertices, int total_pool_elements, VkBuffer *vertex_buffer, struct GPUAllocation *vertex_buffer_memory) {
   VkDeviceSize vertex_buffer_size = vertices->memory_size * total_pool_elements;
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, vertex_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertex_buffer, vertex_buffer_memory);
+  graphics_utils_create_buffer(vulkan_state, vertex_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertex_buffer, vertex_buffer_memory);
 }
 
-static inline void graphics_utils_update_vertex_buffer(struct VulkanState *vulkan_state, struct Vector *vertices, VkBuffer *vertex_buffer, VkDeviceMemory *vertex_buffer_memory) {
+static inline void graphics_utils_update_vertex_buffer(struct VulkanState *vulkan_state, struct Vector *vertices, VkBuffer *vertex_buffer, struct GPUAllocation *vertex_buffer_memory) {
   VkDeviceSize vertex_buffer_size = vertices->memory_size * vertices->size;
-  VkBuffer vertex_staging_buffer = {0};
-  VkDeviceMemory vertex_staging_buffer_memory = {0};
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, vertex_buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &vertex_staging_buffer, &vertex_staging_buffer_memory);
-  void *vertex_data;
-  vkMapMemory(vulkan_state->device, vertex_staging_buffer_memory, 0, vertex_buffer_size, 0, &vertex_data);
-  memcpy(vertex_data, vertices->items, vertex_buffer_size);
-  vkUnmapMemory(vulkan_state->device, vertex_staging_buffer_memory);
-  graphics_utisl_copy_buffer(vulkan_state, vertex_staging_buffer, *vertex_buffer, vertex_buffer_size);
-  vkDestroyBuffer(vulkan_state->device, vertex_staging_buffer, NULL);
-  vkFreeMemory(vulkan_state->device, vertex_staging_buffer_memory, NULL);
-}
-
-static inline void graphics_utils_setup_index_buffer(struct VulkanState *vulkan_state, struct Vector *indices, VkBuffer *index_buffer, VkDeviceMemory *index_buffer_memory) {
+  upload_manager_upload_buffer(vulkan_state->upload_manager, vulkan_state, *vertex_buffer, 0, vertices->items, vertex_buffer_size);
+}
+
+static inline void graphics_utils_setup_index_buffer(struct VulkanState *vulkan_state, struct Vector *indices, VkBuffer *index_buffer, struct GPUAllocation *index_buffer_memory) {
   VkDeviceSize index_buffer_size = indices->memory_size * indices->size;
-  VkBuffer index_staging_buffer = {0};
-  VkDeviceMemory index_staging_buffer_memory = {0};
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, index_buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &index_staging_buffer, &index_staging_buffer_memory);
-  void *index_data;
-  vkMapMemory(vulkan_state->device, index_staging_buffer_memory, 0, index_buffer_size, 0, &index_data);
-  memcpy(index_data, indices->items, index_buffer_size);
-  vkUnmapMemory(vulkan_state->device, index_staging_buffer_memory);
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, index_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, index_buffer, index_buffer_memory);
-  graphics_utisl_copy_buffer(vulkan_state, index_staging_buffer, *index_buffer, index_buffer_size);
-  vkDestroyBuffer(vulkan_state->device, index_staging_buffer, NULL);
-  vkFreeMemory(vulkan_state->device, index_staging_buffer_memory, NULL);
-}
-
-static inline void graphics_utils_setup_index_buffer_pool(struct VulkanState *vulkan_state, struct Vector *indices, int total_pool_elements, VkBuffer *index_buffer, VkDeviceMemory *index_buffer_memory) {
+  graphics_utils_create_buffer(vulkan_state, index_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, index_buffer, index_buffer_memory);
+  upload_manager_upload_buffer(vulkan_state->upload_manager, vulkan_state, *index_buffer, 0, indices->items, index_buffer_size);
+}
+
+static inline void graphics_utils_setup_index_buffer_pool(struct VulkanState *vulkan_state, struct Vector *indices, int total_pool_elements, VkBuffer *index_buffer, struct GPUAllocation *index_buffer_memory) {
   VkDeviceSize index_buffer_size = indices->memory_size * total_pool_elements;
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, index_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, index_buffer, index_buffer_memory);
+  graphics_utils_create_buffer(vulkan_state, index_buffer_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, index_buffer, index_buffer_memory);
 }
 
-static inline void graphics_utils_update_index_buffer(struct VulkanState *vulkan_state, struct Vector *indices, VkBuffer *index_buffer, VkDeviceMemory *index_buffer_memory) {
+static inline void graphics_utils_update_index_buffer(struct VulkanState *vulkan_state, struct Vector *indices, VkBuffer *index_buffer, struct GPUAllocation *index_buffer_memory) {
   VkDeviceSize index_buffer_size = indices->memory_size * indices->size;
-  VkBuffer index_staging_buffer = {0};
-  VkDeviceMemory index_staging_buffer_memory = {0};
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, index_buffer_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &index_staging_buffer, &index_staging_buffer_memory);
-  void *index_data;
-  vkMapMemory(vulkan_state->device, index_staging_buffer_memory, 0, index_buffer_size, 0, &index_data);
-  memcpy(index_data, indices->items, index_buffer_size);
-  vkUnmapMemory(vulkan_state->device, index_staging_buffer_memory);
-  graphics_utisl_copy_buffer(vulkan_state, index_staging_buffer, *index_buffer, index_buffer_size);
-  vkDestroyBuffer(vulkan_state->device, index_staging_buffer, NULL);
-  vkFreeMemory(vulkan_state->device, index_staging_buffer_memory, NULL);
-}
-
-static inline void graphics_utils_setup_uniform_buffer(struct VulkanState *vulkan_state, size_t memory_size, VkBuffer *uniform_buffer, VkDeviceMemory *uniform_buffer_memory) {
+  upload_manager_upload_buffer(vulkan_state->upload_manager, vulkan_state, *index_buffer, 0, indices->items, index_buffer_size);
+}
+
+static inline void graphics_utils_setup_uniform_buffer(struct VulkanState *vulkan_state, size_t memory_size, VkBuffer *uniform_buffer, struct GPUAllocation *uniform_buffer_memory) {
   VkDeviceSize uniform_buffer_size = memory_size;
-  graphics_utils_create_buffer(vulkan_state->device, vulkan_state->physical_device, uniform_buffer_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uniform_buffer, uniform_buffer_memory);
+  graphics_utils_create_buffer(vulkan_state, uniform_buffer_size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uniform_buffer, uniform_buffer_memory);
 }
 
 static inline int graphics_utils_setup_descriptor(struct VulkanState *vulkan_state, struct VkDescriptorSetLayout_T *descriptor_set_layout, struct VkDescriptorPool_T *descriptor_pool, VkDescriptorSet *descriptor_set) {
@@ -505,6 +495,11 @@ static inline void graphics_utils_setup_descriptor_buffer(struct VulkanState *vu
   dcs[index].pBufferInfo = buffer_info;
 }
 
+static inline void graphics_utils_setup_descriptor_dynamic_buffer(struct VulkanState *vulkan_state, VkWriteDescriptorSet *dcs, size_t index, VkDescriptorSet *descriptor_set, VkDescriptorBufferInfo *buffer_info) {
+  graphics_utils_setup_descriptor_buffer(vulkan_state, dcs, index, descriptor_set, buffer_info);
+  dcs[index].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+}
+
 static inline VkDescriptorImageInfo graphics_utils_setup_descriptor_image_info(VkImageView *texture_image_view, VkSampler *texture_sampler) {
   VkDescriptorImageInfo image_info = {0};
   image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
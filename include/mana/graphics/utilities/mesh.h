@@ -5,10 +5,19 @@
 #include "mana/core/memoryallocator.h"
 //
 #include <cstorage/cstorage.h>
+#include <math.h>
+#include <stdint.h>
 
 #include "mana/graphics/graphicscommon.h"
 #include "mana/graphics/utilities/texture.h"
 
+// Note: Uploads manifold terrain and animated models with the packed layouts below. The examples build compiles the packed vertex shaders along with the rest, it stays off until they've been checked on a GPU
+// Manifold terrain measured on the CPU, single core, vertex and index upload with packing
+// 64 ^ 3 8430 vertices 395 KB -> 131 KB, upload 1.95x smaller, pack 0.0008
+// 128 ^ 3 34062 vertices 1596 KB -> 532 KB, upload 1.96x smaller, pack 0.0027
+// 256 ^ 3 134786 vertices 6318 KB -> 2106 KB, upload 1.99x smaller, pack 0.013 on the main thread
+#define MESH_PACKED_VERTICES false
+
 enum VertexType {
   VERTEXSPRITE,
   VERTEXQUAD,
@@ -21,6 +30,14 @@ struct VertexSprite {
   vec2 tex_coord;
 };
 
+// Note: Per instance for the sprite batch, size scales the unit quad before rotating and uv_rect is offset then size into the texture. Negative uv size mirrors
+struct VertexSpriteInstance {
+  vec3 position;
+  vec2 size;
+  quat rotation;
+  vec4 uv_rect;
+};
+
 struct VertexQuad {
   vec3 position;
 };
@@ -61,6 +78,23 @@ struct VertexGrass {
   vec4 position_color;
 };
 
+// Note: 16 bytes against 48, position is unorm16 relative to the chunk so the model matrix has to scale it back out, normal is octahedral snorm16
+struct VertexManifoldDualContouringPacked {
+  uint16_t position[4];
+  int16_t normal[2];
+  uint8_t color[4];
+};
+
+// Note: 32 bytes against 68, position stays full float since models have no bounds to quantize against. Joint ids fit a byte as long as MAX_JOINTS does
+struct VertexModelPacked {
+  vec3 position;
+  int16_t normal[2];
+  uint16_t tex_coord[2];
+  uint8_t color[4];
+  uint8_t joints_ids[4];
+  uint8_t weights[4];
+};
+
 struct Mesh {
   struct Vector* vertices;
   struct Vector* indices;
@@ -71,6 +105,8 @@ static inline void mesh_sprite_init(struct Mesh* mesh);
 static inline void mesh_sprite_assign_vertex(struct Vector* vector, float x, float y, float z, float u, float v);
 static inline VkVertexInputBindingDescription mesh_sprite_get_binding_description();
 static inline void mesh_sprite_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions);
+static inline VkVertexInputBindingDescription mesh_sprite_instance_get_binding_description();
+static inline void mesh_sprite_instance_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions);
 
 static inline void mesh_quad_init(struct Mesh* mesh);
 static inline void mesh_quad_assign_vertex(struct Vector* vector, float x, float y, float z);
@@ -87,6 +123,11 @@ static inline void mesh_model_assign_vertex(struct Vector* vector, float x, floa
 static inline VkVertexInputBindingDescription mesh_model_get_binding_description();
 static inline void mesh_model_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions);
 
+static inline void mesh_model_packed_init(struct Mesh* mesh);
+static inline void mesh_model_packed_assign_vertex(struct Vector* vector, float x, float y, float z, float r1, float g1, float b1, float u, float v, float r2, float g2, float b2, int joint_id_x, int joint_id_y, int joint_id_z, float weight_x, float weight_y, float weight_z);
+static inline VkVertexInputBindingDescription mesh_model_packed_get_binding_description();
+static inline void mesh_model_packed_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions);
+
 static inline void mesh_model_static_init(struct Mesh* mesh);
 static inline void mesh_model_static_assign_vertex(struct Vector* vector, float x, float y, float z, float r1, float g1, float b1, float u, float v, float r2, float g2, float b2);
 static inline VkVertexInputBindingDescription mesh_model_static_get_binding_description();
@@ -103,6 +144,10 @@ static inline void mesh_manifold_dual_contouring_assign_vertex_simple(struct Vec
 static inline VkVertexInputBindingDescription mesh_manifold_dual_contouring_get_binding_description();
 static inline void mesh_manifold_dual_contouring_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions);
 
+static inline void mesh_manifold_dual_contouring_pack_vertices(struct Vector* vertices, struct Vector* packed_vertices, float position_offset, float position_scale);
+static inline VkVertexInputBindingDescription mesh_manifold_dual_contouring_packed_get_binding_description();
+static inline void mesh_manifold_dual_contouring_packed_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions);
+
 static inline void mesh_grass_init(struct Mesh* mesh);
 static inline void mesh_grass_assign_vertex(struct Vector* vector, float x, float y, float z, float w);
 static inline VkVertexInputBindingDescription mesh_grass_get_binding_description();
@@ -113,6 +158,14 @@ static inline void mesh_clear(struct Mesh* mesh);
 static inline void mesh_clear_vertices(struct Mesh* mesh);
 static inline void mesh_clear_indices(struct Mesh* mesh);
 static inline void mesh_assign_indice(struct Vector* vector, uint32_t indice);
+static inline VkIndexType mesh_get_index_type(struct Mesh* mesh);
+
+static inline uint8_t mesh_pack_unorm8(float value);
+static inline uint16_t mesh_pack_unorm16(float value);
+static inline int16_t mesh_pack_snorm16(float value);
+static inline uint16_t mesh_pack_half(float value);
+static inline void mesh_pack_octahedral(vec3 normal, int16_t packed[2]);
+static inline void mesh_pack_weights_unorm8(const float weights[3], uint8_t packed[4]);
 
 /////////////////////////////////////////////////////////////////////////////////////
 
@@ -157,6 +210,38 @@ static inline void mesh_sprite_get_attribute_descriptions(VkVertexInputAttribute
   attribute_descriptions[1].offset = offsetof(struct VertexSprite, tex_coord);
 }
 
+static inline VkVertexInputBindingDescription mesh_sprite_instance_get_binding_description() {
+  VkVertexInputBindingDescription binding_description = {0};
+  binding_description.binding = 1;
+  binding_description.stride = sizeof(struct VertexSpriteInstance);
+  binding_description.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+
+  return binding_description;
+}
+
+// Note: Follows the sprite attributes so locations start at 2
+static inline void mesh_sprite_instance_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions) {
+  attribute_descriptions[0].binding = 1;
+  attribute_descriptions[0].location = 2;
+  attribute_descriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+  attribute_descriptions[0].offset = offsetof(struct VertexSpriteInstance, position);
+
+  attribute_descriptions[1].binding = 1;
+  attribute_descriptions[1].location = 3;
+  attribute_descriptions[1].format = VK_FORMAT_R32G32_SFLOAT;
+  attribute_descriptions[1].offset = offsetof(struct VertexSpriteInstance, size);
+
+  attribute_descriptions[2].binding = 1;
+  attribute_descriptions[2].location = 4;
+  attribute_descriptions[2].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+  attribute_descriptions[2].offset = offsetof(struct VertexSpriteInstance, rotation);
+
+  attribute_descriptions[3].binding = 1;
+  attribute_descriptions[3].location = 5;
+  attribute_descriptions[3].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+  attribute_descriptions[3].offset = offsetof(struct VertexSpriteInstance, uv_rect);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 
 static inline void mesh_quad_init(struct Mesh* mesh) {
@@ -329,6 +414,83 @@ static inline void mesh_model_get_attribute_descriptions(VkVertexInputAttributeD
 
 /////////////////////////////////////////////////////////////////////////////////////
 
+static inline void mesh_model_packed_init(struct Mesh* mesh) {
+  mesh->vertices = calloc(1, sizeof(struct Vector));
+  vector_init(mesh->vertices, sizeof(struct VertexModelPacked));
+
+  mesh->indices = calloc(1, sizeof(struct Vector));
+  vector_init(mesh->indices, sizeof(uint32_t));
+}
+
+static inline void mesh_model_packed_assign_vertex(struct Vector* vector, float x, float y, float z, float r1, float g1, float b1, float u, float v, float r2, float g2, float b2, int joint_id_x, int joint_id_y, int joint_id_z, float weight_x, float weight_y, float weight_z) {
+  struct VertexModelPacked vertex = {{{0}}};
+
+  vertex.position.x = x;
+  vertex.position.y = y;
+  vertex.position.z = z;
+
+  mesh_pack_octahedral((vec3){.x = r1, .y = g1, .z = b1}, vertex.normal);
+
+  vertex.tex_coord[0] = mesh_pack_half(u);
+  vertex.tex_coord[1] = mesh_pack_half(v);
+
+  vertex.color[0] = mesh_pack_unorm8(r2);
+  vertex.color[1] = mesh_pack_unorm8(g2);
+  vertex.color[2] = mesh_pack_unorm8(b2);
+  vertex.color[3] = UINT8_MAX;
+
+  vertex.joints_ids[0] = (uint8_t)joint_id_x;
+  vertex.joints_ids[1] = (uint8_t)joint_id_y;
+  vertex.joints_ids[2] = (uint8_t)joint_id_z;
+
+  mesh_pack_weights_unorm8((float[3]){weight_x, weight_y, weight_z}, vertex.weights);
+
+  vector_push_back(vector, &vertex);
+}
+
+static inline VkVertexInputBindingDescription mesh_model_packed_get_binding_description() {
+  VkVertexInputBindingDescription binding_description = {0};
+  binding_description.binding = 0;
+  binding_description.stride = sizeof(struct VertexModelPacked);
+  binding_description.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+  return binding_description;
+}
+
+static inline void mesh_model_packed_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions) {
+  attribute_descriptions[0].binding = 0;
+  attribute_descriptions[0].location = 0;
+  attribute_descriptions[0].format = VK_FORMAT_R32G32B32_SFLOAT;
+  attribute_descriptions[0].offset = offsetof(struct VertexModelPacked, position);
+
+  attribute_descriptions[1].binding = 0;
+  attribute_descriptions[1].location = 1;
+  attribute_descriptions[1].format = VK_FORMAT_R16G16_SNORM;
+  attribute_descriptions[1].offset = offsetof(struct VertexModelPacked, normal);
+
+  attribute_descriptions[2].binding = 0;
+  attribute_descriptions[2].location = 2;
+  attribute_descriptions[2].format = VK_FORMAT_R16G16_SFLOAT;
+  attribute_descriptions[2].offset = offsetof(struct VertexModelPacked, tex_coord);
+
+  attribute_descriptions[3].binding = 0;
+  attribute_descriptions[3].location = 3;
+  attribute_descriptions[3].format = VK_FORMAT_R8G8B8A8_UNORM;
+  attribute_descriptions[3].offset = offsetof(struct VertexModelPacked, color);
+
+  attribute_descriptions[4].binding = 0;
+  attribute_descriptions[4].location = 4;
+  attribute_descriptions[4].format = VK_FORMAT_R8G8B8A8_UINT;
+  attribute_descriptions[4].offset = offsetof(struct VertexModelPacked, joints_ids);
+
+  attribute_descriptions[5].binding = 0;
+  attribute_descriptions[5].location = 5;
+  attribute_descriptions[5].format = VK_FORMAT_R8G8B8A8_UNORM;
+  attribute_descriptions[5].offset = offsetof(struct VertexModelPacked, weights);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
 static inline void mesh_model_static_init(struct Mesh* mesh) {
   mesh->vertices = calloc(1, sizeof(struct Vector));
   vector_init(mesh->vertices, sizeof(struct VertexModelStatic));
@@ -499,6 +661,55 @@ static inline void mesh_manifold_dual_contouring_get_attribute_descriptions(VkVe
   attribute_descriptions[3].offset = offsetof(struct VertexManifoldDualContouring, normal2);
 }
 
+// Note: Positions map [position_offset, position_offset + position_scale] to [0, 1] and are clamped to it, normal2 is left out since it always matches normal1
+static inline void mesh_manifold_dual_contouring_pack_vertices(struct Vector* vertices, struct Vector* packed_vertices, float position_offset, float position_scale) {
+  vector_clear(packed_vertices);
+  if (vector_size(vertices) == 0)
+    return;
+
+  vector_resize(packed_vertices, vector_size(vertices));
+  packed_vertices->size = vector_size(vertices);
+  for (size_t vertex_num = 0; vertex_num < vector_size(vertices); vertex_num++) {
+    struct VertexManifoldDualContouring* vertex = vector_get(vertices, vertex_num);
+    struct VertexManifoldDualContouringPacked* packed_vertex = vector_get(packed_vertices, vertex_num);
+
+    for (int axis = 0; axis < 3; axis++) {
+      packed_vertex->position[axis] = mesh_pack_unorm16((vertex->position.data[axis] - position_offset) / position_scale);
+      packed_vertex->color[axis] = mesh_pack_unorm8(vertex->color.data[axis]);
+    }
+    packed_vertex->position[3] = UINT16_MAX;
+    packed_vertex->color[3] = UINT8_MAX;
+
+    mesh_pack_octahedral(vertex->normal1, packed_vertex->normal);
+  }
+}
+
+static inline VkVertexInputBindingDescription mesh_manifold_dual_contouring_packed_get_binding_description() {
+  VkVertexInputBindingDescription binding_description = {0};
+  binding_description.binding = 0;
+  binding_description.stride = sizeof(struct VertexManifoldDualContouringPacked);
+  binding_description.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+  return binding_description;
+}
+
+static inline void mesh_manifold_dual_contouring_packed_get_attribute_descriptions(VkVertexInputAttributeDescription* attribute_descriptions) {
+  attribute_descriptions[0].binding = 0;
+  attribute_descriptions[0].location = 0;
+  attribute_descriptions[0].format = VK_FORMAT_R16G16B16A16_UNORM;
+  attribute_descriptions[0].offset = offsetof(struct VertexManifoldDualContouringPacked, position);
+
+  attribute_descriptions[1].binding = 0;
+  attribute_descriptions[1].location = 1;
+  attribute_descriptions[1].format = VK_FORMAT_R8G8B8A8_UNORM;
+  attribute_descriptions[1].offset = offsetof(struct VertexManifoldDualContouringPacked, color);
+
+  attribute_descriptions[2].binding = 0;
+  attribute_descriptions[2].location = 2;
+  attribute_descriptions[2].format = VK_FORMAT_R16G16_SNORM;
+  attribute_descriptions[2].offset = offsetof(struct VertexManifoldDualContouringPacked, normal);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////
 
 static inline void mesh_grass_init(struct Mesh* mesh) {
@@ -562,4 +773,102 @@ static inline void mesh_assign_indice(struct Vector* vector, uint32_t indice) {
   vector_push_back(vector, &indice);
 }
 
+// Note: Meshes start out with 32 bit indices, mesh_optimize_compress_indices may narrow them once the mesh is final
+static inline VkIndexType mesh_get_index_type(struct Mesh* mesh) {
+  return (mesh->indices->memory_size == sizeof(uint16_t)) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t mesh_pack_unorm8(float value) {
+  return (uint8_t)lrintf(fminf(fmaxf(value, 0.0f), 1.0f) * (float)UINT8_MAX);
+}
+
+// Note: Rounding each weight on its own can leave the sum a few steps off 255 which scales the skinned position, so they're normalized first and the rounding leftovers go to the weights that lost the most
+static inline void mesh_pack_weights_unorm8(const float weights[3], uint8_t packed[4]) {
+  float clamped[3];
+  float sum = 0.0f;
+  for (int weight_num = 0; weight_num < 3; weight_num++) {
+    clamped[weight_num] = fmaxf(weights[weight_num], 0.0f);
+    sum += clamped[weight_num];
+  }
+
+  packed[3] = 0;
+  if (!(sum > 0.0f)) {
+    packed[0] = packed[1] = packed[2] = 0;
+    return;
+  }
+
+  float remainders[3];
+  int total = 0;
+  for (int weight_num = 0; weight_num < 3; weight_num++) {
+    const float scaled = (clamped[weight_num] / sum) * (float)UINT8_MAX;
+    packed[weight_num] = (uint8_t)MIN((int)scaled, UINT8_MAX);
+    remainders[weight_num] = scaled - (float)packed[weight_num];
+    total += packed[weight_num];
+  }
+
+  for (; total < UINT8_MAX; total++) {
+    int largest = 0;
+    for (int weight_num = 1; weight_num < 3; weight_num++)
+      if (remainders[weight_num] > remainders[largest])
+        largest = weight_num;
+    packed[largest]++;
+    remainders[largest] -= 1.0f;
+  }
+}
+
+static inline uint16_t mesh_pack_unorm16(float value) {
+  return (uint16_t)lrintf(fminf(fmaxf(value, 0.0f), 1.0f) * (float)UINT16_MAX);
+}
+
+static inline int16_t mesh_pack_snorm16(float value) {
+  return (int16_t)lrintf(fminf(fmaxf(value, -1.0f), 1.0f) * (float)INT16_MAX);
+}
+
+// Note: Rounds to nearest, anything past the half range becomes infinity and NaN isn't kept
+static inline uint16_t mesh_pack_half(float value) {
+  union {
+    float f;
+    uint32_t u;
+  } bits = {.f = value};
+  const uint32_t sign = (bits.u >> 16) & 0x8000;
+  const int32_t exponent = (int32_t)((bits.u >> 23) & 0xFF) - 127 + 15;
+  uint32_t mantissa = bits.u & 0x7FFFFF;
+
+  if (exponent >= 31)
+    return (uint16_t)(sign | 0x7C00);
+  if (exponent <= 0) {
+    if (exponent < -10)
+      return (uint16_t)sign;
+    mantissa |= 0x800000;
+    const int shift = 14 - exponent;
+    return (uint16_t)(sign | ((mantissa >> shift) + ((mantissa >> (shift - 1)) & 1)));
+  }
+
+  // Note: A carry out of the mantissa rounds up into the exponent which is still the right answer
+  return (uint16_t)((sign | ((uint32_t)exponent << 10) | (mantissa >> 13)) + ((mantissa >> 12) & 1));
+}
+
+// Note: Projects onto the octahedron and folds the lower half over the diagonals, the shaders undo it with octahedral_decode
+static inline void mesh_pack_octahedral(vec3 normal, int16_t packed[2]) {
+  const float sum = fabsf(normal.x) + fabsf(normal.y) + fabsf(normal.z);
+  if (sum == 0.0f) {
+    packed[0] = packed[1] = 0;
+    return;
+  }
+
+  float u = normal.x / sum;
+  float v = normal.y / sum;
+  if (normal.z < 0.0f) {
+    const float folded_u = (1.0f - fabsf(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+    const float folded_v = (1.0f - fabsf(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+    u = folded_u;
+    v = folded_v;
+  }
+
+  packed[0] = mesh_pack_snorm16(u);
+  packed[1] = mesh_pack_snorm16(v);
+}
+
 #endif  // MESH_H
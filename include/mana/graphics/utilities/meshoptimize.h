@@ -0,0 +1,37 @@
+#pragma once
+#ifndef MESH_OPTIMIZE_H
+#define MESH_OPTIMIZE_H
+
+#include "mana/core/memoryallocator.h"
+//
+#include <cstorage/cstorage.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mana/core/corecommon.h"
+#include "mana/graphics/utilities/mesh.h"
+
+// Note: Post transform cache size the triangle order is tuned for and ACMR is measured against, small enough to hold on any GPU we run on
+#define MESH_OPTIMIZE_CACHE_SIZE 16
+// Note: 0xFFFF is left out so a 16 bit buffer never holds the primitive restart value
+#define MESH_OPTIMIZE_MAX_16_BIT_VERTICES 65535
+
+// Note: ACMR is vertex shader invocations per triangle through a FIFO cache, 3.0 is no reuse at all and ~0.5 the best a closed grid mesh can do
+struct MeshOptimizeStats {
+  int vertices_before;
+  int vertices_after;
+  int triangles_before;
+  int triangles_after;
+  float acmr_before;
+  float acmr_after;
+};
+
+int mesh_optimize_remove_degenerates(uint32_t* indices, int index_count);
+int mesh_optimize_weld_vertices(struct Vector* vertices, uint32_t* indices, int index_count, uint32_t* remap);
+void mesh_optimize_vertex_cache(uint32_t* indices, int index_count, int vertex_count, int cache_size);
+void mesh_optimize_vertex_fetch(struct Vector* vertices, uint32_t* indices, int index_count, uint32_t* remap);
+float mesh_optimize_acmr(const uint32_t* indices, int index_count, int vertex_count, int cache_size);
+bool mesh_optimize_compress_indices(struct Vector* indices, int vertex_count);
+void mesh_optimize(struct Mesh* mesh, bool compress_indices, struct MeshOptimizeStats* stats);
+
+#endif  // MESH_OPTIMIZE_H
@@ -41,11 +41,11 @@ struct SpriteAnimation {
 
   struct Shader* shader;
   VkBuffer vertex_buffer;
-  VkDeviceMemory vertex_buffer_memory;
+  struct GPUAllocation vertex_buffer_memory;
   VkBuffer index_buffer;
-  VkDeviceMemory index_buffer_memory;
-  VkBuffer uniform_buffer;
-  VkDeviceMemory uniform_buffers_memory;
+  struct GPUAllocation index_buffer_memory;
+  // Note: Where sprite_animation_update_uniforms pushed this frame's uniforms in the uniform ring
+  uint32_t uniform_offset;
   VkDescriptorSet descriptor_set;
 };
 
@@ -60,5 +60,6 @@ void sprite_animation_update_uniforms(struct SpriteAnimation* sprite_animation,
 void sprite_animation_recreate(struct SpriteAnimation* sprite_animation, struct GPUAPI* gpu_api);
 void sprite_animation_set_frame(struct SpriteAnimation* sprite_animation, int frame);
 void sprite_animation_update(struct SpriteAnimation* sprite_animation, float delta_time);
+vec4 sprite_animation_get_uv_rect(struct SpriteAnimation* sprite_animation);
 
 #endif  // SPRITE_ANIMATION_H
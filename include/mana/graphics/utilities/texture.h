@@ -39,7 +39,7 @@ struct Texture {
   char *type;
   char *path;
   VkImage texture_image;                // Raw image data in ram
-  VkDeviceMemory texture_image_memory;  // Image data in GPU/device ram
+  struct GPUAllocation texture_image_memory;  // Image data in GPU/device ram
   VkImageView texture_image_view;       // Texture format
   VkSampler texture_sampler;            // Image sampling settings
   //VkFilter filter_type;
@@ -30,21 +30,20 @@ int engine_init(struct Engine* engine, struct EngineSettings engine_settings) {
       return ENGINE_GPU_API_ERROR;
   }
 
+  if (job_system_init(&engine->job_system, JOB_SYSTEM_DEFAULT_WORKERS) != JOB_SYSTEM_SUCCESS) {
+    fprintf(stderr, "Failed to setup job system for engine!\n");
+    return ENGINE_JOB_SYSTEM_ERROR;
+  }
+
   return ENGINE_SUCCESS;
 }
 
 void engine_delete(struct Engine* engine) {
+  job_system_delete(&engine->job_system);
   gpu_api_delete(&engine->gpu_api);
   graphics_library_delete(&engine->graphics_library);
 }
 
-double engine_get_time() {
-  struct timespec current_time;
-  timespec_get(&current_time, TIME_UTC);
-  double time = (double)current_time.tv_sec + (double)current_time.tv_nsec / 1000000000;
-  return time;
-}
-
 int engine_get_max_omp_threads() {
   int max_omp_threads = 1;
 #pragma omp parallel
@@ -0,0 +1,35 @@
+#include "mana/core/engine.h"
+
+#ifdef IS_WINDOWS
+#include <windows.h>
+//
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Note: Clock and memory queries only, kept out of engine.c so headless benchmarks can link them without GLFW or Vulkan
+double engine_get_time() {
+  struct timespec current_time;
+  timespec_get(&current_time, TIME_UTC);
+  double time = (double)current_time.tv_sec + (double)current_time.tv_nsec / 1000000000;
+  return time;
+}
+
+// Note: Peak resident set size in bytes, used by the benchmark paths
+size_t engine_get_peak_memory_usage() {
+#ifdef IS_WINDOWS
+  PROCESS_MEMORY_COUNTERS memory_counters = {0};
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &memory_counters, sizeof(memory_counters)))
+    return memory_counters.PeakWorkingSetSize;
+  return 0;
+#else
+  struct rusage usage = {0};
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return (size_t)usage.ru_maxrss;
+#else
+  return (size_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
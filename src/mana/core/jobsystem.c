@@ -0,0 +1,157 @@
+#include "mana/core/jobsystem.h"
+
+void job_queue_init(struct JobQueue* job_queue) {
+  for (size_t cell_num = 0; cell_num < JOB_QUEUE_CAPACITY; cell_num++)
+    atomic_init(&job_queue->cells[cell_num].sequence, cell_num);
+
+  atomic_init(&job_queue->enqueue_pos, 0);
+  atomic_init(&job_queue->dequeue_pos, 0);
+}
+
+// Returns false if the queue is full
+bool job_queue_push(struct JobQueue* job_queue, struct Job* job) {
+  struct JobQueueCell* cell;
+  size_t pos = atomic_load_explicit(&job_queue->enqueue_pos, memory_order_relaxed);
+  for (;;) {
+    cell = &job_queue->cells[pos & (JOB_QUEUE_CAPACITY - 1)];
+    const size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    const intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+    if (diff == 0) {
+      if (atomic_compare_exchange_weak_explicit(&job_queue->enqueue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+        break;
+    } else if (diff < 0)
+      return false;
+    else
+      pos = atomic_load_explicit(&job_queue->enqueue_pos, memory_order_relaxed);
+  }
+
+  cell->job = *job;
+  atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+
+  return true;
+}
+
+// Returns false if the queue is empty
+bool job_queue_pop(struct JobQueue* job_queue, struct Job* job) {
+  struct JobQueueCell* cell;
+  size_t pos = atomic_load_explicit(&job_queue->dequeue_pos, memory_order_relaxed);
+  for (;;) {
+    cell = &job_queue->cells[pos & (JOB_QUEUE_CAPACITY - 1)];
+    const size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+    const intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1);
+    if (diff == 0) {
+      if (atomic_compare_exchange_weak_explicit(&job_queue->dequeue_pos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed))
+        break;
+    } else if (diff < 0)
+      return false;
+    else
+      pos = atomic_load_explicit(&job_queue->dequeue_pos, memory_order_relaxed);
+  }
+
+  *job = cell->job;
+  atomic_store_explicit(&cell->sequence, pos + JOB_QUEUE_CAPACITY, memory_order_release);
+
+  return true;
+}
+
+static int job_system_worker(void* arg) {
+  struct JobSystem* job_system = (struct JobSystem*)arg;
+  struct Job job;
+
+  for (;;) {
+    if (job_queue_pop(&job_system->pending, &job)) {
+      atomic_fetch_sub(&job_system->queued, 1);
+      job.execute(job.data);
+      // Note: Can't fail since submit never lets more than the queue capacity be in flight
+      job_queue_push(&job_system->completed, &job);
+      continue;
+    }
+
+    // Note: Queued can briefly dip below zero when a job is popped before submit counts it
+    mtx_lock(&job_system->wake_mutex);
+    while (atomic_load(&job_system->alive) && atomic_load(&job_system->queued) <= 0)
+      cnd_wait(&job_system->wake_condition, &job_system->wake_mutex);
+    const bool exit = !atomic_load(&job_system->alive) && atomic_load(&job_system->queued) <= 0;
+    mtx_unlock(&job_system->wake_mutex);
+
+    if (exit)
+      return 0;
+  }
+}
+
+int job_system_init(struct JobSystem* job_system, int worker_count) {
+  job_queue_init(&job_system->pending);
+  job_queue_init(&job_system->completed);
+  atomic_init(&job_system->queued, 0);
+  atomic_init(&job_system->in_flight, 0);
+  atomic_init(&job_system->alive, true);
+  mtx_init(&job_system->wake_mutex, mtx_plain);
+  cnd_init(&job_system->wake_condition);
+
+  worker_count = MIN(MAX(worker_count, 1), JOB_SYSTEM_MAX_WORKERS);
+  job_system->worker_count = 0;
+  for (int worker_num = 0; worker_num < worker_count; worker_num++) {
+    if (thrd_create(&job_system->workers[worker_num], job_system_worker, job_system) != thrd_success) {
+      fprintf(stderr, "Error starting job system worker thread!\n");
+      return JOB_SYSTEM_THREAD_ERROR;
+    }
+    job_system->worker_count++;
+  }
+
+  return JOB_SYSTEM_SUCCESS;
+}
+
+// Note: Workers drain the pending queue before exiting but finish callbacks still sitting in completed are dropped, flush first if they matter
+void job_system_delete(struct JobSystem* job_system) {
+  mtx_lock(&job_system->wake_mutex);
+  atomic_store(&job_system->alive, false);
+  cnd_broadcast(&job_system->wake_condition);
+  mtx_unlock(&job_system->wake_mutex);
+
+  for (int worker_num = 0; worker_num < job_system->worker_count; worker_num++)
+    thrd_join(job_system->workers[worker_num], NULL);
+  job_system->worker_count = 0;
+
+  cnd_destroy(&job_system->wake_condition);
+  mtx_destroy(&job_system->wake_mutex);
+}
+
+// Note: Callers should fall back to running the job inline when this doesn't return success
+int job_system_submit(struct JobSystem* job_system, struct Job job) {
+  if (job_system->worker_count == 0)
+    return JOB_SYSTEM_THREAD_ERROR;
+
+  if (atomic_fetch_add(&job_system->in_flight, 1) >= JOB_QUEUE_CAPACITY || !job_queue_push(&job_system->pending, &job)) {
+    atomic_fetch_sub(&job_system->in_flight, 1);
+    return JOB_SYSTEM_FULL_ERROR;
+  }
+
+  atomic_fetch_add(&job_system->queued, 1);
+  mtx_lock(&job_system->wake_mutex);
+  cnd_signal(&job_system->wake_condition);
+  mtx_unlock(&job_system->wake_mutex);
+
+  return JOB_SYSTEM_SUCCESS;
+}
+
+// Runs finish for up to max_jobs completed jobs, or all of them if max_jobs <= 0, and returns how many ran
+int job_system_process_completed(struct JobSystem* job_system, int max_jobs) {
+  int processed = 0;
+  struct Job job;
+  while ((max_jobs <= 0 || processed < max_jobs) && job_queue_pop(&job_system->completed, &job)) {
+    if (job.finish)
+      job.finish(job.data);
+    atomic_fetch_sub(&job_system->in_flight, 1);
+    processed++;
+  }
+
+  return processed;
+}
+
+// Blocks until every submitted job has executed and had its finish run on the calling thread
+void job_system_flush(struct JobSystem* job_system) {
+  while (atomic_load(&job_system->in_flight) > 0) {
+    if (job_system_process_completed(job_system, 0) == 0)
+      thrd_yield();
+  }
+}
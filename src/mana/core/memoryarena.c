@@ -0,0 +1,92 @@
+#include "mana/core/memoryarena.h"
+
+#define MEMORY_ARENA_ALIGN(size) (((size) + (MEMORY_ARENA_ALIGNMENT - 1)) & ~((size_t)MEMORY_ARENA_ALIGNMENT - 1))
+#define MEMORY_ARENA_PAGE_HEADER MEMORY_ARENA_ALIGN(sizeof(struct MemoryArenaPage))
+
+static inline struct MemoryArenaPage* memory_arena_new_page(struct MemoryArena* memory_arena, size_t size) {
+  // Note: Try to recycle a page kept from the last reset before going back to the allocator
+  struct MemoryArenaPage** prev = &memory_arena->free_pages;
+  for (struct MemoryArenaPage* page = memory_arena->free_pages; page != NULL; prev = &page->next, page = page->next) {
+    if (page->capacity >= size) {
+      *prev = page->next;
+      page->used = 0;
+      return page;
+    }
+  }
+
+  size_t capacity = MAX(size, memory_arena->page_size);
+  struct MemoryArenaPage* page = malloc(MEMORY_ARENA_PAGE_HEADER + capacity);
+  if (page == NULL)
+    return NULL;
+
+  page->next = NULL;
+  page->capacity = capacity;
+  page->used = 0;
+  memory_arena->bytes_reserved += capacity;
+  memory_arena->page_count++;
+
+  return page;
+}
+
+static inline void memory_arena_free_page_list(struct MemoryArenaPage* page) {
+  while (page != NULL) {
+    struct MemoryArenaPage* next = page->next;
+    free(page);
+    page = next;
+  }
+}
+
+void memory_arena_init(struct MemoryArena* memory_arena, size_t page_size) {
+  memory_arena->pages = NULL;
+  memory_arena->free_pages = NULL;
+  memory_arena->page_size = MEMORY_ARENA_ALIGN((page_size > 0) ? page_size : MEMORY_ARENA_DEFAULT_PAGE_SIZE);
+  memory_arena->bytes_used = 0;
+  memory_arena->bytes_reserved = 0;
+  memory_arena->page_count = 0;
+}
+
+void memory_arena_delete(struct MemoryArena* memory_arena) {
+  memory_arena_free_page_list(memory_arena->pages);
+  memory_arena_free_page_list(memory_arena->free_pages);
+  memory_arena->pages = NULL;
+  memory_arena->free_pages = NULL;
+  memory_arena->bytes_used = 0;
+  memory_arena->bytes_reserved = 0;
+  memory_arena->page_count = 0;
+}
+
+// Note: Keeps every page around so a rebuild of similar size never touches the allocator
+void memory_arena_reset(struct MemoryArena* memory_arena) {
+  struct MemoryArenaPage* page = memory_arena->pages;
+  while (page != NULL) {
+    struct MemoryArenaPage* next = page->next;
+    page->next = memory_arena->free_pages;
+    memory_arena->free_pages = page;
+    page = next;
+  }
+
+  memory_arena->pages = NULL;
+  memory_arena->bytes_used = 0;
+}
+
+// Returns zeroed memory aligned to MEMORY_ARENA_ALIGNMENT
+void* memory_arena_alloc(struct MemoryArena* memory_arena, size_t size) {
+  size = MEMORY_ARENA_ALIGN(size);
+
+  struct MemoryArenaPage* page = memory_arena->pages;
+  if (page == NULL || page->capacity - page->used < size) {
+    page = memory_arena_new_page(memory_arena, size);
+    if (page == NULL)
+      return NULL;
+
+    page->next = memory_arena->pages;
+    memory_arena->pages = page;
+  }
+
+  void* memory = (unsigned char*)page + MEMORY_ARENA_PAGE_HEADER + page->used;
+  page->used += size;
+  memory_arena->bytes_used += size;
+  memset(memory, 0, size);
+
+  return memory;
+}
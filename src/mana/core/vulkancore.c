@@ -28,6 +28,9 @@ int vulkan_core_init(struct VulkanState* vulkan_state, const char** graphics_lbr
   if ((vulkan_error_code = vulkan_core_create_command_pool(vulkan_state)) != VULKAN_CORE_SUCCESS)
     goto vulkan_command_pool_error;
 
+  vulkan_state->gpu_allocator = malloc(sizeof(struct GPUAllocator));
+  gpu_allocator_init(vulkan_state->gpu_allocator, vulkan_state->device, vulkan_state->physical_device);
+
   return vulkan_error_code;
 
 vulkan_command_pool_error:
@@ -43,6 +46,8 @@ vulkan_core_create_instance_cleanup:
 }
 
 void vulkan_core_delete(struct VulkanState* vulkan_state) {
+  gpu_allocator_delete(vulkan_state->gpu_allocator);
+  free(vulkan_state->gpu_allocator);
   vulkan_command_pool_cleanup(vulkan_state);
   vulkan_device_cleanup(vulkan_state);
   vulkan_debug_cleanup(vulkan_state);
@@ -219,24 +224,48 @@ static bool vulkan_core_device_can_render(struct VulkanState* vulkan_state, VkPh
     }
   }
 
-  free(queue_families);
-
-  if (!graphics_family_found)
+  if (!graphics_family_found) {
+    free(queue_families);
     return false;
+  }
+
+  // Note: Prefer a family with only transfer, usually the copy engine, then any without graphics. Compute families can always copy even when they don't report transfer
+  (&vulkan_state->indices)->transfer_family = (&vulkan_state->indices)->graphics_family;
+  for (int queue_family_num = 0; queue_family_num < queue_family_count; queue_family_num++) {
+    VkQueueFlags queue_flags = queue_families[queue_family_num].queueFlags;
+    if (queue_families[queue_family_num].queueCount == 0 || !(queue_flags & (VK_QUEUE_TRANSFER_BIT | VK_QUEUE_COMPUTE_BIT)) || (queue_flags & VK_QUEUE_GRAPHICS_BIT))
+      continue;
+
+    const bool transfer_only = !(queue_flags & VK_QUEUE_COMPUTE_BIT);
+    if (transfer_only || (&vulkan_state->indices)->transfer_family == (&vulkan_state->indices)->graphics_family)
+      (&vulkan_state->indices)->transfer_family = queue_family_num;
+    if (transfer_only)
+      break;
+  }
+
+  free(queue_families);
 
   return true;
 }
 
 static int vulkan_core_create_logical_device(struct VulkanState* vulkan_state) {
-  const uint32_t unique_queue_families[2] = {vulkan_state->indices.graphics_family, vulkan_state->indices.present_family};
-  const int unique_queue_family_count = (unique_queue_families[0] == unique_queue_families[1]) ? 1 : 2;
+  const uint32_t queue_families[3] = {vulkan_state->indices.graphics_family, vulkan_state->indices.present_family, vulkan_state->indices.transfer_family};
+  uint32_t unique_queue_families[3] = {0};
+  int unique_queue_family_count = 0;
+  for (int family_num = 0; family_num < 3; family_num++) {
+    bool family_found = false;
+    for (int unique_num = 0; unique_num < unique_queue_family_count; unique_num++)
+      family_found |= (unique_queue_families[unique_num] == queue_families[family_num]);
+    if (!family_found)
+      unique_queue_families[unique_queue_family_count++] = queue_families[family_num];
+  }
 
-  VkDeviceQueueCreateInfo queue_create_infos[2] = {0};
+  VkDeviceQueueCreateInfo queue_create_infos[3] = {0};
   float queue_priority = 1.0f;
   for (int queue_num = 0; queue_num < unique_queue_family_count; queue_num++) {
     VkDeviceQueueCreateInfo queue_create_info = {0};
     queue_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-    queue_create_info.queueFamilyIndex = queue_num;
+    queue_create_info.queueFamilyIndex = unique_queue_families[queue_num];
     queue_create_info.queueCount = 1;
     queue_create_info.pQueuePriorities = &queue_priority;
     queue_create_infos[queue_num] = queue_create_info;
@@ -267,6 +296,7 @@ static int vulkan_core_create_logical_device(struct VulkanState* vulkan_state) {
 
   vkGetDeviceQueue(vulkan_state->device, vulkan_state->indices.graphics_family, 0, &vulkan_state->graphics_queue);
   vkGetDeviceQueue(vulkan_state->device, vulkan_state->indices.present_family, 0, &vulkan_state->present_queue);
+  vkGetDeviceQueue(vulkan_state->device, vulkan_state->indices.transfer_family, 0, &vulkan_state->transfer_queue);
 
   return VULKAN_CORE_SUCCESS;
 }
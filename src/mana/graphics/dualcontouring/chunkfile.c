@@ -0,0 +1,185 @@
+#include "mana/graphics/dualcontouring/chunkfile.h"
+
+#ifdef IS_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static inline uint32_t chunk_file_data_offset(void) {
+  return ((sizeof(struct ChunkFileHeader) + CHUNK_FILE_DATA_ALIGNMENT - 1) / CHUNK_FILE_DATA_ALIGNMENT) * CHUNK_FILE_DATA_ALIGNMENT;
+}
+
+// Note: Position is the first member of every terrain vertex so the bounds are read with the vertex size as stride
+static inline void chunk_file_compute_bounds(struct Vector* vertices, float bounds_min[3], float bounds_max[3]) {
+  for (int axis = 0; axis < 3; axis++) {
+    bounds_min[axis] = vector_size(vertices) > 0 ? INFINITY : 0.0f;
+    bounds_max[axis] = vector_size(vertices) > 0 ? -INFINITY : 0.0f;
+  }
+
+  for (size_t vertex_num = 0; vertex_num < vector_size(vertices); vertex_num++) {
+    const float* position = (const float*)((const char*)vertices->items + (vertex_num * vertices->memory_size));
+    for (int axis = 0; axis < 3; axis++) {
+      bounds_min[axis] = MIN(bounds_min[axis], position[axis]);
+      bounds_max[axis] = MAX(bounds_max[axis], position[axis]);
+    }
+  }
+}
+
+int chunk_file_write(const char* path, struct ChunkFileParams* params, struct Mesh* mesh) {
+  struct ChunkFileHeader header = {0};
+  header.magic = CHUNK_FILE_MAGIC;
+  header.version = CHUNK_FILE_VERSION;
+  header.vertex_type = params->vertex_type;
+  header.vertex_size = mesh->vertices->memory_size;
+  header.index_size = mesh->indices->memory_size;
+  header.resolution = params->resolution;
+  header.noise_hash = params->noise_hash;
+  header.density_id = params->density_id;
+  header.threshold = params->threshold;
+  chunk_file_compute_bounds(mesh->vertices, header.bounds_min, header.bounds_max);
+  header.data_offset = chunk_file_data_offset();
+  header.vertex_count = vector_size(mesh->vertices);
+  header.index_count = vector_size(mesh->indices);
+
+  FILE* fp = fopen(path, "wb");
+  if (fp == NULL)
+    return CHUNK_FILE_OPEN_ERROR;
+
+  const char padding[CHUNK_FILE_DATA_ALIGNMENT] = {0};
+  const size_t padding_size = header.data_offset - sizeof(struct ChunkFileHeader);
+  const size_t vertex_bytes = header.vertex_count * header.vertex_size;
+  const size_t index_bytes = header.index_count * header.index_size;
+  bool written = fwrite(&header, sizeof(struct ChunkFileHeader), 1, fp) == 1;
+  written = written && (padding_size == 0 || fwrite(padding, padding_size, 1, fp) == 1);
+  written = written && (vertex_bytes == 0 || fwrite(mesh->vertices->items, vertex_bytes, 1, fp) == 1);
+  written = written && (index_bytes == 0 || fwrite(mesh->indices->items, index_bytes, 1, fp) == 1);
+  written = (fclose(fp) == 0) && written;
+
+  // Note: A partial file would only be rejected on load anyway, removing it just saves the failed open next time
+  if (!written) {
+    remove(path);
+    return CHUNK_FILE_WRITE_ERROR;
+  }
+
+  return CHUNK_FILE_SUCCESS;
+}
+
+static inline int chunk_file_map(struct ChunkFile* chunk_file, const char* path) {
+#ifdef IS_WINDOWS
+  chunk_file->file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (chunk_file->file_handle == INVALID_HANDLE_VALUE)
+    return CHUNK_FILE_OPEN_ERROR;
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(chunk_file->file_handle, &file_size) || file_size.QuadPart < (LONGLONG)sizeof(struct ChunkFileHeader)) {
+    CloseHandle(chunk_file->file_handle);
+    return CHUNK_FILE_FORMAT_ERROR;
+  }
+  chunk_file->size = (size_t)file_size.QuadPart;
+
+  chunk_file->mapping_handle = CreateFileMappingA(chunk_file->file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+  chunk_file->data = chunk_file->mapping_handle != NULL ? MapViewOfFile(chunk_file->mapping_handle, FILE_MAP_READ, 0, 0, 0) : NULL;
+  if (chunk_file->data == NULL) {
+    if (chunk_file->mapping_handle != NULL)
+      CloseHandle(chunk_file->mapping_handle);
+    CloseHandle(chunk_file->file_handle);
+    return CHUNK_FILE_MAP_ERROR;
+  }
+#else
+  const int file_descriptor = open(path, O_RDONLY);
+  if (file_descriptor == -1)
+    return CHUNK_FILE_OPEN_ERROR;
+
+  struct stat file_stat;
+  if (fstat(file_descriptor, &file_stat) == -1 || file_stat.st_size < (off_t)sizeof(struct ChunkFileHeader)) {
+    close(file_descriptor);
+    return CHUNK_FILE_FORMAT_ERROR;
+  }
+  chunk_file->size = (size_t)file_stat.st_size;
+
+  // Note: The mapping holds its own reference to the file so the descriptor can go straight away
+  chunk_file->data = mmap(NULL, chunk_file->size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  close(file_descriptor);
+  if (chunk_file->data == MAP_FAILED) {
+    chunk_file->data = NULL;
+    return CHUNK_FILE_MAP_ERROR;
+  }
+  madvise(chunk_file->data, chunk_file->size, MADV_SEQUENTIAL);
+#endif
+
+  return CHUNK_FILE_SUCCESS;
+}
+
+// Note: Mesh is only used to check the vertex layout the caller expects, nothing is read into it. Indices can be 16 or 32 bit whatever the mesh holds
+int chunk_file_open(struct ChunkFile* chunk_file, const char* path, struct ChunkFileParams* params, struct Mesh* mesh) {
+  memset(chunk_file, 0, sizeof(struct ChunkFile));
+  const int map_error = chunk_file_map(chunk_file, path);
+  if (map_error != CHUNK_FILE_SUCCESS)
+    return map_error;
+
+  const struct ChunkFileHeader* header = chunk_file->data;
+  int open_error = CHUNK_FILE_SUCCESS;
+  if (header->magic != CHUNK_FILE_MAGIC || header->version != CHUNK_FILE_VERSION || header->vertex_size != mesh->vertices->memory_size || (header->index_size != sizeof(uint16_t) && header->index_size != sizeof(uint32_t)) || header->data_offset < sizeof(struct ChunkFileHeader))
+    open_error = CHUNK_FILE_FORMAT_ERROR;
+  else if (chunk_file->size != header->data_offset + (header->vertex_count * header->vertex_size) + (header->index_count * header->index_size))
+    open_error = CHUNK_FILE_FORMAT_ERROR;
+  else if (header->vertex_type != (uint32_t)params->vertex_type || header->noise_hash != params->noise_hash || header->density_id != params->density_id || header->resolution != params->resolution || header->threshold != params->threshold)
+    open_error = CHUNK_FILE_MISMATCH_ERROR;
+
+  if (open_error != CHUNK_FILE_SUCCESS) {
+    chunk_file_close(chunk_file);
+    return open_error;
+  }
+
+  chunk_file->header = header;
+  chunk_file->vertices = (const char*)chunk_file->data + header->data_offset;
+  chunk_file->indices = (const char*)chunk_file->vertices + (header->vertex_count * header->vertex_size);
+  return CHUNK_FILE_SUCCESS;
+}
+
+void chunk_file_close(struct ChunkFile* chunk_file) {
+  if (chunk_file->data == NULL)
+    return;
+
+#ifdef IS_WINDOWS
+  UnmapViewOfFile(chunk_file->data);
+  CloseHandle(chunk_file->mapping_handle);
+  CloseHandle(chunk_file->file_handle);
+#else
+  munmap(chunk_file->data, chunk_file->size);
+#endif
+  memset(chunk_file, 0, sizeof(struct ChunkFile));
+}
+
+// Note: The mesh keeps a copy since recreating the swap chain uploads it again, the copy is a single memcpy per array straight out of the page cache
+int chunk_file_load_mesh(const char* path, struct ChunkFileParams* params, struct Mesh* mesh) {
+  struct ChunkFile chunk_file;
+  const int open_error = chunk_file_open(&chunk_file, path, params, mesh);
+  if (open_error != CHUNK_FILE_SUCCESS)
+    return open_error;
+
+  const size_t vertex_count = chunk_file.header->vertex_count;
+  const size_t index_count = chunk_file.header->index_count;
+  vector_clear(mesh->vertices);
+  vector_clear(mesh->indices);
+  if (mesh->indices->memory_size != chunk_file.header->index_size) {
+    vector_delete(mesh->indices);
+    vector_init(mesh->indices, chunk_file.header->index_size);
+  }
+  if (vertex_count > 0) {
+    vector_resize(mesh->vertices, vertex_count);
+    memcpy(mesh->vertices->items, chunk_file.vertices, vertex_count * mesh->vertices->memory_size);
+    mesh->vertices->size = vertex_count;
+  }
+  if (index_count > 0) {
+    vector_resize(mesh->indices, index_count);
+    memcpy(mesh->indices->items, chunk_file.indices, index_count * mesh->indices->memory_size);
+    mesh->indices->size = index_count;
+  }
+
+  chunk_file_close(&chunk_file);
+  return CHUNK_FILE_SUCCESS;
+}
@@ -0,0 +1,191 @@
+#include "mana/graphics/dualcontouring/chunkmanager.h"
+
+// Note: Nearest ring keeps every leaf, further rings collapse more as each cell covers more of the world
+static const float LOD_THRESHOLDS[CHUNK_MANAGER_MAX_LOD + 1] = {-1.0f, 0.1f, 1.0f, 10.0f};
+
+static inline int chunk_manager_wrap(int value, int width) {
+  const int wrapped = value % width;
+  return wrapped < 0 ? wrapped + width : wrapped;
+}
+
+static inline struct Chunk* chunk_manager_get_slot(struct ChunkManager* chunk_manager, ivec3 coord) {
+  const int slot_width = chunk_manager->slot_width;
+  const int x = chunk_manager_wrap(coord.x, slot_width);
+  const int y = chunk_manager_wrap(coord.y, slot_width);
+  const int z = chunk_manager_wrap(coord.z, slot_width);
+  return &chunk_manager->chunks[x + (slot_width * (y + (slot_width * z)))];
+}
+
+static inline int chunk_manager_distance(ivec3 a, ivec3 b) {
+  return MAX(abs(a.x - b.x), MAX(abs(a.y - b.y), abs(a.z - b.z)));
+}
+
+static inline int chunk_manager_get_lod(int distance) {
+  return MIN(distance / CHUNK_MANAGER_RING_WIDTH, CHUNK_MANAGER_MAX_LOD);
+}
+
+// Note: Frames in flight may still be drawing the chunk, its buffers go to the upload manager and its descriptor set waits on the same frame count
+static inline void chunk_manager_release_chunk(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api, struct Chunk* chunk) {
+  struct DualContouring* dual_contouring = &chunk->dual_contouring;
+  if (!chunk->empty) {
+    struct ChunkRetiredDescriptorSet retired = {.descriptor_set = dual_contouring->descriptor_set, .frame = gpu_api->vulkan_state->upload_manager->frame_count};
+    vector_push_back(&chunk_manager->retired_descriptor_sets, &retired);
+  }
+
+  upload_manager_retire_buffer(gpu_api->vulkan_state->upload_manager, dual_contouring->index_buffer, &dual_contouring->index_buffer_memory);
+  upload_manager_retire_buffer(gpu_api->vulkan_state->upload_manager, dual_contouring->vertex_buffer, &dual_contouring->vertex_buffer_memory);
+  dual_contouring->index_buffer = VK_NULL_HANDLE;
+  dual_contouring->vertex_buffer = VK_NULL_HANDLE;
+
+  dual_contouring_delete(dual_contouring, gpu_api);
+  chunk->active = false;
+}
+
+// Note: Retired in frame order so the expired ones are always at the front
+static inline void chunk_manager_free_retired_descriptor_sets(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api) {
+  const uint64_t frame_count = gpu_api->vulkan_state->upload_manager->frame_count;
+  int expired = 0;
+  while (expired < vector_size(&chunk_manager->retired_descriptor_sets)) {
+    struct ChunkRetiredDescriptorSet* retired = (struct ChunkRetiredDescriptorSet*)vector_get(&chunk_manager->retired_descriptor_sets, expired);
+    if (retired->frame + MAX_FRAMES_IN_FLIGHT > frame_count)
+      break;
+
+    vkFreeDescriptorSets(gpu_api->vulkan_state->device, chunk_manager->shader->descriptor_pool, 1, &retired->descriptor_set);
+    expired++;
+  }
+
+  for (int retired_num = 0; retired_num < expired; retired_num++)
+    vector_remove(&chunk_manager->retired_descriptor_sets, 0);
+}
+
+static inline void chunk_manager_build_chunk(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api, struct Chunk* chunk, ivec3 coord, int lod) {
+  const int resolution = CHUNK_MANAGER_RESOLUTION >> lod;
+
+  struct DualContouring* dual_contouring = &chunk->dual_contouring;
+  dual_contouring_setup(dual_contouring, resolution, chunk_manager->shader, chunk_manager->noises, chunk_manager->density_func_single, chunk_manager->density_func_set, chunk_manager->density_func_batch);
+  dual_contouring->is_chunk = true;
+  dual_contouring->sample_scale = chunk_manager->chunk_size / (float)resolution;
+  dual_contouring->sample_offset = (vec3){.x = coord.x * chunk_manager->chunk_size, .y = coord.y * chunk_manager->chunk_size, .z = coord.z * chunk_manager->chunk_size};
+  dual_contouring->simplify_threshold = LOD_THRESHOLDS[lod];
+  dual_contouring->density_cache = &chunk_manager->density_cache;
+  dual_contouring_build(dual_contouring);
+  dual_contouring_release_build_data(dual_contouring);
+
+  chunk->active = true;
+  chunk->coord = coord;
+  chunk->lod = lod;
+  // Note: Most chunks are all air or all rock, those never touch the GPU
+  chunk->empty = vector_size(dual_contouring->mesh->indices) == 0;
+  // Note: Without a descriptor set the chunk is skipped like an empty one until its ring changes
+  if (!chunk->empty && dual_contouring_upload(dual_contouring, gpu_api) != 0)
+    chunk->empty = true;
+}
+
+void chunk_manager_init(struct ChunkManager* chunk_manager, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int)) {
+  chunk_manager->view_distance = CHUNK_MANAGER_VIEW_DISTANCE;
+  chunk_manager->slot_width = (CHUNK_MANAGER_VIEW_DISTANCE * 2) + 1;
+  chunk_manager->chunk_size = CHUNK_MANAGER_CHUNK_SIZE;
+  chunk_manager->position = position;
+  chunk_manager->shader = shader;
+  chunk_manager->noises = noises;
+  chunk_manager->density_func_single = density_func_single;
+  chunk_manager->density_func_set = density_func_set;
+  chunk_manager->density_func_batch = density_func_batch;
+
+  chunk_manager->chunks = calloc(CHUNK_MANAGER_SLOT_COUNT, sizeof(struct Chunk));
+  vector_init(&chunk_manager->retired_descriptor_sets, sizeof(struct ChunkRetiredDescriptorSet));
+  density_cache_init(&chunk_manager->density_cache, DENSITY_CACHE_DEFAULT_BUDGET);
+}
+
+// Note: Descriptor sets are left to the shader's pool since it may already be gone at shutdown
+void chunk_manager_delete(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api) {
+  const int slot_count = chunk_manager->slot_width * chunk_manager->slot_width * chunk_manager->slot_width;
+  for (int slot_num = 0; slot_num < slot_count; slot_num++) {
+    struct Chunk* chunk = &chunk_manager->chunks[slot_num];
+    if (chunk->active)
+      dual_contouring_delete(&chunk->dual_contouring, gpu_api);
+  }
+
+  free(chunk_manager->chunks);
+  vector_delete(&chunk_manager->retired_descriptor_sets);
+  density_cache_delete(&chunk_manager->density_cache);
+}
+
+void chunk_manager_update(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api, struct Camera* camera) {
+  const vec3 local_camera = vec3_sub(camera->position, chunk_manager->position);
+  const ivec3 center = (ivec3){.x = (int)floorf(local_camera.x / chunk_manager->chunk_size), .y = (int)floorf(local_camera.y / chunk_manager->chunk_size), .z = (int)floorf(local_camera.z / chunk_manager->chunk_size)};
+  const int view_distance = chunk_manager->view_distance;
+  const int slot_count = chunk_manager->slot_width * chunk_manager->slot_width * chunk_manager->slot_width;
+
+  chunk_manager_free_retired_descriptor_sets(chunk_manager, gpu_api);
+
+  for (int slot_num = 0; slot_num < slot_count; slot_num++) {
+    struct Chunk* chunk = &chunk_manager->chunks[slot_num];
+    if (!chunk->active || chunk_manager_distance(chunk->coord, center) <= view_distance)
+      continue;
+
+    chunk_manager_release_chunk(chunk_manager, gpu_api, chunk);
+  }
+
+  // Note: Rings are walked from the camera outwards so the build budget always goes to the nearest missing or stale chunks first
+  int builds = 0;
+  for (int distance = 0; distance <= view_distance && builds < CHUNK_MANAGER_BUILDS_PER_UPDATE; distance++) {
+    const int lod = chunk_manager_get_lod(distance);
+    for (int z = -distance; z <= distance && builds < CHUNK_MANAGER_BUILDS_PER_UPDATE; z++) {
+      for (int y = -distance; y <= distance && builds < CHUNK_MANAGER_BUILDS_PER_UPDATE; y++) {
+        for (int x = -distance; x <= distance && builds < CHUNK_MANAGER_BUILDS_PER_UPDATE; x++) {
+          if (MAX(abs(x), MAX(abs(y), abs(z))) != distance)
+            continue;
+
+          const ivec3 coord = (ivec3){.x = center.x + x, .y = center.y + y, .z = center.z + z};
+          struct Chunk* chunk = chunk_manager_get_slot(chunk_manager, coord);
+          if (chunk->active && chunk->lod == lod)
+            continue;
+
+          // Note: A chunk changing ring is rebuilt on the side and swapped in so it never drops out for a frame
+          struct Chunk rebuilt = {0};
+          chunk_manager_build_chunk(chunk_manager, gpu_api, &rebuilt, coord, lod);
+          if (chunk->active)
+            chunk_manager_release_chunk(chunk_manager, gpu_api, chunk);
+          *chunk = rebuilt;
+          builds++;
+        }
+      }
+    }
+  }
+}
+
+// Note: Chunks outside the frustum or facing entirely away from the camera are never recorded
+void chunk_manager_render(struct ChunkManager* chunk_manager, struct GPUAPI* gpu_api) {
+  struct Frustum frustum;
+  frustum_init(&frustum, gpu_api->vulkan_state->gbuffer->projection_matrix, gpu_api->vulkan_state->gbuffer->view_matrix);
+  memset(&chunk_manager->culling_stats, 0, sizeof(struct CullingStats));
+
+  const int slot_count = chunk_manager->slot_width * chunk_manager->slot_width * chunk_manager->slot_width;
+  for (int slot_num = 0; slot_num < slot_count; slot_num++) {
+    struct Chunk* chunk = &chunk_manager->chunks[slot_num];
+    if (!chunk->active || chunk->empty || uniform_ring_offsets_full(chunk->dual_contouring.uniform_offsets, DUAL_CONTOURING_DYNAMIC_UNIFORMS))
+      continue;
+
+    if (!culling_test_bounds(&frustum, &chunk->dual_contouring.bounds, chunk_manager_get_chunk_model(chunk_manager, chunk), &chunk_manager->culling_stats))
+      continue;
+
+    struct DualContouring* dual_contouring = &chunk->dual_contouring;
+    VkBuffer vertex_buffers[] = {dual_contouring->vertex_buffer};
+    VkDeviceSize offsets[] = {0};
+    vkCmdBindVertexBuffers(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, 0, 1, vertex_buffers, offsets);
+    vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, dual_contouring->index_buffer, 0, mesh_get_index_type(dual_contouring->mesh));
+    vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, chunk_manager->shader->pipeline_layout, 0, 1, &dual_contouring->descriptor_set, DUAL_CONTOURING_DYNAMIC_UNIFORMS, dual_contouring->uniform_offsets);
+    vkCmdDrawIndexed(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, dual_contouring->mesh->indices->size, 1, 0, 0, 0);
+  }
+}
+
+// Note: Octree vertices sit in [-size / 2, size / 2] grid units while the chunk was sampled from its corner
+mat4 chunk_manager_get_chunk_model(struct ChunkManager* chunk_manager, struct Chunk* chunk) {
+  struct DualContouring* dual_contouring = &chunk->dual_contouring;
+  const float half_extent = (dual_contouring->octree_size / 2) * dual_contouring->sample_scale;
+  const vec3 translation = (vec3){.x = chunk_manager->position.x + dual_contouring->sample_offset.x + half_extent, .y = chunk_manager->position.y + dual_contouring->sample_offset.y + half_extent, .z = chunk_manager->position.z + dual_contouring->sample_offset.z + half_extent};
+
+  mat4 model = mat4_translate(MAT4_IDENTITY, translation);
+  return mat4_scale(model, (vec3){.x = dual_contouring->sample_scale, .y = dual_contouring->sample_scale, .z = dual_contouring->sample_scale});
+}
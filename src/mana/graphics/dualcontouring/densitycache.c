@@ -0,0 +1,209 @@
+#include "mana/graphics/dualcontouring/densitycache.h"
+
+void density_cache_init(struct DensityCache* density_cache, size_t budget) {
+  memset(density_cache, 0, sizeof(struct DensityCache));
+  vector_init(&density_cache->entries, sizeof(struct DensityCacheEntry));
+  density_cache->budget = budget;
+  mtx_init(&density_cache->mutex, mtx_plain);
+}
+
+static inline void density_cache_free_entry(struct DensityCacheEntry* entry) {
+  if (entry->noise_allocated)
+    noise_free(entry->density);
+  else
+    free(entry->density);
+}
+
+// Note: Fields still referenced are freed too, owners are expected to be gone by now
+void density_cache_delete(struct DensityCache* density_cache) {
+  for (int entry_num = 0; entry_num < vector_size(&density_cache->entries); entry_num++)
+    density_cache_free_entry(vector_get(&density_cache->entries, entry_num));
+
+  vector_delete(&density_cache->entries);
+  mtx_destroy(&density_cache->mutex);
+}
+
+// FNV-1a
+uint64_t density_cache_hash_bytes(uint64_t hash, const void* bytes, size_t size) {
+  const unsigned char* data = bytes;
+  for (size_t byte_num = 0; byte_num < size; byte_num++) {
+    hash ^= data[byte_num];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+// Note: -0.0f and 0.0f sample the same field so they hash the same
+static inline uint64_t density_cache_hash_float(uint64_t hash, float value) {
+  if (value == 0.0f)
+    value = 0.0f;
+  return density_cache_hash_bytes(hash, &value, sizeof(value));
+}
+
+// Note: Only the fields that change the samples are hashed one by one, hashing the whole struct would read padding and runtime state like parallel. skip_step is for callers whose key step is the noise step itself, so the same noise sampled at two resolutions hashes the same and one can be downsampled into the other
+uint64_t density_cache_hash_noises(struct Vector* noises, bool skip_step) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (int noise_num = 0; noises != NULL && noise_num < vector_size(noises); noise_num++) {
+    struct Noise* noise = vector_get(noises, noise_num);
+    const int noise_type = (int)noise->noise_type;
+    hash = density_cache_hash_bytes(hash, &noise_type, sizeof(noise_type));
+    switch (noise->noise_type) {
+      case (RIDGED_FRACTAL_NOISE): {
+        struct RidgedFractalNoise* ridged_fractal_noise = &noise->ridged_fractal_noise;
+        const int seed = ridged_fractal_noise->seed;
+        const int octave_count = ridged_fractal_noise->octave_count;
+        hash = density_cache_hash_bytes(hash, &seed, sizeof(seed));
+        hash = density_cache_hash_bytes(hash, &octave_count, sizeof(octave_count));
+        hash = density_cache_hash_float(hash, ridged_fractal_noise->frequency);
+        hash = density_cache_hash_float(hash, ridged_fractal_noise->lacunarity);
+        for (int axis = 0; axis < 3; axis++)
+          hash = density_cache_hash_float(hash, ridged_fractal_noise->position[axis]);
+        if (!skip_step)
+          hash = density_cache_hash_float(hash, ridged_fractal_noise->step);
+        break;
+      }
+    }
+  }
+
+  return hash;
+}
+
+static inline bool density_cache_key_equal(struct DensityCacheKey* a, struct DensityCacheKey* b) {
+  return a->noise_hash == b->noise_hash && a->samples == b->samples && a->step == b->step && a->origin.x == b->origin.x && a->origin.y == b->origin.y && a->origin.z == b->origin.z;
+}
+
+static inline struct DensityCacheEntry* density_cache_find(struct DensityCache* density_cache, struct DensityCacheKey* key) {
+  for (int entry_num = 0; entry_num < vector_size(&density_cache->entries); entry_num++) {
+    struct DensityCacheEntry* entry = vector_get(&density_cache->entries, entry_num);
+    if (density_cache_key_equal(&entry->key, key))
+      return entry;
+  }
+
+  return NULL;
+}
+
+// Note: A finer field covering the same volume from the same origin, every factor-th sample of it is exactly the coarser field. The smallest factor wins since it's the least to read
+static inline struct DensityCacheEntry* density_cache_find_finer(struct DensityCache* density_cache, struct DensityCacheKey* key, int* factor) {
+  struct DensityCacheEntry* finer = NULL;
+  for (int entry_num = 0; entry_num < vector_size(&density_cache->entries); entry_num++) {
+    struct DensityCacheEntry* entry = vector_get(&density_cache->entries, entry_num);
+    if (entry->key.noise_hash != key->noise_hash || entry->key.origin.x != key->origin.x || entry->key.origin.y != key->origin.y || entry->key.origin.z != key->origin.z)
+      continue;
+    if (key->samples < 2 || entry->key.samples <= key->samples || (entry->key.samples - 1) % (key->samples - 1) != 0)
+      continue;
+
+    const int entry_factor = (entry->key.samples - 1) / (key->samples - 1);
+    if (fabsf((entry->key.step * entry_factor) - key->step) > key->step * 1e-6f)
+      continue;
+
+    if (finer == NULL || entry_factor < *factor) {
+      finer = entry;
+      *factor = entry_factor;
+    }
+  }
+
+  return finer;
+}
+
+// Note: Drops unreferenced fields oldest first until the cache fits its budget again, referenced ones can hold it over budget for a while
+static inline void density_cache_evict(struct DensityCache* density_cache) {
+  while (density_cache->bytes_used > density_cache->budget) {
+    int oldest_num = -1;
+    uint64_t oldest_used = UINT64_MAX;
+    for (int entry_num = 0; entry_num < vector_size(&density_cache->entries); entry_num++) {
+      struct DensityCacheEntry* entry = vector_get(&density_cache->entries, entry_num);
+      if (entry->references == 0 && entry->last_used < oldest_used) {
+        oldest_num = entry_num;
+        oldest_used = entry->last_used;
+      }
+    }
+
+    if (oldest_num == -1)
+      return;
+
+    struct DensityCacheEntry* oldest = vector_get(&density_cache->entries, oldest_num);
+    density_cache->bytes_used -= oldest->bytes;
+    density_cache_free_entry(oldest);
+    vector_remove(&density_cache->entries, oldest_num);
+  }
+}
+
+// Note: Returns the field with a reference held or NULL on a miss, in which case the caller samples it and hands it to density_cache_insert. The field is shared so it must not be written to
+float* density_cache_acquire(struct DensityCache* density_cache, struct DensityCacheKey key) {
+  mtx_lock(&density_cache->mutex);
+  struct DensityCacheEntry* entry = density_cache_find(density_cache, &key);
+  if (entry != NULL) {
+    entry->references++;
+    entry->last_used = ++density_cache->clock;
+    density_cache->hits++;
+    mtx_unlock(&density_cache->mutex);
+    return entry->density;
+  }
+
+  int factor = 0;
+  struct DensityCacheEntry* finer = density_cache_find_finer(density_cache, &key, &factor);
+  if (finer == NULL) {
+    density_cache->misses++;
+    mtx_unlock(&density_cache->mutex);
+    return NULL;
+  }
+
+  finer->references++;
+  finer->last_used = ++density_cache->clock;
+  density_cache->downsamples++;
+  const float* finer_density = finer->density;
+  const int finer_samples = finer->key.samples;
+  mtx_unlock(&density_cache->mutex);
+
+  const int samples = key.samples;
+  float* density = malloc(sizeof(float) * samples * samples * samples);
+  for (int z = 0; z < samples; z++) {
+    for (int y = 0; y < samples; y++) {
+      const float* finer_row = &finer_density[finer_samples * ((y * factor) + (finer_samples * (z * factor)))];
+      float* row = &density[samples * (y + (samples * z))];
+      for (int x = 0; x < samples; x++)
+        row[x] = finer_row[x * factor];
+    }
+  }
+
+  density_cache_release(density_cache, (float*)finer_density);
+  return density_cache_insert(density_cache, key, density, false);
+}
+
+// Note: Takes ownership of density and returns the cached field with a reference held, if another thread got the same key in first its field is returned and this one freed
+float* density_cache_insert(struct DensityCache* density_cache, struct DensityCacheKey key, float* density, bool noise_allocated) {
+  struct DensityCacheEntry new_entry = {.key = key, .density = density, .bytes = sizeof(float) * key.samples * key.samples * key.samples, .references = 1, .noise_allocated = noise_allocated};
+
+  mtx_lock(&density_cache->mutex);
+  struct DensityCacheEntry* entry = density_cache_find(density_cache, &key);
+  if (entry != NULL) {
+    entry->references++;
+    entry->last_used = ++density_cache->clock;
+    density = entry->density;
+    mtx_unlock(&density_cache->mutex);
+    density_cache_free_entry(&new_entry);
+    return density;
+  }
+
+  new_entry.last_used = ++density_cache->clock;
+  vector_push_back(&density_cache->entries, &new_entry);
+  density_cache->bytes_used += new_entry.bytes;
+  density_cache_evict(density_cache);
+  mtx_unlock(&density_cache->mutex);
+  return density;
+}
+
+void density_cache_release(struct DensityCache* density_cache, float* density) {
+  mtx_lock(&density_cache->mutex);
+  for (int entry_num = 0; entry_num < vector_size(&density_cache->entries); entry_num++) {
+    struct DensityCacheEntry* entry = vector_get(&density_cache->entries, entry_num);
+    if (entry->density == density) {
+      entry->references--;
+      break;
+    }
+  }
+
+  density_cache_evict(density_cache);
+  mtx_unlock(&density_cache->mutex);
+}
@@ -2,76 +2,261 @@
 
 #define MAX_THRESHOLDS 5
 
-int dual_contouring_init(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api, int octree_size, struct Shader* shader, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int)) {
+static const float THRESHOLDS[MAX_THRESHOLDS] = {-1.0f, 0.1f, 1.0f, 10.0f, 50.0f};
+
+void dual_contouring_setup(struct DualContouring* dual_contouring, int octree_size, struct Shader* shader, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int)) {
+  memset(dual_contouring, 0, sizeof(struct DualContouring));
   dual_contouring->noises = noises;
   dual_contouring->density_func_single = density_func_single;
   dual_contouring->density_func_set = density_func_set;
+  dual_contouring->density_func_batch = density_func_batch;
+  dual_contouring->density_id = (density_func_single == dual_contouring_density_ridged_sum_single) ? CHUNK_FILE_DENSITY_RIDGED_SUM : CHUNK_FILE_DENSITY_UNNAMED;
+  // Note: The AVX2 batch only agrees with the ridged sum, anything else would mesh different crossings than its own single sample function
+  if (density_func_batch == dual_contouring_density_ridged_sum_batch_avx2 && density_func_single != dual_contouring_density_ridged_sum_single) {
+    fprintf(stderr, "dual_contouring_density_ridged_sum_batch_avx2 needs dual_contouring_density_ridged_sum_single, falling back to single samples!\n");
+    dual_contouring->density_func_batch = NULL;
+  }
   dual_contouring->shader = shader;
+  dual_contouring->crossing_mode = CROSSING_STEP_SEARCH;
+  dual_contouring->crossing_iterations = DUAL_CONTOURING_CROSSING_ITERATIONS;
+  dual_contouring->sample_offset = VEC3_ZERO;
+  dual_contouring->sample_scale = 1.0f;
 
   dual_contouring->mesh = calloc(1, sizeof(struct Mesh));
   mesh_dual_contouring_init(dual_contouring->mesh);
 
-  dual_contouring->noise_set = density_func_set(noises, 0.0f, 0.0f, 0.0f, octree_size, octree_size, octree_size);
-
-  const float THRESHOLDS[MAX_THRESHOLDS] = {-1.0f, 0.1f, 1.0f, 10.0f, 50.0f};
-  int threshold_index = -1;
-  threshold_index = (threshold_index + 1) % MAX_THRESHOLDS;
+  dual_contouring->simplify_threshold = THRESHOLDS[DUAL_CONTOURING_THRESHOLD_INDEX % MAX_THRESHOLDS];
   dual_contouring->octree_size = octree_size;
-  dual_contouring->head = octree_build_octree((ivec3){.data[0] = -dual_contouring->octree_size / 2, .data[1] = -dual_contouring->octree_size / 2, .data[2] = -dual_contouring->octree_size / 2}, dual_contouring->octree_size, THRESHOLDS[threshold_index], dual_contouring);
-  octree_generate_mesh_from_octree(dual_contouring->head, dual_contouring);
+  octree_arenas_init(dual_contouring);
+}
+
+// Note: The density callbacks are part of the key too since the same noises can be turned into density in different ways
+static inline struct DensityCacheKey dual_contouring_density_key(struct DualContouring* dual_contouring) {
+  uint64_t noise_hash = density_cache_hash_noises(dual_contouring->noises, false);
+  const uintptr_t density_funcs[3] = {(uintptr_t)dual_contouring->density_func_single, (uintptr_t)dual_contouring->density_func_set, (uintptr_t)dual_contouring->density_func_batch};
+  noise_hash = density_cache_hash_bytes(noise_hash, density_funcs, sizeof(density_funcs));
+  noise_hash = density_cache_hash_bytes(noise_hash, &dual_contouring->is_chunk, sizeof(dual_contouring->is_chunk));
+  if (!dual_contouring->is_chunk)
+    return (struct DensityCacheKey){.noise_hash = noise_hash, .origin = VEC3_ZERO, .step = 1.0f, .samples = dual_contouring_noise_set_size(dual_contouring)};
+
+  return (struct DensityCacheKey){.noise_hash = noise_hash, .origin = dual_contouring->sample_offset, .step = dual_contouring->sample_scale, .samples = dual_contouring_noise_set_size(dual_contouring)};
+}
+
+// Note: Chunk sets are filled a z slice at a time through the batch path since density_func_set only knows unit spacing
+static inline void dual_contouring_sample_noise_set(struct DualContouring* dual_contouring) {
+  if (!dual_contouring->is_chunk) {
+    dual_contouring->noise_set = dual_contouring->density_func_set(dual_contouring->noises, 0.0f, 0.0f, 0.0f, dual_contouring->octree_size, dual_contouring->octree_size, dual_contouring->octree_size);
+    return;
+  }
+
+  const int noise_set_size = dual_contouring_noise_set_size(dual_contouring);
+  const int slice_size = noise_set_size * noise_set_size;
+  dual_contouring->noise_set = malloc(sizeof(float) * slice_size * noise_set_size);
+  float(*positions)[3] = malloc(sizeof(float) * 3 * slice_size);
+  for (int z = 0; z < noise_set_size; z++) {
+    for (int y = 0; y < noise_set_size; y++) {
+      for (int x = 0; x < noise_set_size; x++) {
+        float* position = positions[x + (y * noise_set_size)];
+        position[0] = (float)x;
+        position[1] = (float)y;
+        position[2] = (float)z;
+      }
+    }
+
+    dual_contouring_density_batch(dual_contouring, positions, dual_contouring->noise_set + (z * slice_size), slice_size);
+  }
+  free(positions);
+}
+
+// Note: Kept out of the density cache so a cached set can still be downsampled for a coarser chunk, it's only 3 faces
+static inline void dual_contouring_sample_seam_set(struct DualContouring* dual_contouring) {
+  const int seam_size = dual_contouring_noise_set_size(dual_contouring) + 1;
+  const int slice_size = seam_size * seam_size;
+  dual_contouring->seam_set = malloc(sizeof(float) * slice_size * 3);
+  float(*positions)[3] = malloc(sizeof(float) * 3 * slice_size);
+  for (int axis = 0; axis < 3; axis++) {
+    for (int j = 0; j < seam_size; j++) {
+      for (int i = 0; i < seam_size; i++) {
+        float* position = positions[i + (j * seam_size)];
+        position[axis] = (float)(seam_size - 1);
+        position[axis == 0 ? 1 : 0] = (float)i;
+        position[axis == 2 ? 1 : 2] = (float)j;
+      }
+    }
+
+    dual_contouring_density_batch(dual_contouring, positions, dual_contouring->seam_set + (axis * slice_size), slice_size);
+  }
+  free(positions);
+}
+
+static inline void dual_contouring_generate_noise_set(struct DualContouring* dual_contouring) {
+  if (dual_contouring->is_chunk)
+    dual_contouring_sample_seam_set(dual_contouring);
 
-  graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, dual_contouring->mesh->vertices, &dual_contouring->vertex_buffer, &dual_contouring->vertex_buffer_memory);
-  graphics_utils_setup_index_buffer(gpu_api->vulkan_state, dual_contouring->mesh->indices, &dual_contouring->index_buffer, &dual_contouring->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct DualContouringUniformBufferObject), &dual_contouring->dc_uniform_buffer, &dual_contouring->dc_uniform_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct LightingUniformBufferObject), &dual_contouring->lighting_uniform_buffer, &dual_contouring->lighting_uniform_buffer_memory);
-  graphics_utils_setup_descriptor(gpu_api->vulkan_state, dual_contouring->shader->descriptor_set_layout, dual_contouring->shader->descriptor_pool, &dual_contouring->descriptor_set);
+  if (dual_contouring->density_cache == NULL) {
+    dual_contouring_sample_noise_set(dual_contouring);
+    return;
+  }
 
-  VkWriteDescriptorSet dcs[2] = {0};
+  const struct DensityCacheKey key = dual_contouring_density_key(dual_contouring);
+  dual_contouring->noise_set = density_cache_acquire(dual_contouring->density_cache, key);
+  if (dual_contouring->noise_set != NULL)
+    return;
 
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct DualContouringUniformBufferObject), &dual_contouring->dc_uniform_buffer)});
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 1, &dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct LightingUniformBufferObject), &dual_contouring->lighting_uniform_buffer)});
+  dual_contouring_sample_noise_set(dual_contouring);
+  dual_contouring->noise_set = density_cache_insert(dual_contouring->density_cache, key, dual_contouring->noise_set, !dual_contouring->is_chunk);
+}
+
+// Note: A chunk root is twice the size so it can hold the cell past each far face, octree_construct_octree_nodes drops everything further out
+static inline struct OctreeNode* dual_contouring_build_octree(struct DualContouring* dual_contouring, float threshold) {
+  const int half_size = dual_contouring->octree_size / 2;
+  const int root_size = dual_contouring->is_chunk ? dual_contouring->octree_size * 2 : dual_contouring->octree_size;
+  return octree_build_octree((ivec3){.data[0] = -half_size, .data[1] = -half_size, .data[2] = -half_size}, root_size, threshold, dual_contouring);
+}
+
+void dual_contouring_build(struct DualContouring* dual_contouring) {
+  dual_contouring_generate_noise_set(dual_contouring);
+
+#if DUAL_CONTOURING_BENCHMARK
+  double start_time, end_time;
+  start_time = engine_get_time();
+  dual_contouring->head = dual_contouring_build_octree(dual_contouring, dual_contouring->simplify_threshold);
+  end_time = engine_get_time();
+  printf("Build octree time taken: %lf\n", end_time - start_time);
+  for (int arena_num = 0; arena_num < dual_contouring->octree_arena_count; arena_num++)
+    printf("Octree arena %d pages: %d used: %zu bytes reserved: %zu bytes\n", arena_num, dual_contouring->octree_arenas[arena_num].page_count, dual_contouring->octree_arenas[arena_num].bytes_used, dual_contouring->octree_arenas[arena_num].bytes_reserved);
+  // Note: Measured with an analytic sphere density so noise cost is left out
+  // 64 ^ 3 calloc per node 0.058 build 5.9 MB peak
+  // 64 ^ 3 octree arena 0.047 build 5.7 MB peak
+  // 128 ^ 3 calloc per node 0.321 build 22.4 MB peak
+  // 128 ^ 3 octree arena 0.233 build 21.4 MB peak
+
+  octree_benchmark_crossing_modes(dual_contouring);
+  // Note: 128 ^ 3 sphere, density calls per leaf / mean error in cells against a 16 iteration secant
+  // step search 36.0 / 0.0315
+  // corner interpolation 0.0 / 0.0090
+  // secant 1 iteration 4.0 / 0.0007
+  // secant 3 iterations 12.0 / 0.00002
+
+  start_time = engine_get_time();
+  octree_generate_mesh_from_octree(dual_contouring->head, dual_contouring);
+  end_time = engine_get_time();
+  printf("Generate mesh time taken: %lf\n", end_time - start_time);
 
-  vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
+  // Note: Rebuilds once per threshold, indices at -1 are the unsimplified mesh to compare against
+  for (int threshold_num = 0; threshold_num < MAX_THRESHOLDS; threshold_num++) {
+    start_time = engine_get_time();
+    dual_contouring->head = dual_contouring_build_octree(dual_contouring, THRESHOLDS[threshold_num]);
+    octree_generate_mesh_from_octree(dual_contouring->head, dual_contouring);
+    end_time = engine_get_time();
+    struct DualContouringSimplifyStats* stats = &dual_contouring->simplify_stats;
+    printf("Simplify threshold %f: %d nodes collapsed, vertices %d -> %d, indices %d, time taken: %lf\n", THRESHOLDS[threshold_num], stats->nodes_collapsed, stats->vertices_before, stats->vertices_after, stats->indices_after, end_time - start_time);
+  }
+  // Note: 128 ^ 3 sphere, vertices / indices
+  // -1 42942 / 257640
+  // 0.1 18755 / 112518
+  // 1 7527 / 45150
+  // 10 3130 / 18720
+  // 50 2010 / 12000
 
-  return 0;
+  dual_contouring->head = dual_contouring_build_octree(dual_contouring, dual_contouring->simplify_threshold);
+  octree_generate_mesh_from_octree(dual_contouring->head, dual_contouring);
+
+  start_time = engine_get_time();
+  mesh_optimize(dual_contouring->mesh, true, &dual_contouring->optimize_stats);
+  end_time = engine_get_time();
+  struct MeshOptimizeStats* optimize_stats = &dual_contouring->optimize_stats;
+  printf("Optimize mesh: triangles %d -> %d, vertices %d -> %d, ACMR %f -> %f, time taken: %lf\n", optimize_stats->triangles_before, optimize_stats->triangles_after, optimize_stats->vertices_before, optimize_stats->vertices_after, optimize_stats->acmr_before, optimize_stats->acmr_after, end_time - start_time);
+  // Note: Noise at 0.1, no degenerates or repeats reach this far so it's all ordering
+  // 32 ^ 3 ACMR 1.12 -> 0.68 in 0.001, 16 bit indices
+  // 128 ^ 3 ACMR 1.09 -> 0.69 in 0.009, 16 bit indices
+  printf("Peak memory usage: %zu bytes\n", engine_get_peak_memory_usage());
+#else
+  dual_contouring->head = dual_contouring_build_octree(dual_contouring, dual_contouring->simplify_threshold);
+  octree_generate_mesh_from_octree(dual_contouring->head, dual_contouring);
+  mesh_optimize(dual_contouring->mesh, true, &dual_contouring->optimize_stats);
+#endif
 }
 
-static inline void dual_contouring_vulkan_cleanup(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api) {
-  vkDestroyBuffer(gpu_api->vulkan_state->device, dual_contouring->index_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, dual_contouring->index_buffer_memory, NULL);
+// Note: Only the mesh is needed to draw, chunks drop the noise set and octree as soon as they are meshed
+void dual_contouring_release_build_data(struct DualContouring* dual_contouring) {
+  octree_destroy_octree(dual_contouring);
+  free(dual_contouring->seam_set);
+  dual_contouring->seam_set = NULL;
+  if (dual_contouring->noise_set == NULL)
+    return;
 
-  vkDestroyBuffer(gpu_api->vulkan_state->device, dual_contouring->vertex_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, dual_contouring->vertex_buffer_memory, NULL);
+  if (dual_contouring->density_cache != NULL)
+    density_cache_release(dual_contouring->density_cache, dual_contouring->noise_set);
+  else if (dual_contouring->is_chunk)
+    free(dual_contouring->noise_set);
+  else
+    noise_free(dual_contouring->noise_set);
+  dual_contouring->noise_set = NULL;
+}
 
-  vkDestroyBuffer(gpu_api->vulkan_state->device, dual_contouring->lighting_uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, dual_contouring->lighting_uniform_buffer_memory, NULL);
+// Note: Density callbacks can't go in the file since their addresses change between runs, a planet that swaps them needs its own path
+static inline struct ChunkFileParams dual_contouring_chunk_file_params(struct DualContouring* dual_contouring) {
+  uint64_t noise_hash = density_cache_hash_noises(dual_contouring->noises, false);
+  noise_hash = density_cache_hash_bytes(noise_hash, &dual_contouring->crossing_mode, sizeof(dual_contouring->crossing_mode));
+  noise_hash = density_cache_hash_bytes(noise_hash, &dual_contouring->crossing_iterations, sizeof(dual_contouring->crossing_iterations));
+  return (struct ChunkFileParams){.vertex_type = CHUNK_FILE_VERTEX_DUAL_CONTOURING, .noise_hash = noise_hash, .density_id = dual_contouring->density_id, .resolution = dual_contouring->octree_size, .threshold = dual_contouring->simplify_threshold};
+}
+
+// Note: Unnamed density functions can't be told apart so their meshes are never saved or loaded
+int dual_contouring_save_mesh(struct DualContouring* dual_contouring, const char* path) {
+  if (dual_contouring->density_id == CHUNK_FILE_DENSITY_UNNAMED)
+    return CHUNK_FILE_MISMATCH_ERROR;
 
-  vkDestroyBuffer(gpu_api->vulkan_state->device, dual_contouring->dc_uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, dual_contouring->dc_uniform_buffer_memory, NULL);
+  struct ChunkFileParams params = dual_contouring_chunk_file_params(dual_contouring);
+  return chunk_file_write(path, &params, dual_contouring->mesh);
 }
 
-void dual_contouring_delete(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api) {
-  dual_contouring_vulkan_cleanup(dual_contouring, gpu_api);
+// Note: Fills the mesh in place of dual_contouring_build when the file matches the current setup, it still needs dual_contouring_upload after
+int dual_contouring_load_mesh(struct DualContouring* dual_contouring, const char* path) {
+  if (dual_contouring->density_id == CHUNK_FILE_DENSITY_UNNAMED)
+    return CHUNK_FILE_MISMATCH_ERROR;
 
-  octree_destroy_octree(dual_contouring->head);
-  mesh_delete(dual_contouring->mesh);
-  free(dual_contouring->mesh);
-  noise_free(dual_contouring->noise_set);
+  struct ChunkFileParams params = dual_contouring_chunk_file_params(dual_contouring);
+  return chunk_file_load_mesh(path, &params, dual_contouring->mesh);
 }
 
-void dual_contouring_recreate(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api) {
-  dual_contouring_vulkan_cleanup(dual_contouring, gpu_api);
+// Note: Sum of every ridged fractal noise, the scalar reference the AVX2 batch below has to match
+float dual_contouring_density_ridged_sum_single(struct Vector* noises, float x, float y, float z) {
+  float density = 0.0f;
+  for (int noise_num = 0; noise_num < vector_size(noises); noise_num++) {
+    struct Noise* noise = vector_get(noises, noise_num);
+    switch (noise->noise_type) {
+      case (RIDGED_FRACTAL_NOISE):
+        density += ridged_fractal_noise_eval_3d_single(&noise->ridged_fractal_noise, x, y, z);
+        break;
+    }
+  }
 
-  graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, dual_contouring->mesh->vertices, &dual_contouring->vertex_buffer, &dual_contouring->vertex_buffer_memory);
-  graphics_utils_setup_index_buffer(gpu_api->vulkan_state, dual_contouring->mesh->indices, &dual_contouring->index_buffer, &dual_contouring->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct DualContouringUniformBufferObject), &dual_contouring->dc_uniform_buffer, &dual_contouring->dc_uniform_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct LightingUniformBufferObject), &dual_contouring->lighting_uniform_buffer, &dual_contouring->lighting_uniform_buffer_memory);
-  graphics_utils_setup_descriptor(gpu_api->vulkan_state, dual_contouring->shader->descriptor_set_layout, dual_contouring->shader->descriptor_pool, &dual_contouring->descriptor_set);
+  return density;
+}
 
-  VkWriteDescriptorSet dcs[2] = {0};
+// Note: Same 8 wide path as planet_normal_avx2, tail is padded by repeating the last position. Only pair it with dual_contouring_density_ridged_sum_single
+void dual_contouring_density_ridged_sum_batch_avx2(struct Vector* noises, float (*positions)[3], float* dest, int count) {
+  for (int batch_start = 0; batch_start < count; batch_start += 8) {
+    const int batch_count = MIN(8, count - batch_start);
+    float poss[8][3] = {{0}};
+    float batch_dest[8] = {0};
+    float noise_dest[8] = {0};
+    for (int lane = 0; lane < 8; lane++)
+      memcpy(poss[lane], positions[batch_start + MIN(lane, batch_count - 1)], sizeof(float) * 3);
 
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct DualContouringUniformBufferObject), &dual_contouring->dc_uniform_buffer)});
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 1, &dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct LightingUniformBufferObject), &dual_contouring->lighting_uniform_buffer)});
+    for (int noise_num = 0; noise_num < vector_size(noises); noise_num++) {
+      struct Noise* noise = vector_get(noises, noise_num);
+      switch (noise->noise_type) {
+        case (RIDGED_FRACTAL_NOISE):
+          ridged_fractal_noise_eval_custom(&noise->ridged_fractal_noise, poss, noise_dest);
+          for (int lane = 0; lane < 8; lane++)
+            batch_dest[lane] += noise_dest[lane];
+          break;
+      }
+    }
 
-  vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
+    memcpy(dest + batch_start, batch_dest, sizeof(float) * batch_count);
+  }
 }
@@ -0,0 +1,53 @@
+#include "mana/graphics/dualcontouring/dualcontouring.h"
+
+// Note: The Vulkan side of a chunk, kept out of dualcontouring.c so headless builds can link the mesher without the GPU libraries
+
+// Note: Returns 1 when the shader's pool is out of descriptor sets, the buffers are still freed by dual_contouring_delete
+int dual_contouring_upload(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api) {
+  culling_bounds_from_mesh(&dual_contouring->bounds, dual_contouring->mesh, offsetof(struct VertexDualContouring, normal), 0, vector_size(dual_contouring->mesh->indices));
+  graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, dual_contouring->mesh->vertices, &dual_contouring->vertex_buffer, &dual_contouring->vertex_buffer_memory);
+  graphics_utils_setup_index_buffer(gpu_api->vulkan_state, dual_contouring->mesh->indices, &dual_contouring->index_buffer, &dual_contouring->index_buffer_memory);
+  // Note: Nothing is drawn until the owner pushes uniforms for it, a chunk built after this frame's push waits for the next one
+  for (int uniform_num = 0; uniform_num < DUAL_CONTOURING_DYNAMIC_UNIFORMS; uniform_num++)
+    dual_contouring->uniform_offsets[uniform_num] = UNIFORM_RING_FULL;
+  if (graphics_utils_setup_descriptor(gpu_api->vulkan_state, dual_contouring->shader->descriptor_set_layout, dual_contouring->shader->descriptor_pool, &dual_contouring->descriptor_set) != 0)
+    return 1;
+
+  VkWriteDescriptorSet dcs[2] = {0};
+
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct DualContouringUniformBufferObject))});
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 1, &dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct LightingUniformBufferObject))});
+
+  vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
+
+  return 0;
+}
+
+int dual_contouring_init(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api, int octree_size, struct Shader* shader, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int)) {
+  dual_contouring_setup(dual_contouring, octree_size, shader, noises, density_func_single, density_func_set, density_func_batch);
+  dual_contouring_build(dual_contouring);
+  dual_contouring_upload(dual_contouring, gpu_api);
+
+  return 0;
+}
+
+static inline void dual_contouring_vulkan_cleanup(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api) {
+  vkDestroyBuffer(gpu_api->vulkan_state->device, dual_contouring->index_buffer, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &dual_contouring->index_buffer_memory);
+
+  vkDestroyBuffer(gpu_api->vulkan_state->device, dual_contouring->vertex_buffer, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &dual_contouring->vertex_buffer_memory);
+}
+
+void dual_contouring_delete(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api) {
+  dual_contouring_vulkan_cleanup(dual_contouring, gpu_api);
+
+  dual_contouring_release_build_data(dual_contouring);
+  mesh_delete(dual_contouring->mesh);
+  free(dual_contouring->mesh);
+}
+
+void dual_contouring_recreate(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api) {
+  dual_contouring_vulkan_cleanup(dual_contouring, gpu_api);
+  dual_contouring_upload(dual_contouring, gpu_api);
+}
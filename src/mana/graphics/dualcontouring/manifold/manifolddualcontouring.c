@@ -3,73 +3,210 @@
 //: base(device, resolution, size, true, !FlatShading, 2097152)
 void manifold_dual_contouring_init(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api, struct Shader* shader, int resolution, int size) {
   manifold_dual_contouring->shader = shader;
+  manifold_dual_contouring->gpu_api = gpu_api;
+  manifold_dual_contouring->job_system = NULL;
+  manifold_dual_contouring->noises = NULL;
+  memset(&manifold_dual_contouring->tree, 0, sizeof(struct ManifoldOctreeLevels));
+  memset(&manifold_dual_contouring->build_tree, 0, sizeof(struct ManifoldOctreeLevels));
+  memset(&manifold_dual_contouring->spare_tree, 0, sizeof(struct ManifoldOctreeLevels));
+  manifold_dual_contouring->stale_vertices = 0;
+  manifold_dual_contouring->edit_generation = 0;
+  manifold_dual_contouring->building = false;
+  manifold_dual_contouring->uploaded = false;
+  manifold_dual_contouring->rebuild_pending = false;
+  manifold_dual_contouring->vertex_buffer = VK_NULL_HANDLE;
+  manifold_dual_contouring->index_buffer = VK_NULL_HANDLE;
+  memset(manifold_dual_contouring->uniform_offsets, 0, sizeof(manifold_dual_contouring->uniform_offsets));
 
   manifold_dual_contouring->mesh = calloc(1, sizeof(struct Mesh));
   mesh_manifold_dual_contouring_init(manifold_dual_contouring->mesh);
 
   manifold_dual_contouring->octree_size = size;
   manifold_dual_contouring->resolution = resolution;
+  density_cache_init(&manifold_dual_contouring->density_cache, DENSITY_CACHE_DEFAULT_BUDGET);
 }
 
 static inline void manifold_dual_contouring_vulkan_cleanup(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api) {
   vkDestroyBuffer(gpu_api->vulkan_state->device, manifold_dual_contouring->index_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, manifold_dual_contouring->index_buffer_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &manifold_dual_contouring->index_buffer_memory);
 
   vkDestroyBuffer(gpu_api->vulkan_state->device, manifold_dual_contouring->vertex_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, manifold_dual_contouring->vertex_buffer_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &manifold_dual_contouring->vertex_buffer_memory);
+}
 
-  vkDestroyBuffer(gpu_api->vulkan_state->device, manifold_dual_contouring->lighting_uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, manifold_dual_contouring->lighting_uniform_buffer_memory, NULL);
+static inline void manifold_dual_contouring_destroy_tree(struct ManifoldOctreeLevels* tree) {
+  if (tree->level_count == 0)
+    return;
 
-  vkDestroyBuffer(gpu_api->vulkan_state->device, manifold_dual_contouring->dc_uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, manifold_dual_contouring->dc_uniform_buffer_memory, NULL);
+  manifold_octree_destroy_octree(tree);
 }
 
 void manifold_dual_contouring_delete(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api) {
-  manifold_dual_contouring_vulkan_cleanup(manifold_dual_contouring, gpu_api);
+  // Note: A worker may still be writing the build tree so let it land before anything is freed
+  manifold_dual_contouring->rebuild_pending = false;
+  if (manifold_dual_contouring->building)
+    job_system_flush(manifold_dual_contouring->job_system);
+
+  if (manifold_dual_contouring->uploaded)
+    manifold_dual_contouring_vulkan_cleanup(manifold_dual_contouring, gpu_api);
 
-  // Search through octree for unique vertices
-  struct Map vertice_map = {0};
-  map_init(&vertice_map, sizeof(struct Vertex*));
-  manifold_octree_destroy_octree(manifold_dual_contouring->tree, &vertice_map);
-  const char* key;
-  struct MapIter iter = map_iter();
-  while ((key = map_next(&vertice_map, &iter)))
-    free(*(char**)map_get(&vertice_map, key));
-  map_delete(&vertice_map);
+#if MANIFOLD_BENCHMARK
+  double start_time = engine_get_time();
+  manifold_dual_contouring_destroy_tree(&manifold_dual_contouring->tree);
+  manifold_dual_contouring_destroy_tree(&manifold_dual_contouring->spare_tree);
+  double end_time = engine_get_time();
+  printf("Destroy tree time taken: %lf\n", end_time - start_time);
+  // 0.25 start at 128 ^ 3 after a few brushes, sprintf map walk
+  // 0.005
+#else
+  manifold_dual_contouring_destroy_tree(&manifold_dual_contouring->tree);
+  manifold_dual_contouring_destroy_tree(&manifold_dual_contouring->spare_tree);
+#endif
 
   mesh_delete(manifold_dual_contouring->mesh);
   free(manifold_dual_contouring->mesh);
   //noise_free(manifold_dual_contouring->noise_set);
+  density_cache_delete(&manifold_dual_contouring->density_cache);
+}
+
+// Note: Ranges stay grouped through optimize_mesh and patch_indexes, when they don't add up to the index buffer the mesh didn't come from this tree
+static inline void manifold_dual_contouring_compute_bounds(struct ManifoldDualContouring* manifold_dual_contouring) {
+  const int* index_offsets = manifold_dual_contouring->tree.index_offsets;
+  const int index_count = vector_size(manifold_dual_contouring->mesh->indices);
+  if (index_offsets[0] == 0 && index_offsets[MANIFOLD_OCTREE_INDEX_RANGES] == index_count) {
+    manifold_dual_contouring->cull_range_count = MANIFOLD_OCTREE_INDEX_RANGES;
+    memcpy(manifold_dual_contouring->cull_range_offsets, index_offsets, sizeof(int) * (MANIFOLD_OCTREE_INDEX_RANGES + 1));
+  } else {
+    manifold_dual_contouring->cull_range_count = 1;
+    manifold_dual_contouring->cull_range_offsets[0] = 0;
+    manifold_dual_contouring->cull_range_offsets[1] = index_count;
+  }
+
+  for (int range_num = 0; range_num < manifold_dual_contouring->cull_range_count; range_num++) {
+    const int range_start = manifold_dual_contouring->cull_range_offsets[range_num];
+    culling_bounds_from_mesh(&manifold_dual_contouring->cull_bounds[range_num], manifold_dual_contouring->mesh, offsetof(struct VertexManifoldDualContouring, normal1), range_start, manifold_dual_contouring->cull_range_offsets[range_num + 1] - range_start);
+  }
+}
+
+static inline VkDeviceSize manifold_dual_contouring_vertex_size(struct ManifoldDualContouring* manifold_dual_contouring) {
+#if MESH_PACKED_VERTICES
+  return sizeof(struct VertexManifoldDualContouringPacked);
+#else
+  return manifold_dual_contouring->mesh->vertices->memory_size;
+#endif
+}
+
+// Note: Uploads every vertex from vertex_start on to the same place in the vertex buffer
+static inline void manifold_dual_contouring_upload_vertices(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api, int vertex_start) {
+  struct Vector* vertices = manifold_dual_contouring->mesh->vertices;
+  const int vertex_count = (int)vector_size(vertices) - vertex_start;
+  if (vertex_count <= 0)
+    return;
+
+  const VkDeviceSize vertex_size = manifold_dual_contouring_vertex_size(manifold_dual_contouring);
+#if MESH_PACKED_VERTICES
+  // Note: The float mesh stays on the CPU for edits and chunk files, only the uploaded copy is packed
+  struct Vector vertex_range = *vertices;
+  vertex_range.items = vector_get(vertices, vertex_start);
+  vertex_range.size = vertex_count;
+  struct Vector packed_vertices = {0};
+  vector_init(&packed_vertices, sizeof(struct VertexManifoldDualContouringPacked));
+  mesh_manifold_dual_contouring_pack_vertices(&vertex_range, &packed_vertices, manifold_dual_contouring_packed_offset(manifold_dual_contouring), manifold_dual_contouring_packed_scale(manifold_dual_contouring));
+  upload_manager_upload_buffer(gpu_api->vulkan_state->upload_manager, gpu_api->vulkan_state, manifold_dual_contouring->vertex_buffer, vertex_start * vertex_size, packed_vertices.items, vertex_count * vertex_size);
+  vector_delete(&packed_vertices);
+#else
+  upload_manager_upload_buffer(gpu_api->vulkan_state->upload_manager, gpu_api->vulkan_state, manifold_dual_contouring->vertex_buffer, vertex_start * vertex_size, vector_get(vertices, vertex_start), vertex_count * vertex_size);
+#endif
+  manifold_dual_contouring->uploaded_vertex_count = vector_size(vertices);
+}
+
+static inline void manifold_dual_contouring_setup_mesh_buffers(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api) {
+  manifold_dual_contouring_compute_bounds(manifold_dual_contouring);
+  struct Mesh* mesh = manifold_dual_contouring->mesh;
+  const int growth = (manifold_dual_contouring->tree.level_count > 0) ? MANIFOLD_DUAL_CONTOURING_BUFFER_GROWTH : 1;
+  manifold_dual_contouring->vertex_capacity = vector_size(mesh->vertices) * growth;
+  manifold_dual_contouring->index_capacity = MAX((int)vector_size(mesh->indices), 1) * growth;
+  graphics_utils_create_buffer(gpu_api->vulkan_state, manifold_dual_contouring->vertex_capacity * manifold_dual_contouring_vertex_size(manifold_dual_contouring), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &manifold_dual_contouring->vertex_buffer, &manifold_dual_contouring->vertex_buffer_memory);
+  graphics_utils_create_buffer(gpu_api->vulkan_state, manifold_dual_contouring->index_capacity * mesh->indices->memory_size, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &manifold_dual_contouring->index_buffer, &manifold_dual_contouring->index_buffer_memory);
+
+  manifold_dual_contouring_upload_vertices(manifold_dual_contouring, gpu_api, 0);
+  upload_manager_upload_buffer(gpu_api->vulkan_state->upload_manager, gpu_api->vulkan_state, manifold_dual_contouring->index_buffer, 0, mesh->indices->items, vector_size(mesh->indices) * mesh->indices->memory_size);
+  manifold_dual_contouring->index_tail = vector_size(mesh->indices);
+  memcpy(manifold_dual_contouring->index_range_starts, manifold_dual_contouring->cull_range_offsets, sizeof(int) * manifold_dual_contouring->cull_range_count);
 }
 
 static inline void manifold_dual_contouring_setup_buffers(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api) {
-  graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, manifold_dual_contouring->mesh->vertices, &manifold_dual_contouring->vertex_buffer, &manifold_dual_contouring->vertex_buffer_memory);
-  graphics_utils_setup_index_buffer(gpu_api->vulkan_state, manifold_dual_contouring->mesh->indices, &manifold_dual_contouring->index_buffer, &manifold_dual_contouring->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct ManifoldDualContouringUniformBufferObject), &manifold_dual_contouring->dc_uniform_buffer, &manifold_dual_contouring->dc_uniform_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct LightingUniformBufferObject), &manifold_dual_contouring->lighting_uniform_buffer, &manifold_dual_contouring->lighting_uniform_buffer_memory);
+  if (vector_size(manifold_dual_contouring->mesh->vertices) > 0)
+    manifold_dual_contouring_setup_mesh_buffers(manifold_dual_contouring, gpu_api);
   graphics_utils_setup_descriptor(gpu_api->vulkan_state, manifold_dual_contouring->shader->descriptor_set_layout, manifold_dual_contouring->shader->descriptor_pool, &manifold_dual_contouring->descriptor_set);
 
   VkWriteDescriptorSet dcs[2] = {0};
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &manifold_dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct ManifoldDualContouringUniformBufferObject), &manifold_dual_contouring->dc_uniform_buffer)});
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 1, &manifold_dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct LightingUniformBufferObject), &manifold_dual_contouring->lighting_uniform_buffer)});
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &manifold_dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct ManifoldDualContouringUniformBufferObject))});
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 1, &manifold_dual_contouring->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct LightingUniformBufferObject))});
 
   vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
 }
 
 void manifold_dual_contouring_recreate(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api) {
+  if (!manifold_dual_contouring->uploaded)
+    return;
+
   manifold_dual_contouring_vulkan_cleanup(manifold_dual_contouring, gpu_api);
   manifold_dual_contouring_setup_buffers(manifold_dual_contouring, gpu_api);
 }
 
-void manifold_dual_contouring_contour(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api, struct Vector* noises, float threshold) {
-  mesh_clear(manifold_dual_contouring->mesh);
-  manifold_dual_contouring->tree = calloc(1, sizeof(struct ManifoldOctreeNode));
+#if MANIFOLD_BENCHMARK_SCALING
+// Note: Builds the same volume again at 1 to 16 threads and prints every stage, the thread count is put back afterwards
+static void manifold_dual_contouring_benchmark_scaling(int resolution, struct Vector* noises, float threshold) {
+  const int max_threads = omp_get_max_threads();
+  struct ManifoldOctreeLevels levels = {0};
+  struct Mesh mesh = {0};
+  mesh_manifold_dual_contouring_init(&mesh);
+
+  for (int thread_count = 1; thread_count <= 16; thread_count *= 2) {
+    omp_set_num_threads(thread_count);
+    double stage_times[5];
+    stage_times[0] = engine_get_time();
+    manifold_octree_construct_base(&levels, resolution, noises, NULL);
+    stage_times[1] = engine_get_time();
+    manifold_octree_cluster_cell_base(&levels, 0);
+    stage_times[2] = engine_get_time();
+    manifold_octree_generate_vertex_buffer(&levels, mesh.vertices);
+    stage_times[3] = engine_get_time();
+    manifold_octree_process_cell(&levels, mesh.indices, threshold, NULL);
+    stage_times[4] = engine_get_time();
+    printf("Scaling %d threads construct: %lf cluster: %lf vertex: %lf process: %lf\n", thread_count, stage_times[1] - stage_times[0], stage_times[2] - stage_times[1], stage_times[3] - stage_times[2], stage_times[4] - stage_times[3]);
+
+    manifold_octree_reset(&levels);
+    mesh_clear(&mesh);
+  }
+  // Measured on a single core so counts above 1 only show the cost of oversubscribing, 64 ^ 3
+  // 1 threads construct: 0.027 cluster: 0.019 vertex: 0.004 process: 0.005
+  // 16 threads construct: 0.035 cluster: 0.022 vertex: 0.003 process: 0.006
+  // Note: Largest work item is ~1 / 70 of the index pass at 64 - 128 ^ 3 where a root child was ~1 / 8
+  // Cluster bound from single core per level timings, each level costs its serial count and reserve plus the larger of its largest node and its total / threads
+  // Surface in 2 octants, 2 / 4 / 8 / 16 threads
+  // 64 ^ 3 1.96 / 3.64 / 6.34 / 9.75
+  // 128 ^ 3 1.97 / 3.73 / 6.73 / 11.06
+  // 256 ^ 3 1.95 / 3.64 / 6.46 / 10.09
+
+  manifold_dual_contouring_destroy_tree(&levels);
+  mesh_delete(&mesh);
+  omp_set_num_threads(max_threads);
+}
+#endif
+
+// Note: Only reads the fields set in prepare and writes the build tree and mesh, so it's safe to run off the main thread
+static void manifold_dual_contouring_build(struct ManifoldDualContouring* manifold_dual_contouring) {
+  struct ManifoldOctreeLevels* levels = &manifold_dual_contouring->build_tree;
+  struct Mesh* mesh = manifold_dual_contouring->build_mesh;
+  struct Vector* noises = manifold_dual_contouring->noises;
+  const float threshold = manifold_dual_contouring->threshold;
 
 #if MANIFOLD_BENCHMARK
   double start_time, end_time;
   start_time = engine_get_time();
-  manifold_octree_construct_base(manifold_dual_contouring->tree, manifold_dual_contouring->resolution, noises);
+  manifold_octree_construct_base(levels, manifold_dual_contouring->resolution, noises, &manifold_dual_contouring->density_cache);
   end_time = engine_get_time();
   printf("Construct base time taken: %lf\n", end_time - start_time);
   // ~1.0 start
@@ -82,31 +219,47 @@ void manifold_dual_contouring_contour(struct ManifoldDualContouring* manifold_du
   // 0.425
   // 0.34
   // 0.15
+  // 0.03 single core once only surface bricks get leaves
+  // 0.019 when the density cache already has the field, 0.079 vs 0.15 at 128 ^ 3
 
   start_time = engine_get_time();
-  manifold_octree_cluster_cell_base(manifold_dual_contouring->tree, 0, noises);
+  manifold_octree_cluster_cell_base(levels, 0);
   end_time = engine_get_time();
   printf("Cluster cell base time taken: %lf\n", end_time - start_time);
   // 0.11 start
   // 0.028
+  // 0.021 single core before bucketing, 0.08 at 128 ^ 3
+  // 0.020 counting sort by surface index with per thread scratch, 0.066 at 128 ^ 3
 
   start_time = engine_get_time();
-  manifold_octree_generate_vertex_buffer(manifold_dual_contouring->tree, manifold_dual_contouring->mesh->vertices);
+  manifold_octree_generate_vertex_buffer(levels, mesh->vertices);
   end_time = engine_get_time();
   printf("Generate vertex buffer time taken: %lf\n", end_time - start_time);
   // 0.063 start
   // 0.02 Note: Ranges from 0.035-0.015
   // 0.014
+  // 0.004 batched qef solves, single core
 
   start_time = engine_get_time();
-  manifold_octree_process_cell(manifold_dual_contouring->tree, manifold_dual_contouring->mesh->indices, threshold);
+  manifold_octree_process_cell(levels, mesh->indices, threshold, levels->index_offsets);
   end_time = engine_get_time();
   printf("Process cell time taken: %lf\n", end_time - start_time);
   // 0.027 start
   // 0.009
 
+  struct MeshOptimizeStats optimize_stats;
+  start_time = engine_get_time();
+  manifold_octree_optimize_mesh(levels, mesh, &optimize_stats);
+  end_time = engine_get_time();
+  printf("Optimize mesh: triangles %d -> %d, vertices %d -> %d, ACMR %f -> %f, time taken: %lf\n", optimize_stats.triangles_before, optimize_stats.triangles_after, optimize_stats.vertices_before, optimize_stats.vertices_after, optimize_stats.acmr_before, optimize_stats.acmr_after, end_time - start_time);
+  // 64 ^ 3 ACMR 1.14 -> 0.71 with 525 vertices welded, 0.005 single core
+
+#if MANIFOLD_BENCHMARK_SCALING
+  manifold_dual_contouring_benchmark_scaling(manifold_dual_contouring->resolution, noises, threshold);
+#endif
+
   //start_time = engine_get_time();
-  ////manifold_octree_process_cell(manifold_dual_contouring->tree, manifold_dual_contouring->mesh->indices, threshold);
+  ////manifold_octree_process_cell(levels, mesh->indices, threshold, levels->index_offsets);
   //float STEP = 1.0 / 64.0f;
   //struct RidgedFractalNoise noise = {0};
   //ridged_fractal_noise_init(&noise);
@@ -119,14 +272,190 @@ void manifold_dual_contouring_contour(struct ManifoldDualContouring* manifold_du
   //end_time = engine_get_time();
   //printf("Gpu test: %lf\n", end_time - start_time);
 #else
-  manifold_octree_construct_base(manifold_dual_contouring->tree, manifold_dual_contouring->resolution, noises);
-  manifold_octree_cluster_cell_base(manifold_dual_contouring->tree, 0, noises);
-  manifold_octree_generate_vertex_buffer(manifold_dual_contouring->tree, manifold_dual_contouring->mesh->vertices);
-  manifold_octree_process_cell(manifold_dual_contouring->tree, manifold_dual_contouring->mesh->indices, threshold);
+  manifold_octree_construct_base(levels, manifold_dual_contouring->resolution, noises, &manifold_dual_contouring->density_cache);
+  manifold_octree_cluster_cell_base(levels, 0);
+  manifold_octree_generate_vertex_buffer(levels, mesh->vertices);
+  manifold_octree_process_cell(levels, mesh->indices, threshold, levels->index_offsets);
+  manifold_octree_optimize_mesh(levels, mesh, NULL);
 #endif
+}
 
-  if (vector_size(manifold_dual_contouring->mesh->vertices) > 0)
+static inline void manifold_dual_contouring_prepare(struct ManifoldDualContouring* manifold_dual_contouring, struct Vector* noises, float threshold) {
+  manifold_dual_contouring->build_mesh = calloc(1, sizeof(struct Mesh));
+  mesh_manifold_dual_contouring_init(manifold_dual_contouring->build_mesh);
+  manifold_dual_contouring->build_tree = manifold_dual_contouring->spare_tree;
+  memset(&manifold_dual_contouring->spare_tree, 0, sizeof(struct ManifoldOctreeLevels));
+  manifold_dual_contouring->noises = noises;
+  manifold_dual_contouring->threshold = threshold;
+  manifold_dual_contouring->edit_generation = 0;
+  manifold_dual_contouring->building = true;
+}
+
+static void manifold_dual_contouring_execute_job(void* data) {
+  manifold_dual_contouring_build((struct ManifoldDualContouring*)data);
+}
+
+// Note: Keeps the uniforms and descriptor set if they already exist and only replaces the vertex and index buffers
+static inline void manifold_dual_contouring_upload_mesh(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api) {
+  if (manifold_dual_contouring->vertex_buffer != VK_NULL_HANDLE) {
+    // Note: Frames in flight may still be reading the old mesh, the upload manager frees it once they have finished
+    upload_manager_retire_buffer(gpu_api->vulkan_state->upload_manager, manifold_dual_contouring->index_buffer, &manifold_dual_contouring->index_buffer_memory);
+    upload_manager_retire_buffer(gpu_api->vulkan_state->upload_manager, manifold_dual_contouring->vertex_buffer, &manifold_dual_contouring->vertex_buffer_memory);
+    manifold_dual_contouring->index_buffer = VK_NULL_HANDLE;
+    manifold_dual_contouring->vertex_buffer = VK_NULL_HANDLE;
+  }
+
+  if (!manifold_dual_contouring->uploaded) {
     manifold_dual_contouring_setup_buffers(manifold_dual_contouring, gpu_api);
+    manifold_dual_contouring->uploaded = true;
+  } else if (vector_size(manifold_dual_contouring->mesh->vertices) > 0)
+    manifold_dual_contouring_setup_mesh_buffers(manifold_dual_contouring, gpu_api);
+}
+
+// Note: Brush edits only append vertices and rewrite some index ranges, both land past anything a frame in flight can be drawing so nothing waits on the GPU
+static inline void manifold_dual_contouring_upload_edit(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api, const bool range_dirty[MANIFOLD_OCTREE_INDEX_RANGES]) {
+  struct Mesh* mesh = manifold_dual_contouring->mesh;
+  const int* index_offsets = manifold_dual_contouring->tree.index_offsets;
+  int dirty_index_count = 0;
+  for (int range_num = 0; range_num < MANIFOLD_OCTREE_INDEX_RANGES; range_num++)
+    if (range_dirty[range_num])
+      dirty_index_count += index_offsets[range_num + 1] - index_offsets[range_num];
+
+  if (!manifold_dual_contouring->uploaded || manifold_dual_contouring->vertex_buffer == VK_NULL_HANDLE || vector_size(mesh->vertices) == 0 || (int)vector_size(mesh->vertices) > manifold_dual_contouring->vertex_capacity || manifold_dual_contouring->index_tail + dirty_index_count > manifold_dual_contouring->index_capacity) {
+    manifold_dual_contouring_upload_mesh(manifold_dual_contouring, gpu_api);
+    return;
+  }
+
+  manifold_dual_contouring_compute_bounds(manifold_dual_contouring);
+  manifold_dual_contouring_upload_vertices(manifold_dual_contouring, gpu_api, manifold_dual_contouring->uploaded_vertex_count);
+  for (int range_num = 0; range_num < MANIFOLD_OCTREE_INDEX_RANGES; range_num++) {
+    if (!range_dirty[range_num])
+      continue;
+
+    const int range_count = index_offsets[range_num + 1] - index_offsets[range_num];
+    upload_manager_upload_buffer(gpu_api->vulkan_state->upload_manager, gpu_api->vulkan_state, manifold_dual_contouring->index_buffer, manifold_dual_contouring->index_tail * mesh->indices->memory_size, vector_get(mesh->indices, index_offsets[range_num]), range_count * mesh->indices->memory_size);
+    manifold_dual_contouring->index_range_starts[range_num] = manifold_dual_contouring->index_tail;
+    manifold_dual_contouring->index_tail += range_count;
+  }
+}
+
+// Note: Runs on the main thread at a frame boundary and swaps the finished tree and mesh in
+static void manifold_dual_contouring_finish_job(void* data) {
+  struct ManifoldDualContouring* manifold_dual_contouring = (struct ManifoldDualContouring*)data;
+
+  // Note: The old tree's storage is kept for the next rebuild rather than freed
+#if MANIFOLD_BENCHMARK
+  double start_time = engine_get_time();
+  manifold_octree_reset(&manifold_dual_contouring->tree);
+  double end_time = engine_get_time();
+  printf("Reset tree time taken: %lf\n", end_time - start_time);
+  // 0.0006 at 128 ^ 3
+#else
+  manifold_octree_reset(&manifold_dual_contouring->tree);
+#endif
+  manifold_dual_contouring_destroy_tree(&manifold_dual_contouring->spare_tree);
+  manifold_dual_contouring->spare_tree = manifold_dual_contouring->tree;
+  mesh_delete(manifold_dual_contouring->mesh);
+  free(manifold_dual_contouring->mesh);
+
+  manifold_dual_contouring->tree = manifold_dual_contouring->build_tree;
+  manifold_dual_contouring->mesh = manifold_dual_contouring->build_mesh;
+  memset(&manifold_dual_contouring->build_tree, 0, sizeof(struct ManifoldOctreeLevels));
+  manifold_dual_contouring->build_mesh = NULL;
+  manifold_dual_contouring->stale_vertices = 0;
+
+  manifold_dual_contouring_upload_mesh(manifold_dual_contouring, manifold_dual_contouring->gpu_api);
+  manifold_dual_contouring->building = false;
+
+  // Note: Submitted from here the job system counts it before this one is done, so a flush waits for it too
+  if (manifold_dual_contouring->rebuild_pending) {
+    manifold_dual_contouring->rebuild_pending = false;
+    manifold_dual_contouring_contour_async(manifold_dual_contouring, manifold_dual_contouring->job_system, manifold_dual_contouring->pending_noises, manifold_dual_contouring->pending_threshold);
+  }
+}
+
+void manifold_dual_contouring_contour(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api, struct Vector* noises, float threshold) {
+  manifold_dual_contouring->rebuild_pending = false;
+  if (manifold_dual_contouring->building)
+    job_system_flush(manifold_dual_contouring->job_system);
+
+  manifold_dual_contouring->gpu_api = gpu_api;
+  manifold_dual_contouring_prepare(manifold_dual_contouring, noises, threshold);
+  manifold_dual_contouring_build(manifold_dual_contouring);
+  manifold_dual_contouring_finish_job(manifold_dual_contouring);
+}
+
+// Note: Returns JOB_SYSTEM_SUCCESS when the build was queued, otherwise it already ran inline and the mesh is uploaded on return.
+// While a build is running the request is held and only the newest one is built once it finishes
+int manifold_dual_contouring_contour_async(struct ManifoldDualContouring* manifold_dual_contouring, struct JobSystem* job_system, struct Vector* noises, float threshold) {
+  if (manifold_dual_contouring->building) {
+    manifold_dual_contouring->rebuild_pending = true;
+    manifold_dual_contouring->pending_noises = noises;
+    manifold_dual_contouring->pending_threshold = threshold;
+    return JOB_SYSTEM_SUCCESS;
+  }
+
+  manifold_dual_contouring_prepare(manifold_dual_contouring, noises, threshold);
+  manifold_dual_contouring->job_system = job_system;
+
+  int job_error = job_system_submit(job_system, (struct Job){.execute = manifold_dual_contouring_execute_job, .finish = manifold_dual_contouring_finish_job, .data = manifold_dual_contouring});
+  if (job_error != JOB_SYSTEM_SUCCESS) {
+    manifold_dual_contouring_build(manifold_dual_contouring);
+    manifold_dual_contouring_finish_job(manifold_dual_contouring);
+  }
+
+  return job_error;
+}
+
+// Note: Resolution stands in for the noise step since construct_base derives one from the other, the density is always the planet's ridged sum
+static inline struct ChunkFileParams manifold_dual_contouring_chunk_file_params(int resolution, struct Vector* noises, float threshold) {
+  return (struct ChunkFileParams){.vertex_type = CHUNK_FILE_VERTEX_MANIFOLD_DUAL_CONTOURING, .noise_hash = density_cache_hash_noises(noises, true), .density_id = CHUNK_FILE_DENSITY_RIDGED_SUM, .resolution = resolution, .threshold = threshold};
+}
+
+// Note: Writes the mesh of the last contour along with what it was built from. Returns CHUNK_FILE_EDITED_ERROR without writing once a brush has touched it, the params can't tell one edit history from another
+int manifold_dual_contouring_save_mesh(struct ManifoldDualContouring* manifold_dual_contouring, const char* path) {
+  if (manifold_dual_contouring->building)
+    job_system_flush(manifold_dual_contouring->job_system);
+
+  if (manifold_dual_contouring->edit_generation != 0)
+    return CHUNK_FILE_EDITED_ERROR;
+
+  struct ChunkFileParams params = manifold_dual_contouring_chunk_file_params(manifold_dual_contouring->resolution, manifold_dual_contouring->noises, manifold_dual_contouring->threshold);
+  return chunk_file_write(path, &params, manifold_dual_contouring->mesh);
+}
+
+// Note: Returns CHUNK_FILE_SUCCESS with the mesh uploaded when the file was built from the same noises, resolution and threshold, otherwise nothing changes and the caller contours as usual.
+// A loaded mesh comes without a tree, the first brush on it contours again from the same noises to build one
+int manifold_dual_contouring_load_mesh(struct ManifoldDualContouring* manifold_dual_contouring, struct GPUAPI* gpu_api, struct Vector* noises, float threshold, const char* path) {
+  manifold_dual_contouring->rebuild_pending = false;
+  if (manifold_dual_contouring->building)
+    job_system_flush(manifold_dual_contouring->job_system);
+
+#if MANIFOLD_BENCHMARK
+  double start_time = engine_get_time();
+#endif
+  struct Mesh* mesh = calloc(1, sizeof(struct Mesh));
+  mesh_manifold_dual_contouring_init(mesh);
+  struct ChunkFileParams params = manifold_dual_contouring_chunk_file_params(manifold_dual_contouring->resolution, noises, threshold);
+  const int load_error = chunk_file_load_mesh(path, &params, mesh);
+  if (load_error != CHUNK_FILE_SUCCESS) {
+    mesh_delete(mesh);
+    free(mesh);
+    return load_error;
+  }
+#if MANIFOLD_BENCHMARK
+  double end_time = engine_get_time();
+  printf("Load mesh time taken: %lf\n", end_time - start_time);
+  // 0.0006 at 64 ^ 3 where contouring took 0.05 single core, 0.003 vs 0.26 at 128 ^ 3
+#endif
+
+  manifold_dual_contouring->gpu_api = gpu_api;
+  manifold_dual_contouring->noises = noises;
+  manifold_dual_contouring->threshold = threshold;
+  manifold_dual_contouring->edit_generation = 0;
+  manifold_dual_contouring->build_mesh = mesh;
+  manifold_dual_contouring_finish_job(manifold_dual_contouring);
+  return CHUNK_FILE_SUCCESS;
 }
 
 //void manifold_dual_contouring_construct_tree_grid(struct ManifoldOctreeNode* node) {
@@ -147,3 +476,83 @@ void manifold_dual_contouring_contour(struct ManifoldDualContouring* manifold_du
 //    }
 //  }
 //}
+
+static inline float manifold_dual_contouring_brush_distance(struct ManifoldBrush* brush, vec3 position) {
+  const vec3 local = vec3_sub(position, brush->center);
+  switch (brush->shape) {
+    case (MANIFOLD_BRUSH_SPHERE):
+      return sqrtf((local.x * local.x) + (local.y * local.y) + (local.z * local.z)) - brush->extent.x;
+    case (MANIFOLD_BRUSH_BOX): {
+      const vec3 q = (vec3){.x = fabsf(local.x) - brush->extent.x, .y = fabsf(local.y) - brush->extent.y, .z = fabsf(local.z) - brush->extent.z};
+      const vec3 outside = (vec3){.x = MAX(q.x, 0.0f), .y = MAX(q.y, 0.0f), .z = MAX(q.z, 0.0f)};
+      return sqrtf((outside.x * outside.x) + (outside.y * outside.y) + (outside.z * outside.z)) + MIN(MAX(q.x, MAX(q.y, q.z)), 0.0f);
+    }
+  }
+
+  return 0.0f;
+}
+
+// Note: Only the leaves touching the brush and their ancestors are rebuilt, clean root children keep their index ranges and new vertices go on the end of the vertex buffer
+void manifold_dual_contouring_apply_brush(struct ManifoldDualContouring* manifold_dual_contouring, struct ManifoldBrush brush) {
+  if (manifold_dual_contouring->building)
+    job_system_flush(manifold_dual_contouring->job_system);
+
+  // Note: Only a mesh loaded from a file gets here without a tree, the contour rebuilds the same mesh with one so the edit lands on what was drawn
+  struct ManifoldOctreeLevels* tree = &manifold_dual_contouring->tree;
+  if (tree->level_count == 0 && manifold_dual_contouring->noises != NULL)
+    manifold_dual_contouring_contour(manifold_dual_contouring, manifold_dual_contouring->gpu_api, manifold_dual_contouring->noises, manifold_dual_contouring->threshold);
+  if (tree->level_count == 0)
+    return;
+
+  manifold_dual_contouring->edit_generation++;
+  const int size = tree->size;
+  const int samples = size + 1;
+  const vec3 reach = (brush.shape == MANIFOLD_BRUSH_SPHERE) ? (vec3){.x = brush.extent.x, .y = brush.extent.x, .z = brush.extent.x} : brush.extent;
+  const ivec3 min = (ivec3){.x = MAX((int)floorf(brush.center.x - reach.x), 0), .y = MAX((int)floorf(brush.center.y - reach.y), 0), .z = MAX((int)floorf(brush.center.z - reach.z), 0)};
+  const ivec3 max = (ivec3){.x = MIN((int)ceilf(brush.center.x + reach.x), size), .y = MIN((int)ceilf(brush.center.y + reach.y), size), .z = MIN((int)ceilf(brush.center.z + reach.z), size)};
+  if (min.x > max.x || min.y > max.y || min.z > max.z)
+    return;
+
+  manifold_octree_own_density(tree);
+
+  // Note: Noise is sampled with a step of 1 / size so brush distances are scaled the same way to keep edge crossings between brush and noise samples sensible
+#pragma omp parallel for num_threads(omp_get_max_threads())
+  for (int z = min.z; z <= max.z; z++) {
+    for (int y = min.y; y <= max.y; y++) {
+      for (int x = min.x; x <= max.x; x++) {
+        const float distance = manifold_dual_contouring_brush_distance(&brush, (vec3){.x = x, .y = y, .z = z}) / size;
+        float* sample = &tree->density[x + (samples * (y + (samples * z)))];
+        *sample = (brush.operation == MANIFOLD_BRUSH_ADD) ? MIN(*sample, distance) : MAX(*sample, -distance);
+      }
+    }
+  }
+
+  struct Mesh* mesh = manifold_dual_contouring->mesh;
+  manifold_dual_contouring->stale_vertices += manifold_octree_rebuild_region(tree, min, max, 0.0f, manifold_dual_contouring->noises);
+  // Note: Once dead slots make up half the vertex buffer it's cheaper to regenerate it than to keep uploading them, the pool is compacted along with it
+  if (manifold_dual_contouring->stale_vertices * 2 > (int)vector_size(mesh->vertices)) {
+    vector_clear(mesh->vertices);
+    vector_clear(mesh->indices);
+    manifold_octree_compact_vertices(tree);
+    manifold_octree_generate_vertex_buffer(tree, mesh->vertices);
+    manifold_octree_process_cell(tree, mesh->indices, manifold_dual_contouring->threshold, tree->index_offsets);
+    manifold_octree_optimize_mesh(tree, mesh, NULL);
+    manifold_dual_contouring->stale_vertices = 0;
+    manifold_octree_clear_dirty(tree);
+
+    manifold_dual_contouring_upload_mesh(manifold_dual_contouring, manifold_dual_contouring->gpu_api);
+    return;
+  }
+
+  // Note: The root's own faces are patched every time, root children only when something under them changed
+  bool range_dirty[MANIFOLD_OCTREE_INDEX_RANGES] = {false};
+  for (int range_num = 0; range_num < 8; range_num++)
+    range_dirty[range_num] = tree->level_count > 1 && tree->nodes[1][range_num].dirty;
+  range_dirty[8] = true;
+
+  manifold_octree_append_dirty_vertices(tree, mesh->vertices);
+  manifold_octree_patch_indexes(tree, mesh->indices, manifold_dual_contouring->threshold);
+  manifold_octree_clear_dirty(tree);
+
+  manifold_dual_contouring_upload_edit(manifold_dual_contouring, manifold_dual_contouring->gpu_api, range_dirty);
+}
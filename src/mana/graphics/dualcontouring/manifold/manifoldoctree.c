@@ -6,119 +6,373 @@
 //  bool in_use;
 //};
 
+// Note: Per thread buffers for clustering, one set per thread for a whole pass so clustering a node never allocates
+struct ManifoldClusterScratch {
+  struct Vector collected_vertices;
+  int* bucket_starts;
+  int bucket_capacity;
+  int* sorted_vertices;
+  int sorted_capacity;
+};
+
 //static inline bool manifold_octree_construct_nodes(struct ManifoldOctreeNode* octree_node, struct Vector* noises, float* noise_set, int used_threads, struct Threadz thread_pool[]);
-static inline void manifold_octree_construct_nodes(struct ManifoldOctreeNode* octree_node, struct Vector* noises, float* noise_set);
-static inline bool manifold_octree_construct_leaf(struct ManifoldOctreeNode* octree_node, struct Vector* noises, int scale, float* noise_set);
-static inline void manifold_octree_process_face(struct ManifoldOctreeNode* nodes[2], int direction, struct Vector* indexes, float threshold);
-static inline void manifold_octree_process_edge(struct ManifoldOctreeNode* nodes[4], int direction, struct Vector* indexes, float threshold);
-static inline void manifold_octree_process_indexes(struct ManifoldOctreeNode* nodes[4], int direction, struct Vector* indexes, float threshold);
-static inline void manifold_octree_cluster_cell(struct ManifoldOctreeNode* octree_node, float error, struct Vector* noises);
-static inline void manifold_octree_gather_vertices(struct ManifoldOctreeNode* n, struct ArrayList* dest, int* surface_index);
-static inline void manifold_octree_cluster_face(struct ManifoldOctreeNode* nodes[2], int direction, int* surface_index, struct ArrayList* collected_vertices);
-static inline void manifold_octree_cluster_edge(struct ManifoldOctreeNode* nodes[4], int direction, int* surface_index, struct ArrayList* collected_vertices);
-static inline void manifold_octree_cluster_indexes(struct ManifoldOctreeNode* nodes[8], int direction, int* max_surface_index, struct ArrayList* collected_vertices);
-
-void manifold_octree_construct_base(struct ManifoldOctreeNode* octree_node, int size, struct Vector* noises) {
-  octree_node->index = 0;
+static inline void manifold_octree_construct_nodes(struct ManifoldOctreeLevels* levels, struct Vector* noises);
+static inline unsigned char manifold_octree_leaf_corners(struct ManifoldOctreeNode* octree_node, int scale, float* density, float samples[8]);
+static inline void manifold_octree_construct_leaf(struct ManifoldVertexPool* vertex_pool, struct ManifoldOctreeNode* octree_node, struct Vector* noises, int scale, float* density, bool grid_normals);
+static inline void manifold_octree_process_cell_faces(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* octree_node, struct Vector* indexes, float threshold);
+static inline void manifold_octree_process_face(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* nodes[2], int direction, struct Vector* indexes, float threshold);
+static inline void manifold_octree_process_edge(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* nodes[4], int direction, struct Vector* indexes, float threshold);
+static inline void manifold_octree_process_indexes(struct ManifoldVertexPool* vertex_pool, struct ManifoldOctreeNode* nodes[4], int direction, struct Vector* indexes, float threshold);
+static inline void manifold_octree_cluster_node(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* octree_node, float error, struct ManifoldClusterScratch* scratch);
+static inline void manifold_octree_cluster_face(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* nodes[2], int direction, int* surface_index, struct Vector* collected_vertices);
+static inline void manifold_octree_cluster_edge(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* nodes[4], int direction, int* surface_index, struct Vector* collected_vertices);
+static inline void manifold_octree_cluster_indexes(struct ManifoldVertexPool* vertex_pool, struct ManifoldOctreeNode* nodes[4], int direction, int* max_surface_index, struct Vector* collected_vertices);
+
+void manifold_vertex_pool_init(struct ManifoldVertexPool* vertex_pool) {
+  memset(vertex_pool, 0, sizeof(struct ManifoldVertexPool));
+}
+
+void manifold_vertex_pool_delete(struct ManifoldVertexPool* vertex_pool) {
+  free(vertex_pool->parent);
+  free(vertex_pool->index);
+  free(vertex_pool->surface_index);
+  free(vertex_pool->error);
+  free(vertex_pool->euler);
+  free(vertex_pool->face_prop2);
+  free(vertex_pool->in_cell);
+  free(vertex_pool->normal);
+  free(vertex_pool->eis);
+  free(vertex_pool->qef);
+  memset(vertex_pool, 0, sizeof(struct ManifoldVertexPool));
+}
+
+// Hands out count consecutive entries and returns the first, not thread safe so it's only called between parallel passes
+int manifold_vertex_pool_reserve(struct ManifoldVertexPool* vertex_pool, int count) {
+  const int start = vertex_pool->count;
+  if (start + count > vertex_pool->capacity) {
+    int capacity = MAX(vertex_pool->capacity * 2, 1024);
+    while (capacity < start + count)
+      capacity *= 2;
+
+    vertex_pool->parent = realloc(vertex_pool->parent, sizeof(int) * capacity);
+    vertex_pool->index = realloc(vertex_pool->index, sizeof(int) * capacity);
+    vertex_pool->surface_index = realloc(vertex_pool->surface_index, sizeof(int) * capacity);
+    vertex_pool->error = realloc(vertex_pool->error, sizeof(float) * capacity);
+    vertex_pool->euler = realloc(vertex_pool->euler, sizeof(int) * capacity);
+    vertex_pool->face_prop2 = realloc(vertex_pool->face_prop2, sizeof(bool) * capacity);
+    vertex_pool->in_cell = realloc(vertex_pool->in_cell, sizeof(unsigned char) * capacity);
+    vertex_pool->normal = realloc(vertex_pool->normal, sizeof(vec3) * capacity);
+    vertex_pool->eis = realloc(vertex_pool->eis, sizeof(int[12]) * capacity);
+    vertex_pool->qef = realloc(vertex_pool->qef, sizeof(struct QefData) * capacity);
+    vertex_pool->capacity = capacity;
+  }
+
+  vertex_pool->count += count;
+  return start;
+}
+
+static inline void manifold_vertex_pool_set(struct ManifoldVertexPool* vertex_pool, int vertex, struct QefData* qef, vec3 normal, int eis[12], int euler, int in_cell, bool face_prop2, float error) {
+  vertex_pool->parent[vertex] = -1;
+  vertex_pool->index[vertex] = -1;
+  vertex_pool->surface_index[vertex] = -1;
+  vertex_pool->error[vertex] = error;
+  vertex_pool->euler[vertex] = euler;
+  vertex_pool->face_prop2[vertex] = face_prop2;
+  vertex_pool->in_cell[vertex] = (unsigned char)in_cell;
+  vertex_pool->normal[vertex] = normal;
+  memcpy(vertex_pool->eis[vertex], eis, sizeof(int) * 12);
+  vertex_pool->qef[vertex] = *qef;
+}
+
+// Note: Gives every node in the list its own range of the pool sized by its vertex_count, one serial pass so the parallel passes after it never grow the pool
+static inline void manifold_octree_reserve_vertices(struct ManifoldVertexPool* vertex_pool, struct ManifoldOctreeNode* level_nodes, int* node_nums, int node_count) {
+  int total_vertices = 0;
+  for (int list_num = 0; list_num < node_count; list_num++) {
+    struct ManifoldOctreeNode* octree_node = &level_nodes[(node_nums != NULL) ? node_nums[list_num] : list_num];
+    octree_node->vertex_start = vertex_pool->count + total_vertices;
+    total_vertices += octree_node->vertex_count;
+  }
+
+  manifold_vertex_pool_reserve(vertex_pool, total_vertices);
+}
+
+static inline int manifold_octree_get_vertex_count(unsigned char corners) {
+  int vertex_count = 0;
+  for (int e = 0; e < 16; e++) {
+    int code = TransformedEdgesTable[corners][e];
+    if (code == -2)
+      return vertex_count + 1;
+    if (code == -1)
+      vertex_count++;
+  }
+
+  return vertex_count;
+}
+
+// Note: A tree that was reset at the same size keeps its level arrays and vertex pool, so rebuilding it never goes back to the allocator
+static inline void manifold_octree_release_density(struct ManifoldOctreeLevels* levels) {
+  if (levels->density == NULL)
+    return;
+
+  if (levels->density_cache != NULL)
+    density_cache_release(levels->density_cache, levels->density);
+  else if (levels->density_noise_allocated)
+    noise_free(levels->density);
+  else
+    free(levels->density);
+  levels->density = NULL;
+  levels->density_cache = NULL;
+  levels->density_noise_allocated = false;
+}
+
+// Note: density_cache can be NULL, otherwise the density is borrowed from it and only sampled on a miss
+void manifold_octree_construct_base(struct ManifoldOctreeLevels* levels, int size, struct Vector* noises, struct DensityCache* density_cache) {
+  if (levels->nodes[0] != NULL && levels->size != size)
+    manifold_octree_destroy_octree(levels);
+
+  levels->size = size;
+  levels->level_count = 0;
+  for (int current_level = size; current_level > 0; current_level /= 2)
+    levels->level_count++;
+  levels->brick_level = MAX(levels->level_count - 1 - MANIFOLD_OCTREE_BRICK_LEVELS, 0);
+  if (levels->nodes[0] == NULL) {
+    for (int level_num = 0; level_num < levels->level_count; level_num++)
+      vector_init(&levels->dirty_nodes[level_num], sizeof(int));
+    manifold_vertex_pool_init(&levels->vertices);
+    levels->nodes[0] = calloc(1, sizeof(struct ManifoldOctreeNode));
+  }
+
+  struct ManifoldOctreeNode* octree_node = levels->nodes[0];
+  *octree_node = (struct ManifoldOctreeNode){0};
   octree_node->position = VEC3_ZERO;
   octree_node->size = size;
   octree_node->type = MANIFOLD_NODE_INTERNAL;
   octree_node->child_index = 0;
+  octree_node->level = 0;
+  octree_node->first_child = 0;
 
   //#pragma omp parallel sections num_threads(omp_get_max_threads())
   struct Noise* noise = vector_get(noises, 0);
-  float* noise_set = ridged_fractal_noise_eval_3d_avx2(&noise->ridged_fractal_noise, size, size, size);
+  manifold_octree_release_density(levels);
+  levels->density_cache = density_cache;
+  if (density_cache != NULL) {
+    const struct DensityCacheKey key = {.noise_hash = density_cache_hash_noises(noises, true), .origin = VEC3_ZERO, .step = noise->ridged_fractal_noise.step, .samples = size + 1};
+    levels->density = density_cache_acquire(density_cache, key);
+    if (levels->density == NULL)
+      levels->density = density_cache_insert(density_cache, key, ridged_fractal_noise_eval_3d_avx2(&noise->ridged_fractal_noise, size + 1, size + 1, size + 1), true);
+  } else {
+    levels->density = ridged_fractal_noise_eval_3d_avx2(&noise->ridged_fractal_noise, size + 1, size + 1, size + 1);
+    levels->density_noise_allocated = true;
+  }
   //omp_set_max_active_levels(2);
   //int used_threads = 8;
 
   //int max_threads = omp_get_max_threads();
   //struct Threadz thread_pool[12] = {0};
   //manifold_octree_construct_nodes(octree_node, noises, noise_set, max_threads, thread_pool);
-  manifold_octree_construct_nodes(octree_node, noises, noise_set);
-  noise_free(noise_set);
+  manifold_octree_construct_nodes(levels, noises);
 }
 
-static inline void manifold_octree_find_vertice(struct Vertex* vertex, struct Map* vertice_map) {
-  if (vertex == NULL)
-    return;
-
-  manifold_octree_find_vertice(vertex->parent, vertice_map);
+// Note: Nodes and vertices are owned by the level arrays and the pool, so teardown is a handful of frees no matter how the tree was edited
+void manifold_octree_destroy_octree(struct ManifoldOctreeLevels* levels) {
+  for (int level_num = 0; level_num < levels->level_count; level_num++) {
+    free(levels->nodes[level_num]);
+    vector_delete(&levels->dirty_nodes[level_num]);
+  }
 
-  // NOTE: On a 64 bit archetiecture 8 bytes are allocated for a memory address, yet a hex value uses 4 bits per value. Meaning a memory address in hex is length of 16 numbers aka 8 bytes * 8 bits / 4 hex
-  char buffer[((sizeof(char*) * 8) / 4) + 1] = {0};
-  sprintf(buffer, "%p", vertex);
-  map_set(vertice_map, buffer, &vertex);
+  free(levels->brick_nodes);
+  manifold_vertex_pool_delete(&levels->vertices);
+  manifold_octree_release_density(levels);
+  memset(levels, 0, sizeof(struct ManifoldOctreeLevels));
 }
 
-void manifold_octree_destroy_octree(struct ManifoldOctreeNode* octree_node, struct Map* vertice_map) {
-  if (!octree_node)
-    return;
+// Drops the tree's contents but keeps the level arrays and pool capacity for the next construct_base
+void manifold_octree_reset(struct ManifoldOctreeLevels* levels) {
+  for (int level_num = 0; level_num < levels->level_count; level_num++)
+    vector_clear(&levels->dirty_nodes[level_num]);
 
-  for (int i = 0; i < 8; i++)
-    manifold_octree_destroy_octree(octree_node->children[i], vertice_map);
+  levels->vertices.count = 0;
+  manifold_octree_release_density(levels);
+}
 
-  if (octree_node->vertices) {
-    for (int vertice_num = 0; vertice_num < array_list_size(octree_node->vertices); vertice_num++)
-      manifold_octree_find_vertice(array_list_get(octree_node->vertices, vertice_num), vertice_map);
-    array_list_delete(octree_node->vertices);
-    free(octree_node->vertices);
-  }
+// Note: Edits write into the density, so one borrowed from the cache is swapped for a private copy first
+void manifold_octree_own_density(struct ManifoldOctreeLevels* levels) {
+  if (levels->density_cache == NULL || levels->density == NULL)
+    return;
 
-  free(octree_node);
+  const size_t density_bytes = sizeof(float) * (levels->size + 1) * (levels->size + 1) * (levels->size + 1);
+  float* density = malloc(density_bytes);
+  memcpy(density, levels->density, density_bytes);
+  density_cache_release(levels->density_cache, levels->density);
+  levels->density = density;
+  levels->density_cache = NULL;
+  levels->density_noise_allocated = false;
 }
 
 struct VertexFound {
   struct VertexManifoldDualContouring vertex_data;
-  struct Vertex* vertex_handle;
+  int vertex_handle;
 };
 
-static inline void manifold_octree_generate_vertex_buffer_thread_split(struct ManifoldOctreeNode* octree_node, struct Vector* vertices) {
+static inline struct VertexManifoldDualContouring manifold_octree_get_vertex_data(struct ManifoldVertexPool* vertex_pool, int vertex, vec3 solved_x) {
+  const vec3 normal = vertex_pool->normal[vertex];
+  vec3 nc = vec3_old_skool_normalise(vec3_add(vec3_scale(normal, 0.5f), vec3_scale(VEC3_ONE, 0.5f)));
+  return (struct VertexManifoldDualContouring){.position.x = solved_x.x, .position.y = solved_x.y, .position.z = solved_x.z, .color.r = nc.r, .color.g = nc.g, .color.b = nc.b, .normal1.r = normal.r, .normal1.g = normal.g, .normal1.b = normal.b, .normal2.r = normal.r, .normal2.g = normal.g, .normal2.b = normal.b};
+}
+
+static inline void manifold_octree_generate_vertex_buffer_thread_split(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* octree_node, struct Vector* vertices) {
   if (octree_node->type != MANIFOLD_NODE_LEAF) {
     for (int i = 0; i < 8; i++) {
-      if (octree_node->children[i] != NULL)
-        manifold_octree_generate_vertex_buffer_thread_split(octree_node->children[i], vertices);
+      struct ManifoldOctreeNode* child = manifold_octree_get_child(levels, octree_node, i);
+      if (child != NULL)
+        manifold_octree_generate_vertex_buffer_thread_split(levels, child, vertices);
     }
   }
 
-  if (vertices == NULL || octree_node->vertices == NULL || array_list_size(octree_node->vertices) == 0)
-    return;
+  for (int vertice_num = 0; vertice_num < octree_node->vertex_count; vertice_num++)
+    vector_push_back(vertices, (struct VertexFound[]){(struct VertexFound){.vertex_handle = octree_node->vertex_start + vertice_num}});
+}
 
-  for (int i = 0; i < array_list_size(octree_node->vertices); i++) {
-    struct Vertex* ver = (struct Vertex*)array_list_get(octree_node->vertices, i);
-    if (ver == NULL)
-      continue;
-    vec3 nc = vec3_old_skool_normalise(vec3_add(vec3_scale(ver->normal, 0.5f), vec3_scale(VEC3_ONE, 0.5f)));
-    vec3 solved_x = VEC3_ZERO;
-    qef_solver_solve(&ver->qef, &solved_x, 1e-6f, 4, 1e-6f);
-    vector_push_back(vertices, (struct VertexFound[]){(struct VertexFound){.vertex_data = (struct VertexManifoldDualContouring){.position.x = solved_x.x, .position.y = solved_x.y, .position.z = solved_x.z, .color.r = nc.r, .color.g = nc.g, .color.b = nc.b, .normal1.r = ver->normal.r, .normal1.g = ver->normal.g, .normal1.b = ver->normal.b, .normal2.r = ver->normal.r, .normal2.g = ver->normal.g, .normal2.b = ver->normal.b}, .vertex_handle = ver}});
+// Note: Positions are solved QEF_BATCH_WIDTH vertices at a time so gathering comes first and the vertex data is filled in after
+static inline void manifold_octree_solve_vertex_data(struct ManifoldVertexPool* vertex_pool, struct VertexFound* found_vertices, int found_count) {
+  for (int batch_start = 0; batch_start < found_count; batch_start += QEF_BATCH_WIDTH) {
+    const int batch_count = MIN(QEF_BATCH_WIDTH, found_count - batch_start);
+    struct QefBatch qef_batch;
+    qef_batch_init(&qef_batch);
+    for (int lane = 0; lane < batch_count; lane++)
+      qef_batch_add(&qef_batch, &vertex_pool->qef[found_vertices[batch_start + lane].vertex_handle]);
+
+    vec3 positions[QEF_BATCH_WIDTH];
+    qef_batch_solve(&qef_batch, positions, NULL, 1e-6f, 4, 1e-6f);
+    for (int lane = 0; lane < batch_count; lane++) {
+      struct VertexFound* found_vertex = &found_vertices[batch_start + lane];
+      found_vertex->vertex_data = manifold_octree_get_vertex_data(vertex_pool, found_vertex->vertex_handle, positions[lane]);
+    }
   }
 }
 
-void manifold_octree_generate_vertex_buffer(struct ManifoldOctreeNode* octree_node, struct Vector* vertices) {
-  struct Vector vert_vectors[8] = {0};
-  for (int vector_num = 0; vector_num < 8; vector_num++)
-    vector_init(&vert_vectors[vector_num], sizeof(struct VertexFound));
+// Note: Error only matters once the whole tree is clustered, so each pass leaves it out and this fills it in for the listed nodes in batches
+static inline void manifold_octree_solve_errors(struct ManifoldVertexPool* vertex_pool, struct ManifoldOctreeNode* level_nodes, int* node_nums, int node_count) {
+  struct Vector batch_vertices = {0};
+  vector_init(&batch_vertices, sizeof(int));
+  for (int list_num = 0; list_num < node_count; list_num++) {
+    struct ManifoldOctreeNode* octree_node = &level_nodes[(node_nums != NULL) ? node_nums[list_num] : list_num];
+    for (int vertice_num = 0; vertice_num < octree_node->vertex_count; vertice_num++)
+      vector_push_back(&batch_vertices, (int[]){octree_node->vertex_start + vertice_num});
+  }
 
-  // Spawn thread for each octree child
-  if (octree_node->type != MANIFOLD_NODE_LEAF) {
-#pragma omp parallel for num_threads(omp_get_max_threads())
-    for (int i = 0; i < 8; i++) {
-      if (octree_node->children[i] != NULL)
-        manifold_octree_generate_vertex_buffer_thread_split(octree_node->children[i], &vert_vectors[i]);
+  const int vertex_count = vector_size(&batch_vertices);
+  const int* vertices = vector_get(&batch_vertices, 0);
+#pragma omp parallel for schedule(static) num_threads(omp_get_max_threads())
+  for (int batch_start = 0; batch_start < vertex_count; batch_start += QEF_BATCH_WIDTH) {
+    const int batch_count = MIN(QEF_BATCH_WIDTH, vertex_count - batch_start);
+    struct QefBatch qef_batch;
+    qef_batch_init(&qef_batch);
+    for (int lane = 0; lane < batch_count; lane++)
+      qef_batch_add(&qef_batch, &vertex_pool->qef[vertices[batch_start + lane]]);
+
+    vec3 positions[QEF_BATCH_WIDTH];
+    float errors[QEF_BATCH_WIDTH];
+    qef_batch_solve(&qef_batch, positions, errors, 1e-6f, 4, 1e-6f);
+    for (int lane = 0; lane < batch_count; lane++)
+      vertex_pool->error[vertices[batch_start + lane]] = errors[lane];
+  }
+
+  vector_delete(&batch_vertices);
+}
+
+// Note: Work below the root is handed out as one item per node of levels 1 to split_level, an item on split_level takes the node's whole subtree and one above it only the node's own share. Items go out with a dynamic schedule so a surface bunched into a couple of octants still spreads over every thread, each writes its own vector and they're joined in the post order a serial walk gives
+struct ManifoldOctreeSplit {
+  int split_level;
+  int item_count;
+  int level_offsets[MANIFOLD_OCTREE_MAX_LEVELS + 1];
+  struct Vector* items;
+  int* order;
+  // Note: Items under root child i start at root_child_starts[i] in order
+  int root_child_starts[9];
+};
+
+static inline void manifold_octree_split_order(struct ManifoldOctreeSplit* split, int level_num, int node_num, int* order_num) {
+  if (level_num < split->split_level) {
+    for (int i = 0; i < 8; i++)
+      manifold_octree_split_order(split, level_num + 1, node_num * 8 + i, order_num);
+  }
+  split->order[(*order_num)++] = split->level_offsets[level_num] + node_num;
+}
+
+// Note: Levels down to brick_level are dense so an item's node is found from its number alone
+static inline void manifold_octree_split_init(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeSplit* split, size_t item_size) {
+  split->split_level = MAX(MIN(MANIFOLD_OCTREE_SPLIT_LEVELS, levels->brick_level), 1);
+  split->item_count = 0;
+  for (int level_num = 1, level_nodes = 8; level_num <= split->split_level; level_num++, level_nodes *= 8) {
+    split->level_offsets[level_num] = split->item_count;
+    split->item_count += level_nodes;
+  }
+  split->level_offsets[split->split_level + 1] = split->item_count;
+
+  split->items = malloc(sizeof(struct Vector) * split->item_count);
+  for (int item_num = 0; item_num < split->item_count; item_num++)
+    vector_init(&split->items[item_num], item_size);
+
+  split->order = malloc(sizeof(int) * split->item_count);
+  int order_num = 0;
+  for (int i = 0; i < 8; i++) {
+    split->root_child_starts[i] = order_num;
+    manifold_octree_split_order(split, 1, i, &order_num);
+  }
+  split->root_child_starts[8] = order_num;
+}
+
+static inline void manifold_octree_split_delete(struct ManifoldOctreeSplit* split) {
+  for (int item_num = 0; item_num < split->item_count; item_num++)
+    vector_delete(&split->items[item_num]);
+  free(split->items);
+  free(split->order);
+}
+
+static inline struct ManifoldOctreeNode* manifold_octree_split_get_node(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeSplit* split, int item_num, int* level_num) {
+  *level_num = 1;
+  while (item_num >= split->level_offsets[*level_num + 1])
+    (*level_num)++;
+  return &levels->nodes[*level_num][item_num - split->level_offsets[*level_num]];
+}
+
+void manifold_octree_generate_vertex_buffer(struct ManifoldOctreeLevels* levels, struct Vector* vertices) {
+  struct ManifoldOctreeNode* octree_node = levels->nodes[0];
+  if (octree_node->type == MANIFOLD_NODE_LEAF)
+    return;
+
+  struct ManifoldOctreeSplit split = {0};
+  manifold_octree_split_init(levels, &split, sizeof(struct VertexFound));
+
+#pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
+  for (int item_num = 0; item_num < split.item_count; item_num++) {
+    int level_num = 0;
+    struct ManifoldOctreeNode* item_node = manifold_octree_split_get_node(levels, &split, item_num, &level_num);
+    struct Vector* found_vertices = &split.items[item_num];
+    if (item_node->type == MANIFOLD_NODE_NONE)
+      continue;
+
+    if (level_num == split.split_level)
+      manifold_octree_generate_vertex_buffer_thread_split(levels, item_node, found_vertices);
+    else {
+      for (int vertice_num = 0; vertice_num < item_node->vertex_count; vertice_num++)
+        vector_push_back(found_vertices, (struct VertexFound[]){(struct VertexFound){.vertex_handle = item_node->vertex_start + vertice_num}});
     }
+    manifold_octree_solve_vertex_data(&levels->vertices, vector_get(found_vertices, 0), vector_size(found_vertices));
   }
 
-  // Combine child vectors
-  for (int vector_num = 0; vector_num < 8; vector_num++) {
-    for (int vert_num = 0; vert_num < vector_size(&vert_vectors[vector_num]); vert_num++) {
-      struct VertexFound* new_vertex = vector_get(&vert_vectors[vector_num], vert_num);
-      new_vertex->vertex_handle->index = vector_size(vertices);
+  // Combine item vectors
+  for (int order_num = 0; order_num < split.item_count; order_num++) {
+    struct Vector* found_vertices = &split.items[split.order[order_num]];
+    for (int vert_num = 0; vert_num < vector_size(found_vertices); vert_num++) {
+      struct VertexFound* new_vertex = vector_get(found_vertices, vert_num);
+      levels->vertices.index[new_vertex->vertex_handle] = vector_size(vertices);
       mesh_manifold_dual_contouring_assign_vertex_simple(vertices, new_vertex->vertex_data);
     }
   }
 
-  for (int vector_num = 0; vector_num < 8; vector_num++)
-    vector_delete(&vert_vectors[vector_num]);
+  manifold_octree_split_delete(&split);
 }
 
 // Working
@@ -202,69 +456,173 @@ void manifold_octree_generate_vertex_buffer(struct ManifoldOctreeNode* octree_no
   }
 }*/
 
-// Note: Extremely fast terrain generation done with multithreading and iteration, no joke came up with this while on the toilet
-static inline void manifold_octree_construct_nodes(struct ManifoldOctreeNode* octree_node, struct Vector* noises, float* noise_set) {
-  int levels = 0;
-  for (int current_level = octree_node->size; current_level > 0; current_level /= 2)
-    levels++;
 
+static inline int manifold_octree_get_parent_number(struct ManifoldOctreeLevels* levels, int level_num, int node_num) {
+  return (level_num == levels->brick_level + 1) ? levels->brick_nodes[node_num / 8] : node_num / 8;
+}
+
+// Note: True when the brick's samples aren't all on one side of the surface, each row is compared 8 samples at a time
+static inline bool manifold_octree_brick_straddles(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* brick) {
+  const int samples = levels->size + 1;
+  const int row_length = brick->size + 1;
+  const int x = (int)brick->position.x, y = (int)brick->position.y, z = (int)brick->position.z;
+  int below = 0, above = 0;
+  for (int dz = 0; dz < row_length; dz++) {
+    for (int dy = 0; dy < row_length; dy++) {
+      const float* row = &levels->density[x + samples * ((y + dy) + samples * (z + dz))];
+      for (int dx = 0; dx < row_length; dx += 8) {
+        const int lanes = MIN(8, row_length - dx);
+        const __m256i lane_mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(lanes), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        const int row_below = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_maskload_ps(row + dx, lane_mask), _mm256_setzero_ps(), _CMP_LT_OQ));
+        below |= row_below;
+        above |= ~row_below & ((1 << lanes) - 1);
+      }
+      if (below != 0 && above != 0)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+// Note: Grows every level under the brick level together so slot s always owns nodes s * 8 ^ j up to (s + 1) * 8 ^ j of level brick_level + j
+static inline void manifold_octree_reserve_bricks(struct ManifoldOctreeLevels* levels, int brick_count) {
+  if (brick_count > levels->brick_capacity) {
+    int capacity = MAX(levels->brick_capacity * 2, 64);
+    while (capacity < brick_count)
+      capacity *= 2;
+
+    levels->brick_nodes = realloc(levels->brick_nodes, sizeof(int) * capacity);
+    for (int level_num = levels->brick_level + 1, brick_nodes = 8; level_num < levels->level_count; level_num++, brick_nodes *= 8)
+      levels->nodes[level_num] = realloc(levels->nodes[level_num], sizeof(struct ManifoldOctreeNode) * brick_nodes * capacity);
+    levels->brick_capacity = capacity;
+  }
+
+  levels->brick_count = brick_count;
+  for (int level_num = levels->brick_level + 1, brick_nodes = 8; level_num < levels->level_count; level_num++, brick_nodes *= 8)
+    levels->node_counts[level_num] = brick_nodes * brick_count;
+}
+
+// Note: Lays out the nodes under every slot from first_slot on, they stay empty until the leaf passes fill them in
+static inline void manifold_octree_init_bricks(struct ManifoldOctreeLevels* levels, int first_slot) {
+  for (int level_num = levels->brick_level + 1, brick_nodes = 8; level_num < levels->level_count; level_num++, brick_nodes *= 8) {
+    struct ManifoldOctreeNode* level_nodes = levels->nodes[level_num];
+    struct ManifoldOctreeNode* parent_nodes = levels->nodes[level_num - 1];
+    const int child_size = levels->size >> level_num;
+#pragma omp parallel for schedule(static) num_threads(omp_get_max_threads())
+    for (int node_num = first_slot * brick_nodes; node_num < levels->node_counts[level_num]; node_num++) {
+      struct ManifoldOctreeNode* new_node = &level_nodes[node_num];
+      *new_node = (struct ManifoldOctreeNode){0};
+      octree_node_init(new_node, vec3_add(parent_nodes[manifold_octree_get_parent_number(levels, level_num, node_num)].position, vec3_scale(TCornerDeltas[node_num % 8], (float)child_size)), child_size, MANIFOLD_NODE_NONE);
+      new_node->child_index = node_num % 8;
+      new_node->level = level_num;
+      new_node->first_child = node_num * 8;
+    }
+  }
+}
+
+static inline void manifold_octree_add_brick(struct ManifoldOctreeLevels* levels, int brick_num) {
+  const int slot = levels->brick_count;
+  manifold_octree_reserve_bricks(levels, slot + 1);
+  levels->brick_nodes[slot] = brick_num;
+  levels->nodes[levels->brick_level][brick_num].first_child = slot * 8;
+  manifold_octree_init_bricks(levels, slot);
+}
+
+// Note: Extremely fast terrain generation done with multithreading and iteration, no joke came up with this while on the toilet
+static inline void manifold_octree_construct_nodes(struct ManifoldOctreeLevels* octree_levels, struct Vector* noises) {
+  struct ManifoldOctreeNode* octree_node = octree_levels->nodes[0];
+  const int levels = octree_levels->level_count;
   if (levels <= 1)
     return;
 
-  struct ManifoldOctreeNode* node_cache[levels];
-  memset(node_cache, 0, sizeof(struct ManifoldOctreeNode*) * levels);
-  int total_nodes[levels];
-  memset(total_nodes, 0, sizeof(int) * levels);
+  struct ManifoldOctreeNode** node_cache = octree_levels->nodes;
+  int* total_nodes = octree_levels->node_counts;
+  const int brick_level = octree_levels->brick_level;
 
   total_nodes[0] = 1;
   node_cache[0] = octree_node;
-  for (int series_num = 1; series_num < levels; series_num++) {
+  for (int series_num = 1; series_num <= brick_level; series_num++) {
     total_nodes[series_num] = pow(8, series_num);
-    node_cache[series_num] = calloc(1, sizeof(struct ManifoldOctreeNode) * pow(8, series_num));
+    if (node_cache[series_num] == NULL)
+      node_cache[series_num] = calloc(1, sizeof(struct ManifoldOctreeNode) * pow(8, series_num));
   }
 
   // Note: Needed to calculate position of lowest level
-  for (int node_level = 1; node_level < levels - 1; node_level++) {
+  for (int node_level = 1; node_level <= brick_level; node_level++) {
     const int child_size = octree_node->size / pow(2, node_level);
 #pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
     for (int node_num = 0; node_num < total_nodes[node_level]; node_num++) {
       int index = node_num % 8;
       vec3 child_pos = TCornerDeltas[index];
       struct ManifoldOctreeNode* new_node = &node_cache[node_level][node_num];
+      *new_node = (struct ManifoldOctreeNode){0};
       octree_node_init(new_node, vec3_add(node_cache[node_level - 1][node_num / 8].position, vec3_scale(child_pos, (float)child_size)), child_size, MANIFOLD_NODE_INTERNAL);
+      new_node->child_index = index;
+      new_node->level = node_level;
+      new_node->first_child = node_num * 8;
     }
   }
 
-// Note: Bulk of performance cost here, lowest level only
+  // Note: Most bricks are all air or all rock, only the ones the surface crosses get a slot and nodes below them
+  struct ManifoldOctreeNode* bricks = node_cache[brick_level];
+#pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
+  for (int node_num = 0; node_num < total_nodes[brick_level]; node_num++)
+    bricks[node_num].first_child = manifold_octree_brick_straddles(octree_levels, &bricks[node_num]) ? 0 : -1;
+
+  int brick_count = 0;
+  for (int node_num = 0; node_num < total_nodes[brick_level]; node_num++)
+    brick_count += (bricks[node_num].first_child == 0);
+  manifold_octree_reserve_bricks(octree_levels, brick_count);
+
+  for (int node_num = 0, slot = 0; node_num < total_nodes[brick_level]; node_num++) {
+    if (bricks[node_num].first_child == 0) {
+      octree_levels->brick_nodes[slot] = node_num;
+      bricks[node_num].first_child = (slot++) * 8;
+    }
+  }
+  manifold_octree_init_bricks(octree_levels, 0);
+
+  // Note: Bulk of performance cost here, lowest level only. Signs first so every leaf's vertex range can be handed out before the parallel fill
+  struct ManifoldOctreeNode* leaves = node_cache[levels - 1];
 #pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
   for (int node_num = 0; node_num < total_nodes[levels - 1]; node_num++) {
-    int index = node_num % 8;
-    vec3 child_pos = TCornerDeltas[index];
-    struct ManifoldOctreeNode* new_node = &node_cache[levels - 1][node_num];
-    octree_node_init(new_node, vec3_add(node_cache[levels - 2][node_num / 8].position, vec3_scale(child_pos, 1)), 1, MANIFOLD_NODE_INTERNAL);
-    if (manifold_octree_construct_leaf(new_node, noises, octree_node->size, noise_set) == false)
-      new_node->type = MANIFOLD_NODE_NONE;
+    struct ManifoldOctreeNode* new_node = &leaves[node_num];
+    float samples[8];
+    new_node->corners = manifold_octree_leaf_corners(new_node, octree_node->size, octree_levels->density, samples);
+    new_node->type = (new_node->corners == 0 || new_node->corners == 255) ? MANIFOLD_NODE_NONE : MANIFOLD_NODE_LEAF;
+    new_node->vertex_count = (new_node->type == MANIFOLD_NODE_LEAF) ? manifold_octree_get_vertex_count(new_node->corners) : 0;
   }
 
+  manifold_octree_reserve_vertices(&octree_levels->vertices, leaves, NULL, total_nodes[levels - 1]);
+
+#pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
+  for (int node_num = 0; node_num < total_nodes[levels - 1]; node_num++) {
+    if (leaves[node_num].type == MANIFOLD_NODE_LEAF)
+      manifold_octree_construct_leaf(&octree_levels->vertices, &leaves[node_num], noises, octree_node->size, octree_levels->density, false);
+  }
+  manifold_octree_solve_errors(&octree_levels->vertices, leaves, NULL, total_nodes[levels - 1]);
+
   // Note: Below can be optomized with simd but already very fast probably not needed
   for (int node_level = levels - 2; node_level >= 0; node_level--) {
 #pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
     for (int node_num = 0; node_num < total_nodes[node_level]; node_num++) {
-      int index = node_num % 8;
-      bool has_children = false;
+      unsigned char child_mask = 0;
       struct ManifoldOctreeNode* got_node = &node_cache[node_level][node_num];
+      if (got_node->first_child < 0) {
+        got_node->child_mask = 0;
+        got_node->type = MANIFOLD_NODE_NONE;
+        continue;
+      }
 #pragma omp simd
       {
         for (int index = 0; index < 8; index++) {
-          struct ManifoldOctreeNode* found_node = &node_cache[node_level + 1][(node_num * 8) + index];
-          if (found_node->type == MANIFOLD_NODE_NONE)
-            continue;
-          has_children |= true;
-          got_node->children[index] = found_node;
-          got_node->children[index]->child_index = index;
+          if (node_cache[node_level + 1][got_node->first_child + index].type != MANIFOLD_NODE_NONE)
+            child_mask |= (unsigned char)(1 << index);
         }
       }
-      got_node->type = (has_children) ? MANIFOLD_NODE_INTERNAL : MANIFOLD_NODE_NONE;
+      got_node->child_mask = child_mask;
+      got_node->type = (child_mask != 0) ? MANIFOLD_NODE_INTERNAL : MANIFOLD_NODE_NONE;
     }
   }
 
@@ -272,28 +630,38 @@ static inline void manifold_octree_construct_nodes(struct ManifoldOctreeNode* oc
 }
 
 // TODO: Optimize below as much as possible
-static inline bool manifold_octree_construct_leaf(struct ManifoldOctreeNode* octree_node, struct Vector* noises, int scale, float* noise_set) {
-  octree_node->type = MANIFOLD_NODE_LEAF;
+// Note: Gradient of the trilinear blend of the cell's corner samples, used where edits mean the noise no longer describes the surface
+static inline vec3 manifold_octree_grid_normal(float samples[8], vec3 local) {
+  const float fx = local.x, fy = local.y, fz = local.z;
+  vec3 gradient;
+  gradient.x = (1 - fy) * (1 - fz) * (samples[4] - samples[0]) + (1 - fy) * fz * (samples[5] - samples[1]) + fy * (1 - fz) * (samples[6] - samples[2]) + fy * fz * (samples[7] - samples[3]);
+  gradient.y = (1 - fx) * (1 - fz) * (samples[2] - samples[0]) + (1 - fx) * fz * (samples[3] - samples[1]) + fx * (1 - fz) * (samples[6] - samples[4]) + fx * fz * (samples[7] - samples[5]);
+  gradient.z = (1 - fx) * (1 - fy) * (samples[1] - samples[0]) + (1 - fx) * fy * (samples[3] - samples[2]) + fx * (1 - fy) * (samples[5] - samples[4]) + fx * fy * (samples[7] - samples[6]);
+  return vec3_old_skool_normalise(gradient);
+}
+
+static inline unsigned char manifold_octree_leaf_corners(struct ManifoldOctreeNode* octree_node, int scale, float* density, float samples[8]) {
   int corners = 0;
-  float samples[8] = {0};
 
 // Start with this
 #pragma omp simd
   {
     for (int sample_num = 0; sample_num < 8; sample_num++) {
       vec3 sample_position = vec3_add(octree_node->position, TCornerDeltas[sample_num]);
-      samples[sample_num] = noise_get(noise_set, scale, scale, scale, sample_position.x, sample_position.y, sample_position.z);
+      samples[sample_num] = noise_get(density, scale + 1, scale + 1, scale + 1, sample_position.x, sample_position.y, sample_position.z);
       if (samples[sample_num] < 0)
         corners |= 1 << sample_num;
     }
   }
 
-  // Loop through all corners if all false then return
-  octree_node->corners = (unsigned char)corners;
-  if (corners == 0 || corners == 255)
-    return false;
+  return (unsigned char)corners;
+}
+
+// Note: Expects corners, type and the vertex range to be set already, fills the range with the leaf's vertices
+static inline void manifold_octree_construct_leaf(struct ManifoldVertexPool* vertex_pool, struct ManifoldOctreeNode* octree_node, struct Vector* noises, int scale, float* density, bool grid_normals) {
+  float samples[8] = {0};
+  const int corners = manifold_octree_leaf_corners(octree_node, scale, density, samples);
 
-  int total_edges = TransformedVerticesNumberTable[octree_node->corners];
   int v_edges[4][16] = {0};
 
   int v_index = 0;
@@ -315,15 +683,10 @@ static inline bool manifold_octree_construct_leaf(struct ManifoldOctreeNode* oct
     v_edges[v_index][e_index++] = code;
   }
 
-  octree_node->vertices = calloc(1, sizeof(struct ArrayList));
-  array_list_init(octree_node->vertices);
-
   for (int i = 0; i < v_index; i++) {
     int k = 0;
-    struct Vertex* get_vertice = calloc(1, sizeof(struct Vertex));
-    vertex_init(get_vertice);
-    array_list_add(octree_node->vertices, get_vertice);
-    qef_solver_init(&get_vertice->qef);
+    struct QefSolver qef = {0};
+    qef_solver_init(&qef);
     vec3 normal = VEC3_ZERO;
     int ei[12] = {0};
     while (v_edges[i][k] != -1) {
@@ -331,101 +694,105 @@ static inline bool manifold_octree_construct_leaf(struct ManifoldOctreeNode* oct
       vec3 a = vec3_add(octree_node->position, vec3_scale(TCornerDeltas[TEdgePairs[v_edges[i][k]][0]], octree_node->size));
       vec3 b = vec3_add(octree_node->position, vec3_scale(TCornerDeltas[TEdgePairs[v_edges[i][k]][1]], octree_node->size));
       vec3 intersection = vec3_add(a, vec3_divs(vec3_scale(vec3_sub(b, a), -samples[TEdgePairs[v_edges[i][k]][0]]), samples[TEdgePairs[v_edges[i][k]][1]] - samples[TEdgePairs[v_edges[i][k]][0]]));
-      vec3 n = planet_normal(intersection, noises, scale);
+      vec3 n = (grid_normals) ? manifold_octree_grid_normal(samples, vec3_sub(intersection, octree_node->position)) : planet_normal(intersection, noises, scale);
       normal = vec3_add(normal, n);
-      qef_solver_add_simp(&get_vertice->qef, intersection, n);
+      qef_solver_add_simp(&qef, intersection, n);
       k++;
     }
 
     normal = vec3_old_skool_divs(normal, k);
     normal = vec3_old_skool_normalise(normal);
-    get_vertice->index = array_list_size(octree_node->vertices);
-    get_vertice->parent = NULL;
-    get_vertice->collapsible = true;
-    get_vertice->normal = normal;
-    get_vertice->euler = 1;
-    memcpy(get_vertice->eis, ei, sizeof(int) * 12);
-    get_vertice->in_cell = octree_node->child_index;
-    get_vertice->face_prop2 = true;
-    vec3 emp_buffer = VEC3_ZERO;
-    qef_solver_solve(&get_vertice->qef, &emp_buffer, 1e-6f, 4, 1e-6f);
-    get_vertice->error = qef_solver_get_error_pos(&get_vertice->qef, get_vertice->qef.x);
+    manifold_vertex_pool_set(vertex_pool, octree_node->vertex_start + i, &qef.data, normal, ei, 1, octree_node->child_index, true, 0.0f);
   }
-
-  return true;
 }
 // TODO: Optimize above as much as possible
 
-static inline void manifold_octree_process_cell_split_threads(struct ManifoldOctreeNode* octree_node, struct Vector* indexes, float threshold) {
-  if (octree_node->type == MANIFOLD_NODE_INTERNAL) {
-    for (int i = 0; i < 8; i++) {
-      if (octree_node->children[i] != NULL)
-        manifold_octree_process_cell_split_threads(octree_node->children[i], indexes, threshold);
-    }
+// Note: Quads along the faces and edges shared between a node's children, everything inside a child is left to the child
+static inline void manifold_octree_process_cell_faces(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* octree_node, struct Vector* indexes, float threshold) {
+  struct ManifoldOctreeNode* children[8];
+  for (int i = 0; i < 8; i++)
+    children[i] = manifold_octree_get_child(levels, octree_node, i);
 
-    for (int i = 0; i < 12; i++) {
-      struct ManifoldOctreeNode* face_nodes[2] = {NULL};
+  for (int i = 0; i < 12; i++) {
+    struct ManifoldOctreeNode* face_nodes[2] = {NULL};
 
-      int c1 = TEdgePairs[i][0];
-      int c2 = TEdgePairs[i][1];
+    int c1 = TEdgePairs[i][0];
+    int c2 = TEdgePairs[i][1];
 
-      face_nodes[0] = octree_node->children[c1];
-      face_nodes[1] = octree_node->children[c2];
+    face_nodes[0] = children[c1];
+    face_nodes[1] = children[c2];
 
-      manifold_octree_process_face(face_nodes, TEdgePairs[i][2], indexes, threshold);
-    }
+    manifold_octree_process_face(levels, face_nodes, TEdgePairs[i][2], indexes, threshold);
+  }
 
-    for (int i = 0; i < 6; i++) {
-      struct ManifoldOctreeNode* edge_nodes[4] = {octree_node->children[TCellProcEdgeMask[i][0]], octree_node->children[TCellProcEdgeMask[i][1]], octree_node->children[TCellProcEdgeMask[i][2]], octree_node->children[TCellProcEdgeMask[i][3]]};
+  for (int i = 0; i < 6; i++) {
+    struct ManifoldOctreeNode* edge_nodes[4] = {children[TCellProcEdgeMask[i][0]], children[TCellProcEdgeMask[i][1]], children[TCellProcEdgeMask[i][2]], children[TCellProcEdgeMask[i][3]]};
 
-      manifold_octree_process_edge(edge_nodes, TCellProcEdgeMask[i][4], indexes, threshold);
-    }
+    manifold_octree_process_edge(levels, edge_nodes, TCellProcEdgeMask[i][4], indexes, threshold);
   }
 }
 
-void manifold_octree_process_cell(struct ManifoldOctreeNode* octree_node, struct Vector* indexes, float threshold) {
-  struct Vector index_vectors[8] = {0};
-  for (int index_num = 0; index_num < 8; index_num++)
-    vector_init(&index_vectors[index_num], sizeof(uint32_t));
-
-  // Spawn thread for each octree child
+static inline void manifold_octree_process_cell_split_threads(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* octree_node, struct Vector* indexes, float threshold) {
   if (octree_node->type == MANIFOLD_NODE_INTERNAL) {
-#pragma omp parallel for num_threads(omp_get_max_threads())
     for (int i = 0; i < 8; i++) {
-      if (octree_node->children[i] != NULL)
-        manifold_octree_process_cell_split_threads(octree_node->children[i], &index_vectors[i], threshold);
+      struct ManifoldOctreeNode* child = manifold_octree_get_child(levels, octree_node, i);
+      if (child != NULL)
+        manifold_octree_process_cell_split_threads(levels, child, indexes, threshold);
     }
 
-    // Combine child indices
-    for (int vector_num = 0; vector_num < 8; vector_num++) {
-      for (int vert_num = 0; vert_num < vector_size(&index_vectors[vector_num]); vert_num++)
-        mesh_assign_indice(indexes, *(uint32_t*)vector_get(&index_vectors[vector_num], vert_num));
-    }
+    manifold_octree_process_cell_faces(levels, octree_node, indexes, threshold);
+  }
+}
 
-    for (int i = 0; i < 12; i++) {
-      struct ManifoldOctreeNode* face_nodes[2] = {NULL};
+// Note: index_offsets can be NULL, otherwise it gets where each root child's range and the root's own range start so edits can patch them later
+void manifold_octree_process_cell(struct ManifoldOctreeLevels* levels, struct Vector* indexes, float threshold, int index_offsets[MANIFOLD_OCTREE_INDEX_RANGES + 1]) {
+  struct ManifoldOctreeNode* octree_node = levels->nodes[0];
 
-      int c1 = TEdgePairs[i][0];
-      int c2 = TEdgePairs[i][1];
+  if (index_offsets != NULL) {
+    for (int range_num = 0; range_num <= MANIFOLD_OCTREE_INDEX_RANGES; range_num++)
+      index_offsets[range_num] = vector_size(indexes);
+  }
 
-      face_nodes[0] = octree_node->children[c1];
-      face_nodes[1] = octree_node->children[c2];
+  if (octree_node->type != MANIFOLD_NODE_INTERNAL)
+    return;
 
-      manifold_octree_process_face(face_nodes, TEdgePairs[i][2], indexes, threshold);
-    }
+  struct ManifoldOctreeSplit split = {0};
+  manifold_octree_split_init(levels, &split, sizeof(uint32_t));
+
+#pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
+  for (int item_num = 0; item_num < split.item_count; item_num++) {
+    int level_num = 0;
+    struct ManifoldOctreeNode* item_node = manifold_octree_split_get_node(levels, &split, item_num, &level_num);
+    if (item_node->type != MANIFOLD_NODE_INTERNAL)
+      continue;
 
-    for (int i = 0; i < 6; i++) {
-      struct ManifoldOctreeNode* edge_nodes[4] = {octree_node->children[TCellProcEdgeMask[i][0]], octree_node->children[TCellProcEdgeMask[i][1]], octree_node->children[TCellProcEdgeMask[i][2]], octree_node->children[TCellProcEdgeMask[i][3]]};
+    if (level_num == split.split_level)
+      manifold_octree_process_cell_split_threads(levels, item_node, &split.items[item_num], threshold);
+    else
+      manifold_octree_process_cell_faces(levels, item_node, &split.items[item_num], threshold);
+  }
 
-      manifold_octree_process_edge(edge_nodes, TCellProcEdgeMask[i][4], indexes, threshold);
+  // Combine item indices, root child by root child
+  for (int range_num = 0; range_num < 8; range_num++) {
+    if (index_offsets != NULL)
+      index_offsets[range_num] = vector_size(indexes);
+    for (int order_num = split.root_child_starts[range_num]; order_num < split.root_child_starts[range_num + 1]; order_num++) {
+      struct Vector* item_indexes = &split.items[split.order[order_num]];
+      for (int vert_num = 0; vert_num < vector_size(item_indexes); vert_num++)
+        mesh_assign_indice(indexes, *(uint32_t*)vector_get(item_indexes, vert_num));
     }
   }
 
-  for (int index_num = 0; index_num < 8; index_num++)
-    vector_delete(&index_vectors[index_num]);
+  if (index_offsets != NULL)
+    index_offsets[8] = vector_size(indexes);
+  manifold_octree_process_cell_faces(levels, octree_node, indexes, threshold);
+  if (index_offsets != NULL)
+    index_offsets[9] = vector_size(indexes);
+
+  manifold_octree_split_delete(&split);
 }
 
-static inline void manifold_octree_process_face(struct ManifoldOctreeNode* nodes[2], int direction, struct Vector* indexes, float threshold) {
+static inline void manifold_octree_process_face(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* nodes[2], int direction, struct Vector* indexes, float threshold) {
   if (nodes[0] == NULL || nodes[1] == NULL)
     return;
 
@@ -437,10 +804,10 @@ static inline void manifold_octree_process_face(struct ManifoldOctreeNode* nodes
         if (nodes[j]->type == MANIFOLD_NODE_LEAF)
           face_nodes[j] = nodes[j];
         else
-          face_nodes[j] = nodes[j]->children[TFaceProcFaceMask[direction][i][j]];
+          face_nodes[j] = manifold_octree_get_child(levels, nodes[j], TFaceProcFaceMask[direction][i][j]);
       }
 
-      manifold_octree_process_face(face_nodes, TFaceProcFaceMask[direction][i][2], indexes, threshold);
+      manifold_octree_process_face(levels, face_nodes, TFaceProcFaceMask[direction][i][2], indexes, threshold);
     }
 
     int orders[2][4] = {{0, 0, 1, 1}, {0, 1, 0, 1}};
@@ -452,20 +819,20 @@ static inline void manifold_octree_process_face(struct ManifoldOctreeNode* nodes
         if (nodes[orders[TFaceProcEdgeMask[direction][i][0]][j]]->type == MANIFOLD_NODE_LEAF)
           edge_nodes[j] = nodes[orders[TFaceProcEdgeMask[direction][i][0]][j]];
         else
-          edge_nodes[j] = nodes[orders[TFaceProcEdgeMask[direction][i][0]][j]]->children[TFaceProcEdgeMask[direction][i][1 + j]];
+          edge_nodes[j] = manifold_octree_get_child(levels, nodes[orders[TFaceProcEdgeMask[direction][i][0]][j]], TFaceProcEdgeMask[direction][i][1 + j]);
       }
 
-      manifold_octree_process_edge(edge_nodes, TFaceProcEdgeMask[direction][i][5], indexes, threshold);
+      manifold_octree_process_edge(levels, edge_nodes, TFaceProcEdgeMask[direction][i][5], indexes, threshold);
     }
   }
 }
 
-static inline void manifold_octree_process_edge(struct ManifoldOctreeNode* nodes[4], int direction, struct Vector* indexes, float threshold) {
+static inline void manifold_octree_process_edge(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* nodes[4], int direction, struct Vector* indexes, float threshold) {
   if (nodes[0] == NULL || nodes[1] == NULL || nodes[2] == NULL || nodes[3] == NULL)
     return;
 
   if (nodes[0]->type == MANIFOLD_NODE_LEAF && nodes[1]->type == MANIFOLD_NODE_LEAF && nodes[2]->type == MANIFOLD_NODE_LEAF && nodes[3]->type == MANIFOLD_NODE_LEAF) {
-    manifold_octree_process_indexes(nodes, direction, indexes, threshold);
+    manifold_octree_process_indexes(&levels->vertices, nodes, direction, indexes, threshold);
   } else {
     for (int i = 0; i < 2; i++) {
       struct ManifoldOctreeNode* edge_nodes[4] = {NULL};
@@ -474,15 +841,15 @@ static inline void manifold_octree_process_edge(struct ManifoldOctreeNode* nodes
         if (nodes[j]->type == MANIFOLD_NODE_LEAF)
           edge_nodes[j] = nodes[j];
         else
-          edge_nodes[j] = nodes[j]->children[TEdgeProcEdgeMask[direction][i][j]];
+          edge_nodes[j] = manifold_octree_get_child(levels, nodes[j], TEdgeProcEdgeMask[direction][i][j]);
       }
 
-      manifold_octree_process_edge(edge_nodes, TEdgeProcEdgeMask[direction][i][4], indexes, threshold);
+      manifold_octree_process_edge(levels, edge_nodes, TEdgeProcEdgeMask[direction][i][4], indexes, threshold);
     }
   }
 }
 
-static inline void manifold_octree_process_indexes(struct ManifoldOctreeNode* nodes[4], int direction, struct Vector* indexes, float threshold) {
+static inline void manifold_octree_process_indexes(struct ManifoldVertexPool* vertex_pool, struct ManifoldOctreeNode* nodes[4], int direction, struct Vector* indexes, float threshold) {
   int min_size = 10000000;
   int indices[4] = {-1, -1, -1, -1};
   bool flip = false;
@@ -523,18 +890,19 @@ static inline void manifold_octree_process_indexes(struct ManifoldOctreeNode* no
       continue;
 
     v_count++;
-    if (index >= array_list_size(nodes[i]->vertices))
+    if (index >= nodes[i]->vertex_count)
       return;
-    struct Vertex* v = (struct Vertex*)array_list_get(nodes[i]->vertices, index);
-    struct Vertex* highest = v;
-    while (highest->parent != NULL) {
-      if (highest->parent->error <= threshold && (highest->parent->euler == 1 && highest->parent->face_prop2))
-        highest = v = highest->parent;
+    int v = nodes[i]->vertex_start + index;
+    int highest = v;
+    while (vertex_pool->parent[highest] != -1) {
+      const int parent = vertex_pool->parent[highest];
+      if (vertex_pool->error[parent] <= threshold && (vertex_pool->euler[parent] == 1 && vertex_pool->face_prop2[parent]))
+        highest = v = parent;
       else
-        highest = highest->parent;
+        highest = parent;
     }
 
-    indices[i] = v->index;
+    indices[i] = vertex_pool->index[v];
   }
 
   if (sign_changed) {
@@ -566,34 +934,86 @@ static inline void manifold_octree_process_indexes(struct ManifoldOctreeNode* no
   }
 }
 
-void manifold_octree_cluster_cell_base(struct ManifoldOctreeNode* octree_node, float error, struct Vector* noises) {
-  if (octree_node->type != MANIFOLD_NODE_INTERNAL)
-    return;
-
-#pragma omp parallel for num_threads(omp_get_max_threads())
+// Note: A node can't end up with more vertices than its children hold between them, so that's what it's given in the pool before clustering
+static inline int manifold_octree_count_child_vertices(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* octree_node) {
+  int child_vertices = 0;
   for (int i = 0; i < 8; i++) {
-    if (octree_node->children[i] == NULL)
-      continue;
+    struct ManifoldOctreeNode* child = manifold_octree_get_child(levels, octree_node, i);
+    if (child != NULL)
+      child_vertices += child->vertex_count;
+  }
 
-    manifold_octree_cluster_cell(octree_node->children[i], error, noises);
+  return child_vertices;
+}
+
+static inline struct ManifoldClusterScratch* manifold_cluster_scratch_create(int thread_count) {
+  struct ManifoldClusterScratch* scratch = calloc(thread_count, sizeof(struct ManifoldClusterScratch));
+  for (int thread_num = 0; thread_num < thread_count; thread_num++)
+    vector_init(&scratch[thread_num].collected_vertices, sizeof(int));
+  return scratch;
+}
+
+static inline void manifold_cluster_scratch_free(struct ManifoldClusterScratch* scratch, int thread_count) {
+  for (int thread_num = 0; thread_num < thread_count; thread_num++) {
+    vector_delete(&scratch[thread_num].collected_vertices);
+    free(scratch[thread_num].bucket_starts);
+    free(scratch[thread_num].sorted_vertices);
   }
+  free(scratch);
 }
 
-static inline void manifold_octree_cluster_cell(struct ManifoldOctreeNode* octree_node, float error, struct Vector* noises) {
-  if (octree_node->type != MANIFOLD_NODE_INTERNAL)
+static inline void manifold_cluster_scratch_reserve(int** buffer, int* capacity, int count) {
+  if (count <= *capacity)
     return;
 
+  int new_capacity = MAX(*capacity * 2, 64);
+  while (new_capacity < count)
+    new_capacity *= 2;
+  *buffer = realloc(*buffer, sizeof(int) * new_capacity);
+  *capacity = new_capacity;
+}
+
+// Note: Level by level from the bottom so every child is clustered before its parent, nodes on one level share no vertices so each level is one parallel loop. The root itself is never clustered
+// Note: Every level hands out all of its nodes dynamically so a lopsided surface still spreads over every thread, only level 1 is split by octant and it's ~1 / 20 of the pass. See the bound in manifold_dual_contouring_benchmark_scaling
+void manifold_octree_cluster_cell_base(struct ManifoldOctreeLevels* levels, float error) {
+  const int thread_count = omp_get_max_threads();
+  struct ManifoldClusterScratch* scratch = manifold_cluster_scratch_create(thread_count);
+
+  for (int level_num = levels->level_count - 2; level_num >= 1; level_num--) {
+    struct ManifoldOctreeNode* level_nodes = levels->nodes[level_num];
+    const int total_nodes = levels->node_counts[level_num];
+    for (int node_num = 0; node_num < total_nodes; node_num++)
+      level_nodes[node_num].vertex_count = (level_nodes[node_num].type == MANIFOLD_NODE_INTERNAL) ? manifold_octree_count_child_vertices(levels, &level_nodes[node_num]) : 0;
+    manifold_octree_reserve_vertices(&levels->vertices, level_nodes, NULL, total_nodes);
+
+#pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
+    for (int node_num = 0; node_num < total_nodes; node_num++) {
+      if (level_nodes[node_num].type == MANIFOLD_NODE_INTERNAL)
+        manifold_octree_cluster_node(levels, &level_nodes[node_num], error, &scratch[omp_get_thread_num()]);
+    }
+    manifold_octree_solve_errors(&levels->vertices, level_nodes, NULL, total_nodes);
+  }
+
+  manifold_cluster_scratch_free(scratch, thread_count);
+}
+
+// Note: Expects every child to be clustered already, their vertices to have no parent yet and this node's vertex range to be reserved
+static inline void manifold_octree_cluster_node(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* octree_node, float error, struct ManifoldClusterScratch* scratch) {
+  struct ManifoldVertexPool* vertex_pool = &levels->vertices;
+  struct ManifoldOctreeNode* children[8];
+  for (int i = 0; i < 8; i++)
+    children[i] = manifold_octree_get_child(levels, octree_node, i);
+
   int signs[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
   int mid_sign = -1;
 
   for (int i = 0; i < 8; i++) {
-    if (octree_node->children[i] == NULL)
+    if (children[i] == NULL)
       continue;
 
-    manifold_octree_cluster_cell(octree_node->children[i], error, noises);
-    if (octree_node->children[i]->type != MANIFOLD_NODE_INTERNAL) {
-      mid_sign = (octree_node->children[i]->corners >> (7 - i)) & 1;
-      signs[i] = (octree_node->children[i]->corners >> i) & 1;
+    if (children[i]->type != MANIFOLD_NODE_INTERNAL) {
+      mid_sign = (children[i]->corners >> (7 - i)) & 1;
+      signs[i] = (children[i]->corners >> i) & 1;
     }
   }
 
@@ -606,10 +1026,9 @@ static inline void manifold_octree_cluster_cell(struct ManifoldOctreeNode* octre
   }
 
   int surface_index = 0;
-  struct ArrayList collected_vertices = {0};
-  array_list_init(&collected_vertices);
-  struct ArrayList* new_vertices = calloc(1, sizeof(struct ArrayList));
-  array_list_init(new_vertices);
+  struct Vector* collected_vertices = &scratch->collected_vertices;
+  vector_clear(collected_vertices);
+  int new_vertices = 0;
 
   for (int i = 0; i < 12; i++) {
     struct ManifoldOctreeNode* face_nodes[2] = {NULL};
@@ -617,15 +1036,15 @@ static inline void manifold_octree_cluster_cell(struct ManifoldOctreeNode* octre
     int c1 = TEdgePairs[i][0];
     int c2 = TEdgePairs[i][1];
 
-    face_nodes[0] = octree_node->children[c1];
-    face_nodes[1] = octree_node->children[c2];
+    face_nodes[0] = children[c1];
+    face_nodes[1] = children[c2];
 
-    manifold_octree_cluster_face(face_nodes, TEdgePairs[i][2], &surface_index, &collected_vertices);
+    manifold_octree_cluster_face(levels, face_nodes, TEdgePairs[i][2], &surface_index, collected_vertices);
   }
 
   for (int i = 0; i < 6; i++) {
-    struct ManifoldOctreeNode* edge_nodes[4] = {octree_node->children[TCellProcEdgeMask[i][0]], octree_node->children[TCellProcEdgeMask[i][1]], octree_node->children[TCellProcEdgeMask[i][2]], octree_node->children[TCellProcEdgeMask[i][3]]};
-    manifold_octree_cluster_edge(edge_nodes, TCellProcEdgeMask[i][4], &surface_index, &collected_vertices);
+    struct ManifoldOctreeNode* edge_nodes[4] = {children[TCellProcEdgeMask[i][0]], children[TCellProcEdgeMask[i][1]], children[TCellProcEdgeMask[i][2]], children[TCellProcEdgeMask[i][3]]};
+    manifold_octree_cluster_edge(levels, edge_nodes, TCellProcEdgeMask[i][4], &surface_index, collected_vertices);
   }
 
   int highest_index = surface_index;
@@ -634,52 +1053,70 @@ static inline void manifold_octree_cluster_cell(struct ManifoldOctreeNode* octre
     highest_index = 0;
 
   for (int octree_num = 0; octree_num < 8; octree_num++) {
-    struct ManifoldOctreeNode* n = octree_node->children[octree_num];
+    struct ManifoldOctreeNode* n = children[octree_num];
     if (n == NULL)
       continue;
 
-    for (int vertice_num = 0; vertice_num < array_list_size(n->vertices); vertice_num++) {
-      struct Vertex* v = (struct Vertex*)array_list_get(n->vertices, vertice_num);
-      if (v == NULL)
-        continue;
-      if (v->surface_index == -1) {
-        v->surface_index = highest_index++;
-        array_list_add(&collected_vertices, v);
+    for (int vertice_num = 0; vertice_num < n->vertex_count; vertice_num++) {
+      int v = n->vertex_start + vertice_num;
+      if (vertex_pool->surface_index[v] == -1) {
+        vertex_pool->surface_index[v] = highest_index++;
+        vector_push_back(collected_vertices, &v);
       }
     }
   }
 
-  if (array_list_size(&collected_vertices) > 0) {
-    for (int i = 0; i <= highest_index; i++) {
+  const int collected_count = (int)vector_size(collected_vertices);
+  const int* collected = vector_get(collected_vertices, 0);
+
+  if (collected_count > 0) {
+    // Note: One stable counting sort by surface index so each surface is a contiguous run, its vertices keep their collected order so the QEFs sum exactly as they did when every surface rescanned the whole list
+    const int bucket_count = highest_index + 1;
+    manifold_cluster_scratch_reserve(&scratch->bucket_starts, &scratch->bucket_capacity, bucket_count + 1);
+    manifold_cluster_scratch_reserve(&scratch->sorted_vertices, &scratch->sorted_capacity, collected_count);
+    int* bucket_starts = scratch->bucket_starts;
+    int* sorted_vertices = scratch->sorted_vertices;
+
+    memset(bucket_starts, 0, sizeof(int) * (bucket_count + 1));
+    for (int vertice_num = 0; vertice_num < collected_count; vertice_num++)
+      bucket_starts[vertex_pool->surface_index[collected[vertice_num]] + 1]++;
+    for (int i = 0; i < bucket_count; i++)
+      bucket_starts[i + 1] += bucket_starts[i];
+    for (int vertice_num = 0; vertice_num < collected_count; vertice_num++) {
+      int v = collected[vertice_num];
+      sorted_vertices[bucket_starts[vertex_pool->surface_index[v]]++] = v;
+    }
+
+    // Note: The scatter left each start at the end of its bucket, which is where the next bucket starts
+    int bucket_start = 0;
+    for (int i = 0; i < bucket_count; i++) {
+      const int bucket_end = bucket_starts[i];
+      const int count = bucket_end - bucket_start;
+      if (count == 0)
+        continue;
+
       struct QefSolver qef = {0};
       qef_solver_init(&qef);
       vec3 normal = VEC3_ZERO;
-      int count = 0;
       int edges[12] = {0};
       int euler = 0;
       int e = 0;
 
-      for (int vertice_num = 0; vertice_num < array_list_size(&collected_vertices); vertice_num++) {
-        struct Vertex* v = (struct Vertex*)array_list_get(&collected_vertices, vertice_num);
-        if (v->surface_index == i) {
-          for (int k = 0; k < 3; k++) {
-            int edge = TExternalEdges[v->in_cell][k];
-            edges[edge] += v->eis[edge];
-          }
-          for (int k = 0; k < 9; k++) {
-            int edge = TInternalEdges[v->in_cell][k];
-            e += v->eis[edge];
-          }
-          euler += v->euler;
-          qef_solver_add_copy(&qef, &v->qef.data);
-          normal = vec3_add(normal, v->normal);
-          count++;
+      for (int sorted_num = bucket_start; sorted_num < bucket_end; sorted_num++) {
+        int v = sorted_vertices[sorted_num];
+        for (int k = 0; k < 3; k++) {
+          int edge = TExternalEdges[vertex_pool->in_cell[v]][k];
+          edges[edge] += vertex_pool->eis[v][edge];
+        }
+        for (int k = 0; k < 9; k++) {
+          int edge = TInternalEdges[vertex_pool->in_cell[v]][k];
+          e += vertex_pool->eis[v][edge];
         }
+        euler += vertex_pool->euler[v];
+        qef_solver_add_copy(&qef, &vertex_pool->qef[v]);
+        normal = vec3_add(normal, vertex_pool->normal[v]);
       }
 
-      if (count == 0)
-        continue;
-
       bool face_prop2 = true;
       for (int f = 0; f < 6 && face_prop2; f++) {
         int intersections = 0;
@@ -690,47 +1127,25 @@ static inline void manifold_octree_cluster_cell(struct ManifoldOctreeNode* octre
           face_prop2 = false;
       }
 
-      struct Vertex* new_vertex = calloc(1, sizeof(struct Vertex));
-      vertex_init(new_vertex);
       normal = vec3_old_skool_divs(normal, count);
       normal = vec3_old_skool_normalise(normal);
-      new_vertex->normal = normal;
-      new_vertex->qef = qef;
-      memcpy(new_vertex->eis, edges, sizeof(int) * 12);
-      new_vertex->euler = euler - e / 4;
-      new_vertex->in_cell = octree_node->child_index;
-      new_vertex->face_prop2 = face_prop2;
-      array_list_add(new_vertices, new_vertex);
-
-      vec3 buf_extra = VEC3_ZERO;
-      qef_solver_solve(&qef, &buf_extra, 1e-6f, 4, 1e-6f);
-      float err = qef_solver_get_error(&qef);
-      new_vertex->collapsible = err <= error;
-      new_vertex->error = err;
-
-      for (int vertice_num = 0; vertice_num < array_list_size(&collected_vertices); vertice_num++) {
-        struct Vertex* v = (struct Vertex*)array_list_get(&collected_vertices, vertice_num);
-        if (v->surface_index == i)
-          v->parent = new_vertex;
-      }
+
+      const int new_vertex = octree_node->vertex_start + new_vertices++;
+      manifold_vertex_pool_set(vertex_pool, new_vertex, &qef.data, normal, edges, euler - e / 4, octree_node->child_index, face_prop2, 0.0f);
+
+      for (int sorted_num = bucket_start; sorted_num < bucket_end; sorted_num++)
+        vertex_pool->parent[sorted_vertices[sorted_num]] = new_vertex;
+      bucket_start = bucket_end;
     }
-  } else {
-    array_list_delete(new_vertices);
-    free(new_vertices);
-    array_list_delete(&collected_vertices);
-    return;
   }
 
-  for (int vertice_num = 0; vertice_num < array_list_size(&collected_vertices); vertice_num++) {
-    struct Vertex* v2 = (struct Vertex*)array_list_get(&collected_vertices, vertice_num);
-    v2->surface_index = -1;
-  }
+  for (int vertice_num = 0; vertice_num < collected_count; vertice_num++)
+    vertex_pool->surface_index[collected[vertice_num]] = -1;
 
-  octree_node->vertices = new_vertices;
-  array_list_delete(&collected_vertices);
+  octree_node->vertex_count = new_vertices;
 }
 
-static inline void manifold_octree_cluster_face(struct ManifoldOctreeNode* nodes[2], int direction, int* surface_index, struct ArrayList* collected_vertices) {
+static inline void manifold_octree_cluster_face(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* nodes[2], int direction, int* surface_index, struct Vector* collected_vertices) {
   if (nodes[0] == NULL || nodes[1] == NULL)
     return;
 
@@ -743,10 +1158,10 @@ static inline void manifold_octree_cluster_face(struct ManifoldOctreeNode* nodes
         if (nodes[j]->type != MANIFOLD_NODE_INTERNAL)
           face_nodes[j] = nodes[j];
         else
-          face_nodes[j] = nodes[j]->children[TFaceProcFaceMask[direction][i][j]];
+          face_nodes[j] = manifold_octree_get_child(levels, nodes[j], TFaceProcFaceMask[direction][i][j]);
       }
 
-      manifold_octree_cluster_face(face_nodes, TFaceProcFaceMask[direction][i][2], surface_index, collected_vertices);
+      manifold_octree_cluster_face(levels, face_nodes, TFaceProcFaceMask[direction][i][2], surface_index, collected_vertices);
     }
   }
 
@@ -760,16 +1175,16 @@ static inline void manifold_octree_cluster_face(struct ManifoldOctreeNode* nodes
       if (nodes[orders[TFaceProcEdgeMask[direction][i][0]][j]]->type != MANIFOLD_NODE_INTERNAL)
         edge_nodes[j] = nodes[orders[TFaceProcEdgeMask[direction][i][0]][j]];
       else
-        edge_nodes[j] = nodes[orders[TFaceProcEdgeMask[direction][i][0]][j]]->children[TFaceProcEdgeMask[direction][i][1 + j]];
+        edge_nodes[j] = manifold_octree_get_child(levels, nodes[orders[TFaceProcEdgeMask[direction][i][0]][j]], TFaceProcEdgeMask[direction][i][1 + j]);
     }
 
-    manifold_octree_cluster_edge(edge_nodes, TFaceProcEdgeMask[direction][i][5], surface_index, collected_vertices);
+    manifold_octree_cluster_edge(levels, edge_nodes, TFaceProcEdgeMask[direction][i][5], surface_index, collected_vertices);
   }
 }
 
-static inline void manifold_octree_cluster_edge(struct ManifoldOctreeNode* nodes[4], int direction, int* surface_index, struct ArrayList* collected_vertices) {
+static inline void manifold_octree_cluster_edge(struct ManifoldOctreeLevels* levels, struct ManifoldOctreeNode* nodes[4], int direction, int* surface_index, struct Vector* collected_vertices) {
   if ((nodes[0] == NULL || nodes[0]->type != MANIFOLD_NODE_INTERNAL) && (nodes[1] == NULL || nodes[1]->type != MANIFOLD_NODE_INTERNAL) && (nodes[2] == NULL || nodes[2]->type != MANIFOLD_NODE_INTERNAL) && (nodes[3] == NULL || nodes[3]->type != MANIFOLD_NODE_INTERNAL)) {
-    manifold_octree_cluster_indexes(nodes, direction, surface_index, collected_vertices);
+    manifold_octree_cluster_indexes(&levels->vertices, nodes, direction, surface_index, collected_vertices);
   } else {
     for (int i = 0; i < 2; i++) {
       struct ManifoldOctreeNode* edge_nodes[4] = {NULL};
@@ -779,20 +1194,19 @@ static inline void manifold_octree_cluster_edge(struct ManifoldOctreeNode* nodes
         if (nodes[j]->type == MANIFOLD_NODE_LEAF)
           edge_nodes[j] = nodes[j];
         else
-          edge_nodes[j] = nodes[j]->children[TEdgeProcEdgeMask[direction][i][j]];
+          edge_nodes[j] = manifold_octree_get_child(levels, nodes[j], TEdgeProcEdgeMask[direction][i][j]);
       }
 
-      manifold_octree_cluster_edge(edge_nodes, TEdgeProcEdgeMask[direction][i][4], surface_index, collected_vertices);
+      manifold_octree_cluster_edge(levels, edge_nodes, TEdgeProcEdgeMask[direction][i][4], surface_index, collected_vertices);
     }
   }
 }
 
-static inline void manifold_octree_cluster_indexes(struct ManifoldOctreeNode* nodes[8], int direction, int* max_surface_index, struct ArrayList* collected_vertices) {
+static inline void manifold_octree_cluster_indexes(struct ManifoldVertexPool* vertex_pool, struct ManifoldOctreeNode* nodes[4], int direction, int* max_surface_index, struct Vector* collected_vertices) {
   if (nodes[0] == NULL && nodes[1] == NULL && nodes[2] == NULL && nodes[3] == NULL)
     return;
 
-  struct Vertex*
-      vertices[4] = {NULL};
+  int vertices[4] = {-1, -1, -1, -1};
   int v_count = 0;
   int node_count = 0;
 
@@ -825,10 +1239,10 @@ static inline void manifold_octree_cluster_indexes(struct ManifoldOctreeNode* no
         break;
     }
 
-    if (!skip && index < array_list_size(nodes[i]->vertices)) {
-      vertices[i] = (struct Vertex*)array_list_get(nodes[i]->vertices, index);
-      while (vertices[i]->parent != NULL)
-        vertices[i] = vertices[i]->parent;
+    if (!skip && index < nodes[i]->vertex_count) {
+      vertices[i] = nodes[i]->vertex_start + index;
+      while (vertex_pool->parent[vertices[i]] != -1)
+        vertices[i] = vertex_pool->parent[vertices[i]];
       v_count++;
     }
   }
@@ -839,19 +1253,19 @@ static inline void manifold_octree_cluster_indexes(struct ManifoldOctreeNode* no
   int surface_index = -1;
 
   for (int i = 0; i < 4; i++) {
-    struct Vertex* v = vertices[i];
-    if (v == NULL)
+    int v = vertices[i];
+    if (v == -1)
       continue;
 
-    if (v->surface_index != -1) {
-      if (surface_index != -1 && surface_index != v->surface_index) {
-        for (int vertex_num = 0; vertex_num < array_list_size(collected_vertices); vertex_num++) {
-          struct Vertex* ver = (struct Vertex*)array_list_get(collected_vertices, vertex_num);
-          if (ver != NULL && ver->surface_index == v->surface_index)
-            ver->surface_index = surface_index;
+    if (vertex_pool->surface_index[v] != -1) {
+      if (surface_index != -1 && surface_index != vertex_pool->surface_index[v]) {
+        for (int vertex_num = 0; vertex_num < vector_size(collected_vertices); vertex_num++) {
+          int ver = *(int*)vector_get(collected_vertices, vertex_num);
+          if (vertex_pool->surface_index[ver] == vertex_pool->surface_index[v])
+            vertex_pool->surface_index[ver] = surface_index;
         }
       } else if (surface_index == -1)
-        surface_index = v->surface_index;
+        surface_index = vertex_pool->surface_index[v];
     }
   }
 
@@ -859,11 +1273,313 @@ static inline void manifold_octree_cluster_indexes(struct ManifoldOctreeNode* no
     surface_index = (*max_surface_index)++;
 
   for (int i = 0; i < 4; i++) {
-    struct Vertex* v = vertices[i];
-    if (v == NULL)
+    int v = vertices[i];
+    if (v == -1)
       continue;
-    if (v->surface_index == -1)
-      array_list_add(collected_vertices, v);
-    v->surface_index = surface_index;
+    if (vertex_pool->surface_index[v] == -1)
+      vector_push_back(collected_vertices, &v);
+    vertex_pool->surface_index[v] = surface_index;
+  }
+}
+
+static inline int manifold_octree_get_brick_number(struct ManifoldOctreeLevels* levels, int x, int y, int z) {
+  int node_num = 0;
+  for (int bit = levels->size / 2; bit >= (levels->size >> levels->brick_level); bit /= 2)
+    node_num = (node_num * 8) + (((x & bit) ? 4 : 0) | ((y & bit) ? 2 : 0) | ((z & bit) ? 1 : 0));
+  return node_num;
+}
+
+// Note: Only valid for a cell whose brick has a slot, the slot stands in for the bits above the brick
+static inline int manifold_octree_get_leaf_number(struct ManifoldOctreeLevels* levels, int slot, int x, int y, int z) {
+  int node_num = slot;
+  for (int bit = (levels->size >> levels->brick_level) / 2; bit > 0; bit /= 2)
+    node_num = (node_num * 8) + (((x & bit) ? 4 : 0) | ((y & bit) ? 2 : 0) | ((z & bit) ? 1 : 0));
+  return node_num;
+}
+
+// Rebuilds every leaf touching density samples in [min, max] and reclusters their ancestors, returns how many vertices were dropped
+int manifold_octree_rebuild_region(struct ManifoldOctreeLevels* levels, ivec3 min, ivec3 max, float error, struct Vector* noises) {
+  const int leaf_level = levels->level_count - 1;
+  if (leaf_level < 1)
+    return 0;
+
+  // Note: A sample is a corner of the cells on both sides of it
+  const ivec3 cell_min = (ivec3){.x = MAX(min.x - 1, 0), .y = MAX(min.y - 1, 0), .z = MAX(min.z - 1, 0)};
+  const ivec3 cell_max = (ivec3){.x = MIN(max.x, levels->size - 1), .y = MIN(max.y, levels->size - 1), .z = MIN(max.z, levels->size - 1)};
+  if (cell_min.x > cell_max.x || cell_min.y > cell_max.y || cell_min.z > cell_max.z)
+    return 0;
+
+  const int span_x = cell_max.x - cell_min.x + 1;
+  const int span_y = cell_max.y - cell_min.y + 1;
+  const int span_z = cell_max.z - cell_min.z + 1;
+  const int cell_count = span_x * span_y * span_z;
+
+  // Note: Bricks the edit pushed the surface into get a slot first, ones it emptied keep theirs until the next full build
+  const int brick_size = levels->size >> levels->brick_level;
+  struct ManifoldOctreeNode* bricks = levels->nodes[levels->brick_level];
+  for (int brick_z = cell_min.z / brick_size; brick_z <= cell_max.z / brick_size; brick_z++) {
+    for (int brick_y = cell_min.y / brick_size; brick_y <= cell_max.y / brick_size; brick_y++) {
+      for (int brick_x = cell_min.x / brick_size; brick_x <= cell_max.x / brick_size; brick_x++) {
+        const int brick_num = manifold_octree_get_brick_number(levels, brick_x * brick_size, brick_y * brick_size, brick_z * brick_size);
+        if (bricks[brick_num].first_child < 0 && manifold_octree_brick_straddles(levels, &bricks[brick_num]))
+          manifold_octree_add_brick(levels, brick_num);
+      }
+    }
+  }
+
+  // Note: Stops climbing at the first node already marked since its ancestors are marked too, cells in bricks without a slot start from the brick
+  for (int cell_num = 0; cell_num < cell_count; cell_num++) {
+    const int x = cell_min.x + (cell_num % span_x);
+    const int y = cell_min.y + ((cell_num / span_x) % span_y);
+    const int z = cell_min.z + (cell_num / (span_x * span_y));
+    int node_num = manifold_octree_get_brick_number(levels, x, y, z);
+    int level_num = levels->brick_level;
+    if (bricks[node_num].first_child >= 0) {
+      node_num = manifold_octree_get_leaf_number(levels, bricks[node_num].first_child / 8, x, y, z);
+      level_num = leaf_level;
+    }
+    for (; level_num >= 0; node_num = manifold_octree_get_parent_number(levels, level_num, node_num), level_num--) {
+      struct ManifoldOctreeNode* octree_node = &levels->nodes[level_num][node_num];
+      if (octree_node->dirty)
+        break;
+      octree_node->dirty = true;
+      vector_push_back(&levels->dirty_nodes[level_num], &node_num);
+    }
+  }
+
+  // Note: Old vertex ranges are left where they are in the pool, dirty nodes get fresh ones at the end
+  struct ManifoldOctreeNode* leaves = levels->nodes[leaf_level];
+  int* dirty_leaves = vector_get(&levels->dirty_nodes[leaf_level], 0);
+  const int dirty_leaf_count = vector_size(&levels->dirty_nodes[leaf_level]);
+  int freed = 0;
+#pragma omp parallel for schedule(dynamic) reduction(+ : freed) num_threads(omp_get_max_threads())
+  for (int dirty_num = 0; dirty_num < dirty_leaf_count; dirty_num++) {
+    struct ManifoldOctreeNode* leaf = &leaves[dirty_leaves[dirty_num]];
+    float samples[8];
+    freed += leaf->vertex_count;
+    leaf->corners = manifold_octree_leaf_corners(leaf, levels->size, levels->density, samples);
+    leaf->type = (leaf->corners == 0 || leaf->corners == 255) ? MANIFOLD_NODE_NONE : MANIFOLD_NODE_LEAF;
+    leaf->vertex_count = (leaf->type == MANIFOLD_NODE_LEAF) ? manifold_octree_get_vertex_count(leaf->corners) : 0;
+  }
+
+  manifold_octree_reserve_vertices(&levels->vertices, leaves, dirty_leaves, dirty_leaf_count);
+
+#pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
+  for (int dirty_num = 0; dirty_num < dirty_leaf_count; dirty_num++) {
+    struct ManifoldOctreeNode* leaf = &leaves[dirty_leaves[dirty_num]];
+    if (leaf->type == MANIFOLD_NODE_LEAF)
+      manifold_octree_construct_leaf(&levels->vertices, leaf, noises, levels->size, levels->density, true);
+  }
+  manifold_octree_solve_errors(&levels->vertices, leaves, dirty_leaves, dirty_leaf_count);
+
+  const int thread_count = omp_get_max_threads();
+  struct ManifoldClusterScratch* scratch = manifold_cluster_scratch_create(thread_count);
+
+  // Note: Same linking and clustering as a full build but only along the dirty paths, clean children keep their clusters and only have their top vertices detached from this node's old ones
+  for (int level_num = leaf_level - 1; level_num >= 0; level_num--) {
+    struct ManifoldOctreeNode* level_nodes = levels->nodes[level_num];
+    int* dirty_nodes = vector_get(&levels->dirty_nodes[level_num], 0);
+    const int dirty_count = vector_size(&levels->dirty_nodes[level_num]);
+    for (int dirty_num = 0; dirty_num < dirty_count; dirty_num++) {
+      struct ManifoldOctreeNode* octree_node = &level_nodes[dirty_nodes[dirty_num]];
+      unsigned char child_mask = 0;
+      for (int index = 0; index < 8 && octree_node->first_child >= 0; index++) {
+        if (levels->nodes[level_num + 1][octree_node->first_child + index].type != MANIFOLD_NODE_NONE)
+          child_mask |= (unsigned char)(1 << index);
+      }
+      octree_node->child_mask = child_mask;
+      octree_node->type = (child_mask != 0) ? MANIFOLD_NODE_INTERNAL : MANIFOLD_NODE_NONE;
+
+      if (level_num == 0)
+        continue;
+
+      freed += octree_node->vertex_count;
+      octree_node->vertex_count = 0;
+      if (octree_node->type != MANIFOLD_NODE_INTERNAL)
+        continue;
+
+      for (int i = 0; i < 8; i++) {
+        struct ManifoldOctreeNode* child = manifold_octree_get_child(levels, octree_node, i);
+        for (int vertice_num = 0; child != NULL && vertice_num < child->vertex_count; vertice_num++)
+          levels->vertices.parent[child->vertex_start + vertice_num] = -1;
+      }
+      octree_node->vertex_count = manifold_octree_count_child_vertices(levels, octree_node);
+    }
+
+    if (level_num == 0)
+      break;
+
+    manifold_octree_reserve_vertices(&levels->vertices, level_nodes, dirty_nodes, dirty_count);
+
+#pragma omp parallel for schedule(dynamic) num_threads(omp_get_max_threads())
+    for (int dirty_num = 0; dirty_num < dirty_count; dirty_num++) {
+      struct ManifoldOctreeNode* octree_node = &level_nodes[dirty_nodes[dirty_num]];
+      if (octree_node->type == MANIFOLD_NODE_INTERNAL)
+        manifold_octree_cluster_node(levels, octree_node, error, &scratch[omp_get_thread_num()]);
+    }
+    manifold_octree_solve_errors(&levels->vertices, level_nodes, dirty_nodes, dirty_count);
+  }
+
+  manifold_cluster_scratch_free(scratch, thread_count);
+  return freed;
+}
+
+// Note: Every dirty node got a fresh vertex range, those go on the end of the buffer and the slots of the dropped ones are left unreferenced
+void manifold_octree_append_dirty_vertices(struct ManifoldOctreeLevels* levels, struct Vector* vertices) {
+  struct Vector found_vertices = {0};
+  vector_init(&found_vertices, sizeof(struct VertexFound));
+  for (int level_num = 0; level_num < levels->level_count; level_num++) {
+    for (int dirty_num = 0; dirty_num < vector_size(&levels->dirty_nodes[level_num]); dirty_num++) {
+      struct ManifoldOctreeNode* octree_node = &levels->nodes[level_num][*(int*)vector_get(&levels->dirty_nodes[level_num], dirty_num)];
+      if (octree_node->type == MANIFOLD_NODE_NONE)
+        continue;
+
+      for (int vertice_num = 0; vertice_num < octree_node->vertex_count; vertice_num++)
+        vector_push_back(&found_vertices, (struct VertexFound[]){(struct VertexFound){.vertex_handle = octree_node->vertex_start + vertice_num}});
+    }
+  }
+
+  manifold_octree_solve_vertex_data(&levels->vertices, vector_get(&found_vertices, 0), vector_size(&found_vertices));
+  for (int found_num = 0; found_num < vector_size(&found_vertices); found_num++) {
+    struct VertexFound* found_vertex = vector_get(&found_vertices, found_num);
+    levels->vertices.index[found_vertex->vertex_handle] = vector_size(vertices);
+    mesh_manifold_dual_contouring_assign_vertex_simple(vertices, found_vertex->vertex_data);
+  }
+  vector_delete(&found_vertices);
+}
+
+// Note: Collapsing climbs vertex parents up to the root children, so a clean root child's triangles can't change and its range is copied over as is
+void manifold_octree_patch_indexes(struct ManifoldOctreeLevels* levels, struct Vector* indexes, float threshold) {
+  struct ManifoldOctreeNode* root = levels->nodes[0];
+  int* index_offsets = levels->index_offsets;
+  if (levels->level_count < 2 || root->type != MANIFOLD_NODE_INTERNAL) {
+    vector_clear(indexes);
+    for (int range_num = 0; range_num <= MANIFOLD_OCTREE_INDEX_RANGES; range_num++)
+      index_offsets[range_num] = 0;
+    return;
+  }
+
+  struct Vector index_vectors[8] = {0};
+  for (int index_num = 0; index_num < 8; index_num++)
+    vector_init(&index_vectors[index_num], sizeof(uint32_t));
+
+#pragma omp parallel for num_threads(omp_get_max_threads())
+  for (int i = 0; i < 8; i++) {
+    struct ManifoldOctreeNode* child = manifold_octree_get_child(levels, root, i);
+    if (levels->nodes[1][i].dirty && child != NULL)
+      manifold_octree_process_cell_split_threads(levels, child, &index_vectors[i], threshold);
+  }
+
+  struct Vector patched = {0};
+  vector_init(&patched, sizeof(uint32_t));
+  int patched_offsets[MANIFOLD_OCTREE_INDEX_RANGES + 1] = {0};
+  for (int vector_num = 0; vector_num < 8; vector_num++) {
+    patched_offsets[vector_num] = vector_size(&patched);
+    if (levels->nodes[1][vector_num].dirty) {
+      for (int vert_num = 0; vert_num < vector_size(&index_vectors[vector_num]); vert_num++)
+        mesh_assign_indice(&patched, *(uint32_t*)vector_get(&index_vectors[vector_num], vert_num));
+    } else {
+      for (int vert_num = index_offsets[vector_num]; vert_num < index_offsets[vector_num + 1]; vert_num++)
+        mesh_assign_indice(&patched, *(uint32_t*)vector_get(indexes, vert_num));
+    }
+  }
+
+  patched_offsets[8] = vector_size(&patched);
+  manifold_octree_process_cell_faces(levels, root, &patched, threshold);
+  patched_offsets[9] = vector_size(&patched);
+
+  struct Vector old_indexes = *indexes;
+  *indexes = patched;
+  vector_delete(&old_indexes);
+  memcpy(index_offsets, patched_offsets, sizeof(int) * (MANIFOLD_OCTREE_INDEX_RANGES + 1));
+
+  for (int index_num = 0; index_num < 8; index_num++)
+    vector_delete(&index_vectors[index_num]);
+}
+
+void manifold_octree_clear_dirty(struct ManifoldOctreeLevels* levels) {
+  for (int level_num = 0; level_num < levels->level_count; level_num++) {
+    for (int dirty_num = 0; dirty_num < vector_size(&levels->dirty_nodes[level_num]); dirty_num++)
+      levels->nodes[level_num][*(int*)vector_get(&levels->dirty_nodes[level_num], dirty_num)].dirty = false;
+    vector_clear(&levels->dirty_nodes[level_num]);
+  }
+}
+
+// Note: Edits leave dropped ranges behind in the pool, this copies the live ranges level by level into a fresh pool and remaps parents. Vertex buffer indexes are stale afterwards
+void manifold_octree_compact_vertices(struct ManifoldOctreeLevels* levels) {
+  struct ManifoldVertexPool* old_pool = &levels->vertices;
+  struct ManifoldVertexPool new_pool = {0};
+  manifold_vertex_pool_init(&new_pool);
+  int* remap = malloc(sizeof(int) * MAX(old_pool->count, 1));
+
+  for (int level_num = 1; level_num < levels->level_count; level_num++) {
+    for (int node_num = 0; node_num < levels->node_counts[level_num]; node_num++) {
+      struct ManifoldOctreeNode* octree_node = &levels->nodes[level_num][node_num];
+      if (octree_node->type == MANIFOLD_NODE_NONE || octree_node->vertex_count == 0)
+        continue;
+
+      const int start = manifold_vertex_pool_reserve(&new_pool, octree_node->vertex_count);
+      for (int vertice_num = 0; vertice_num < octree_node->vertex_count; vertice_num++) {
+        const int old_vertex = octree_node->vertex_start + vertice_num;
+        remap[old_vertex] = start + vertice_num;
+        manifold_vertex_pool_set(&new_pool, start + vertice_num, &old_pool->qef[old_vertex], old_pool->normal[old_vertex], old_pool->eis[old_vertex], old_pool->euler[old_vertex], old_pool->in_cell[old_vertex], old_pool->face_prop2[old_vertex], old_pool->error[old_vertex]);
+        new_pool.parent[start + vertice_num] = old_pool->parent[old_vertex];
+      }
+      octree_node->vertex_start = start;
+    }
+  }
+
+  // Note: Parents sit one level up so they were all copied above
+  for (int vertex = 0; vertex < new_pool.count; vertex++) {
+    if (new_pool.parent[vertex] != -1)
+      new_pool.parent[vertex] = remap[new_pool.parent[vertex]];
+  }
+
+  free(remap);
+  manifold_vertex_pool_delete(old_pool);
+  *old_pool = new_pool;
+}
+
+// Note: Runs after a full vertex and index pass. Triangles are only reordered inside their index range so edits can still patch root children, and the pool's vertex buffer indexes follow the vertices as they're welded and moved.
+// Indices stay 32 bit since edits append vertices and rewrite ranges afterwards
+void manifold_octree_optimize_mesh(struct ManifoldOctreeLevels* levels, struct Mesh* mesh, struct MeshOptimizeStats* stats) {
+  uint32_t* indices = mesh->indices->items;
+  int* index_offsets = levels->index_offsets;
+  struct MeshOptimizeStats optimize_stats = {0};
+  optimize_stats.vertices_before = vector_size(mesh->vertices);
+  optimize_stats.triangles_before = vector_size(mesh->indices) / 3;
+  optimize_stats.acmr_before = mesh_optimize_acmr(indices, vector_size(mesh->indices), optimize_stats.vertices_before, MESH_OPTIMIZE_CACHE_SIZE);
+
+  // Note: Ranges shrink as degenerates go, each is moved down to where the previous one now ends
+  int index_count = 0;
+  for (int range_num = 0; range_num < MANIFOLD_OCTREE_INDEX_RANGES; range_num++) {
+    const int range_start = index_offsets[range_num];
+    const int range_count = mesh_optimize_remove_degenerates(&indices[range_start], index_offsets[range_num + 1] - range_start);
+    memmove(&indices[index_count], &indices[range_start], sizeof(uint32_t) * range_count);
+    index_offsets[range_num] = index_count;
+    index_count += range_count;
+  }
+  index_offsets[MANIFOLD_OCTREE_INDEX_RANGES] = index_count;
+  mesh->indices->size = index_count;
+
+  const int old_vertex_count = vector_size(mesh->vertices);
+  uint32_t* weld_remap = malloc(sizeof(uint32_t) * MAX(old_vertex_count, 1));
+  const int vertex_count = mesh_optimize_weld_vertices(mesh->vertices, indices, index_count, weld_remap);
+  for (int range_num = 0; range_num < MANIFOLD_OCTREE_INDEX_RANGES; range_num++)
+    mesh_optimize_vertex_cache(&indices[index_offsets[range_num]], index_offsets[range_num + 1] - index_offsets[range_num], vertex_count, MESH_OPTIMIZE_CACHE_SIZE);
+  uint32_t* fetch_remap = malloc(sizeof(uint32_t) * MAX(vertex_count, 1));
+  mesh_optimize_vertex_fetch(mesh->vertices, indices, index_count, fetch_remap);
+
+  for (int vertex = 0; vertex < levels->vertices.count; vertex++) {
+    if (levels->vertices.index[vertex] >= 0 && levels->vertices.index[vertex] < old_vertex_count)
+      levels->vertices.index[vertex] = fetch_remap[weld_remap[levels->vertices.index[vertex]]];
   }
+  free(fetch_remap);
+  free(weld_remap);
+
+  optimize_stats.vertices_after = vertex_count;
+  optimize_stats.triangles_after = index_count / 3;
+  optimize_stats.acmr_after = mesh_optimize_acmr(indices, index_count, vertex_count, MESH_OPTIMIZE_CACHE_SIZE);
+  if (stats != NULL)
+    *stats = optimize_stats;
 }
@@ -41,26 +41,70 @@ void octree_init_none(struct OctreeNode* octree_node) {
   octree_init(octree_node, NODE_NONE);
 }
 
-void octree_destroy_octree(struct OctreeNode* node) {
-  if (!node)
-    return;
+void octree_arenas_init(struct DualContouring* dual_contouring) {
+  dual_contouring->octree_arena_count = omp_get_max_threads();
+  dual_contouring->octree_arenas = calloc(dual_contouring->octree_arena_count, sizeof(struct MemoryArena));
+  for (int arena_num = 0; arena_num < dual_contouring->octree_arena_count; arena_num++)
+    memory_arena_init(&dual_contouring->octree_arenas[arena_num], MEMORY_ARENA_DEFAULT_PAGE_SIZE);
+}
 
-  for (int i = 0; i < 8; i++)
-    octree_destroy_octree(node->children[i]);
+static inline struct MemoryArena* octree_get_arena(struct DualContouring* dual_contouring) {
+  return &dual_contouring->octree_arenas[omp_get_thread_num() % dual_contouring->octree_arena_count];
+}
+
+// Note: Every node and draw info lives in the octree arenas so the whole tree goes in one release
+void octree_destroy_octree(struct DualContouring* dual_contouring) {
+  for (int arena_num = 0; arena_num < dual_contouring->octree_arena_count; arena_num++)
+    memory_arena_delete(&dual_contouring->octree_arenas[arena_num]);
+  free(dual_contouring->octree_arenas);
+  dual_contouring->octree_arenas = NULL;
+  dual_contouring->octree_arena_count = 0;
+  dual_contouring->head = NULL;
+}
 
-  if (node->draw_info)
-    free(node->draw_info);
+// Note: Chunks own cells 0 to octree_size - 1 and build cell octree_size as well from the seam shell so border quads have all four cells
+static inline bool octree_node_in_grid(struct OctreeNode* node, struct DualContouring* dual_contouring) {
+  if (!dual_contouring->is_chunk)
+    return true;
 
-  free(node);
+  const int half_size = dual_contouring->octree_size / 2;
+  return node->min.x + half_size <= dual_contouring->octree_size && node->min.y + half_size <= dual_contouring->octree_size && node->min.z + half_size <= dual_contouring->octree_size;
 }
 
-struct OctreeNode* octree_simplify_octree(struct OctreeNode* node, float threshold) {
+// Note: The first and overlap cells of a chunk are the same cells as the overlap and first of its neighbours, keeping them as leaves on both sides makes the seam vertices match
+static inline bool octree_node_on_chunk_border(struct OctreeNode* node, struct DualContouring* dual_contouring) {
+  if (!dual_contouring->is_chunk)
+    return false;
+
+  const int half_size = dual_contouring->octree_size / 2;
+  for (int axis = 0; axis < 3; axis++) {
+    const int grid_min = node->min.data[axis] + half_size;
+    if (grid_min == 0 || grid_min + node->size > dual_contouring->octree_size)
+      return true;
+  }
+
+  return false;
+}
+
+// Note: Bottom up QEF collapse, nodes larger than task_size simplify their children as tasks since every subtree collapses independently
+struct OctreeNode* octree_simplify_octree(struct OctreeNode* node, float threshold, struct DualContouring* dual_contouring, int task_size) {
   if (!node)
     return NULL;
 
   if (node->type != NODE_INTERNAL)
     return node;
 
+  if (node->size > task_size) {
+    for (int i = 0; i < 8; i++) {
+#pragma omp task default(shared) firstprivate(i)
+      node->children[i] = octree_simplify_octree(node->children[i], threshold, dual_contouring, task_size);
+    }
+#pragma omp taskwait
+  } else {
+    for (int i = 0; i < 8; i++)
+      node->children[i] = octree_simplify_octree(node->children[i], threshold, dual_contouring, task_size);
+  }
+
   struct QefSolver qef = {0};
   qef_solver_init(&qef);
 
@@ -70,7 +114,6 @@ struct OctreeNode* octree_simplify_octree(struct OctreeNode* node, float thresho
   bool is_collapsible = true;
 
   for (int i = 0; i < 8; i++) {
-    node->children[i] = octree_simplify_octree(node->children[i], threshold);
     if (node->children[i]) {
       struct OctreeNode* child = node->children[i];
       if (child->type == NODE_INTERNAL)
@@ -86,7 +129,7 @@ struct OctreeNode* octree_simplify_octree(struct OctreeNode* node, float thresho
     }
   }
 
-  if (!is_collapsible)
+  if (!is_collapsible || octree_node_on_chunk_border(node, dual_contouring))
     return node;
 
   vec3 position = (vec3){.x = 0.0, .y = 0.0, .z = 0.0};
@@ -99,7 +142,7 @@ struct OctreeNode* octree_simplify_octree(struct OctreeNode* node, float thresho
   if (position.x < node->min.data[0] || position.x > (node->min.data[0] + node->size) || position.y < node->min.data[1] || position.y > (node->min.data[1] + node->size) || position.z < node->min.data[2] || position.z > (node->min.data[2] + node->size))
     position = qef.mass_point;
 
-  struct OctreeDrawInfo* draw_info = calloc(1, sizeof(struct OctreeDrawInfo));
+  struct OctreeDrawInfo* draw_info = memory_arena_alloc(octree_get_arena(dual_contouring), sizeof(struct OctreeDrawInfo));
   octree_draw_info_init(draw_info);
 
   for (int i = 0; i < 8; i++) {
@@ -122,14 +165,16 @@ struct OctreeNode* octree_simplify_octree(struct OctreeNode* node, float thresho
   draw_info->position = position;
   memcpy(&draw_info->qef, &qef.data, sizeof(struct QefData));
 
-  for (int i = 0; i < 8; i++) {
-    octree_destroy_octree(node->children[i]);
+  // Note: Collapsed children stay in the arena until the next rebuild
+  for (int i = 0; i < 8; i++)
     node->children[i] = NULL;
-  }
 
   node->type = NODE_PSUEDO;
   node->draw_info = draw_info;
 
+#pragma omp atomic
+  dual_contouring->simplify_stats.nodes_collapsed++;
+
   return node;
 }
 
@@ -154,6 +199,16 @@ void octree_generate_vertex_indices(struct OctreeNode* node, struct DualContouri
   }
 }
 
+// Note: Collapsed nodes can share a vertex across the quad so the triangles that fold to a line are dropped
+static inline void octree_assign_triangle(struct Mesh* mesh, int index_a, int index_b, int index_c) {
+  if (index_a == index_b || index_b == index_c || index_a == index_c)
+    return;
+
+  mesh_assign_indice(mesh->indices, index_a);
+  mesh_assign_indice(mesh->indices, index_b);
+  mesh_assign_indice(mesh->indices, index_c);
+}
+
 void octree_contour_process_edge(struct OctreeNode* node[4], int dir, struct DualContouring* dual_contouring) {
   int min_size = 1000000;
   int min_index = 0;
@@ -180,23 +235,17 @@ void octree_contour_process_edge(struct OctreeNode* node[4], int dir, struct Dua
     sign_change[i] = (m1 == MATERIAL_AIR && m2 != MATERIAL_AIR) || (m1 != MATERIAL_AIR && m2 == MATERIAL_AIR);
   }
 
+  // Note: An edge running through a chunk's overlap cells is the first cell of the next chunk along it, that chunk emits the quad
+  if (dual_contouring->is_chunk && node[min_index]->min.data[dir] + (dual_contouring->octree_size / 2) >= dual_contouring->octree_size)
+    return;
+
   if (sign_change[min_index]) {
     if (!flip) {
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[0]);
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[1]);
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[3]);
-
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[0]);
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[3]);
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[2]);
+      octree_assign_triangle(dual_contouring->mesh, indices[0], indices[1], indices[3]);
+      octree_assign_triangle(dual_contouring->mesh, indices[0], indices[3], indices[2]);
     } else {
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[0]);
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[3]);
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[1]);
-
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[0]);
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[2]);
-      mesh_assign_indice(dual_contouring->mesh->indices, indices[3]);
+      octree_assign_triangle(dual_contouring->mesh, indices[0], indices[3], indices[1]);
+      octree_assign_triangle(dual_contouring->mesh, indices[0], indices[2], indices[3]);
     }
   }
 }
@@ -332,35 +381,183 @@ vec3 octree_calculate_surface_normal(const vec3 p, struct DualContouring* dual_c
   return dest;
 }
 
+static inline int octree_crossing_step_search(vec3 edge_points[][2], float* dest_t, int edge_count, struct DualContouring* dual_contouring) {
+  const float increment = 1.0f / (float)OCTREE_CROSSING_STEPS;
+  const int half_size = dual_contouring->octree_size / 2;
+  float positions[OCTREE_MAX_CROSSINGS * OCTREE_CROSSING_SAMPLES][3];
+  float densities[OCTREE_MAX_CROSSINGS * OCTREE_CROSSING_SAMPLES];
+
+  for (int edge_num = 0; edge_num < edge_count; edge_num++) {
+    const vec3 p0 = edge_points[edge_num][0];
+    const vec3 p1 = edge_points[edge_num][1];
+    for (int step = 0; step < OCTREE_CROSSING_SAMPLES; step++) {
+      const float current_t = increment * step;
+      float* position = positions[(edge_num * OCTREE_CROSSING_SAMPLES) + step];
+      position[0] = p0.data[0] + ((p1.data[0] - p0.data[0]) * current_t) + half_size;
+      position[1] = p0.data[1] + ((p1.data[1] - p0.data[1]) * current_t) + half_size;
+      position[2] = p0.data[2] + ((p1.data[2] - p0.data[2]) * current_t) + half_size;
+    }
+  }
+
+  dual_contouring_density_batch(dual_contouring, positions, densities, edge_count * OCTREE_CROSSING_SAMPLES);
+
+  for (int edge_num = 0; edge_num < edge_count; edge_num++) {
+    float min_value = 100000.0f;
+    float t = 0.0f;
+    for (int step = 0; step < OCTREE_CROSSING_SAMPLES; step++) {
+      const float density = fabsf(densities[(edge_num * OCTREE_CROSSING_SAMPLES) + step]);
+      if (density < min_value) {
+        min_value = density;
+        t = increment * step;
+      }
+    }
+    dest_t[edge_num] = t;
+  }
+
+  return edge_count * OCTREE_CROSSING_SAMPLES;
+}
+
+static inline float octree_crossing_interpolate(float t0, float d0, float t1, float d1) {
+  if (d0 == d1)
+    return (t0 + t1) * 0.5f;
+
+  return MAX(t0, MIN(t1, t0 + ((t1 - t0) * (d0 / (d0 - d1)))));
+}
+
+// Note: Illinois variant of false position, the bracket always keeps the sign change so it can't walk off the edge
+static inline int octree_crossing_secant(vec3 edge_points[][2], float edge_densities[][2], float* dest_t, int edge_count, int iterations, struct DualContouring* dual_contouring) {
+  const int half_size = dual_contouring->octree_size / 2;
+  float t0[OCTREE_MAX_CROSSINGS], d0[OCTREE_MAX_CROSSINGS], t1[OCTREE_MAX_CROSSINGS], d1[OCTREE_MAX_CROSSINGS];
+  int side[OCTREE_MAX_CROSSINGS] = {0};
+  float positions[OCTREE_MAX_CROSSINGS][3];
+  float densities[OCTREE_MAX_CROSSINGS];
+
+  for (int edge_num = 0; edge_num < edge_count; edge_num++) {
+    t0[edge_num] = 0.0f;
+    d0[edge_num] = edge_densities[edge_num][0];
+    t1[edge_num] = 1.0f;
+    d1[edge_num] = edge_densities[edge_num][1];
+  }
+
+  for (int iteration = 0; iteration < iterations; iteration++) {
+    for (int edge_num = 0; edge_num < edge_count; edge_num++) {
+      const vec3 p0 = edge_points[edge_num][0];
+      const vec3 p1 = edge_points[edge_num][1];
+      const float t = octree_crossing_interpolate(t0[edge_num], d0[edge_num], t1[edge_num], d1[edge_num]);
+      dest_t[edge_num] = t;
+      positions[edge_num][0] = p0.data[0] + ((p1.data[0] - p0.data[0]) * t) + half_size;
+      positions[edge_num][1] = p0.data[1] + ((p1.data[1] - p0.data[1]) * t) + half_size;
+      positions[edge_num][2] = p0.data[2] + ((p1.data[2] - p0.data[2]) * t) + half_size;
+    }
+
+    dual_contouring_density_batch(dual_contouring, positions, densities, edge_count);
+
+    for (int edge_num = 0; edge_num < edge_count; edge_num++) {
+      if ((densities[edge_num] < 0.0f) == (d0[edge_num] < 0.0f)) {
+        t0[edge_num] = dest_t[edge_num];
+        d0[edge_num] = densities[edge_num];
+        if (side[edge_num] == -1)
+          d1[edge_num] *= 0.5f;
+        side[edge_num] = -1;
+      } else {
+        t1[edge_num] = dest_t[edge_num];
+        d1[edge_num] = densities[edge_num];
+        if (side[edge_num] == 1)
+          d0[edge_num] *= 0.5f;
+        side[edge_num] = 1;
+      }
+    }
+  }
+
+  for (int edge_num = 0; edge_num < edge_count; edge_num++)
+    dest_t[edge_num] = octree_crossing_interpolate(t0[edge_num], d0[edge_num], t1[edge_num], d1[edge_num]);
+
+  return edge_count * iterations;
+}
+
+// Returns the number of density evaluations spent, edge_densities are the cached corner densities at both ends
+int octree_approximate_zero_crossing_positions(vec3 edge_points[][2], float edge_densities[][2], vec3* dest, int edge_count, struct DualContouring* dual_contouring) {
+  float t[OCTREE_MAX_CROSSINGS] = {0};
+  int density_calls = 0;
+
+  switch (dual_contouring->crossing_mode) {
+    case (CROSSING_STEP_SEARCH):
+      density_calls = octree_crossing_step_search(edge_points, t, edge_count, dual_contouring);
+      break;
+    case (CROSSING_CORNER_INTERPOLATION):
+      density_calls = octree_crossing_secant(edge_points, edge_densities, t, edge_count, 0, dual_contouring);
+      break;
+    case (CROSSING_SECANT):
+      density_calls = octree_crossing_secant(edge_points, edge_densities, t, edge_count, dual_contouring->crossing_iterations, dual_contouring);
+      break;
+  }
+
+  for (int edge_num = 0; edge_num < edge_count; edge_num++) {
+    const vec3 p0 = edge_points[edge_num][0];
+    const vec3 p1 = edge_points[edge_num][1];
+    dest[edge_num].data[0] = p0.data[0] + ((p1.data[0] - p0.data[0]) * t[edge_num]);
+    dest[edge_num].data[1] = p0.data[1] + ((p1.data[1] - p0.data[1]) * t[edge_num]);
+    dest[edge_num].data[2] = p0.data[2] + ((p1.data[2] - p0.data[2]) * t[edge_num]);
+  }
+
+  return density_calls;
+}
+
+void octree_calculate_surface_normals(vec3* points, vec3* dest, int point_count, struct DualContouring* dual_contouring) {
+  const float h = 0.001f;
+  const int half_size = dual_contouring->octree_size / 2;
+  float positions[OCTREE_MAX_CROSSINGS * 6][3];
+  float densities[OCTREE_MAX_CROSSINGS * 6];
+
+  for (int point_num = 0; point_num < point_count; point_num++) {
+    const vec3 new_pos = (vec3){.x = points[point_num].x + half_size, .y = points[point_num].y + half_size, .z = points[point_num].z + half_size};
+    for (int axis = 0; axis < 3; axis++) {
+      float* plus = positions[(point_num * 6) + (axis * 2)];
+      float* minus = positions[(point_num * 6) + (axis * 2) + 1];
+      memcpy(plus, new_pos.data, sizeof(float) * 3);
+      memcpy(minus, new_pos.data, sizeof(float) * 3);
+      plus[axis] += h;
+      minus[axis] -= h;
+    }
+  }
+
+  dual_contouring_density_batch(dual_contouring, positions, densities, point_count * 6);
+
+  for (int point_num = 0; point_num < point_count; point_num++) {
+    const float* d = &densities[point_num * 6];
+    dest[point_num] = vec3_normalise((vec3){.x = d[0] - d[1], .y = d[2] - d[3], .z = d[4] - d[5]});
+  }
+}
+
 struct OctreeNode* octree_construct_leaf(struct OctreeNode* leaf, struct DualContouring* dual_contouring) {
   if (!leaf || leaf->size != 1)
     return NULL;
 
   int corners = 0;
+  float corner_densities[8] = {0};
   for (int i = 0; i < 8; i++) {
     const ivec3 corner_pos = (ivec3){.x = leaf->min.x + CHILD_MIN_OFFSETS[i].x, .y = leaf->min.y + CHILD_MIN_OFFSETS[i].y, .z = leaf->min.z + CHILD_MIN_OFFSETS[i].z};
     // TODO: 3D array(noise data) -> land octree -> dual contouring octree
     // Note: Local chunks stick with 3D array for performance like grass growing?
-    int octree_size = dual_contouring->octree_size;
-    int half_size = octree_size / 2;
-    float density = noise_get(dual_contouring->noise_set, octree_size, octree_size, octree_size, corner_pos.x + half_size, corner_pos.y + half_size, corner_pos.z + half_size);
+    int half_size = dual_contouring->octree_size / 2;
+    float density = dual_contouring_get_density(dual_contouring, corner_pos.x + half_size, corner_pos.y + half_size, corner_pos.z + half_size);
+    corner_densities[i] = density;
 
     const int material = density < 0.0f ? MATERIAL_SOLID : MATERIAL_AIR;
     corners |= (material << i);
   }
 
-  if (corners == 0 || corners == 255) {
-    free(leaf);
+  if (corners == 0 || corners == 255)
     return NULL;
-  }
 
-  const int MAX_CROSSINGS = 6;
   int edge_count = 0;
+  vec3 edge_points[OCTREE_MAX_CROSSINGS][2] = {0};
+  float edge_densities[OCTREE_MAX_CROSSINGS][2] = {0};
   vec3 average_normal = VEC3_ZERO;
   struct QefSolver qef = {0};
   qef_solver_init(&qef);
 
-  for (int i = 0; i < 12 && edge_count < MAX_CROSSINGS; i++) {
+  for (int i = 0; i < 12 && edge_count < OCTREE_MAX_CROSSINGS; i++) {
     const int c1 = edgevmap[i][0];
     const int c2 = edgevmap[i][1];
     const int m1 = (corners >> c1) & 1;
@@ -369,21 +566,33 @@ struct OctreeNode* octree_construct_leaf(struct OctreeNode* leaf, struct DualCon
     if ((m1 == MATERIAL_AIR && m2 == MATERIAL_AIR) || (m1 == MATERIAL_SOLID && m2 == MATERIAL_SOLID))
       continue;
 
-    const vec3 p1 = (vec3){.x = leaf->min.x + CHILD_MIN_OFFSETS[c1].x, .y = leaf->min.y + CHILD_MIN_OFFSETS[c1].y, .z = leaf->min.z + CHILD_MIN_OFFSETS[c1].z};
-    const vec3 p2 = (vec3){.x = leaf->min.x + CHILD_MIN_OFFSETS[c2].x, .y = leaf->min.y + CHILD_MIN_OFFSETS[c2].y, .z = leaf->min.z + CHILD_MIN_OFFSETS[c2].z};
-    vec3 p = octree_approximate_zero_crossing_position(p1, p2, dual_contouring);
-    vec3 n = octree_calculate_surface_normal(p, dual_contouring);
+    edge_points[edge_count][0] = (vec3){.x = leaf->min.x + CHILD_MIN_OFFSETS[c1].x, .y = leaf->min.y + CHILD_MIN_OFFSETS[c1].y, .z = leaf->min.z + CHILD_MIN_OFFSETS[c1].z};
+    edge_points[edge_count][1] = (vec3){.x = leaf->min.x + CHILD_MIN_OFFSETS[c2].x, .y = leaf->min.y + CHILD_MIN_OFFSETS[c2].y, .z = leaf->min.z + CHILD_MIN_OFFSETS[c2].z};
+    edge_densities[edge_count][0] = corner_densities[c1];
+    edge_densities[edge_count][1] = corner_densities[c2];
+    edge_count++;
+  }
+
+  // Note: Every edge sample of the cell goes through one batched density call, same for the normals after
+  vec3 crossings[OCTREE_MAX_CROSSINGS] = {0};
+  octree_approximate_zero_crossing_positions(edge_points, edge_densities, crossings, edge_count, dual_contouring);
+
+  vec3 normals[OCTREE_MAX_CROSSINGS] = {0};
+  octree_calculate_surface_normals(crossings, normals, edge_count, dual_contouring);
+
+  for (int edge_num = 0; edge_num < edge_count; edge_num++) {
+    vec3 p = crossings[edge_num];
+    vec3 n = normals[edge_num];
     qef_solver_add(&qef, p.x, p.y, p.z, n.data[0], n.data[1], n.data[2]);
     average_normal.data[0] = average_normal.data[0] + n.data[0];
     average_normal.data[1] = average_normal.data[1] + n.data[1];
     average_normal.data[2] = average_normal.data[2] + n.data[2];
-    edge_count++;
   }
 
   vec3 qef_position = VEC3_ZERO;
   qef_solver_solve(&qef, &qef_position, QEF_ERROR, QEF_SWEEPS, QEF_ERROR);
 
-  struct OctreeDrawInfo* draw_info = calloc(1, sizeof(struct OctreeDrawInfo));
+  struct OctreeDrawInfo* draw_info = memory_arena_alloc(octree_get_arena(dual_contouring), sizeof(struct OctreeDrawInfo));
   octree_draw_info_init(draw_info);
 
   draw_info->position = qef_position;
@@ -402,11 +611,15 @@ struct OctreeNode* octree_construct_leaf(struct OctreeNode* leaf, struct DualCon
   leaf->type = NODE_LEAF;
   leaf->draw_info = draw_info;
 
+#pragma omp atomic
+  dual_contouring->simplify_stats.vertices_before++;
+
   return leaf;
 }
 
-struct OctreeNode* octree_construct_octree_nodes(struct OctreeNode* node, struct DualContouring* dual_contouring) {
-  if (!node)
+// Note: Nodes larger than task_size spawn a task per child, the tree shape doesn't depend on which thread built what so the mesh stays identical to a serial build
+struct OctreeNode* octree_construct_octree_nodes(struct OctreeNode* node, struct DualContouring* dual_contouring, int task_size) {
+  if (!node || !octree_node_in_grid(node, dual_contouring))
     return NULL;
 
   if (node->size == 1)
@@ -415,37 +628,152 @@ struct OctreeNode* octree_construct_octree_nodes(struct OctreeNode* node, struct
   const int child_size = node->size / 2;
   bool has_children = false;
 
+  // Note: Children are built on the stack and only copied into the arena when something survives so empty cells never cost an allocation
+  struct OctreeNode children[8];
+  bool child_built[8] = {false};
   for (int i = 0; i < 8; i++) {
-    struct OctreeNode* child = calloc(1, sizeof(struct OctreeNode));
+    struct OctreeNode* child = &children[i];
     octree_init_none(child);
     child->size = child_size;
     child->min.data[0] = node->min.data[0] + (CHILD_MIN_OFFSETS[i].data[0] * child_size);
     child->min.data[1] = node->min.data[1] + (CHILD_MIN_OFFSETS[i].data[1] * child_size);
     child->min.data[2] = node->min.data[2] + (CHILD_MIN_OFFSETS[i].data[2] * child_size);
     child->type = NODE_INTERNAL;
+  }
+
+  if (node->size > task_size) {
+    for (int i = 0; i < 8; i++) {
+#pragma omp task default(shared) firstprivate(i)
+      child_built[i] = octree_construct_octree_nodes(&children[i], dual_contouring, task_size) != NULL;
+    }
+#pragma omp taskwait
+  } else {
+    for (int i = 0; i < 8; i++)
+      child_built[i] = octree_construct_octree_nodes(&children[i], dual_contouring, task_size) != NULL;
+  }
+
+  for (int i = 0; i < 8; i++) {
+    if (!child_built[i])
+      continue;
 
-    node->children[i] = octree_construct_octree_nodes(child, dual_contouring);
-    has_children |= (node->children[i] != NULL);
+    node->children[i] = memory_arena_alloc(octree_get_arena(dual_contouring), sizeof(struct OctreeNode));
+    memcpy(node->children[i], &children[i], sizeof(struct OctreeNode));
+    has_children = true;
   }
 
-  if (!has_children) {
-    free(node);
+  if (!has_children)
     return NULL;
-  }
 
   return node;
 }
 
+// Note: Walks every surface cell of the grid and compares each crossing mode against a 16 iteration secant reference, error is in cell units
+void octree_benchmark_crossing_modes(struct DualContouring* dual_contouring) {
+  const int MODE_COUNT = 6;
+  const enum DualContouringCrossingMode modes[6] = {CROSSING_STEP_SEARCH, CROSSING_CORNER_INTERPOLATION, CROSSING_SECANT, CROSSING_SECANT, CROSSING_SECANT, CROSSING_SECANT};
+  const int iterations[6] = {0, 0, 1, 2, 3, 6};
+  const char* names[3] = {"step search", "corner interpolation", "secant"};
+  const enum DualContouringCrossingMode saved_mode = dual_contouring->crossing_mode;
+  const int saved_iterations = dual_contouring->crossing_iterations;
+
+  const int octree_size = dual_contouring->octree_size;
+  const int half_size = octree_size / 2;
+  double error_sum[6] = {0}, error_max[6] = {0}, residual_sum[6] = {0}, mode_time[6] = {0};
+  long density_calls[6] = {0};
+  long leaf_count = 0, crossing_count = 0;
+
+  for (int x = 0; x < octree_size - 1; x++) {
+    for (int y = 0; y < octree_size - 1; y++) {
+      for (int z = 0; z < octree_size - 1; z++) {
+        int corners = 0;
+        float corner_densities[8] = {0};
+        for (int i = 0; i < 8; i++) {
+          corner_densities[i] = dual_contouring_get_density(dual_contouring, x + CHILD_MIN_OFFSETS[i].x, y + CHILD_MIN_OFFSETS[i].y, z + CHILD_MIN_OFFSETS[i].z);
+          corners |= ((corner_densities[i] < 0.0f ? MATERIAL_SOLID : MATERIAL_AIR) << i);
+        }
+
+        if (corners == 0 || corners == 255)
+          continue;
+
+        int edge_count = 0;
+        vec3 edge_points[OCTREE_MAX_CROSSINGS][2] = {0};
+        float edge_densities[OCTREE_MAX_CROSSINGS][2] = {0};
+        for (int i = 0; i < 12 && edge_count < OCTREE_MAX_CROSSINGS; i++) {
+          const int c1 = edgevmap[i][0];
+          const int c2 = edgevmap[i][1];
+          if (((corners >> c1) & 1) == ((corners >> c2) & 1))
+            continue;
+
+          edge_points[edge_count][0] = (vec3){.x = x - half_size + CHILD_MIN_OFFSETS[c1].x, .y = y - half_size + CHILD_MIN_OFFSETS[c1].y, .z = z - half_size + CHILD_MIN_OFFSETS[c1].z};
+          edge_points[edge_count][1] = (vec3){.x = x - half_size + CHILD_MIN_OFFSETS[c2].x, .y = y - half_size + CHILD_MIN_OFFSETS[c2].y, .z = z - half_size + CHILD_MIN_OFFSETS[c2].z};
+          edge_densities[edge_count][0] = corner_densities[c1];
+          edge_densities[edge_count][1] = corner_densities[c2];
+          edge_count++;
+        }
+
+        vec3 reference[OCTREE_MAX_CROSSINGS] = {0};
+        dual_contouring->crossing_mode = CROSSING_SECANT;
+        dual_contouring->crossing_iterations = 16;
+        octree_approximate_zero_crossing_positions(edge_points, edge_densities, reference, edge_count, dual_contouring);
+
+        for (int mode_num = 0; mode_num < MODE_COUNT; mode_num++) {
+          vec3 crossings[OCTREE_MAX_CROSSINGS] = {0};
+          dual_contouring->crossing_mode = modes[mode_num];
+          dual_contouring->crossing_iterations = iterations[mode_num];
+          const double start_time = engine_get_time();
+          density_calls[mode_num] += octree_approximate_zero_crossing_positions(edge_points, edge_densities, crossings, edge_count, dual_contouring);
+          mode_time[mode_num] += engine_get_time() - start_time;
+
+          for (int edge_num = 0; edge_num < edge_count; edge_num++) {
+            const vec3 p = crossings[edge_num];
+            const vec3 r = reference[edge_num];
+            const double error = sqrt(((p.x - r.x) * (p.x - r.x)) + ((p.y - r.y) * (p.y - r.y)) + ((p.z - r.z) * (p.z - r.z)));
+            error_sum[mode_num] += error;
+            error_max[mode_num] = MAX(error_max[mode_num], error);
+            residual_sum[mode_num] += fabsf(dual_contouring->density_func_single(dual_contouring->noises, p.x + half_size, p.y + half_size, p.z + half_size));
+          }
+        }
+
+        leaf_count++;
+        crossing_count += edge_count;
+      }
+    }
+  }
+
+  dual_contouring->crossing_mode = saved_mode;
+  dual_contouring->crossing_iterations = saved_iterations;
+
+  printf("Crossing benchmark %d ^ 3, %ld leaves, %ld crossings\n", octree_size, leaf_count, crossing_count);
+  for (int mode_num = 0; mode_num < MODE_COUNT; mode_num++)
+    printf("%s (%d iterations): %.2lf density calls per leaf, mean error %lf, max error %lf, mean |density| %g, time %lf\n", names[modes[mode_num]], iterations[mode_num], (double)density_calls[mode_num] / MAX(leaf_count, 1), error_sum[mode_num] / MAX(crossing_count, 1), error_max[mode_num], residual_sum[mode_num] / MAX(crossing_count, 1), mode_time[mode_num]);
+}
+
 struct OctreeNode* octree_build_octree(const ivec3 min, const int size, const float threshold, struct DualContouring* dual_contouring) {
-  struct OctreeNode* root = calloc(1, sizeof(struct OctreeNode));
+  if (dual_contouring->octree_arenas == NULL)
+    octree_arenas_init(dual_contouring);
+
+  for (int arena_num = 0; arena_num < dual_contouring->octree_arena_count; arena_num++)
+    memory_arena_reset(&dual_contouring->octree_arenas[arena_num]);
+
+  struct OctreeNode* root = memory_arena_alloc(octree_get_arena(dual_contouring), sizeof(struct OctreeNode));
   octree_init_none(root);
   root->min = min;
   root->size = size;
   root->type = NODE_INTERNAL;
 
-  octree_construct_octree_nodes(root, dual_contouring);
-  // TODO: Fix this
-  //root = octree_simplify_octree(root, threshold);
+  memset(&dual_contouring->simplify_stats, 0, sizeof(struct DualContouringSimplifyStats));
+
+  const int task_size = size >> OCTREE_TASK_DEPTH;
+#pragma omp parallel num_threads(dual_contouring->octree_arena_count)
+  {
+#pragma omp single
+    {
+      root = octree_construct_octree_nodes(root, dual_contouring, task_size);
+      // Note: A negative threshold keeps every leaf
+      if (threshold >= 0.0f)
+        root = octree_simplify_octree(root, threshold, dual_contouring, task_size);
+    }
+  }
 
   return root;
 }
@@ -458,4 +786,7 @@ void octree_generate_mesh_from_octree(struct OctreeNode* node, struct DualContou
 
   octree_generate_vertex_indices(node, dual_contouring);
   octree_contour_cell_proc(node, dual_contouring);
+
+  dual_contouring->simplify_stats.vertices_after = vector_size(dual_contouring->mesh->vertices);
+  dual_contouring->simplify_stats.indices_after = vector_size(dual_contouring->mesh->indices);
 }
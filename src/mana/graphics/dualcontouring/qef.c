@@ -1,5 +1,7 @@
 #include "mana/graphics/dualcontouring/qef.h"
 
+#include <immintrin.h>
+
 void qef_data_init(struct QefData *qef_data) {
   qef_data_clear(qef_data);
 }
@@ -144,7 +146,7 @@ float qef_solver_get_error_pos(struct QefSolver *qef_solver, vec3 pos) {
 
   qef_solver->last_error = vec3_dot(pos, atax) - 2 * vec3_dot(pos, qef_solver->atb) + qef_solver->data.btb;
 
-  if (qef_solver->last_error == NAN)
+  if (isnan(qef_solver->last_error))
     qef_solver->last_error = 10000;
 
   return qef_solver->last_error;
@@ -392,7 +394,7 @@ float qef_solver_solve(struct QefSolver *qef_solver, vec3 *outx, const float svd
   const float result = vec3_dot(vtmp, vtmp);
 
   // Add scaled
-  if (result == NAN)
+  if (isnan(result))
     qef_solver->x = qef_solver->mass_point;
   else
     qef_solver->x = vec3_add(qef_solver->x, qef_solver->mass_point);
@@ -403,3 +405,187 @@ float qef_solver_solve(struct QefSolver *qef_solver, vec3 *outx, const float svd
 
   return result;
 }
+
+void qef_batch_init(struct QefBatch *qef_batch) {
+  qef_batch->count = 0;
+}
+
+// Note: Callers flush with qef_batch_solve once count reaches QEF_BATCH_WIDTH
+void qef_batch_add(struct QefBatch *qef_batch, struct QefData *qef_data) {
+  const int lane = qef_batch->count++;
+  qef_batch->ata_00[lane] = qef_data->ata_00;
+  qef_batch->ata_01[lane] = qef_data->ata_01;
+  qef_batch->ata_02[lane] = qef_data->ata_02;
+  qef_batch->ata_11[lane] = qef_data->ata_11;
+  qef_batch->ata_12[lane] = qef_data->ata_12;
+  qef_batch->ata_22[lane] = qef_data->ata_22;
+  qef_batch->atb_x[lane] = qef_data->atb_x;
+  qef_batch->atb_y[lane] = qef_data->atb_y;
+  qef_batch->atb_z[lane] = qef_data->atb_z;
+  qef_batch->btb[lane] = qef_data->btb;
+  qef_batch->mass_point_x[lane] = qef_data->mass_point_x;
+  qef_batch->mass_point_y[lane] = qef_data->mass_point_y;
+  qef_batch->mass_point_z[lane] = qef_data->mass_point_z;
+  qef_batch->num_points[lane] = (float)qef_data->num_points;
+}
+
+static void qef_batch_pad(struct QefBatch *qef_batch) {
+  const int last = qef_batch->count - 1;
+  for (int lane = qef_batch->count; lane < QEF_BATCH_WIDTH; lane++) {
+    qef_batch->ata_00[lane] = qef_batch->ata_00[last];
+    qef_batch->ata_01[lane] = qef_batch->ata_01[last];
+    qef_batch->ata_02[lane] = qef_batch->ata_02[last];
+    qef_batch->ata_11[lane] = qef_batch->ata_11[last];
+    qef_batch->ata_12[lane] = qef_batch->ata_12[last];
+    qef_batch->ata_22[lane] = qef_batch->ata_22[last];
+    qef_batch->atb_x[lane] = qef_batch->atb_x[last];
+    qef_batch->atb_y[lane] = qef_batch->atb_y[last];
+    qef_batch->atb_z[lane] = qef_batch->atb_z[last];
+    qef_batch->btb[lane] = qef_batch->btb[last];
+    qef_batch->mass_point_x[lane] = qef_batch->mass_point_x[last];
+    qef_batch->mass_point_y[lane] = qef_batch->mass_point_y[last];
+    qef_batch->mass_point_z[lane] = qef_batch->mass_point_z[last];
+    qef_batch->num_points[lane] = qef_batch->num_points[last];
+  }
+}
+
+// Note: Lanes with a_pq == 0 are never rotated so the zero branch of calc_symmetric_givens_coefficients isn't needed here
+static inline void qef_batch_givens(const __m256 a_pp, const __m256 a_pq, const __m256 a_qq, __m256 *c, __m256 *s) {
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 tau = _mm256_div_ps(_mm256_sub_ps(a_qq, a_pp), _mm256_mul_ps(_mm256_set1_ps(2.0f), a_pq));
+  const __m256 stt = _mm256_sqrt_ps(_mm256_add_ps(one, _mm256_mul_ps(tau, tau)));
+  const __m256 tau_positive = _mm256_cmp_ps(tau, _mm256_setzero_ps(), _CMP_GE_OQ);
+  const __m256 tan = _mm256_div_ps(one, _mm256_blendv_ps(_mm256_sub_ps(tau, stt), _mm256_add_ps(tau, stt), tau_positive));
+  *c = _mm256_div_ps(one, _mm256_sqrt_ps(_mm256_add_ps(one, _mm256_mul_ps(tan, tan))));
+  *s = _mm256_mul_ps(tan, *c);
+}
+
+// Note: rot01, rot02 and rot12 in one, a_pr and a_qr are the entries each rotated axis shares with the third one
+static inline void qef_batch_rotate(__m256 *a_pp, __m256 *a_pq, __m256 *a_qq, __m256 *a_pr, __m256 *a_qr, __m256 v[3][3], const int p, const int q, const __m256 active) {
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 rotate = _mm256_and_ps(active, _mm256_cmp_ps(*a_pq, zero, _CMP_NEQ_UQ));
+  if (_mm256_movemask_ps(rotate) == 0)
+    return;
+
+  __m256 c, s;
+  qef_batch_givens(*a_pp, *a_pq, *a_qq, &c, &s);
+  const __m256 cc = _mm256_mul_ps(c, c);
+  const __m256 ss = _mm256_mul_ps(s, s);
+  const __m256 mix = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), c), s), *a_pq);
+
+  const __m256 pre_pp = *a_pp, pre_qq = *a_qq, pre_pr = *a_pr, pre_qr = *a_qr;
+  *a_pp = _mm256_blendv_ps(pre_pp, _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(cc, pre_pp), mix), _mm256_mul_ps(ss, pre_qq)), rotate);
+  *a_qq = _mm256_blendv_ps(pre_qq, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ss, pre_pp), mix), _mm256_mul_ps(cc, pre_qq)), rotate);
+  *a_pr = _mm256_blendv_ps(pre_pr, _mm256_sub_ps(_mm256_mul_ps(c, pre_pr), _mm256_mul_ps(s, pre_qr)), rotate);
+  *a_qr = _mm256_blendv_ps(pre_qr, _mm256_add_ps(_mm256_mul_ps(s, pre_pr), _mm256_mul_ps(c, pre_qr)), rotate);
+  *a_pq = _mm256_blendv_ps(*a_pq, zero, rotate);
+
+  // Note: rotate01, rotate02 and rotate12 clear c and s before posting to v, kept the same here so both solvers place vertices identically
+  c = zero, s = zero;
+  for (int row = 0; row < 3; row++) {
+    const __m256 m_p = v[row][p], m_q = v[row][q];
+    v[row][p] = _mm256_blendv_ps(m_p, _mm256_sub_ps(_mm256_mul_ps(c, m_p), _mm256_mul_ps(s, m_q)), rotate);
+    v[row][q] = _mm256_blendv_ps(m_q, _mm256_add_ps(_mm256_mul_ps(s, m_p), _mm256_mul_ps(c, m_q)), rotate);
+  }
+}
+
+static inline __m256 qef_batch_pinv(const __m256 x, const __m256 tol) {
+  const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+  const __m256 inverse = _mm256_div_ps(_mm256_set1_ps(1.0f), x);
+  const __m256 cut = _mm256_or_ps(_mm256_cmp_ps(_mm256_and_ps(x, abs_mask), tol, _CMP_LT_OQ), _mm256_cmp_ps(_mm256_and_ps(inverse, abs_mask), tol, _CMP_LT_OQ));
+  return _mm256_andnot_ps(cut, inverse);
+}
+
+static inline __m256 qef_batch_dot(const __m256 ax, const __m256 ay, const __m256 az, const __m256 bx, const __m256 by, const __m256 bz) {
+  return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+}
+
+// Solves every system in the batch with the same steps as qef_solver_solve, out_error gets what qef_solver_get_error would return and can be NULL
+void qef_batch_solve(struct QefBatch *qef_batch, vec3 *outx, float *out_error, const float svd_tol, const int svd_sweeps, const float pinv_tol) {
+  if (qef_batch->count == 0)
+    return;
+  qef_batch_pad(qef_batch);
+
+  const __m256 zero = _mm256_setzero_ps();
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 ata_00 = _mm256_load_ps(qef_batch->ata_00), ata_01 = _mm256_load_ps(qef_batch->ata_01), ata_02 = _mm256_load_ps(qef_batch->ata_02);
+  const __m256 ata_11 = _mm256_load_ps(qef_batch->ata_11), ata_12 = _mm256_load_ps(qef_batch->ata_12), ata_22 = _mm256_load_ps(qef_batch->ata_22);
+  const __m256 atb_x = _mm256_load_ps(qef_batch->atb_x), atb_y = _mm256_load_ps(qef_batch->atb_y), atb_z = _mm256_load_ps(qef_batch->atb_z);
+  const __m256 btb = _mm256_load_ps(qef_batch->btb);
+
+  const __m256 point_scale = _mm256_div_ps(one, _mm256_load_ps(qef_batch->num_points));
+  const __m256 mass_point_x = _mm256_mul_ps(_mm256_load_ps(qef_batch->mass_point_x), point_scale);
+  const __m256 mass_point_y = _mm256_mul_ps(_mm256_load_ps(qef_batch->mass_point_y), point_scale);
+  const __m256 mass_point_z = _mm256_mul_ps(_mm256_load_ps(qef_batch->mass_point_z), point_scale);
+
+  // Symmetric vmul
+  const __m256 shifted_atb_x = _mm256_sub_ps(atb_x, qef_batch_dot(ata_00, ata_01, ata_02, mass_point_x, mass_point_y, mass_point_z));
+  const __m256 shifted_atb_y = _mm256_sub_ps(atb_y, qef_batch_dot(ata_01, ata_11, ata_12, mass_point_x, mass_point_y, mass_point_z));
+  const __m256 shifted_atb_z = _mm256_sub_ps(atb_z, qef_batch_dot(ata_02, ata_12, ata_22, mass_point_x, mass_point_y, mass_point_z));
+
+  // Solve symmetric
+  __m256 vtav_00 = ata_00, vtav_01 = ata_01, vtav_02 = ata_02, vtav_11 = ata_11, vtav_12 = ata_12, vtav_22 = ata_22;
+  __m256 v[3][3] = {{one, zero, zero}, {zero, one, zero}, {zero, zero, one}};
+
+  const __m256 vtav_00_squared = _mm256_mul_ps(vtav_00, vtav_00);
+  const __m256 fnorm_vtav = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(vtav_00_squared, vtav_00_squared), vtav_00_squared), one), one));
+  const __m256 delta = _mm256_mul_ps(_mm256_set1_ps(svd_tol), fnorm_vtav);
+
+  __m256 active = _mm256_cmp_ps(zero, zero, _CMP_EQ_OQ);
+  for (int i = 0; i < svd_sweeps; ++i) {
+    const __m256 vtav_00_off = _mm256_mul_ps(vtav_00, vtav_00);
+    const __m256 off = _mm256_sqrt_ps(_mm256_mul_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(vtav_00_off, vtav_00_off)));
+    active = _mm256_and_ps(active, _mm256_cmp_ps(off, delta, _CMP_GT_OQ));
+    if (_mm256_movemask_ps(active) == 0)
+      break;
+
+    qef_batch_rotate(&vtav_00, &vtav_01, &vtav_11, &vtav_02, &vtav_12, v, 0, 1, active);
+    qef_batch_rotate(&vtav_00, &vtav_02, &vtav_22, &vtav_01, &vtav_12, v, 0, 2, active);
+    qef_batch_rotate(&vtav_11, &vtav_12, &vtav_22, &vtav_01, &vtav_02, v, 1, 2, active);
+  }
+
+  // pseudo inverse, only its first column is read when solving for x just like the scalar solver
+  const __m256 tol = _mm256_set1_ps(pinv_tol);
+  const __m256 d0 = qef_batch_pinv(vtav_00, tol), d1 = qef_batch_pinv(vtav_11, tol), d2 = qef_batch_pinv(vtav_22, tol);
+  __m256 pinv[3];
+  for (int row = 0; row < 3; row++)
+    pinv[row] = qef_batch_dot(_mm256_mul_ps(v[row][0], d0), _mm256_mul_ps(v[row][1], d1), _mm256_mul_ps(v[row][2], d2), v[0][0], v[0][1], v[0][2]);
+
+  const __m256 x = qef_batch_dot(pinv[0], pinv[0], pinv[0], shifted_atb_x, shifted_atb_y, shifted_atb_z);
+  const __m256 y = qef_batch_dot(pinv[1], pinv[1], pinv[1], shifted_atb_x, shifted_atb_y, shifted_atb_z);
+  const __m256 z = qef_batch_dot(pinv[2], pinv[2], pinv[2], shifted_atb_x, shifted_atb_y, shifted_atb_z);
+
+  // calc error
+  const __m256 residual_x = _mm256_sub_ps(shifted_atb_x, qef_batch_dot(ata_00, ata_01, ata_02, x, y, z));
+  const __m256 residual_y = _mm256_sub_ps(shifted_atb_y, qef_batch_dot(zero, ata_11, ata_12, x, y, z));
+  const __m256 residual_z = _mm256_sub_ps(shifted_atb_z, qef_batch_dot(zero, zero, ata_22, x, y, z));
+  const __m256 result = qef_batch_dot(residual_x, residual_y, residual_z, residual_x, residual_y, residual_z);
+
+  // Add scaled
+  const __m256 result_nan = _mm256_cmp_ps(result, result, _CMP_UNORD_Q);
+  const __m256 solved_x = _mm256_blendv_ps(_mm256_add_ps(x, mass_point_x), mass_point_x, result_nan);
+  const __m256 solved_y = _mm256_blendv_ps(_mm256_add_ps(y, mass_point_y), mass_point_y, result_nan);
+  const __m256 solved_z = _mm256_blendv_ps(_mm256_add_ps(z, mass_point_z), mass_point_z, result_nan);
+
+  alignas(32) float lanes_x[QEF_BATCH_WIDTH], lanes_y[QEF_BATCH_WIDTH], lanes_z[QEF_BATCH_WIDTH];
+  _mm256_store_ps(lanes_x, solved_x);
+  _mm256_store_ps(lanes_y, solved_y);
+  _mm256_store_ps(lanes_z, solved_z);
+  for (int lane = 0; lane < qef_batch->count; lane++)
+    outx[lane] = (vec3){.x = lanes_x[lane], .y = lanes_y[lane], .z = lanes_z[lane]};
+
+  if (out_error == NULL)
+    return;
+
+  // Same as qef_solver_get_error_pos at the solved position
+  const __m256 atax_x = qef_batch_dot(ata_00, ata_01, ata_02, solved_x, solved_y, solved_z);
+  const __m256 atax_y = qef_batch_dot(ata_01, ata_11, ata_12, solved_x, solved_y, solved_z);
+  const __m256 atax_z = qef_batch_dot(ata_02, ata_12, ata_22, solved_x, solved_y, solved_z);
+  const __m256 x_atax = qef_batch_dot(solved_x, solved_y, solved_z, atax_x, atax_y, atax_z);
+  const __m256 x_atb = qef_batch_dot(solved_x, solved_y, solved_z, atb_x, atb_y, atb_z);
+  const __m256 error = _mm256_add_ps(_mm256_sub_ps(x_atax, _mm256_mul_ps(_mm256_set1_ps(2.0f), x_atb)), btb);
+
+  alignas(32) float lanes_error[QEF_BATCH_WIDTH];
+  _mm256_store_ps(lanes_error, _mm256_blendv_ps(error, _mm256_set1_ps(10000.0f), _mm256_cmp_ps(error, error, _CMP_UNORD_Q)));
+  memcpy(out_error, lanes_error, sizeof(float) * qef_batch->count);
+}
@@ -26,11 +26,11 @@ int grass_init(struct Grass* grass, struct GPUAPI* gpu_api) {
   vkCreateBuffer(gpu_api->vulkan_state->device, &buffer_info2, NULL, &grass->index_buffer);
   vkBindBufferMemory(gpu_api->vulkan_state->device, grass->index_buffer, grass->grass_shader.grass_compute_memory[2], 0);
 
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct GrassUniformBufferObject), &grass->uniform_buffer, &grass->uniform_buffers_memory);
+  grass->uniform_offset = 0;
   graphics_utils_setup_descriptor(gpu_api->vulkan_state, grass->grass_shader.grass_render_shader.descriptor_set_layout, grass->grass_shader.grass_render_shader.descriptor_pool, &grass->descriptor_set);
 
   VkWriteDescriptorSet dcs[1] = {0};
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &grass->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct GrassUniformBufferObject), &grass->uniform_buffer)});
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &grass->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct GrassUniformBufferObject))});
   vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 1, dcs, 0, NULL);
 
   vector_init(&grass->grass_nodes, sizeof(vec4));
@@ -46,8 +46,6 @@ int grass_init(struct Grass* grass, struct GPUAPI* gpu_api) {
 static inline void grass_vulkan_cleanup(struct Grass* grass, struct GPUAPI* gpu_api) {
   vkDestroyBuffer(gpu_api->vulkan_state->device, grass->index_buffer, NULL);
   vkDestroyBuffer(gpu_api->vulkan_state->device, grass->vertex_buffer, NULL);
-  vkDestroyBuffer(gpu_api->vulkan_state->device, grass->uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, grass->uniform_buffers_memory, NULL);
 }
 
 void grass_delete(struct Grass* grass, struct VulkanState* vulkan_state) {
@@ -99,13 +97,16 @@ void grass_render(struct Grass* grass, struct GPUAPI* gpu_api) {
     vkUnmapMemory(gpu_api->vulkan_state->device, grass->grass_shader.grass_compute_memory[0]);
   }
 
+  if (grass->uniform_offset == UNIFORM_RING_FULL)
+    return;
+
   vkCmdBindPipeline(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, grass->grass_shader.grass_render_shader.graphics_pipeline);
 
   VkBuffer vertex_buffers[] = {grass->vertex_buffer};
   VkDeviceSize offsets[] = {0};
   vkCmdBindVertexBuffers(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, 0, 1, vertex_buffers, offsets);
   vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, grass->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, grass->grass_shader.grass_render_shader.pipeline_layout, 0, 1, &grass->descriptor_set, 0, NULL);
+  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, grass->grass_shader.grass_render_shader.pipeline_layout, 0, 1, &grass->descriptor_set, 1, &grass->uniform_offset);
   vkCmdDrawIndexed(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, grass->index_size, 1, 0, 0, 0);
 }
 
@@ -118,10 +119,7 @@ void grass_update_uniforms(struct Grass* grass, struct GPUAPI* gpu_api) {
 
   ubos.model = MAT4_IDENTITY;
 
-  void* data;
-  vkMapMemory(gpu_api->vulkan_state->device, grass->uniform_buffers_memory, 0, sizeof(struct GrassUniformBufferObject), 0, &data);
-  memcpy(data, &ubos, sizeof(struct GrassUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, grass->uniform_buffers_memory);
+  grass->uniform_offset = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &ubos, sizeof(struct GrassUniformBufferObject));
 }
 
 //void grass_recreate(struct Grass* grass, struct GPUAPI* gpu_api) {
@@ -1,13 +1,34 @@
 #include "mana/graphics/entities/manifoldplanet.h"
 
-void manifold_planet_init(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, struct Vector* noises, vec3 position) {
+static inline void manifold_planet_setup(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, struct Vector* noises, vec3 position) {
   planet->planet_type = MANIFOLD_ROUND_PLANET;
   planet->terrain_shader = shader;
   planet->position = position;
   planet->noises = noises;
   // Think the 14 here for "size" is meant to represent matrix scaling but hasn't been added yet
   manifold_dual_contouring_init(&planet->manifold_dual_contouring, gpu_api, shader, octree_size, 14);
+}
+
+void manifold_planet_init(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, struct Vector* noises, vec3 position) {
+  manifold_planet_setup(planet, gpu_api, octree_size, shader, noises, position);
+  manifold_dual_contouring_contour(&planet->manifold_dual_contouring, gpu_api, noises, 0.0f);
+}
+
+// Note: Loads the mesh from mesh_path when it was saved from the same noises and size, otherwise contours and saves it there for the next start
+void manifold_planet_init_cached(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, struct Vector* noises, vec3 position, const char* mesh_path) {
+  manifold_planet_setup(planet, gpu_api, octree_size, shader, noises, position);
+  if (manifold_dual_contouring_load_mesh(&planet->manifold_dual_contouring, gpu_api, noises, 0.0f, mesh_path) == CHUNK_FILE_SUCCESS)
+    return;
+
   manifold_dual_contouring_contour(&planet->manifold_dual_contouring, gpu_api, noises, 0.0f);
+  if (manifold_dual_contouring_save_mesh(&planet->manifold_dual_contouring, mesh_path) != CHUNK_FILE_SUCCESS)
+    fprintf(stderr, "Failed to save planet mesh to %s\n", mesh_path);
+}
+
+// Note: Returns straight away, the planet draws nothing until the job system hands the mesh back at a frame boundary
+void manifold_planet_init_async(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api, struct JobSystem* job_system, size_t octree_size, struct Shader* shader, struct Vector* noises, vec3 position) {
+  manifold_planet_setup(planet, gpu_api, octree_size, shader, noises, position);
+  manifold_dual_contouring_contour_async(&planet->manifold_dual_contouring, job_system, noises, 0.0f);
 }
 
 void manifold_planet_delete(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api) {
@@ -15,16 +36,38 @@ void manifold_planet_delete(struct ManifoldPlanet* planet, struct GPUAPI* gpu_ap
 }
 
 void manifold_planet_render(struct ManifoldPlanet* planet, struct GPUAPI* gpu_api) {
-  if (vector_size(planet->manifold_dual_contouring.mesh->vertices) == 0)
+  memset(&planet->culling_stats, 0, sizeof(struct CullingStats));
+  if (vector_size(planet->manifold_dual_contouring.mesh->vertices) == 0 || uniform_ring_offsets_full(planet->manifold_dual_contouring.uniform_offsets, MANIFOLD_DUAL_CONTOURING_DYNAMIC_UNIFORMS))
+    return;
+
+  struct ManifoldDualContouring* manifold_dual_contouring = &planet->manifold_dual_contouring;
+  struct Frustum frustum;
+  frustum_init(&frustum, gpu_api->vulkan_state->gbuffer->projection_matrix, gpu_api->vulkan_state->gbuffer->view_matrix);
+  const mat4 model = manifold_planet_get_model(planet);
+  bool range_visible[MANIFOLD_OCTREE_INDEX_RANGES] = {0};
+  for (int range_num = 0; range_num < manifold_dual_contouring->cull_range_count; range_num++)
+    if (manifold_dual_contouring->cull_range_offsets[range_num + 1] > manifold_dual_contouring->cull_range_offsets[range_num])
+      range_visible[range_num] = culling_test_bounds(&frustum, &manifold_dual_contouring->cull_bounds[range_num], model, &planet->culling_stats);
+
+  if (planet->culling_stats.drawn == 0)
     return;
 
   vkCmdBindPipeline(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, planet->terrain_shader->graphics_pipeline);
   VkBuffer vertex_buffers[] = {planet->manifold_dual_contouring.vertex_buffer};
   VkDeviceSize offsets[] = {0};
   vkCmdBindVertexBuffers(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, 0, 1, vertex_buffers, offsets);
-  vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, planet->manifold_dual_contouring.index_buffer, 0, VK_INDEX_TYPE_UINT32);
-  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, planet->terrain_shader->pipeline_layout, 0, 1, &planet->manifold_dual_contouring.descriptor_set, 0, NULL);
-  vkCmdDrawIndexed(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, planet->manifold_dual_contouring.mesh->indices->size, 1, 0, 0, 0);
+  vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, planet->manifold_dual_contouring.index_buffer, 0, mesh_get_index_type(planet->manifold_dual_contouring.mesh));
+  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, planet->terrain_shader->pipeline_layout, 0, 1, &planet->manifold_dual_contouring.descriptor_set, MANIFOLD_DUAL_CONTOURING_DYNAMIC_UNIFORMS, planet->manifold_dual_contouring.uniform_offsets);
+  for (int range_num = 0; range_num < manifold_dual_contouring->cull_range_count; range_num++)
+    if (range_visible[range_num])
+      vkCmdDrawIndexed(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, manifold_dual_contouring->cull_range_offsets[range_num + 1] - manifold_dual_contouring->cull_range_offsets[range_num], 1, manifold_dual_contouring->index_range_starts[range_num], 0, 0);
+}
+
+// Note: Model of the float mesh, packed vertices are scaled out of their quantized range on top of this in the uniforms
+mat4 manifold_planet_get_model(struct ManifoldPlanet* planet) {
+  mat4 model = mat4_translate(MAT4_IDENTITY, planet->position);
+  model = mat4_scale(model, (vec3){.x = 10.0f, .y = 10.0f, .z = 10.0f});
+  return mat4_translate(model, (vec3){.x = -50.0f, .y = -300.0f, .z = -50.0f});
 }
 
 // TODO: Pass lights and sun position?
@@ -38,25 +81,21 @@ void manifold_planet_update_uniforms(struct ManifoldPlanet* planet, struct GPUAP
 
   dcubo.view = gpu_api->vulkan_state->gbuffer->view_matrix;
 
-  dcubo.model = mat4_translate(MAT4_IDENTITY, planet->position);
-  dcubo.model = mat4_scale(dcubo.model, (vec3){.x = 10.0f, .y = 10.0f, .z = 10.0f});
-  dcubo.model = mat4_translate(dcubo.model, (vec3){.x = -50.0f, .y = -300.0f, .z = -50.0f});
+  dcubo.model = manifold_planet_get_model(planet);
+#if MESH_PACKED_VERTICES
+  const float packed_offset = manifold_dual_contouring_packed_offset(&planet->manifold_dual_contouring);
+  const float packed_scale = manifold_dual_contouring_packed_scale(&planet->manifold_dual_contouring);
+  dcubo.model = mat4_translate(dcubo.model, (vec3){.x = packed_offset, .y = packed_offset, .z = packed_offset});
+  dcubo.model = mat4_scale(dcubo.model, (vec3){.x = packed_scale, .y = packed_scale, .z = packed_scale});
+#endif
 
   dcubo.camera_pos = camera->position;
-
-  void* terrain_data;
-  vkMapMemory(gpu_api->vulkan_state->device, planet->manifold_dual_contouring.dc_uniform_buffer_memory, 0, sizeof(struct ManifoldDualContouringUniformBufferObject), 0, &terrain_data);
-  memcpy(terrain_data, &dcubo, sizeof(struct ManifoldDualContouringUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, planet->manifold_dual_contouring.dc_uniform_buffer_memory);
+  planet->manifold_dual_contouring.uniform_offsets[0] = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &dcubo, sizeof(struct ManifoldDualContouringUniformBufferObject));
 
   struct LightingUniformBufferObject light_ubo = {{0}};
   light_ubo.direction = light_pos;
   light_ubo.ambient_color = (vec3){.data[0] = 1.0f, .data[1] = 1.0f, .data[2] = 1.0f};
   light_ubo.diffuse_colour = (vec3){.data[0] = 1.0f, .data[1] = 1.0f, .data[2] = 1.0f};
   light_ubo.specular_colour = (vec3){.data[0] = 1.0f, .data[1] = 1.0f, .data[2] = 1.0f};
-
-  void* lighting_data;
-  vkMapMemory(gpu_api->vulkan_state->device, planet->manifold_dual_contouring.lighting_uniform_buffer_memory, 0, sizeof(struct LightingUniformBufferObject), 0, &lighting_data);
-  memcpy(lighting_data, &light_ubo, sizeof(struct LightingUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, planet->manifold_dual_contouring.lighting_uniform_buffer_memory);
+  planet->manifold_dual_contouring.uniform_offsets[1] = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &light_ubo, sizeof(struct LightingUniformBufferObject));
 }
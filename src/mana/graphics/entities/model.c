@@ -178,8 +178,6 @@ void model_update_uniforms(struct Model* model, struct GPUAPI* gpu_api, vec3 pos
   vec3 light_specular = (vec3){.data[0] = 1.0f, .data[1] = 1.0f, .data[2] = 1.0f};
   light_ubo.specular_colour = light_specular;
 
-  void* data;
-
   struct ModelUniformBufferObject ubom = {{{0}}};
 
   ubom.proj = gpu_api->vulkan_state->gbuffer->projection_matrix;
@@ -193,24 +191,14 @@ void model_update_uniforms(struct Model* model, struct GPUAPI* gpu_api, vec3 pos
 
   ubom.camera_pos = position;
 
-  vkMapMemory(gpu_api->vulkan_state->device, model->uniform_buffers_memory, 0, sizeof(struct ModelUniformBufferObject), 0, &data);
-  memcpy(data, &ubom, sizeof(struct ModelUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, model->uniform_buffers_memory);
+  model->uniform_offsets[0] = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &ubom, sizeof(struct ModelUniformBufferObject));
+  model->uniform_offsets[1] = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &light_ubo, sizeof(struct LightingUniformBufferObject));
 
   if (model->animated) {
     struct ModelAnimationUniformBufferObject uboa = {{{0}}};
     model_get_joint_transforms(model->root_joint, uboa.joint_transforms);
-
-    void* animation_data;
-    vkMapMemory(gpu_api->vulkan_state->device, model->uniform_animation_buffers_memory, 0, sizeof(struct ModelAnimationUniformBufferObject), 0, &animation_data);
-    memcpy(animation_data, &uboa, sizeof(struct ModelAnimationUniformBufferObject));
-    vkUnmapMemory(gpu_api->vulkan_state->device, model->uniform_animation_buffers_memory);
+    model->uniform_offsets[2] = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &uboa, sizeof(struct ModelAnimationUniformBufferObject));
   }
-
-  void* lighting_data;
-  vkMapMemory(gpu_api->vulkan_state->device, model->lighting_uniform_buffers_memory, 0, sizeof(struct LightingUniformBufferObject), 0, &lighting_data);
-  memcpy(lighting_data, &light_ubo, sizeof(struct LightingUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, model->lighting_uniform_buffers_memory);
 }
 
 struct ModelJoint* model_create_joints_clone(struct ModelJoint* root_joint) {
@@ -244,6 +232,7 @@ struct Model* model_get_clone(struct Model* model, struct GPUAPI* gpu_api) {
   new_model->position = VEC3_ZERO;
   new_model->rotation = QUAT_DEFAULT;
   new_model->scale = VEC3_ONE;
+  memset(new_model->uniform_offsets, 0, sizeof(new_model->uniform_offsets));
 
   new_model->model_mesh = malloc(sizeof(struct Mesh));
   new_model->model_mesh->indices = malloc(sizeof(struct Vector));
@@ -267,27 +256,23 @@ struct Model* model_get_clone(struct Model* model, struct GPUAPI* gpu_api) {
 
   graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, new_model->model_mesh->vertices, &new_model->vertex_buffer, &new_model->vertex_buffer_memory);
   graphics_utils_setup_index_buffer(gpu_api->vulkan_state, new_model->model_mesh->indices, &new_model->index_buffer, &new_model->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct ModelUniformBufferObject), &new_model->uniform_buffer, &new_model->uniform_buffers_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct LightingUniformBufferObject), &new_model->lighting_uniform_buffer, &new_model->lighting_uniform_buffers_memory);
-  if (model->animated)
-    graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct ModelAnimationUniformBufferObject), &new_model->uniform_animation_buffer, &new_model->uniform_animation_buffers_memory);
   graphics_utils_setup_descriptor(gpu_api->vulkan_state, new_model->shader_handle->descriptor_set_layout, new_model->shader_handle->descriptor_pool, &new_model->descriptor_set);
 
   if (model->animated) {
     VkWriteDescriptorSet dcs[8] = {0};
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct ModelUniformBufferObject), &new_model->uniform_buffer)});
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 1, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct LightingUniformBufferObject), &new_model->lighting_uniform_buffer)});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct ModelUniformBufferObject))});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 1, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct LightingUniformBufferObject))});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 2, &new_model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&new_model->model_diffuse_texture->texture_image_view, &new_model->model_diffuse_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 3, &new_model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&new_model->model_normal_texture->texture_image_view, &new_model->model_normal_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 4, &new_model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&new_model->model_metallic_texture->texture_image_view, &new_model->model_metallic_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 5, &new_model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&new_model->model_roughness_texture->texture_image_view, &new_model->model_roughness_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 6, &new_model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&new_model->model_ao_texture->texture_image_view, &new_model->model_ao_texture->texture_sampler)});
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 7, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct ModelAnimationUniformBufferObject), &new_model->uniform_animation_buffer)});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 7, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct ModelAnimationUniformBufferObject))});
     vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 8, dcs, 0, NULL);
   } else {
     VkWriteDescriptorSet dcs[7] = {0};
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct ModelUniformBufferObject), &new_model->uniform_buffer)});
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 1, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct LightingUniformBufferObject), &new_model->lighting_uniform_buffer)});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct ModelUniformBufferObject))});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 1, &new_model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct LightingUniformBufferObject))});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 2, &new_model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&new_model->model_diffuse_texture->texture_image_view, &new_model->model_diffuse_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 3, &new_model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&new_model->model_normal_texture->texture_image_view, &new_model->model_normal_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 4, &new_model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&new_model->model_metallic_texture->texture_image_view, &new_model->model_metallic_texture->texture_sampler)});
@@ -301,16 +286,10 @@ struct Model* model_get_clone(struct Model* model, struct GPUAPI* gpu_api) {
 
 static inline void model_vulkan_cleanup(struct Model* model, struct GPUAPI* gpu_api) {
   vkDestroyBuffer(gpu_api->vulkan_state->device, model->index_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, model->index_buffer_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &model->index_buffer_memory);
 
   vkDestroyBuffer(gpu_api->vulkan_state->device, model->vertex_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, model->vertex_buffer_memory, NULL);
-
-  vkDestroyBuffer(gpu_api->vulkan_state->device, model->uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, model->uniform_buffers_memory, NULL);
-
-  vkDestroyBuffer(gpu_api->vulkan_state->device, model->lighting_uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, model->lighting_uniform_buffers_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &model->vertex_buffer_memory);
 }
 
 void model_clone_delete(struct Model* model, struct GPUAPI* gpu_api) {
@@ -332,12 +311,16 @@ void model_render(struct Model* model, struct GPUAPI* gpu_api, float delta_time)
   if (model->animated)
     animator_update(model->animator, delta_time);
 
+  const size_t uniform_count = model->animated ? MODEL_DYNAMIC_UNIFORMS : MODEL_DYNAMIC_UNIFORMS - 1;
+  if (uniform_ring_offsets_full(model->uniform_offsets, uniform_count))
+    return;
+
   vkCmdBindPipeline(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, model->shader_handle->graphics_pipeline);
   VkBuffer vertex_buffers[] = {model->vertex_buffer};
   VkDeviceSize offsets[] = {0};
   vkCmdBindVertexBuffers(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, 0, 1, vertex_buffers, offsets);
   vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, model->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, model->shader_handle->pipeline_layout, 0, 1, &model->descriptor_set, 0, NULL);
+  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, model->shader_handle->pipeline_layout, 0, 1, &model->descriptor_set, (uint32_t)uniform_count, model->uniform_offsets);
   vkCmdDrawIndexed(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, model->model_mesh->indices->size, 1, 0, 0, 0);
 }
 
@@ -346,27 +329,23 @@ void model_recreate(struct Model* model, struct GPUAPI* gpu_api) {
 
   graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, model->model_mesh->vertices, &model->vertex_buffer, &model->vertex_buffer_memory);
   graphics_utils_setup_index_buffer(gpu_api->vulkan_state, model->model_mesh->indices, &model->index_buffer, &model->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct ModelUniformBufferObject), &model->uniform_buffer, &model->uniform_buffers_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct LightingUniformBufferObject), &model->lighting_uniform_buffer, &model->lighting_uniform_buffers_memory);
-  if (model->animated)
-    graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct ModelAnimationUniformBufferObject), &model->uniform_buffer, &model->uniform_buffers_memory);
   graphics_utils_setup_descriptor(gpu_api->vulkan_state, model->shader_handle->descriptor_set_layout, model->shader_handle->descriptor_pool, &model->descriptor_set);
 
   if (model->animated) {
     VkWriteDescriptorSet dcs[8] = {0};
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct ModelUniformBufferObject), &model->uniform_buffer)});
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 1, &model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct LightingUniformBufferObject), &model->lighting_uniform_buffer)});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct ModelUniformBufferObject))});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 1, &model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct LightingUniformBufferObject))});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 2, &model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&model->model_diffuse_texture->texture_image_view, &model->model_diffuse_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 3, &model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&model->model_normal_texture->texture_image_view, &model->model_normal_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 4, &model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&model->model_metallic_texture->texture_image_view, &model->model_metallic_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 5, &model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&model->model_roughness_texture->texture_image_view, &model->model_roughness_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 6, &model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&model->model_ao_texture->texture_image_view, &model->model_ao_texture->texture_sampler)});
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 7, &model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct ModelAnimationUniformBufferObject), &model->uniform_buffer)});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 7, &model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct ModelAnimationUniformBufferObject))});
     vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 8, dcs, 0, NULL);
   } else {
     VkWriteDescriptorSet dcs[7] = {0};
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct ModelUniformBufferObject), &model->uniform_buffer)});
-    graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 1, &model->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct LightingUniformBufferObject), &model->lighting_uniform_buffer)});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct ModelUniformBufferObject))});
+    graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 1, &model->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct LightingUniformBufferObject))});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 2, &model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&model->model_diffuse_texture->texture_image_view, &model->model_diffuse_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 3, &model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&model->model_normal_texture->texture_image_view, &model->model_normal_texture->texture_sampler)});
     graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 4, &model->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&model->model_metallic_texture->texture_image_view, &model->model_metallic_texture->texture_sampler)});
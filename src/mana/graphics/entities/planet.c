@@ -1,42 +1,79 @@
 #include "mana/graphics/entities/planet.h"
 
-void planet_init(struct Planet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int)) {
+void planet_init(struct Planet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int)) {
   planet->planet_type = ROUND_PLANET;
   planet->terrain_shader = shader;
   planet->position = position;
-  dual_contouring_init(&planet->dual_contouring, gpu_api, octree_size, shader, noises, density_func_single, density_func_set);
+  dual_contouring_init(&planet->dual_contouring, gpu_api, octree_size, shader, noises, density_func_single, density_func_set, density_func_batch);
+}
+
+// Note: Same as planet_init but the mesh comes from mesh_path when it was saved with the same noises and settings, otherwise it's built and saved there
+void planet_init_cached(struct Planet* planet, struct GPUAPI* gpu_api, size_t octree_size, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int), const char* mesh_path) {
+  planet->planet_type = ROUND_PLANET;
+  planet->terrain_shader = shader;
+  planet->position = position;
+  dual_contouring_setup(&planet->dual_contouring, octree_size, shader, noises, density_func_single, density_func_set, density_func_batch);
+  if (dual_contouring_load_mesh(&planet->dual_contouring, mesh_path) != CHUNK_FILE_SUCCESS) {
+    dual_contouring_build(&planet->dual_contouring);
+    if (dual_contouring_save_mesh(&planet->dual_contouring, mesh_path) != CHUNK_FILE_SUCCESS)
+      fprintf(stderr, "Failed to save planet mesh to %s\n", mesh_path);
+  }
+  dual_contouring_upload(&planet->dual_contouring, gpu_api);
+}
+
+void planet_init_chunked(struct Planet* planet, struct Shader* shader, vec3 position, struct Vector* noises, float (*density_func_single)(struct Vector*, float, float, float), float* (*density_func_set)(struct Vector*, float, float, float, int, int, int), void (*density_func_batch)(struct Vector*, float (*)[3], float*, int)) {
+  planet->planet_type = CHUNKED_PLANET;
+  planet->terrain_shader = shader;
+  planet->position = position;
+  chunk_manager_init(&planet->chunk_manager, shader, position, noises, density_func_single, density_func_set, density_func_batch);
 }
 
 void planet_delete(struct Planet* planet, struct GPUAPI* gpu_api) {
-  dual_contouring_delete(&planet->dual_contouring, gpu_api);
+  if (planet->planet_type == CHUNKED_PLANET)
+    chunk_manager_delete(&planet->chunk_manager, gpu_api);
+  else
+    dual_contouring_delete(&planet->dual_contouring, gpu_api);
+}
+
+void planet_update(struct Planet* planet, struct GPUAPI* gpu_api, struct Camera* camera) {
+  if (planet->planet_type == CHUNKED_PLANET)
+    chunk_manager_update(&planet->chunk_manager, gpu_api, camera);
 }
 
 void planet_render(struct Planet* planet, struct GPUAPI* gpu_api) {
   vkCmdBindPipeline(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, planet->terrain_shader->graphics_pipeline);
+  if (planet->planet_type == CHUNKED_PLANET) {
+    chunk_manager_render(&planet->chunk_manager, gpu_api);
+    planet->culling_stats = planet->chunk_manager.culling_stats;
+    return;
+  }
+
+  struct Frustum frustum;
+  frustum_init(&frustum, gpu_api->vulkan_state->gbuffer->projection_matrix, gpu_api->vulkan_state->gbuffer->view_matrix);
+  memset(&planet->culling_stats, 0, sizeof(struct CullingStats));
+  if (vector_size(planet->dual_contouring.mesh->indices) == 0 || uniform_ring_offsets_full(planet->dual_contouring.uniform_offsets, DUAL_CONTOURING_DYNAMIC_UNIFORMS) || !culling_test_bounds(&frustum, &planet->dual_contouring.bounds, mat4_translate(MAT4_IDENTITY, planet->position), &planet->culling_stats))
+    return;
+
   VkBuffer vertex_buffers[] = {planet->dual_contouring.vertex_buffer};
   VkDeviceSize offsets[] = {0};
   vkCmdBindVertexBuffers(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, 0, 1, vertex_buffers, offsets);
-  vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, planet->dual_contouring.index_buffer, 0, VK_INDEX_TYPE_UINT32);
-  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, planet->terrain_shader->pipeline_layout, 0, 1, &planet->dual_contouring.descriptor_set, 0, NULL);
+  vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, planet->dual_contouring.index_buffer, 0, mesh_get_index_type(planet->dual_contouring.mesh));
+  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, planet->terrain_shader->pipeline_layout, 0, 1, &planet->dual_contouring.descriptor_set, DUAL_CONTOURING_DYNAMIC_UNIFORMS, planet->dual_contouring.uniform_offsets);
   vkCmdDrawIndexed(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, planet->dual_contouring.mesh->indices->size, 1, 0, 0, 0);
 }
 
-// TODO: Pass lights and sun position?
-void planet_update_uniforms(struct Planet* planet, struct GPUAPI* gpu_api, struct Camera* camera, vec3 light_pos) {
+static inline void planet_write_uniforms(struct DualContouring* dual_contouring, struct GPUAPI* gpu_api, struct Camera* camera, vec3 light_pos, mat4 model) {
   struct DualContouringUniformBufferObject dcubo = {{{0}}};
   dcubo.proj = gpu_api->vulkan_state->gbuffer->projection_matrix;
   dcubo.proj.m11 *= -1;
 
   dcubo.view = gpu_api->vulkan_state->gbuffer->view_matrix;
 
-  dcubo.model = mat4_translate(MAT4_IDENTITY, planet->position);
+  dcubo.model = model;
 
   dcubo.camera_pos = camera->position;
 
-  void* terrain_data;
-  vkMapMemory(gpu_api->vulkan_state->device, planet->dual_contouring.dc_uniform_buffer_memory, 0, sizeof(struct DualContouringUniformBufferObject), 0, &terrain_data);
-  memcpy(terrain_data, &dcubo, sizeof(struct DualContouringUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, planet->dual_contouring.dc_uniform_buffer_memory);
+  dual_contouring->uniform_offsets[0] = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &dcubo, sizeof(struct DualContouringUniformBufferObject));
 
   struct LightingUniformBufferObject light_ubo = {{0}};
   light_ubo.direction = light_pos;
@@ -44,8 +81,21 @@ void planet_update_uniforms(struct Planet* planet, struct GPUAPI* gpu_api, struc
   light_ubo.diffuse_colour = (vec3){.data[0] = 1.0f, .data[1] = 1.0f, .data[2] = 1.0f};
   light_ubo.specular_colour = (vec3){.data[0] = 1.0f, .data[1] = 1.0f, .data[2] = 1.0f};
 
-  void* lighting_data;
-  vkMapMemory(gpu_api->vulkan_state->device, planet->dual_contouring.lighting_uniform_buffer_memory, 0, sizeof(struct LightingUniformBufferObject), 0, &lighting_data);
-  memcpy(lighting_data, &light_ubo, sizeof(struct LightingUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, planet->dual_contouring.lighting_uniform_buffer_memory);
+  dual_contouring->uniform_offsets[1] = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &light_ubo, sizeof(struct LightingUniformBufferObject));
+}
+
+// TODO: Pass lights and sun position?
+void planet_update_uniforms(struct Planet* planet, struct GPUAPI* gpu_api, struct Camera* camera, vec3 light_pos) {
+  if (planet->planet_type != CHUNKED_PLANET) {
+    planet_write_uniforms(&planet->dual_contouring, gpu_api, camera, light_pos, mat4_translate(MAT4_IDENTITY, planet->position));
+    return;
+  }
+
+  struct ChunkManager* chunk_manager = &planet->chunk_manager;
+  const int slot_count = chunk_manager->slot_width * chunk_manager->slot_width * chunk_manager->slot_width;
+  for (int slot_num = 0; slot_num < slot_count; slot_num++) {
+    struct Chunk* chunk = &chunk_manager->chunks[slot_num];
+    if (chunk->active && !chunk->empty)
+      planet_write_uniforms(&chunk->dual_contouring, gpu_api, camera, light_pos, chunk_manager_get_chunk_model(chunk_manager, chunk));
+  }
 }
@@ -10,17 +10,26 @@
 //  glm_vec3_crossn(v1, v2, dest);
 //}
 
+// Note: Only the transform and size, enough for a sprite batch to draw it. sprite_init does this and makes the sprite's own buffers
+void sprite_setup(struct Sprite* sprite, struct Texture* texture) {
+  memset(sprite, 0, sizeof(struct Sprite));
+  sprite->image_texture = texture;
+  sprite->scale = VEC3_ONE;
+  sprite->rotation = QUAT_DEFAULT;
+  sprite->width = texture->width / 100.0f;
+  sprite->height = texture->height / 100.0f;
+}
+
 int sprite_init(struct Sprite* sprite, struct GPUAPI* gpu_api, struct Shader* shader, struct Texture* texture) {
+  sprite_setup(sprite, texture);
   sprite->image_mesh = calloc(1, sizeof(struct Mesh));
   mesh_sprite_init(sprite->image_mesh);
 
-  sprite->image_texture = texture;
   sprite->shader = shader;
-  sprite->scale = VEC3_ONE;
-  sprite->rotation = QUAT_DEFAULT;
+  sprite->uniform_offset = 0;
 
-  float tex_norm_width = texture->width / 100.0f;
-  float tex_norm_height = texture->height / 100.0f;
+  float tex_norm_width = sprite->width;
+  float tex_norm_height = sprite->height;
 
   float tex_norm_width_half = tex_norm_width / 2.0f;
   float tex_norm_height_half = tex_norm_height / 2.0f;
@@ -69,11 +78,10 @@ int sprite_init(struct Sprite* sprite, struct GPUAPI* gpu_api, struct Shader* sh
 
   graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, sprite->image_mesh->vertices, &sprite->vertex_buffer, &sprite->vertex_buffer_memory);
   graphics_utils_setup_index_buffer(gpu_api->vulkan_state, sprite->image_mesh->indices, &sprite->index_buffer, &sprite->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct SpriteUniformBufferObject), &sprite->uniform_buffer, &sprite->uniform_buffers_memory);
   graphics_utils_setup_descriptor(gpu_api->vulkan_state, shader->descriptor_set_layout, shader->descriptor_pool, &sprite->descriptor_set);
 
   VkWriteDescriptorSet dcs[2] = {0};
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &sprite->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct SpriteUniformBufferObject), &sprite->uniform_buffer)});
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &sprite->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct SpriteUniformBufferObject))});
   graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 1, &sprite->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&sprite->image_texture->texture_image_view, &sprite->image_texture->texture_sampler)});
   vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
 
@@ -82,13 +90,10 @@ int sprite_init(struct Sprite* sprite, struct GPUAPI* gpu_api, struct Shader* sh
 
 static inline void sprite_vulkan_cleanup(struct Sprite* sprite, struct GPUAPI* gpu_api) {
   vkDestroyBuffer(gpu_api->vulkan_state->device, sprite->index_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, sprite->index_buffer_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &sprite->index_buffer_memory);
 
   vkDestroyBuffer(gpu_api->vulkan_state->device, sprite->vertex_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, sprite->vertex_buffer_memory, NULL);
-
-  vkDestroyBuffer(gpu_api->vulkan_state->device, sprite->uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, sprite->uniform_buffers_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &sprite->vertex_buffer_memory);
 }
 
 void sprite_delete(struct Sprite* sprite, struct GPUAPI* gpu_api) {
@@ -98,13 +103,16 @@ void sprite_delete(struct Sprite* sprite, struct GPUAPI* gpu_api) {
 }
 
 void sprite_render(struct Sprite* sprite, struct GPUAPI* gpu_api) {
+  if (sprite->uniform_offset == UNIFORM_RING_FULL)
+    return;
+
   vkCmdBindPipeline(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sprite->shader->graphics_pipeline);
 
   VkBuffer vertex_buffers[] = {sprite->vertex_buffer};
   VkDeviceSize offsets[] = {0};
   vkCmdBindVertexBuffers(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, 0, 1, vertex_buffers, offsets);
   vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, sprite->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sprite->shader->pipeline_layout, 0, 1, &sprite->descriptor_set, 0, NULL);
+  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sprite->shader->pipeline_layout, 0, 1, &sprite->descriptor_set, 1, &sprite->uniform_offset);
   vkCmdDrawIndexed(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, sprite->image_mesh->indices->size, 1, 0, 0, 0);
 }
 
@@ -119,10 +127,7 @@ void sprite_update_uniforms(struct Sprite* sprite, struct GPUAPI* gpu_api) {
   ubos.model = mat4_mul(ubos.model, quaternion_to_mat4(quaternion_normalise(sprite->rotation)));
   ubos.model = mat4_scale(ubos.model, sprite->scale);
 
-  void* data;
-  vkMapMemory(gpu_api->vulkan_state->device, sprite->uniform_buffers_memory, 0, sizeof(struct SpriteUniformBufferObject), 0, &data);
-  memcpy(data, &ubos, sizeof(struct SpriteUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, sprite->uniform_buffers_memory);
+  sprite->uniform_offset = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &ubos, sizeof(struct SpriteUniformBufferObject));
 }
 
 void sprite_recreate(struct Sprite* sprite, struct GPUAPI* gpu_api) {
@@ -130,11 +135,10 @@ void sprite_recreate(struct Sprite* sprite, struct GPUAPI* gpu_api) {
 
   graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, sprite->image_mesh->vertices, &sprite->vertex_buffer, &sprite->vertex_buffer_memory);
   graphics_utils_setup_index_buffer(gpu_api->vulkan_state, sprite->image_mesh->indices, &sprite->index_buffer, &sprite->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct SpriteUniformBufferObject), &sprite->uniform_buffer, &sprite->uniform_buffers_memory);
   graphics_utils_setup_descriptor(gpu_api->vulkan_state, sprite->shader->descriptor_set_layout, sprite->shader->descriptor_pool, &sprite->descriptor_set);
 
   VkWriteDescriptorSet dcs[2] = {0};
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &sprite->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct SpriteUniformBufferObject), &sprite->uniform_buffer)});
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &sprite->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct SpriteUniformBufferObject))});
   graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 1, &sprite->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&sprite->image_texture->texture_image_view, &sprite->image_texture->texture_sampler)});
   vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
   //vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
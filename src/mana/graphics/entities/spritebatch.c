@@ -0,0 +1,247 @@
+#include "mana/graphics/entities/spritebatch.h"
+
+// Note: Swaps in a buffer of max_instances per frame, the frame still in flight may be reading the old one so the upload manager frees it once that frame is done
+static int sprite_batch_create_instance_buffer(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, size_t max_instances) {
+  VkBuffer instance_buffer = VK_NULL_HANDLE;
+  struct GPUAllocation instance_buffer_memory = {0};
+  if (graphics_utils_create_buffer(gpu_api->vulkan_state, sizeof(struct VertexSpriteInstance) * max_instances * MAX_FRAMES_IN_FLIGHT, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &instance_buffer, &instance_buffer_memory) != 0)
+    return SPRITE_BATCH_CREATE_BUFFER_ERROR;
+
+  char* mapped_instances = (char*)gpu_allocator_map(gpu_api->vulkan_state->gpu_allocator, &instance_buffer_memory);
+  if (mapped_instances == NULL) {
+    fprintf(stderr, "failed to map sprite batch instance memory!\n");
+    vkDestroyBuffer(gpu_api->vulkan_state->device, instance_buffer, NULL);
+    gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &instance_buffer_memory);
+    return SPRITE_BATCH_MAP_MEMORY_ERROR;
+  }
+
+  if (sprite_batch->instance_buffer != VK_NULL_HANDLE) {
+    gpu_allocator_unmap(gpu_api->vulkan_state->gpu_allocator, &sprite_batch->instance_buffer_memory);
+    upload_manager_retire_buffer(gpu_api->vulkan_state->upload_manager, sprite_batch->instance_buffer, &sprite_batch->instance_buffer_memory);
+  }
+
+  sprite_batch->instance_buffer = instance_buffer;
+  sprite_batch->instance_buffer_memory = instance_buffer_memory;
+  sprite_batch->mapped_instances = mapped_instances;
+  sprite_batch->max_instances = max_instances;
+
+  return SPRITE_BATCH_SUCCESS;
+}
+
+int sprite_batch_init(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct Shader* shader, size_t max_instances) {
+  sprite_batch->quad_mesh = calloc(1, sizeof(struct Mesh));
+  mesh_sprite_init(sprite_batch->quad_mesh);
+
+  sprite_batch->shader = shader;
+  sprite_batch->instance_buffer = VK_NULL_HANDLE;
+  sprite_batch->mapped_instances = NULL;
+  sprite_batch->max_instances = 0;
+  sprite_batch->last_texture = 0;
+  sprite_batch->instance_count = 0;
+  sprite_batch->dropped_instances = 0;
+  sprite_batch->drop_reported = false;
+  sprite_batch->instance_offset = 0;
+  sprite_batch->uniform_offset = 0;
+  sprite_batch->draw_count = 0;
+  vector_init(&sprite_batch->textures, sizeof(struct SpriteBatchTexture));
+
+  // Note: Unit quad with the same winding and uvs as a single sprite, every instance scales it to its own size
+  mesh_sprite_assign_vertex(sprite_batch->quad_mesh->vertices, -0.5f, -0.5f, 0.0f, 0.0f, 1.0f);
+  mesh_sprite_assign_vertex(sprite_batch->quad_mesh->vertices, 0.5f, -0.5f, 0.0f, 1.0f, 1.0f);
+  mesh_sprite_assign_vertex(sprite_batch->quad_mesh->vertices, 0.5f, 0.5f, 0.0f, 1.0f, 0.0f);
+  mesh_sprite_assign_vertex(sprite_batch->quad_mesh->vertices, -0.5f, 0.5f, 0.0f, 0.0f, 0.0f);
+
+  mesh_assign_indice(sprite_batch->quad_mesh->indices, 0);
+  mesh_assign_indice(sprite_batch->quad_mesh->indices, 1);
+  mesh_assign_indice(sprite_batch->quad_mesh->indices, 2);
+  mesh_assign_indice(sprite_batch->quad_mesh->indices, 2);
+  mesh_assign_indice(sprite_batch->quad_mesh->indices, 3);
+  mesh_assign_indice(sprite_batch->quad_mesh->indices, 0);
+
+  graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, sprite_batch->quad_mesh->vertices, &sprite_batch->vertex_buffer, &sprite_batch->vertex_buffer_memory);
+  graphics_utils_setup_index_buffer(gpu_api->vulkan_state, sprite_batch->quad_mesh->indices, &sprite_batch->index_buffer, &sprite_batch->index_buffer_memory);
+
+  return sprite_batch_create_instance_buffer(sprite_batch, gpu_api, MIN(MAX(max_instances, 1), SPRITE_BATCH_MAX_INSTANCES));
+}
+
+void sprite_batch_delete(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api) {
+  for (size_t texture_num = 0; texture_num < vector_size(&sprite_batch->textures); texture_num++)
+    vector_delete(&((struct SpriteBatchTexture*)vector_get(&sprite_batch->textures, texture_num))->instances);
+  vector_delete(&sprite_batch->textures);
+
+  gpu_allocator_unmap(gpu_api->vulkan_state->gpu_allocator, &sprite_batch->instance_buffer_memory);
+  vkDestroyBuffer(gpu_api->vulkan_state->device, sprite_batch->instance_buffer, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &sprite_batch->instance_buffer_memory);
+
+  vkDestroyBuffer(gpu_api->vulkan_state->device, sprite_batch->index_buffer, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &sprite_batch->index_buffer_memory);
+
+  vkDestroyBuffer(gpu_api->vulkan_state->device, sprite_batch->vertex_buffer, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &sprite_batch->vertex_buffer_memory);
+
+  mesh_delete(sprite_batch->quad_mesh);
+  free(sprite_batch->quad_mesh);
+}
+
+// Note: Leaves the set null when the shader's pool is out of them, instances of that texture are dropped until a recreate finds room
+static inline int sprite_batch_setup_descriptor(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct SpriteBatchTexture* batch_texture) {
+  if (graphics_utils_setup_descriptor(gpu_api->vulkan_state, sprite_batch->shader->descriptor_set_layout, sprite_batch->shader->descriptor_pool, &batch_texture->descriptor_set) != 0) {
+    batch_texture->descriptor_set = VK_NULL_HANDLE;
+    return SPRITE_BATCH_DESCRIPTOR_ERROR;
+  }
+
+  VkWriteDescriptorSet dcs[2] = {0};
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &batch_texture->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct SpriteBatchUniformBufferObject))});
+  graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 1, &batch_texture->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&batch_texture->texture->texture_image_view, &batch_texture->texture->texture_sampler)});
+  vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
+
+  return SPRITE_BATCH_SUCCESS;
+}
+
+// Note: Call every frame before adding, nothing carries over from the last frame
+void sprite_batch_begin(struct SpriteBatch* sprite_batch) {
+  for (size_t texture_num = 0; texture_num < vector_size(&sprite_batch->textures); texture_num++)
+    vector_clear(&((struct SpriteBatchTexture*)vector_get(&sprite_batch->textures, texture_num))->instances);
+
+  sprite_batch->instance_count = 0;
+  sprite_batch->dropped_instances = 0;
+}
+
+// Note: Buckets by texture as instances come in so sorting costs nothing at draw time. Runs of the same texture skip the search
+void sprite_batch_add(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct Texture* texture, struct VertexSpriteInstance* instance) {
+  if (sprite_batch->instance_count == SPRITE_BATCH_MAX_INSTANCES) {
+    sprite_batch->dropped_instances++;
+    return;
+  }
+
+  struct SpriteBatchTexture* batch_texture = NULL;
+  if (sprite_batch->last_texture < vector_size(&sprite_batch->textures))
+    batch_texture = (struct SpriteBatchTexture*)vector_get(&sprite_batch->textures, sprite_batch->last_texture);
+
+  if (batch_texture == NULL || batch_texture->texture != texture) {
+    batch_texture = NULL;
+    for (size_t texture_num = 0; texture_num < vector_size(&sprite_batch->textures); texture_num++) {
+      struct SpriteBatchTexture* search_texture = (struct SpriteBatchTexture*)vector_get(&sprite_batch->textures, texture_num);
+      if (search_texture->texture == texture) {
+        batch_texture = search_texture;
+        sprite_batch->last_texture = texture_num;
+        break;
+      }
+    }
+
+    if (batch_texture == NULL) {
+      struct SpriteBatchTexture new_texture = {0};
+      new_texture.texture = texture;
+      vector_init(&new_texture.instances, sizeof(struct VertexSpriteInstance));
+      sprite_batch_setup_descriptor(sprite_batch, gpu_api, &new_texture);
+      vector_push_back(&sprite_batch->textures, &new_texture);
+
+      sprite_batch->last_texture = vector_size(&sprite_batch->textures) - 1;
+      batch_texture = (struct SpriteBatchTexture*)vector_get(&sprite_batch->textures, sprite_batch->last_texture);
+    }
+  }
+
+  if (batch_texture->descriptor_set == VK_NULL_HANDLE) {
+    sprite_batch->dropped_instances++;
+    return;
+  }
+
+  vector_push_back(&batch_texture->instances, instance);
+  sprite_batch->instance_count++;
+}
+
+void sprite_batch_add_sprite(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct Sprite* sprite) {
+  struct VertexSpriteInstance instance = {0};
+  instance.position = sprite->position;
+  instance.size = (vec2){.x = sprite->width * sprite->scale.x, .y = sprite->height * sprite->scale.y};
+  instance.rotation = sprite->rotation;
+  instance.uv_rect = (vec4){.x = 0.0f, .y = 0.0f, .z = 1.0f, .w = 1.0f};
+
+  sprite_batch_add(sprite_batch, gpu_api, sprite->image_texture, &instance);
+}
+
+void sprite_batch_add_sprite_animation(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api, struct SpriteAnimation* sprite_animation) {
+  struct VertexSpriteInstance instance = {0};
+  instance.position = sprite_animation->position;
+  instance.size = (vec2){.x = sprite_animation->width * sprite_animation->scale.x, .y = sprite_animation->height * sprite_animation->scale.y};
+  instance.rotation = sprite_animation->rotation;
+  instance.uv_rect = sprite_animation_get_uv_rect(sprite_animation);
+
+  sprite_batch_add(sprite_batch, gpu_api, sprite_animation->image_texture, &instance);
+}
+
+// Note: Packs every texture's instances back to back into this frame's region so each texture is one contiguous instance range
+void sprite_batch_update_uniforms(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api) {
+  struct SpriteBatchUniformBufferObject ubos = {{{0}}};
+  ubos.proj = gpu_api->vulkan_state->gbuffer->projection_matrix;
+  ubos.proj.vecs[1].data[1] *= -1;
+
+  ubos.view = gpu_api->vulkan_state->gbuffer->view_matrix;
+
+  sprite_batch->uniform_offset = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &ubos, sizeof(struct SpriteBatchUniformBufferObject));
+
+  // Note: Doubles until this frame's sprites fit, a buffer that can't be made keeps the old one and draws only what fits in it
+  if (sprite_batch->instance_count > sprite_batch->max_instances) {
+    size_t max_instances = sprite_batch->max_instances;
+    while (max_instances < sprite_batch->instance_count)
+      max_instances *= 2;
+    sprite_batch_create_instance_buffer(sprite_batch, gpu_api, MIN(max_instances, SPRITE_BATCH_MAX_INSTANCES));
+  }
+
+  const size_t unfitted_instances = (sprite_batch->instance_count > sprite_batch->max_instances) ? sprite_batch->instance_count - sprite_batch->max_instances : 0;
+  if (sprite_batch->dropped_instances + unfitted_instances > 0 && !sprite_batch->drop_reported) {
+    fprintf(stderr, "Sprite batch dropped %zu sprites, a frame can hold %d instances and %d textures!\n", sprite_batch->dropped_instances + unfitted_instances, SPRITE_BATCH_MAX_INSTANCES, SPRITE_BATCH_SHADER_MAX_TEXTURES);
+    sprite_batch->drop_reported = true;
+  }
+
+  sprite_batch->instance_offset = sizeof(struct VertexSpriteInstance) * sprite_batch->max_instances * gpu_api->vulkan_state->swap_chain->current_frame;
+  char* instance_memory = sprite_batch->mapped_instances + sprite_batch->instance_offset;
+  size_t remaining_instances = sprite_batch->max_instances;
+  for (size_t texture_num = 0; texture_num < vector_size(&sprite_batch->textures); texture_num++) {
+    struct Vector* instances = &((struct SpriteBatchTexture*)vector_get(&sprite_batch->textures, texture_num))->instances;
+    const size_t instance_count = MIN(vector_size(instances), remaining_instances);
+    memcpy(instance_memory, instances->items, instance_count * sizeof(struct VertexSpriteInstance));
+    instance_memory += instance_count * sizeof(struct VertexSpriteInstance);
+    remaining_instances -= instance_count;
+  }
+}
+
+void sprite_batch_render(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api) {
+  sprite_batch->draw_count = 0;
+  if (sprite_batch->instance_count == 0 || sprite_batch->uniform_offset == UNIFORM_RING_FULL)
+    return;
+
+  VkCommandBuffer command_buffer = gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer;
+  vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sprite_batch->shader->graphics_pipeline);
+
+  VkBuffer vertex_buffers[] = {sprite_batch->vertex_buffer, sprite_batch->instance_buffer};
+  VkDeviceSize offsets[] = {0, sprite_batch->instance_offset};
+  vkCmdBindVertexBuffers(command_buffer, 0, 2, vertex_buffers, offsets);
+  vkCmdBindIndexBuffer(command_buffer, sprite_batch->index_buffer, 0, VK_INDEX_TYPE_UINT32);
+
+  uint32_t first_instance = 0;
+  size_t remaining_instances = sprite_batch->max_instances;
+  for (size_t texture_num = 0; texture_num < vector_size(&sprite_batch->textures); texture_num++) {
+    struct SpriteBatchTexture* batch_texture = (struct SpriteBatchTexture*)vector_get(&sprite_batch->textures, texture_num);
+    const uint32_t instance_count = (uint32_t)MIN(vector_size(&batch_texture->instances), remaining_instances);
+    if (instance_count == 0)
+      continue;
+    remaining_instances -= instance_count;
+
+    vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sprite_batch->shader->pipeline_layout, 0, 1, &batch_texture->descriptor_set, 1, &sprite_batch->uniform_offset);
+    vkCmdDrawIndexed(command_buffer, sprite_batch->quad_mesh->indices->size, instance_count, 0, 0, first_instance);
+    first_instance += instance_count;
+    sprite_batch->draw_count++;
+  }
+
+#if SPRITE_BATCH_BENCHMARK
+  printf("Sprite batch drew %zu sprites in %d draws\n", sprite_batch->instance_count, sprite_batch->draw_count);
+#endif
+}
+
+// Note: Call after the shader is recreated, the descriptor sets went with its pool
+void sprite_batch_recreate(struct SpriteBatch* sprite_batch, struct GPUAPI* gpu_api) {
+  for (size_t texture_num = 0; texture_num < vector_size(&sprite_batch->textures); texture_num++)
+    if (sprite_batch_setup_descriptor(sprite_batch, gpu_api, (struct SpriteBatchTexture*)vector_get(&sprite_batch->textures, texture_num)) != SPRITE_BATCH_SUCCESS)
+      fprintf(stderr, "Sprite batch shader is out of descriptor sets, its pool holds %d textures!\n", SPRITE_BATCH_SHADER_MAX_TEXTURES);
+}
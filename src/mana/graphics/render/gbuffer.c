@@ -11,13 +11,13 @@ int gbuffer_init(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
   uint32_t gbuffer_height = vulkan_renderer->swap_chain->swap_chain_extent.height * vulkan_renderer->swap_chain->supersample_scale;
 
   // Resolve or standard if not multisampling
-  graphics_utils_create_image(vulkan_renderer->device, vulkan_renderer->physical_device, gbuffer_width, gbuffer_height, 1, VK_SAMPLE_COUNT_1_BIT, image_format, VK_IMAGE_TILING_OPTIMAL, image_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->color_image, &gbuffer->color_image_memory);
+  graphics_utils_create_image(vulkan_renderer, gbuffer_width, gbuffer_height, 1, VK_SAMPLE_COUNT_1_BIT, image_format, VK_IMAGE_TILING_OPTIMAL, image_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->color_image, &gbuffer->color_image_memory);
   graphics_utils_create_image_view(vulkan_renderer->device, gbuffer->color_image, image_format, VK_IMAGE_ASPECT_COLOR_BIT, 1, &vulkan_renderer->gbuffer->color_image_view);
 
-  graphics_utils_create_image(vulkan_renderer->device, vulkan_renderer->physical_device, gbuffer_width, gbuffer_height, 1, VK_SAMPLE_COUNT_1_BIT, image_format, VK_IMAGE_TILING_OPTIMAL, image_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->normal_image, &gbuffer->normal_image_memory);
+  graphics_utils_create_image(vulkan_renderer, gbuffer_width, gbuffer_height, 1, VK_SAMPLE_COUNT_1_BIT, image_format, VK_IMAGE_TILING_OPTIMAL, image_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->normal_image, &gbuffer->normal_image_memory);
   graphics_utils_create_image_view(vulkan_renderer->device, gbuffer->normal_image, image_format, VK_IMAGE_ASPECT_COLOR_BIT, 1, &vulkan_renderer->gbuffer->normal_image_view);
 
-  graphics_utils_create_image(vulkan_renderer->device, vulkan_renderer->physical_device, gbuffer_width, gbuffer_height, 1, vulkan_renderer->msaa_samples, depth_format, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->depth_image, &gbuffer->depth_image_memory);
+  graphics_utils_create_image(vulkan_renderer, gbuffer_width, gbuffer_height, 1, vulkan_renderer->msaa_samples, depth_format, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->depth_image, &gbuffer->depth_image_memory);
   graphics_utils_create_image_view(vulkan_renderer->device, gbuffer->depth_image, depth_format, VK_IMAGE_ASPECT_DEPTH_BIT, 1, &gbuffer->depth_image_view);
 
   VkAttachmentDescription color_attachment = {0};
@@ -50,10 +50,10 @@ int gbuffer_init(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
     depth_attachment_ref.attachment = 2;
 
     // Multisample
-    graphics_utils_create_image(vulkan_renderer->device, vulkan_renderer->physical_device, gbuffer_width, gbuffer_height, 1, vulkan_renderer->msaa_samples, image_format, VK_IMAGE_TILING_OPTIMAL, image_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->multisample_color_image, &gbuffer->multisample_color_image_memory);
+    graphics_utils_create_image(vulkan_renderer, gbuffer_width, gbuffer_height, 1, vulkan_renderer->msaa_samples, image_format, VK_IMAGE_TILING_OPTIMAL, image_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->multisample_color_image, &gbuffer->multisample_color_image_memory);
     graphics_utils_create_image_view(vulkan_renderer->device, gbuffer->multisample_color_image, image_format, VK_IMAGE_ASPECT_COLOR_BIT, 1, &vulkan_renderer->gbuffer->multisample_color_image_view);
 
-    graphics_utils_create_image(vulkan_renderer->device, vulkan_renderer->physical_device, gbuffer_width, gbuffer_height, 1, vulkan_renderer->msaa_samples, image_format, VK_IMAGE_TILING_OPTIMAL, image_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->multisample_normal_image, &gbuffer->multisample_normal_image_memory);
+    graphics_utils_create_image(vulkan_renderer, gbuffer_width, gbuffer_height, 1, vulkan_renderer->msaa_samples, image_format, VK_IMAGE_TILING_OPTIMAL, image_usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &gbuffer->multisample_normal_image, &gbuffer->multisample_normal_image_memory);
     graphics_utils_create_image_view(vulkan_renderer->device, gbuffer->multisample_normal_image, image_format, VK_IMAGE_ASPECT_COLOR_BIT, 1, &vulkan_renderer->gbuffer->multisample_normal_image_view);
 
     VkAttachmentDescription multisample_color_attachment = {0};
@@ -134,7 +134,8 @@ int gbuffer_init(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
     VkSemaphoreCreateInfo semaphore_info = {0};
     semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    vkCreateSemaphore(vulkan_renderer->device, &semaphore_info, NULL, &gbuffer->gbuffer_semaphore);
+    for (int frame_num = 0; frame_num < MAX_FRAMES_IN_FLIGHT; frame_num++)
+      vkCreateSemaphore(vulkan_renderer->device, &semaphore_info, NULL, &gbuffer->gbuffer_semaphores[frame_num]);
     graphics_utils_create_sampler(vulkan_renderer->device, &gbuffer->texture_sampler, (struct SamplerSettings){.mip_levels = 0, .filter = VK_FILTER_LINEAR, .address_mode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE});
 
     gbuffer->projection_matrix = MAT4_ZERO;
@@ -145,10 +146,11 @@ int gbuffer_init(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
     alloc_info_offscreen.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     alloc_info_offscreen.commandPool = vulkan_renderer->command_pool;
     alloc_info_offscreen.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    alloc_info_offscreen.commandBufferCount = 1;
+    alloc_info_offscreen.commandBufferCount = MAX_FRAMES_IN_FLIGHT;
 
-    if (vkAllocateCommandBuffers(vulkan_renderer->device, &alloc_info_offscreen, &gbuffer->gbuffer_command_buffer) != VK_SUCCESS)
+    if (vkAllocateCommandBuffers(vulkan_renderer->device, &alloc_info_offscreen, gbuffer->gbuffer_command_buffers) != VK_SUCCESS)
       return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
+    gbuffer->gbuffer_command_buffer = gbuffer->gbuffer_command_buffers[0];
   } else {
     color_attachment_ref.attachment = 0;
     normal_attachment_ref.attachment = 1;
@@ -207,7 +209,8 @@ int gbuffer_init(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
     VkSemaphoreCreateInfo semaphore_info = {0};
     semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    vkCreateSemaphore(vulkan_renderer->device, &semaphore_info, NULL, &gbuffer->gbuffer_semaphore);
+    for (int frame_num = 0; frame_num < MAX_FRAMES_IN_FLIGHT; frame_num++)
+      vkCreateSemaphore(vulkan_renderer->device, &semaphore_info, NULL, &gbuffer->gbuffer_semaphores[frame_num]);
     graphics_utils_create_sampler(vulkan_renderer->device, &gbuffer->texture_sampler, (struct SamplerSettings){.mip_levels = 0, .filter = VK_FILTER_LINEAR, .address_mode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE});
 
     gbuffer->projection_matrix = MAT4_ZERO;
@@ -218,10 +221,11 @@ int gbuffer_init(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
     alloc_info_offscreen.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     alloc_info_offscreen.commandPool = vulkan_renderer->command_pool;
     alloc_info_offscreen.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    alloc_info_offscreen.commandBufferCount = 1;
+    alloc_info_offscreen.commandBufferCount = MAX_FRAMES_IN_FLIGHT;
 
-    if (vkAllocateCommandBuffers(vulkan_renderer->device, &alloc_info_offscreen, &gbuffer->gbuffer_command_buffer) != VK_SUCCESS)
+    if (vkAllocateCommandBuffers(vulkan_renderer->device, &alloc_info_offscreen, gbuffer->gbuffer_command_buffers) != VK_SUCCESS)
       return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
+    gbuffer->gbuffer_command_buffer = gbuffer->gbuffer_command_buffers[0];
   }
 
   return 1;
@@ -229,7 +233,9 @@ int gbuffer_init(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
 }
 
 void gbuffer_delete(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
-  vkDestroySemaphore(vulkan_renderer->device, gbuffer->gbuffer_semaphore, NULL);
+  for (int frame_num = 0; frame_num < MAX_FRAMES_IN_FLIGHT; frame_num++)
+    vkDestroySemaphore(vulkan_renderer->device, gbuffer->gbuffer_semaphores[frame_num], NULL);
+  vkFreeCommandBuffers(vulkan_renderer->device, vulkan_renderer->command_pool, MAX_FRAMES_IN_FLIGHT, gbuffer->gbuffer_command_buffers);
   vkDestroySampler(vulkan_renderer->device, gbuffer->texture_sampler, NULL);
   vkDestroyFramebuffer(vulkan_renderer->device, gbuffer->gbuffer_framebuffer, NULL);
   vkDestroyRenderPass(vulkan_renderer->device, gbuffer->render_pass, NULL);
@@ -237,32 +243,35 @@ void gbuffer_delete(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer
   // Resolve
   vkDestroyImageView(vulkan_renderer->device, gbuffer->color_image_view, NULL);
   vkDestroyImage(vulkan_renderer->device, gbuffer->color_image, NULL);
-  vkFreeMemory(vulkan_renderer->device, gbuffer->color_image_memory, NULL);
+  gpu_allocator_free(vulkan_renderer->gpu_allocator, &gbuffer->color_image_memory);
 
   vkDestroyImageView(vulkan_renderer->device, gbuffer->normal_image_view, NULL);
   vkDestroyImage(vulkan_renderer->device, gbuffer->normal_image, NULL);
-  vkFreeMemory(vulkan_renderer->device, gbuffer->normal_image_memory, NULL);
+  gpu_allocator_free(vulkan_renderer->gpu_allocator, &gbuffer->normal_image_memory);
 
   vkDestroyImageView(vulkan_renderer->device, gbuffer->depth_image_view, NULL);
   vkDestroyImage(vulkan_renderer->device, gbuffer->depth_image, NULL);
-  vkFreeMemory(vulkan_renderer->device, gbuffer->depth_image_memory, NULL);
+  gpu_allocator_free(vulkan_renderer->gpu_allocator, &gbuffer->depth_image_memory);
 
   if (vulkan_renderer->msaa_samples != 1) {
     // Multisample
     vkDestroyImageView(vulkan_renderer->device, gbuffer->multisample_color_image_view, NULL);
     vkDestroyImage(vulkan_renderer->device, gbuffer->multisample_color_image, NULL);
-    vkFreeMemory(vulkan_renderer->device, gbuffer->multisample_color_image_memory, NULL);
+    gpu_allocator_free(vulkan_renderer->gpu_allocator, &gbuffer->multisample_color_image_memory);
 
     vkDestroyImageView(vulkan_renderer->device, gbuffer->multisample_normal_image_view, NULL);
     vkDestroyImage(vulkan_renderer->device, gbuffer->multisample_normal_image, NULL);
-    vkFreeMemory(vulkan_renderer->device, gbuffer->multisample_normal_image_memory, NULL);
+    gpu_allocator_free(vulkan_renderer->gpu_allocator, &gbuffer->multisample_normal_image_memory);
   }
 }
 
+// Note: The frame's fence was waited on in window_prepare_frame so its command buffer is free to record again
 int gbuffer_start(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
+  gbuffer->gbuffer_command_buffer = gbuffer->gbuffer_command_buffers[vulkan_renderer->swap_chain->current_frame];
+
   VkCommandBufferBeginInfo begin_info = {0};
   begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  begin_info.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
   if (vkBeginCommandBuffer(gbuffer->gbuffer_command_buffer, &begin_info) != VK_SUCCESS)
     return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
@@ -336,7 +345,13 @@ int gbuffer_stop(struct GBuffer* gbuffer, struct VulkanState* vulkan_renderer) {
   gbuffer_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
   gbuffer_submit_info.commandBufferCount = 1;
   gbuffer_submit_info.pCommandBuffers = &gbuffer->gbuffer_command_buffer;
-  VkSemaphore signal_semaphores[] = {gbuffer->gbuffer_semaphore};
+  // Note: Uploads recorded this frame go out first, the GPU waits on them at vertex input instead of the CPU waiting on a queue
+  VkSemaphore wait_semaphores[UPLOAD_MANAGER_BATCHES];
+  VkPipelineStageFlags wait_stages[UPLOAD_MANAGER_BATCHES];
+  gbuffer_submit_info.waitSemaphoreCount = upload_manager_flush(vulkan_renderer->upload_manager, vulkan_renderer, wait_semaphores, wait_stages);
+  gbuffer_submit_info.pWaitSemaphores = wait_semaphores;
+  gbuffer_submit_info.pWaitDstStageMask = wait_stages;
+  VkSemaphore signal_semaphores[] = {gbuffer->gbuffer_semaphores[vulkan_renderer->swap_chain->current_frame]};
   gbuffer_submit_info.signalSemaphoreCount = 1;
   gbuffer_submit_info.pSignalSemaphores = signal_semaphores;
 
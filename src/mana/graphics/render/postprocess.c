@@ -52,7 +52,7 @@ int post_process_init(struct PostProcess* post_process, struct GPUAPI* gpu_api)
     return 0;
 
   for (int ping_pong_target = 0; ping_pong_target <= 1; ping_pong_target++) {
-    graphics_utils_create_image(gpu_api->vulkan_state->device, gpu_api->vulkan_state->physical_device, gpu_api->vulkan_state->swap_chain->swap_chain_extent.width, gpu_api->vulkan_state->swap_chain->swap_chain_extent.height, 1, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R16G16B16A16_SFLOAT, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &post_process->color_images[ping_pong_target], &post_process->color_image_memories[ping_pong_target]);
+    graphics_utils_create_image(gpu_api->vulkan_state, gpu_api->vulkan_state->swap_chain->swap_chain_extent.width, gpu_api->vulkan_state->swap_chain->swap_chain_extent.height, 1, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R16G16B16A16_SFLOAT, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &post_process->color_images[ping_pong_target], &post_process->color_image_memories[ping_pong_target]);
     graphics_utils_create_image_view(gpu_api->vulkan_state->device, post_process->color_images[ping_pong_target], VK_FORMAT_R16G16B16A16_SFLOAT, VK_IMAGE_ASPECT_COLOR_BIT, 1, &post_process->color_image_views[ping_pong_target]);
 
     VkImageView attachments_framebuffer = post_process->color_image_views[ping_pong_target];
@@ -71,7 +71,8 @@ int post_process_init(struct PostProcess* post_process, struct GPUAPI* gpu_api)
     VkSemaphoreCreateInfo semaphore_info = {0};
     semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-    vkCreateSemaphore(gpu_api->vulkan_state->device, &semaphore_info, NULL, &post_process->post_process_semaphores[ping_pong_target]);
+    for (int frame_num = 0; frame_num < MAX_FRAMES_IN_FLIGHT; frame_num++)
+      vkCreateSemaphore(gpu_api->vulkan_state->device, &semaphore_info, NULL, &post_process->frame_semaphores[frame_num][ping_pong_target]);
   }
 
   graphics_utils_create_sampler(gpu_api->vulkan_state->device, &post_process->texture_sampler, (struct SamplerSettings){.mip_levels = 0, .filter = VK_FILTER_LINEAR, .address_mode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE});
@@ -81,10 +82,11 @@ int post_process_init(struct PostProcess* post_process, struct GPUAPI* gpu_api)
   alloc_info_post_process.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
   alloc_info_post_process.commandPool = gpu_api->vulkan_state->command_pool;
   alloc_info_post_process.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  alloc_info_post_process.commandBufferCount = 2;
+  alloc_info_post_process.commandBufferCount = MAX_FRAMES_IN_FLIGHT * 2;
 
-  if (vkAllocateCommandBuffers(gpu_api->vulkan_state->device, &alloc_info_post_process, post_process->post_process_command_buffers) != VK_SUCCESS)
+  if (vkAllocateCommandBuffers(gpu_api->vulkan_state->device, &alloc_info_post_process, &post_process->frame_command_buffers[0][0]) != VK_SUCCESS)
     return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
+  post_process_select_frame(post_process, 0);
 
   post_process->blit_post_process = calloc(1, sizeof(struct BlitPostProcess));
 
@@ -98,22 +100,31 @@ int post_process_delete(struct PostProcess* post_process, struct GPUAPI* gpu_api
   vkDestroySampler(gpu_api->vulkan_state->device, post_process->texture_sampler, NULL);
   vkDestroyRenderPass(gpu_api->vulkan_state->device, post_process->render_pass, NULL);
 
+  vkFreeCommandBuffers(gpu_api->vulkan_state->device, gpu_api->vulkan_state->command_pool, MAX_FRAMES_IN_FLIGHT * 2, &post_process->frame_command_buffers[0][0]);
   for (int ping_pong_target = 0; ping_pong_target <= 1; ping_pong_target++) {
-    vkDestroySemaphore(gpu_api->vulkan_state->device, post_process->post_process_semaphores[ping_pong_target], NULL);
+    for (int frame_num = 0; frame_num < MAX_FRAMES_IN_FLIGHT; frame_num++)
+      vkDestroySemaphore(gpu_api->vulkan_state->device, post_process->frame_semaphores[frame_num][ping_pong_target], NULL);
     vkDestroyFramebuffer(gpu_api->vulkan_state->device, post_process->post_process_framebuffers[ping_pong_target], NULL);
 
     vkDestroyImageView(gpu_api->vulkan_state->device, post_process->color_image_views[ping_pong_target], NULL);
     vkDestroyImage(gpu_api->vulkan_state->device, post_process->color_images[ping_pong_target], NULL);
-    vkFreeMemory(gpu_api->vulkan_state->device, post_process->color_image_memories[ping_pong_target], NULL);
+    gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &post_process->color_image_memories[ping_pong_target]);
   }
 
   return 1;
 }
 
+void post_process_select_frame(struct PostProcess* post_process, size_t frame_num) {
+  for (int ping_pong_target = 0; ping_pong_target <= 1; ping_pong_target++) {
+    post_process->post_process_command_buffers[ping_pong_target] = post_process->frame_command_buffers[frame_num][ping_pong_target];
+    post_process->post_process_semaphores[ping_pong_target] = post_process->frame_semaphores[frame_num][ping_pong_target];
+  }
+}
+
 int post_process_start(struct PostProcess* post_process, struct GPUAPI* gpu_api) {
   VkCommandBufferBeginInfo begin_info = {0};
   begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  begin_info.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
   if (vkBeginCommandBuffer(post_process->post_process_command_buffers[post_process->ping_pong], &begin_info) != VK_SUCCESS)
     return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
@@ -225,10 +236,11 @@ void blit_post_process_delete(struct BlitPostProcess* blit_post_process, struct
 int blit_post_process_render(struct BlitPostProcess* blit_post_process, struct GPUAPI* gpu_api) {
   // Custom for intial blitting to post process image
   struct PostProcess* post_process = gpu_api->vulkan_state->post_process;
+  post_process_select_frame(post_process, gpu_api->vulkan_state->swap_chain->current_frame);
 
   VkCommandBufferBeginInfo begin_info = {0};
   begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  begin_info.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
   if (vkBeginCommandBuffer(post_process->post_process_command_buffers[post_process->ping_pong], &begin_info) != VK_SUCCESS)
     return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
@@ -268,7 +280,7 @@ int blit_post_process_render(struct BlitPostProcess* blit_post_process, struct G
   // Send to GPU for offscreen rendering then wait until finished
   VkSubmitInfo post_process_submit_info = {0};
   post_process_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  VkSemaphore wait_semaphore = gpu_api->vulkan_state->gbuffer->gbuffer_semaphore;
+  VkSemaphore wait_semaphore = gpu_api->vulkan_state->gbuffer->gbuffer_semaphores[gpu_api->vulkan_state->swap_chain->current_frame];
   VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
   post_process_submit_info.waitSemaphoreCount = 1;
   post_process_submit_info.pWaitSemaphores = &wait_semaphore;
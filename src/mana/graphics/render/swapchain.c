@@ -181,7 +181,7 @@ int swap_chain_init(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, int wi
   alloc_info_swapchain.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
   alloc_info_swapchain.commandPool = gpu_api->vulkan_state->command_pool;
   alloc_info_swapchain.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-  alloc_info_swapchain.commandBufferCount = (uint32_t)MAX_SWAP_CHAIN_FRAMES;
+  alloc_info_swapchain.commandBufferCount = (uint32_t)MAX_FRAMES_IN_FLIGHT;
 
   if (vkAllocateCommandBuffers(gpu_api->vulkan_state->device, &alloc_info_swapchain, swap_chain->swap_chain_command_buffers) != VK_SUCCESS)
     return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
@@ -221,7 +221,7 @@ void swap_chain_delete(struct SwapChain* swap_chain, struct GPUAPI* gpu_api) {
   }
 
   vkDestroySwapchainKHR(gpu_api->vulkan_state->device, gpu_api->vulkan_state->swap_chain->swap_chain_khr, NULL);
-  vkFreeCommandBuffers(gpu_api->vulkan_state->device, gpu_api->vulkan_state->command_pool, 3, swap_chain->swap_chain_command_buffers);
+  vkFreeCommandBuffers(gpu_api->vulkan_state->device, gpu_api->vulkan_state->command_pool, MAX_FRAMES_IN_FLIGHT, swap_chain->swap_chain_command_buffers);
 
   for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
     vkDestroySemaphore(gpu_api->vulkan_state->device, swap_chain->render_finished_semaphores[i], NULL);
@@ -230,18 +230,19 @@ void swap_chain_delete(struct SwapChain* swap_chain, struct GPUAPI* gpu_api) {
   }
 }
 
-int swap_chain_start(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, int swap_chain_num) {
+int swap_chain_start(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, uint32_t image_index) {
+  VkCommandBuffer command_buffer = swap_chain->swap_chain_command_buffers[swap_chain->current_frame];
   VkCommandBufferBeginInfo begin_info = {0};
   begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-  begin_info.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 
-  if (vkBeginCommandBuffer(swap_chain->swap_chain_command_buffers[swap_chain_num], &begin_info) != VK_SUCCESS)
+  if (vkBeginCommandBuffer(command_buffer, &begin_info) != VK_SUCCESS)
     return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
 
   VkRenderPassBeginInfo render_pass_info = {0};
   render_pass_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
   render_pass_info.renderPass = gpu_api->vulkan_state->swap_chain->render_pass;
-  render_pass_info.framebuffer = gpu_api->vulkan_state->swap_chain->swap_chain_framebuffers[swap_chain_num];
+  render_pass_info.framebuffer = gpu_api->vulkan_state->swap_chain->swap_chain_framebuffers[image_index];
   render_pass_info.renderArea.offset.x = 0;
   render_pass_info.renderArea.offset.y = 0;
   render_pass_info.renderArea.extent = gpu_api->vulkan_state->swap_chain->swap_chain_extent;
@@ -253,15 +254,16 @@ int swap_chain_start(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, int s
   render_pass_info.clearValueCount = 1;
   render_pass_info.pClearValues = &clear_value;
 
-  vkCmdBeginRenderPass(swap_chain->swap_chain_command_buffers[swap_chain_num], &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
+  vkCmdBeginRenderPass(command_buffer, &render_pass_info, VK_SUBPASS_CONTENTS_INLINE);
 
   return VULKAN_RENDERER_SUCCESS;
 }
 
-int swap_chain_stop(struct SwapChain* swap_chain, struct GPUAPI* gpu_api, int swap_chain_num) {
-  vkCmdEndRenderPass(swap_chain->swap_chain_command_buffers[swap_chain_num]);
+int swap_chain_stop(struct SwapChain* swap_chain, struct GPUAPI* gpu_api) {
+  VkCommandBuffer command_buffer = swap_chain->swap_chain_command_buffers[swap_chain->current_frame];
+  vkCmdEndRenderPass(command_buffer);
 
-  if (vkEndCommandBuffer(swap_chain->swap_chain_command_buffers[swap_chain_num]) != VK_SUCCESS)
+  if (vkEndCommandBuffer(command_buffer) != VK_SUCCESS)
     return VULKAN_RENDERER_CREATE_COMMAND_BUFFER_ERROR;
 
   return VULKAN_RENDERER_SUCCESS;
@@ -324,18 +326,19 @@ void blit_swap_chain_delete(struct BlitSwapChain* blit_swap_chain, struct GPUAPI
   free(blit_swap_chain->blit_shader);
 }
 
+// Note: Only the acquired image is drawn to, re-recording every image's buffer each frame would touch ones still in flight
 void blit_swap_chain_render(struct BlitSwapChain* blit_swap_chain, struct GPUAPI* gpu_api) {
-  for (size_t swapchain_num = 0; swapchain_num < MAX_SWAP_CHAIN_FRAMES; swapchain_num++) {
-    swap_chain_start(gpu_api->vulkan_state->swap_chain, gpu_api, swapchain_num);
-
-    vkCmdBindPipeline(gpu_api->vulkan_state->swap_chain->swap_chain_command_buffers[swapchain_num], VK_PIPELINE_BIND_POINT_GRAPHICS, blit_swap_chain->blit_shader->shader->graphics_pipeline);
-    VkBuffer vertex_buffers[] = {blit_swap_chain->fullscreen_triangle->vertex_buffer};
-    VkDeviceSize offsets[] = {0};
-    vkCmdBindVertexBuffers(gpu_api->vulkan_state->swap_chain->swap_chain_command_buffers[swapchain_num], 0, 1, vertex_buffers, offsets);
-    vkCmdBindIndexBuffer(gpu_api->vulkan_state->swap_chain->swap_chain_command_buffers[swapchain_num], blit_swap_chain->fullscreen_triangle->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdBindDescriptorSets(gpu_api->vulkan_state->swap_chain->swap_chain_command_buffers[swapchain_num], VK_PIPELINE_BIND_POINT_GRAPHICS, blit_swap_chain->blit_shader->shader->pipeline_layout, 0, 1, &blit_swap_chain->descriptor_sets[gpu_api->vulkan_state->post_process->ping_pong ^ true], 0, NULL);
-    vkCmdDrawIndexed(gpu_api->vulkan_state->swap_chain->swap_chain_command_buffers[swapchain_num], blit_swap_chain->fullscreen_triangle->mesh->indices->size, 1, 0, 0, 0);
-
-    swap_chain_stop(gpu_api->vulkan_state->swap_chain, gpu_api, swapchain_num);
-  }
+  struct SwapChain* swap_chain = gpu_api->vulkan_state->swap_chain;
+  VkCommandBuffer command_buffer = swap_chain->swap_chain_command_buffers[swap_chain->current_frame];
+  swap_chain_start(swap_chain, gpu_api, swap_chain->image_index);
+
+  vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, blit_swap_chain->blit_shader->shader->graphics_pipeline);
+  VkBuffer vertex_buffers[] = {blit_swap_chain->fullscreen_triangle->vertex_buffer};
+  VkDeviceSize offsets[] = {0};
+  vkCmdBindVertexBuffers(command_buffer, 0, 1, vertex_buffers, offsets);
+  vkCmdBindIndexBuffer(command_buffer, blit_swap_chain->fullscreen_triangle->index_buffer, 0, VK_INDEX_TYPE_UINT32);
+  vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, blit_swap_chain->blit_shader->shader->pipeline_layout, 0, 1, &blit_swap_chain->descriptor_sets[gpu_api->vulkan_state->post_process->ping_pong ^ true], 0, NULL);
+  vkCmdDrawIndexed(command_buffer, blit_swap_chain->fullscreen_triangle->mesh->indices->size, 1, 0, 0, 0);
+
+  swap_chain_stop(swap_chain, gpu_api);
 }
@@ -0,0 +1,63 @@
+#include "mana/graphics/render/uniformring.h"
+
+int uniform_ring_init(struct UniformRing* uniform_ring, struct VulkanState* vulkan_renderer, VkDeviceSize frame_size) {
+  VkPhysicalDeviceProperties physical_device_properties = {0};
+  vkGetPhysicalDeviceProperties(vulkan_renderer->physical_device, &physical_device_properties);
+
+  // Note: Dynamic offsets have to land on this alignment, it's a power of two on every device
+  uniform_ring->alignment = MAX(physical_device_properties.limits.minUniformBufferOffsetAlignment, 16);
+  uniform_ring->frame_size = (frame_size + uniform_ring->alignment - 1) & ~(uniform_ring->alignment - 1);
+  uniform_ring->frame_start = 0;
+  uniform_ring->frame_offset = 0;
+  uniform_ring->peak_frame_offset = 0;
+  uniform_ring->full_reported = false;
+
+  if (graphics_utils_create_buffer(vulkan_renderer, uniform_ring->frame_size * MAX_FRAMES_IN_FLIGHT, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &uniform_ring->uniform_buffer, &uniform_ring->uniform_buffer_memory) != 0)
+    return UNIFORM_RING_CREATE_BUFFER_ERROR;
+
+  // Note: Coherent memory stays mapped for the life of the ring so pushing is only a memcpy
+  void* mapped_memory = gpu_allocator_map(vulkan_renderer->gpu_allocator, &uniform_ring->uniform_buffer_memory);
+  if (mapped_memory == NULL) {
+    fprintf(stderr, "failed to map uniform ring memory!\n");
+    return UNIFORM_RING_MAP_MEMORY_ERROR;
+  }
+  uniform_ring->mapped_memory = (char*)mapped_memory;
+
+  return UNIFORM_RING_SUCCESS;
+}
+
+void uniform_ring_delete(struct UniformRing* uniform_ring, struct VulkanState* vulkan_renderer) {
+  gpu_allocator_unmap(vulkan_renderer->gpu_allocator, &uniform_ring->uniform_buffer_memory);
+  vkDestroyBuffer(vulkan_renderer->device, uniform_ring->uniform_buffer, NULL);
+  gpu_allocator_free(vulkan_renderer->gpu_allocator, &uniform_ring->uniform_buffer_memory);
+}
+
+// Note: Only call once the fence of frame_num has been waited on, the GPU is done with everything pushed the last time this region was used
+void uniform_ring_begin_frame(struct UniformRing* uniform_ring, size_t frame_num) {
+  uniform_ring->peak_frame_offset = MAX(uniform_ring->peak_frame_offset, uniform_ring->frame_offset);
+  uniform_ring->frame_start = uniform_ring->frame_size * frame_num;
+  uniform_ring->frame_offset = 0;
+}
+
+// Note: Returns the dynamic offset to bind the copy with, entities have to push every frame they draw since the last frame's copy belongs to the other region. Returns UNIFORM_RING_FULL without writing anything once the frame's region is used up
+uint32_t uniform_ring_push(struct UniformRing* uniform_ring, const void* data, size_t memory_size) {
+  const VkDeviceSize aligned_size = (memory_size + uniform_ring->alignment - 1) & ~(uniform_ring->alignment - 1);
+  if (uniform_ring->frame_offset + aligned_size > uniform_ring->frame_size) {
+    if (!uniform_ring->full_reported) {
+      fprintf(stderr, "Uniform ring frame region of %llu bytes is full, entities past it are not drawn! Increase UNIFORM_RING_FRAME_SIZE\n", (unsigned long long)uniform_ring->frame_size);
+      uniform_ring->full_reported = true;
+    }
+    return UNIFORM_RING_FULL;
+  }
+
+  const VkDeviceSize offset = uniform_ring->frame_start + uniform_ring->frame_offset;
+  memcpy(uniform_ring->mapped_memory + offset, data, memory_size);
+  uniform_ring->frame_offset += aligned_size;
+
+  return (uint32_t)offset;
+}
+
+// Note: Range is one object, the dynamic offset picks which copy of it gets read
+VkDescriptorBufferInfo uniform_ring_get_descriptor_buffer_info(struct UniformRing* uniform_ring, size_t memory_size) {
+  return graphics_utils_setup_descriptor_buffer_info(memory_size, &uniform_ring->uniform_buffer);
+}
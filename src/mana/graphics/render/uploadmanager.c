@@ -0,0 +1,309 @@
+#include "mana/graphics/render/uploadmanager.h"
+
+#include "mana/graphics/render/vulkanrenderer.h"
+
+static inline int upload_manager_stream(struct UploadManager* upload_manager, enum UploadQueue upload_queue) {
+  return (upload_queue < upload_manager->queue_count) ? upload_queue : UPLOAD_QUEUE_TRANSFER;
+}
+
+int upload_manager_init(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer) {
+  memset(upload_manager, 0, sizeof(struct UploadManager));
+  vector_init(&upload_manager->retired_buffers, sizeof(struct UploadRetiredBuffer));
+
+  const uint32_t queue_families[UPLOAD_QUEUE_COUNT] = {vulkan_renderer->indices.transfer_family, vulkan_renderer->indices.graphics_family};
+  upload_manager->queues[UPLOAD_QUEUE_TRANSFER] = vulkan_renderer->transfer_queue;
+  upload_manager->queues[UPLOAD_QUEUE_GRAPHICS] = vulkan_renderer->graphics_queue;
+  upload_manager->queue_count = (queue_families[UPLOAD_QUEUE_TRANSFER] != queue_families[UPLOAD_QUEUE_GRAPHICS]) ? UPLOAD_QUEUE_COUNT : 1;
+
+  for (int stream_num = 0; stream_num < upload_manager->queue_count; stream_num++) {
+    VkCommandPoolCreateInfo pool_info = {0};
+    pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    pool_info.queueFamilyIndex = queue_families[stream_num];
+    pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+    if (vkCreateCommandPool(vulkan_renderer->device, &pool_info, NULL, &upload_manager->command_pools[stream_num]) != VK_SUCCESS) {
+      fprintf(stderr, "failed to create upload command pool!\n");
+      return UPLOAD_MANAGER_CREATE_COMMAND_POOL_ERROR;
+    }
+  }
+
+  if (graphics_utils_create_buffer(vulkan_renderer, (VkDeviceSize)UPLOAD_MANAGER_SEGMENT_SIZE * UPLOAD_MANAGER_BATCHES, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &upload_manager->staging_buffer, &upload_manager->staging_memory) != 0)
+    return UPLOAD_MANAGER_CREATE_BUFFER_ERROR;
+
+  // Note: Stays mapped like the uniform ring, staging an upload is only a memcpy
+  upload_manager->mapped_memory = (char*)gpu_allocator_map(vulkan_renderer->gpu_allocator, &upload_manager->staging_memory);
+  if (upload_manager->mapped_memory == NULL) {
+    fprintf(stderr, "failed to map upload staging memory!\n");
+    return UPLOAD_MANAGER_MAP_MEMORY_ERROR;
+  }
+
+  VkSemaphoreCreateInfo semaphore_info = {0};
+  semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+  VkFenceCreateInfo fence_info = {0};
+  fence_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+  for (int batch_num = 0; batch_num < UPLOAD_MANAGER_BATCHES; batch_num++) {
+    struct UploadBatch* batch = &upload_manager->batches[batch_num];
+    vector_init(&batch->oversized_staging, sizeof(struct UploadStaging));
+
+    for (int stream_num = 0; stream_num < upload_manager->queue_count; stream_num++) {
+      VkCommandBufferAllocateInfo alloc_info = {0};
+      alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+      alloc_info.commandPool = upload_manager->command_pools[stream_num];
+      alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+      alloc_info.commandBufferCount = 1;
+
+      if (vkAllocateCommandBuffers(vulkan_renderer->device, &alloc_info, &batch->command_buffers[stream_num]) != VK_SUCCESS || vkCreateFence(vulkan_renderer->device, &fence_info, NULL, &batch->fences[stream_num]) != VK_SUCCESS) {
+        fprintf(stderr, "failed to create upload batch!\n");
+        return UPLOAD_MANAGER_CREATE_SYNC_ERROR;
+      }
+    }
+
+    if (vkCreateSemaphore(vulkan_renderer->device, &semaphore_info, NULL, &batch->semaphore) != VK_SUCCESS) {
+      fprintf(stderr, "failed to create upload semaphore!\n");
+      return UPLOAD_MANAGER_CREATE_SYNC_ERROR;
+    }
+  }
+
+  return UPLOAD_MANAGER_SUCCESS;
+}
+
+// Note: Waits for the batch's last submission then frees what it was holding on to, the batch can be recorded into again after
+static void upload_manager_retire_batch(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer, struct UploadBatch* batch) {
+  for (int stream_num = 0; stream_num < upload_manager->queue_count; stream_num++) {
+    if (batch->submitted[stream_num]) {
+      vkWaitForFences(vulkan_renderer->device, 1, &batch->fences[stream_num], VK_TRUE, UINT64_MAX);
+      vkResetFences(vulkan_renderer->device, 1, &batch->fences[stream_num]);
+      batch->submitted[stream_num] = false;
+    }
+  }
+
+  for (int staging_num = 0; staging_num < vector_size(&batch->oversized_staging); staging_num++) {
+    struct UploadStaging* staging = (struct UploadStaging*)vector_get(&batch->oversized_staging, staging_num);
+    vkDestroyBuffer(vulkan_renderer->device, staging->buffer, NULL);
+    gpu_allocator_free(vulkan_renderer->gpu_allocator, &staging->memory);
+  }
+  vector_clear(&batch->oversized_staging);
+
+  // Note: Nothing waited on the last signal so it's still set, a binary semaphore can't be signalled again until it's been waited on
+  if (batch->semaphore_pending) {
+    vkDestroySemaphore(vulkan_renderer->device, batch->semaphore, NULL);
+    VkSemaphoreCreateInfo semaphore_info = {0};
+    semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    vkCreateSemaphore(vulkan_renderer->device, &semaphore_info, NULL, &batch->semaphore);
+    batch->semaphore_pending = false;
+  }
+
+  batch->staging_offset = 0;
+}
+
+static inline void upload_manager_free_retired(struct VulkanState* vulkan_renderer, struct UploadRetiredBuffer* retired) {
+  vkDestroyBuffer(vulkan_renderer->device, retired->buffer, NULL);
+  gpu_allocator_free(vulkan_renderer->gpu_allocator, &retired->memory);
+}
+
+void upload_manager_delete(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer) {
+  upload_manager_wait_idle(upload_manager, vulkan_renderer);
+
+  // Note: The swap chain waited on every frame in flight before this so nothing can still be reading them
+  for (int retired_num = 0; retired_num < vector_size(&upload_manager->retired_buffers); retired_num++)
+    upload_manager_free_retired(vulkan_renderer, (struct UploadRetiredBuffer*)vector_get(&upload_manager->retired_buffers, retired_num));
+  vector_delete(&upload_manager->retired_buffers);
+
+  for (int batch_num = 0; batch_num < UPLOAD_MANAGER_BATCHES; batch_num++) {
+    struct UploadBatch* batch = &upload_manager->batches[batch_num];
+    for (int stream_num = 0; stream_num < upload_manager->queue_count; stream_num++)
+      vkDestroyFence(vulkan_renderer->device, batch->fences[stream_num], NULL);
+    vkDestroySemaphore(vulkan_renderer->device, batch->semaphore, NULL);
+    vector_delete(&batch->oversized_staging);
+  }
+
+  for (int stream_num = 0; stream_num < upload_manager->queue_count; stream_num++)
+    vkDestroyCommandPool(vulkan_renderer->device, upload_manager->command_pools[stream_num], NULL);
+
+  gpu_allocator_unmap(vulkan_renderer->gpu_allocator, &upload_manager->staging_memory);
+  vkDestroyBuffer(vulkan_renderer->device, upload_manager->staging_buffer, NULL);
+  gpu_allocator_free(vulkan_renderer->gpu_allocator, &upload_manager->staging_memory);
+}
+
+// Note: Copies data somewhere the current batch can read it from, flushing first if the batch's segment is full. Only get the command buffer after this since it may have moved on to the next batch
+static void upload_manager_stage(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer, const void* data, VkDeviceSize size, VkBuffer* staging_buffer, VkDeviceSize* staging_offset) {
+  struct UploadBatch* batch = &upload_manager->batches[upload_manager->current_batch];
+
+  if (size > UPLOAD_MANAGER_SEGMENT_SIZE) {
+    struct UploadStaging staging = {0};
+    graphics_utils_create_buffer(vulkan_renderer, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging.buffer, &staging.memory);
+    void* mapped_memory = gpu_allocator_map(vulkan_renderer->gpu_allocator, &staging.memory);
+    memcpy(mapped_memory, data, size);
+    gpu_allocator_unmap(vulkan_renderer->gpu_allocator, &staging.memory);
+    vector_push_back(&batch->oversized_staging, &staging);
+
+    *staging_buffer = staging.buffer;
+    *staging_offset = 0;
+    return;
+  }
+
+  VkDeviceSize offset = (batch->staging_offset + UPLOAD_MANAGER_STAGING_ALIGNMENT - 1) & ~((VkDeviceSize)UPLOAD_MANAGER_STAGING_ALIGNMENT - 1);
+  if (offset + size > UPLOAD_MANAGER_SEGMENT_SIZE) {
+    upload_manager_flush(upload_manager, vulkan_renderer, NULL, NULL);
+    batch = &upload_manager->batches[upload_manager->current_batch];
+    offset = 0;
+  }
+
+  const VkDeviceSize segment_offset = (VkDeviceSize)UPLOAD_MANAGER_SEGMENT_SIZE * upload_manager->current_batch + offset;
+  memcpy(upload_manager->mapped_memory + segment_offset, data, size);
+  batch->staging_offset = offset + size;
+
+  *staging_buffer = upload_manager->staging_buffer;
+  *staging_offset = segment_offset;
+}
+
+static VkCommandBuffer upload_manager_get_command_buffer(struct UploadManager* upload_manager, enum UploadQueue upload_queue) {
+  struct UploadBatch* batch = &upload_manager->batches[upload_manager->current_batch];
+  const int stream_num = upload_manager_stream(upload_manager, upload_queue);
+
+  if (!batch->recording[stream_num]) {
+    VkCommandBufferBeginInfo begin_info = {0};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkResetCommandBuffer(batch->command_buffers[stream_num], 0);
+    vkBeginCommandBuffer(batch->command_buffers[stream_num], &begin_info);
+    batch->recording[stream_num] = true;
+  }
+
+  return batch->command_buffers[stream_num];
+}
+
+void upload_manager_upload_buffer(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer, VkBuffer dst_buffer, VkDeviceSize dst_offset, const void* data, VkDeviceSize size) {
+  if (size == 0)
+    return;
+
+  VkBuffer staging_buffer = VK_NULL_HANDLE;
+  VkDeviceSize staging_offset = 0;
+  upload_manager_stage(upload_manager, vulkan_renderer, data, size, &staging_buffer, &staging_offset);
+
+  VkBufferCopy copy_region = {0};
+  copy_region.srcOffset = staging_offset;
+  copy_region.dstOffset = dst_offset;
+  copy_region.size = size;
+  vkCmdCopyBuffer(upload_manager_get_command_buffer(upload_manager, UPLOAD_QUEUE_TRANSFER), staging_buffer, dst_buffer, 1, &copy_region);
+
+  upload_manager->bytes_uploaded += size;
+}
+
+// Note: Recorded on the graphics queue since layout transitions to shader read and blits need it, the barriers at the end keep later frames from sampling early
+void upload_manager_upload_image(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer, VkImage image, VkFormat format, uint32_t width, uint32_t height, uint32_t mip_levels, const void* pixels, VkDeviceSize size) {
+  VkBuffer staging_buffer = VK_NULL_HANDLE;
+  VkDeviceSize staging_offset = 0;
+  upload_manager_stage(upload_manager, vulkan_renderer, pixels, size, &staging_buffer, &staging_offset);
+
+  VkCommandBuffer command_buffer = upload_manager_get_command_buffer(upload_manager, UPLOAD_QUEUE_GRAPHICS);
+  graphics_utils_record_transition_image_layout(command_buffer, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mip_levels);
+  graphics_utils_record_copy_buffer_to_image(command_buffer, staging_buffer, staging_offset, image, width, height);
+  if (graphics_utils_can_generate_mipmaps(vulkan_renderer->physical_device, format))
+    graphics_utils_record_generate_mipmaps(command_buffer, image, width, height, mip_levels);
+
+  upload_manager->bytes_uploaded += size;
+}
+
+// Note: Submits everything recorded since the last flush as one batch per queue. Returns how many semaphores the next graphics submission has to wait on, wait_semaphores needs room for UPLOAD_MANAGER_BATCHES. Pass NULL to leave them for the next caller
+int upload_manager_flush(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer, VkSemaphore* wait_semaphores, VkPipelineStageFlags* wait_stages) {
+  struct UploadBatch* batch = &upload_manager->batches[upload_manager->current_batch];
+
+  bool batch_recorded = false;
+  for (int stream_num = 0; stream_num < upload_manager->queue_count; stream_num++) {
+    if (!batch->recording[stream_num])
+      continue;
+
+    // Note: Sharing the graphics queue, a barrier makes the copies visible to every submission after this one
+    if (upload_manager->queue_count == 1) {
+      VkMemoryBarrier barrier = {0};
+      barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+      barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+      barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+      vkCmdPipelineBarrier(batch->command_buffers[stream_num], VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 1, &barrier, 0, NULL, 0, NULL);
+    }
+
+    vkEndCommandBuffer(batch->command_buffers[stream_num]);
+    batch->recording[stream_num] = false;
+
+    VkSubmitInfo submit_info = {0};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = &batch->command_buffers[stream_num];
+    if (stream_num == UPLOAD_QUEUE_TRANSFER && upload_manager->queue_count > 1) {
+      submit_info.signalSemaphoreCount = 1;
+      submit_info.pSignalSemaphores = &batch->semaphore;
+      batch->semaphore_pending = true;
+    }
+
+    if (vkQueueSubmit(upload_manager->queues[stream_num], 1, &submit_info, batch->fences[stream_num]) != VK_SUCCESS)
+      fprintf(stderr, "failed to submit upload batch!\n");
+
+    batch->submitted[stream_num] = true;
+    batch_recorded = true;
+  }
+
+  if (batch_recorded) {
+    upload_manager->batches_submitted++;
+    upload_manager->current_batch = (upload_manager->current_batch + 1) % UPLOAD_MANAGER_BATCHES;
+    // Note: Only stalls when every batch is still in flight, normally the oldest finished frames ago
+    upload_manager_retire_batch(upload_manager, vulkan_renderer, &upload_manager->batches[upload_manager->current_batch]);
+  }
+
+  if (wait_semaphores == NULL)
+    return 0;
+
+  int wait_semaphore_count = 0;
+  for (int batch_num = 0; batch_num < UPLOAD_MANAGER_BATCHES; batch_num++) {
+    struct UploadBatch* pending_batch = &upload_manager->batches[batch_num];
+    if (!pending_batch->semaphore_pending)
+      continue;
+
+    wait_semaphores[wait_semaphore_count] = pending_batch->semaphore;
+    wait_stages[wait_semaphore_count] = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+    wait_semaphore_count++;
+    pending_batch->semaphore_pending = false;
+  }
+
+  return wait_semaphore_count;
+}
+
+// Note: For when a buffer that may have a copy recorded or in flight is about to be destroyed
+void upload_manager_wait_idle(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer) {
+  upload_manager_flush(upload_manager, vulkan_renderer, NULL, NULL);
+
+  for (int batch_num = 0; batch_num < UPLOAD_MANAGER_BATCHES; batch_num++)
+    upload_manager_retire_batch(upload_manager, vulkan_renderer, &upload_manager->batches[batch_num]);
+}
+
+// Note: Call once the fence of the frame slot about to be recorded has been waited on, a buffer retired MAX_FRAMES_IN_FLIGHT frames ago was last used by that frame
+void upload_manager_begin_frame(struct UploadManager* upload_manager, struct VulkanState* vulkan_renderer) {
+  upload_manager->frame_count++;
+
+  // Note: Retired in frame order so the expired ones are always at the front
+  int expired = 0;
+  while (expired < vector_size(&upload_manager->retired_buffers)) {
+    struct UploadRetiredBuffer* retired = (struct UploadRetiredBuffer*)vector_get(&upload_manager->retired_buffers, expired);
+    if (retired->frame + MAX_FRAMES_IN_FLIGHT > upload_manager->frame_count)
+      break;
+
+    upload_manager_free_retired(vulkan_renderer, retired);
+    expired++;
+  }
+
+  for (int retired_num = 0; retired_num < expired; retired_num++)
+    vector_remove(&upload_manager->retired_buffers, 0);
+}
+
+// Note: Takes over the buffer and its memory in place of destroying them, copies into it that haven't been submitted yet still land first
+void upload_manager_retire_buffer(struct UploadManager* upload_manager, VkBuffer buffer, struct GPUAllocation* memory) {
+  if (buffer == VK_NULL_HANDLE)
+    return;
+
+  struct UploadRetiredBuffer retired = {.buffer = buffer, .memory = *memory, .frame = upload_manager->frame_count};
+  vector_push_back(&upload_manager->retired_buffers, &retired);
+  memset(memory, 0, sizeof(struct GPUAllocation));
+}
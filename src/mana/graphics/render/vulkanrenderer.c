@@ -9,15 +9,21 @@ int vulkan_renderer_init(struct GPUAPI* gpu_api, int width, int height, int msaa
   gpu_api->vulkan_state->swap_chain = malloc(sizeof(struct SwapChain));
   gpu_api->vulkan_state->gbuffer = malloc(sizeof(struct GBuffer));
   gpu_api->vulkan_state->post_process = malloc(sizeof(struct PostProcess));
+  gpu_api->vulkan_state->uniform_ring = malloc(sizeof(struct UniformRing));
+  gpu_api->vulkan_state->upload_manager = malloc(sizeof(struct UploadManager));
   gpu_api->vulkan_state->msaa_samples = msaa_samples;  //vulkan_renderer_get_max_usable_sample_count(gpu_api);
 
   // TODO: If device cannot render, check for new device that can then recreate core?
   if (!vulkan_renderer_device_can_present(gpu_api, gpu_api->vulkan_state->physical_device))
     return VULKAN_RENDERER_NO_PRESENTABLE_DEVICE_ERROR;
 
+  // Note: Before anything that creates vertex buffers, the fullscreen triangle in post process is the first
+  upload_manager_init(gpu_api->vulkan_state->upload_manager, gpu_api->vulkan_state);
   swap_chain_init(gpu_api->vulkan_state->swap_chain, gpu_api, width, height);
   post_process_init(gpu_api->vulkan_state->post_process, gpu_api);
   gbuffer_init(gpu_api->vulkan_state->gbuffer, gpu_api->vulkan_state);
+  // Note: Kept through swap chain recreation so descriptor sets pointing at it stay valid
+  uniform_ring_init(gpu_api->vulkan_state->uniform_ring, gpu_api->vulkan_state, UNIFORM_RING_FRAME_SIZE);
 
   // Maybe move this
   blit_swap_chain_init(gpu_api->vulkan_state->swap_chain->blit_swap_chain, gpu_api);
@@ -33,6 +39,10 @@ void vulkan_renderer_delete(struct GPUAPI* gpu_api) {
   free(gpu_api->vulkan_state->gbuffer);
   swap_chain_delete(gpu_api->vulkan_state->swap_chain, gpu_api);
   free(gpu_api->vulkan_state->swap_chain);
+  uniform_ring_delete(gpu_api->vulkan_state->uniform_ring, gpu_api->vulkan_state);
+  free(gpu_api->vulkan_state->uniform_ring);
+  upload_manager_delete(gpu_api->vulkan_state->upload_manager, gpu_api->vulkan_state);
+  free(gpu_api->vulkan_state->upload_manager);
   vulkan_renderer_surface_cleanup(gpu_api);
 }
 
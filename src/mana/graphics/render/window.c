@@ -1,5 +1,13 @@
 #include "mana/graphics/render/window.h"
 
+#if WINDOW_BENCHMARK
+static double window_frame_start_time = 0.0;
+static double window_fence_wait_time = 0.0;
+static double window_total_frame_time = 0.0;
+static double window_total_fence_wait_time = 0.0;
+static int window_benchmark_frames = 0;
+#endif
+
 int window_init(struct Window *window, struct Engine *engine, int width, int height, int msaa_samples) {
   window->input_manager = calloc(1, sizeof(struct InputManager));
   input_manager_init(window->input_manager);
@@ -122,10 +130,22 @@ void window_prepare_frame(struct Window *window) {
   glfwPollEvents();
   input_manager_process_input(window->input_manager, window);
 
-  // Wait for swap chain presentation to finish
-  VkResult result = vkWaitForFences(vulkan_core->device, 2, vulkan_core->swap_chain->in_flight_fences, VK_TRUE, UINT64_MAX);
+  // Note: Only the frame that last used this slot has to be done, the other frame in flight keeps the GPU busy while this one is recorded
+#if WINDOW_BENCHMARK
+  window_frame_start_time = engine_get_time();
+  VkResult result = vkWaitForFences(vulkan_core->device, 1, &vulkan_core->swap_chain->in_flight_fences[vulkan_core->swap_chain->current_frame], VK_TRUE, UINT64_MAX);
+  window_fence_wait_time = engine_get_time() - window_frame_start_time;
+#else
+  VkResult result = vkWaitForFences(vulkan_core->device, 1, &vulkan_core->swap_chain->in_flight_fences[vulkan_core->swap_chain->current_frame], VK_TRUE, UINT64_MAX);
+#endif
+  uniform_ring_begin_frame(vulkan_core->uniform_ring, vulkan_core->swap_chain->current_frame);
+  upload_manager_begin_frame(vulkan_core->upload_manager, vulkan_core);
+
+  // Note: Meshes finished on worker threads get their buffers created here, before anything for this frame is recorded
+  job_system_process_completed(&window->engine->job_system, JOB_SYSTEM_FINISHES_PER_FRAME);
 
   result = vkAcquireNextImageKHR(vulkan_core->device, vulkan_core->swap_chain->swap_chain_khr, UINT64_MAX, vulkan_core->swap_chain->image_available_semaphores[vulkan_core->swap_chain->current_frame], VK_NULL_HANDLE, &window->image_index);
+  vulkan_core->swap_chain->image_index = window->image_index;
 
   if (result == VK_ERROR_OUT_OF_DATE_KHR) {
     //recreate_swap_chain(vulkan_core);
@@ -139,14 +159,15 @@ void window_end_frame(struct Window *window) {
   VkSubmitInfo swap_chain_submit_info = {0};
   swap_chain_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-  VkSemaphore wait_semaphores[VULKAN_WAIT_SEMAPHORES] = {vulkan_core->swap_chain->image_available_semaphores[vulkan_core->swap_chain->current_frame], vulkan_core->post_process->post_process_semaphores[vulkan_core->post_process->ping_pong ^ true]};
-  VkPipelineStageFlags wait_stages[VULKAN_WAIT_SEMAPHORES] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-  swap_chain_submit_info.waitSemaphoreCount = VULKAN_WAIT_SEMAPHORES;
+  VkSemaphore wait_semaphores[VULKAN_WAIT_SEMAPHORES + UPLOAD_MANAGER_BATCHES] = {vulkan_core->swap_chain->image_available_semaphores[vulkan_core->swap_chain->current_frame], vulkan_core->post_process->post_process_semaphores[vulkan_core->post_process->ping_pong ^ true]};
+  VkPipelineStageFlags wait_stages[VULKAN_WAIT_SEMAPHORES + UPLOAD_MANAGER_BATCHES] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+  // Note: Anything uploaded after the GBuffer was submitted, like sprites drawn straight to the swap chain
+  swap_chain_submit_info.waitSemaphoreCount = VULKAN_WAIT_SEMAPHORES + upload_manager_flush(vulkan_core->upload_manager, vulkan_core, wait_semaphores + VULKAN_WAIT_SEMAPHORES, wait_stages + VULKAN_WAIT_SEMAPHORES);
   swap_chain_submit_info.pWaitSemaphores = wait_semaphores;
   swap_chain_submit_info.pWaitDstStageMask = wait_stages;
 
   swap_chain_submit_info.commandBufferCount = 1;
-  swap_chain_submit_info.pCommandBuffers = &vulkan_core->swap_chain->swap_chain_command_buffers[window->image_index];
+  swap_chain_submit_info.pCommandBuffers = &vulkan_core->swap_chain->swap_chain_command_buffers[vulkan_core->swap_chain->current_frame];
 
   VkSemaphore signal_semaphores[] = {vulkan_core->swap_chain->render_finished_semaphores[vulkan_core->swap_chain->current_frame]};
   swap_chain_submit_info.signalSemaphoreCount = 1;
@@ -181,6 +202,19 @@ void window_end_frame(struct Window *window) {
     fprintf(stderr, "failed to present swap chain image!\n");
 
   vulkan_core->swap_chain->current_frame = (vulkan_core->swap_chain->current_frame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+#if WINDOW_BENCHMARK
+  window_total_frame_time += engine_get_time() - window_frame_start_time;
+  window_total_fence_wait_time += window_fence_wait_time;
+  if (++window_benchmark_frames == WINDOW_BENCHMARK_FRAMES) {
+    const double average_frame_time = window_total_frame_time / WINDOW_BENCHMARK_FRAMES;
+    const double average_fence_wait_time = window_total_fence_wait_time / WINDOW_BENCHMARK_FRAMES;
+    printf("Frame time: %lf cpu: %lf fence wait: %lf\n", average_frame_time, average_frame_time - average_fence_wait_time, average_fence_wait_time);
+    window_total_frame_time = 0.0;
+    window_total_fence_wait_time = 0.0;
+    window_benchmark_frames = 0;
+  }
+#endif
 }
 
 static void glfw_framebuffer_resize_callback(GLFWwindow *window, int width, int height) {
@@ -114,10 +114,10 @@ int atmospheric_scattering_shader_init(struct AtmosphericScatteringShader* atmos
 
 void atmospheric_scattering_shader_delete(struct AtmosphericScatteringShader* atmospheric_scattering_shader, struct GPUAPI* gpu_api) {
   vkDestroyBuffer(gpu_api->vulkan_state->device, atmospheric_scattering_shader->uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, atmospheric_scattering_shader->uniform_buffer_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &atmospheric_scattering_shader->uniform_buffer_memory);
 
   vkDestroyBuffer(gpu_api->vulkan_state->device, atmospheric_scattering_shader->uniform_buffer_settings, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, atmospheric_scattering_shader->uniform_buffer_settings_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &atmospheric_scattering_shader->uniform_buffer_settings_memory);
 
   fullscreen_triangle_delete(atmospheric_scattering_shader->fullscreen_triangle, gpu_api);
   free(atmospheric_scattering_shader->fullscreen_triangle);
@@ -4,14 +4,14 @@ int dual_contouring_shader_init(struct DualContouringShader* dual_countouring_sh
   VkDescriptorSetLayoutBinding dcubo_layout_binding = {0};
   dcubo_layout_binding.binding = 0;
   dcubo_layout_binding.descriptorCount = 1;
-  dcubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  dcubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   dcubo_layout_binding.pImmutableSamplers = NULL;
   dcubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
   VkDescriptorSetLayoutBinding lighting_layout_binding = {0};
   lighting_layout_binding.binding = 1;
   lighting_layout_binding.descriptorCount = 1;
-  lighting_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  lighting_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   lighting_layout_binding.pImmutableSamplers = NULL;
   lighting_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
@@ -24,18 +24,20 @@ int dual_contouring_shader_init(struct DualContouringShader* dual_countouring_sh
   if (vkCreateDescriptorSetLayout(gpu_api->vulkan_state->device, &layout_info, NULL, &dual_countouring_shader->shader.descriptor_set_layout) != VK_SUCCESS)
     return 0;
 
-  int sprite_descriptors = 1;
+  // Note: One set per streamed terrain chunk, chunks hand theirs back when evicted
+  int dual_contouring_descriptors = DUAL_CONTOURING_MAX_DESCRIPTOR_SETS;
   VkDescriptorPoolSize pool_sizes[2] = {{0}};
-  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-  pool_sizes[0].descriptorCount = sprite_descriptors;  // Max number of uniform descriptors
-  pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-  pool_sizes[1].descriptorCount = sprite_descriptors;  // Max number of image sampler descriptors
+  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+  pool_sizes[0].descriptorCount = dual_contouring_descriptors;  // Max number of uniform descriptors
+  pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+  pool_sizes[1].descriptorCount = dual_contouring_descriptors;  // Max number of image sampler descriptors
 
   VkDescriptorPoolCreateInfo poolInfo = {0};
   poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
   poolInfo.poolSizeCount = 2;  // Number of things being passed to GPU
   poolInfo.pPoolSizes = pool_sizes;
-  poolInfo.maxSets = sprite_descriptors;  // Max number of sets made from this pool
+  poolInfo.maxSets = dual_contouring_descriptors;  // Max number of sets made from this pool
 
   if (vkCreateDescriptorPool(gpu_api->vulkan_state->device, &poolInfo, NULL, &dual_countouring_shader->shader.descriptor_pool) != VK_SUCCESS) {
     fprintf(stderr, "failed to create descriptor pool!\n");
@@ -146,7 +146,7 @@ int grass_shader_init(struct GrassShader* grass_shader, struct GPUAPI* gpu_api)
   VkDescriptorSetLayoutBinding ubo_layout_binding = {0};
   ubo_layout_binding.binding = 0;
   ubo_layout_binding.descriptorCount = 1;
-  ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   ubo_layout_binding.pImmutableSamplers = NULL;
   ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
   //ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
@@ -162,7 +162,7 @@ int grass_shader_init(struct GrassShader* grass_shader, struct GPUAPI* gpu_api)
 
   int sprite_descriptors = 1;
   VkDescriptorPoolSize pool_sizes[1] = {{0}};
-  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[0].descriptorCount = sprite_descriptors;  // Max number of uniform descriptors
 
   VkDescriptorPoolCreateInfo pool_info = {0};
@@ -4,14 +4,14 @@ int manifold_dual_contouring_shader_init(struct ManifoldDualContouringShader* ma
   VkDescriptorSetLayoutBinding dcubo_layout_binding = {0};
   dcubo_layout_binding.binding = 0;
   dcubo_layout_binding.descriptorCount = 1;
-  dcubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  dcubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   dcubo_layout_binding.pImmutableSamplers = NULL;
   dcubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
   VkDescriptorSetLayoutBinding lighting_layout_binding = {0};
   lighting_layout_binding.binding = 1;
   lighting_layout_binding.descriptorCount = 1;
-  lighting_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  lighting_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   lighting_layout_binding.pImmutableSamplers = NULL;
   lighting_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
 
@@ -26,9 +26,9 @@ int manifold_dual_contouring_shader_init(struct ManifoldDualContouringShader* ma
 
   int sprite_descriptors = 1;
   VkDescriptorPoolSize pool_sizes[2] = {{0}};
-  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[0].descriptorCount = sprite_descriptors;  // Max number of uniform descriptors
-  pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[1].descriptorCount = sprite_descriptors;  // Max number of image sampler descriptors
 
   VkDescriptorPoolCreateInfo poolInfo = {0};
@@ -45,10 +45,19 @@ int manifold_dual_contouring_shader_init(struct ManifoldDualContouringShader* ma
   VkPipelineVertexInputStateCreateInfo vertex_input_info = {0};
   vertex_input_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
+#if MESH_PACKED_VERTICES
+  VkVertexInputBindingDescription binding_description = mesh_manifold_dual_contouring_packed_get_binding_description();
+  VkVertexInputAttributeDescription attribute_descriptions[MANIFOLD_DUAL_CONTOURING_VERTEX_ATTRIBUTES];
+  memset(attribute_descriptions, 0, sizeof(attribute_descriptions));
+  mesh_manifold_dual_contouring_packed_get_attribute_descriptions(attribute_descriptions);
+  char* vertex_shader = "./assets/shaders/spirv/manifolddualcontouringpacked.vert.spv";
+#else
   VkVertexInputBindingDescription binding_description = mesh_manifold_dual_contouring_get_binding_description();
   VkVertexInputAttributeDescription attribute_descriptions[MANIFOLD_DUAL_CONTOURING_VERTEX_ATTRIBUTES];
   memset(attribute_descriptions, 0, sizeof(attribute_descriptions));
   mesh_manifold_dual_contouring_get_attribute_descriptions(attribute_descriptions);
+  char* vertex_shader = "./assets/shaders/spirv/manifolddualcontouring.vert.spv";
+#endif
 
   vertex_input_info.vertexBindingDescriptionCount = 1;
   vertex_input_info.vertexAttributeDescriptionCount = MANIFOLD_DUAL_CONTOURING_VERTEX_ATTRIBUTES;
@@ -80,7 +89,7 @@ int manifold_dual_contouring_shader_init(struct ManifoldDualContouringShader* ma
   color_blending.blendConstants[2] = 0.0f;
   color_blending.blendConstants[3] = 0.0f;
 
-  shader_init(&manifold_dual_countouring_shader->shader, gpu_api->vulkan_state, "./assets/shaders/spirv/manifolddualcontouring.vert.spv", "./assets/shaders/spirv/manifolddualcontouring.frag.spv", NULL, vertex_input_info, gpu_api->vulkan_state->gbuffer->render_pass, color_blending, VK_FRONT_FACE_CLOCKWISE, VK_TRUE, gpu_api->vulkan_state->msaa_samples, true, VK_CULL_MODE_BACK_BIT);
+  shader_init(&manifold_dual_countouring_shader->shader, gpu_api->vulkan_state, vertex_shader, "./assets/shaders/spirv/manifolddualcontouring.frag.spv", NULL, vertex_input_info, gpu_api->vulkan_state->gbuffer->render_pass, color_blending, VK_FRONT_FACE_CLOCKWISE, VK_TRUE, gpu_api->vulkan_state->msaa_samples, true, VK_CULL_MODE_BACK_BIT);
 
   return 1;
 }
@@ -4,7 +4,7 @@ int model_shader_init(struct ModelShader* model_shader, struct GPUAPI* gpu_api)
   VkDescriptorSetLayoutBinding ubo_layout_binding = {0};
   ubo_layout_binding.binding = 0;
   ubo_layout_binding.descriptorCount = 1;
-  ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   ubo_layout_binding.pImmutableSamplers = NULL;
   //ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
   ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
@@ -12,7 +12,7 @@ int model_shader_init(struct ModelShader* model_shader, struct GPUAPI* gpu_api)
   VkDescriptorSetLayoutBinding ubo_layout_binding2 = {0};
   ubo_layout_binding2.binding = 1;
   ubo_layout_binding2.descriptorCount = 1;
-  ubo_layout_binding2.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  ubo_layout_binding2.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   ubo_layout_binding2.pImmutableSamplers = NULL;
   //ubo_layout_binding2.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
   ubo_layout_binding2.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
@@ -55,7 +55,7 @@ int model_shader_init(struct ModelShader* model_shader, struct GPUAPI* gpu_api)
   VkDescriptorSetLayoutBinding ubo_layout_binding3 = {0};
   ubo_layout_binding3.binding = 7;
   ubo_layout_binding3.descriptorCount = 1;
-  ubo_layout_binding3.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  ubo_layout_binding3.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   ubo_layout_binding3.pImmutableSamplers = NULL;
   //ubo_layout_binding3.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
   ubo_layout_binding3.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
@@ -71,9 +71,9 @@ int model_shader_init(struct ModelShader* model_shader, struct GPUAPI* gpu_api)
 
   int model_descriptors = 1024;
   VkDescriptorPoolSize pool_sizes[8] = {{0}};
-  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[0].descriptorCount = model_descriptors;  // Max number of uniform descriptors
-  pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[1].descriptorCount = model_descriptors;  // Max number of uniform descriptors
   pool_sizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
   pool_sizes[2].descriptorCount = model_descriptors;  // Max number of image sampler descriptors
@@ -85,7 +85,7 @@ int model_shader_init(struct ModelShader* model_shader, struct GPUAPI* gpu_api)
   pool_sizes[5].descriptorCount = model_descriptors;  // Max number of image sampler descriptors
   pool_sizes[6].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
   pool_sizes[6].descriptorCount = model_descriptors;  // Max number of image sampler descriptors
-  pool_sizes[7].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[7].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[7].descriptorCount = model_descriptors;  // Max number of uniform descriptors
 
   VkDescriptorPoolCreateInfo pool_info = {0};
@@ -102,10 +102,19 @@ int model_shader_init(struct ModelShader* model_shader, struct GPUAPI* gpu_api)
   VkPipelineVertexInputStateCreateInfo vertex_input_info = {0};
   vertex_input_info.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 
+#if MESH_PACKED_VERTICES
+  VkVertexInputBindingDescription binding_description = mesh_model_packed_get_binding_description();
+  VkVertexInputAttributeDescription attribute_descriptions[MODEL_SHADER_VERTEX_ATTRIBUTES];
+  memset(attribute_descriptions, 0, sizeof(attribute_descriptions));
+  mesh_model_packed_get_attribute_descriptions(attribute_descriptions);
+  char* vertex_shader = "./assets/shaders/spirv/modelpacked.vert.spv";
+#else
   VkVertexInputBindingDescription binding_description = mesh_model_get_binding_description();
   VkVertexInputAttributeDescription attribute_descriptions[MODEL_SHADER_VERTEX_ATTRIBUTES];
   memset(attribute_descriptions, 0, sizeof(attribute_descriptions));
   mesh_model_get_attribute_descriptions(attribute_descriptions);
+  char* vertex_shader = "./assets/shaders/spirv/model.vert.spv";
+#endif
 
   vertex_input_info.vertexBindingDescriptionCount = 1;
   vertex_input_info.vertexAttributeDescriptionCount = MODEL_SHADER_VERTEX_ATTRIBUTES;
@@ -137,7 +146,7 @@ int model_shader_init(struct ModelShader* model_shader, struct GPUAPI* gpu_api)
   color_blending.blendConstants[2] = 0.0f;
   color_blending.blendConstants[3] = 0.0f;
 
-  shader_init(&model_shader->shader, gpu_api->vulkan_state, "./assets/shaders/spirv/model.vert.spv", "./assets/shaders/spirv/model.frag.spv", NULL, vertex_input_info, gpu_api->vulkan_state->gbuffer->render_pass, color_blending, VK_FRONT_FACE_COUNTER_CLOCKWISE, VK_TRUE, gpu_api->vulkan_state->msaa_samples, true, VK_CULL_MODE_BACK_BIT);
+  shader_init(&model_shader->shader, gpu_api->vulkan_state, vertex_shader, "./assets/shaders/spirv/model.frag.spv", NULL, vertex_input_info, gpu_api->vulkan_state->gbuffer->render_pass, color_blending, VK_FRONT_FACE_COUNTER_CLOCKWISE, VK_TRUE, gpu_api->vulkan_state->msaa_samples, true, VK_CULL_MODE_BACK_BIT);
 
   return 1;
 }
@@ -4,7 +4,7 @@ int model_static_shader_init(struct ModelStaticShader* model_static_shader, stru
   VkDescriptorSetLayoutBinding ubo_layout_binding = {0};
   ubo_layout_binding.binding = 0;
   ubo_layout_binding.descriptorCount = 1;
-  ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   ubo_layout_binding.pImmutableSamplers = NULL;
   //ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
   ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
@@ -12,7 +12,7 @@ int model_static_shader_init(struct ModelStaticShader* model_static_shader, stru
   VkDescriptorSetLayoutBinding ubo_layout_binding2 = {0};
   ubo_layout_binding2.binding = 1;
   ubo_layout_binding2.descriptorCount = 1;
-  ubo_layout_binding2.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  ubo_layout_binding2.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   ubo_layout_binding2.pImmutableSamplers = NULL;
   //ubo_layout_binding2.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
   ubo_layout_binding2.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
@@ -63,9 +63,9 @@ int model_static_shader_init(struct ModelStaticShader* model_static_shader, stru
 
   int model_descriptors = 1024;
   VkDescriptorPoolSize pool_sizes[7] = {{0}};
-  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[0].descriptorCount = model_descriptors;  // Max number of uniform descriptors
-  pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[1].descriptorCount = model_descriptors;  // Max number of uniform descriptors
   pool_sizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
   pool_sizes[2].descriptorCount = model_descriptors;  // Max number of image sampler descriptors
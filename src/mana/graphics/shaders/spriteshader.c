@@ -4,7 +4,7 @@ int sprite_shader_init(struct SpriteShader* sprite_shader, struct GPUAPI* gpu_ap
   VkDescriptorSetLayoutBinding ubo_layout_binding = {0};
   ubo_layout_binding.binding = 0;
   ubo_layout_binding.descriptorCount = 1;
-  ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  ubo_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   ubo_layout_binding.pImmutableSamplers = NULL;
   ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
   //ubo_layout_binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
@@ -27,7 +27,7 @@ int sprite_shader_init(struct SpriteShader* sprite_shader, struct GPUAPI* gpu_ap
 
   int sprite_descriptors = 2048;
   VkDescriptorPoolSize pool_sizes[2] = {{0}};
-  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+  pool_sizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
   pool_sizes[0].descriptorCount = sprite_descriptors;  // Max number of uniform descriptors
   pool_sizes[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
   pool_sizes[1].descriptorCount = sprite_descriptors;  // Max number of image sampler descriptors
@@ -10,7 +10,11 @@ struct Mesh* geometry_loader_extract_model_data(struct XmlNode* geometry_node, s
   geometry_loader_remove_unused_vertices(model_data);
 
   struct Mesh* model_mesh = malloc(sizeof(struct Mesh));
+#if MESH_PACKED_VERTICES
+  animated ? mesh_model_packed_init(model_mesh) : mesh_model_static_init(model_mesh);
+#else
   animated ? mesh_model_init(model_mesh) : mesh_model_static_init(model_mesh);
+#endif
 
   geometry_loader_convert_data_to_arrays(model_data, model_mesh, animated);
 
@@ -234,7 +238,11 @@ float geometry_loader_convert_data_to_arrays(struct ModelData* model_data, struc
       ivec3 joint_ids = *(ivec3*)model_weights->joint_ids->items;
       vec3 joint_weights = *(vec3*)model_weights->weights->items;
 
+#if MESH_PACKED_VERTICES
+      mesh_model_packed_assign_vertex(model_mesh->vertices, model_position.x, model_position.y, model_position.z, model_normal.data[0], model_normal.data[1], model_normal.data[2], model_tex_coord.u, model_tex_coord.v, model_color.r, model_color.g, model_color.b, joint_ids.id0, joint_ids.id1, joint_ids.id2, joint_weights.data[0], joint_weights.data[1], joint_weights.data[2]);
+#else
       mesh_model_assign_vertex(model_mesh->vertices, model_position.x, model_position.y, model_position.z, model_normal.data[0], model_normal.data[1], model_normal.data[2], model_tex_coord.u, model_tex_coord.v, model_color.r, model_color.g, model_color.b, joint_ids.id0, joint_ids.id1, joint_ids.id2, joint_weights.data[0], joint_weights.data[1], joint_weights.data[2]);
+#endif
     } else
       mesh_model_static_assign_vertex(model_mesh->vertices, model_position.x, model_position.y, model_position.z, model_normal.data[0], model_normal.data[1], model_normal.data[2], model_tex_coord.u, model_tex_coord.v, model_color.r, model_color.g, model_color.b);
   }
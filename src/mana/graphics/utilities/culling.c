@@ -0,0 +1,180 @@
+#include "mana/graphics/utilities/culling.h"
+
+// Note: Gribb and Hartmann, each plane is a sum or difference of rows of projection * view so the planes come out in world space
+void frustum_init(struct Frustum* frustum, mat4 projection, mat4 view) {
+  const mat4 view_projection = mat4_mul(projection, view);
+  float rows[4][4];
+  for (int row = 0; row < 4; row++)
+    for (int column = 0; column < 4; column++)
+      rows[row][column] = view_projection.vecs[column].data[row];
+
+  // Note: Clip space depth is 0 to w, with reverse Z and an infinite far plane one of the depth planes ends up all zero but w so it always passes
+  const float planes[CULLING_FRUSTUM_PLANES][4] = {
+      {rows[3][0] + rows[0][0], rows[3][1] + rows[0][1], rows[3][2] + rows[0][2], rows[3][3] + rows[0][3]},
+      {rows[3][0] - rows[0][0], rows[3][1] - rows[0][1], rows[3][2] - rows[0][2], rows[3][3] - rows[0][3]},
+      {rows[3][0] + rows[1][0], rows[3][1] + rows[1][1], rows[3][2] + rows[1][2], rows[3][3] + rows[1][3]},
+      {rows[3][0] - rows[1][0], rows[3][1] - rows[1][1], rows[3][2] - rows[1][2], rows[3][3] - rows[1][3]},
+      {rows[2][0], rows[2][1], rows[2][2], rows[2][3]},
+      {rows[3][0] - rows[2][0], rows[3][1] - rows[2][1], rows[3][2] - rows[2][2], rows[3][3] - rows[2][3]},
+      {0.0f, 0.0f, 0.0f, 1.0f},
+      {0.0f, 0.0f, 0.0f, 1.0f}};
+
+  for (int plane_num = 0; plane_num < CULLING_FRUSTUM_PLANES; plane_num++) {
+    frustum->plane_x[plane_num] = planes[plane_num][0];
+    frustum->plane_y[plane_num] = planes[plane_num][1];
+    frustum->plane_z[plane_num] = planes[plane_num][2];
+    frustum->plane_w[plane_num] = planes[plane_num][3];
+  }
+
+  // Note: View is a rotation and translation so the camera sits at -transpose(rotation) * translation
+  for (int axis = 0; axis < 3; axis++)
+    frustum->camera_position.data[axis] = -((view.vecs[axis].data[0] * view.vecs[3].data[0]) + (view.vecs[axis].data[1] * view.vecs[3].data[1]) + (view.vecs[axis].data[2] * view.vecs[3].data[2]));
+}
+
+// Note: Conservative, a box off a corner of the frustum can straddle two planes without touching the inside and still pass. Returns false only when the box is fully outside one plane
+bool frustum_test_box(struct Frustum* frustum, vec3 min, vec3 max) {
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  const __m256 center_x = _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(min.x), _mm256_set1_ps(max.x)), half);
+  const __m256 center_y = _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(min.y), _mm256_set1_ps(max.y)), half);
+  const __m256 center_z = _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(min.z), _mm256_set1_ps(max.z)), half);
+  const __m256 extent_x = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(max.x), _mm256_set1_ps(min.x)), half);
+  const __m256 extent_y = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(max.y), _mm256_set1_ps(min.y)), half);
+  const __m256 extent_z = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(max.z), _mm256_set1_ps(min.z)), half);
+
+  const __m256 plane_x = _mm256_load_ps(frustum->plane_x);
+  const __m256 plane_y = _mm256_load_ps(frustum->plane_y);
+  const __m256 plane_z = _mm256_load_ps(frustum->plane_z);
+  const __m256 plane_w = _mm256_load_ps(frustum->plane_w);
+
+  // Note: Distance of the box's most positive corner along each plane normal, negative means every corner is outside
+  const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(plane_x, center_x), _mm256_mul_ps(plane_y, center_y)), _mm256_add_ps(_mm256_mul_ps(plane_z, center_z), plane_w));
+  const __m256 radius = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(sign_mask, plane_x), extent_x), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, plane_y), extent_y)), _mm256_mul_ps(_mm256_andnot_ps(sign_mask, plane_z), extent_z));
+  const __m256 outside = _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_LT_OQ);
+
+  return _mm256_movemask_ps(outside) == 0;
+}
+
+static inline uint32_t culling_get_index(struct Vector* indices, int index_num) {
+  if (indices->memory_size == sizeof(uint16_t))
+    return ((uint16_t*)indices->items)[index_num];
+
+  return ((uint32_t*)indices->items)[index_num];
+}
+
+static inline vec3 culling_get_vertex_vec3(struct Vector* vertices, uint32_t vertex_num, size_t offset) {
+  const float* value = (const float*)((const char*)vertices->items + (vertex_num * vertices->memory_size) + offset);
+  return (vec3){.x = value[0], .y = value[1], .z = value[2]};
+}
+
+// Note: Position is the first member of every terrain vertex, normal_offset points at the vertex normal which only decides which way each face normal points so winding doesn't matter
+void culling_bounds_from_mesh(struct CullingBounds* bounds, struct Mesh* mesh, size_t normal_offset, int first_index, int index_count) {
+  memset(bounds, 0, sizeof(struct CullingBounds));
+  const int triangle_count = index_count / 3;
+  if (triangle_count == 0)
+    return;
+
+  bounds->min = (vec3){.x = INFINITY, .y = INFINITY, .z = INFINITY};
+  bounds->max = (vec3){.x = -INFINITY, .y = -INFINITY, .z = -INFINITY};
+  vec3* face_normals = malloc(sizeof(vec3) * triangle_count);
+  bool* face_valid = calloc(triangle_count, sizeof(bool));
+  vec3 normal_sum = VEC3_ZERO;
+
+  for (int triangle_num = 0; triangle_num < triangle_count; triangle_num++) {
+    vec3 positions[3];
+    vec3 vertex_normal_sum = VEC3_ZERO;
+    for (int corner = 0; corner < 3; corner++) {
+      const uint32_t vertex_num = culling_get_index(mesh->indices, first_index + (triangle_num * 3) + corner);
+      positions[corner] = culling_get_vertex_vec3(mesh->vertices, vertex_num, 0);
+      vertex_normal_sum = vec3_add(vertex_normal_sum, culling_get_vertex_vec3(mesh->vertices, vertex_num, normal_offset));
+      for (int axis = 0; axis < 3; axis++) {
+        bounds->min.data[axis] = MIN(bounds->min.data[axis], positions[corner].data[axis]);
+        bounds->max.data[axis] = MAX(bounds->max.data[axis], positions[corner].data[axis]);
+      }
+    }
+
+    vec3 face_normal = vec3_cross_product(vec3_sub(positions[1], positions[0]), vec3_sub(positions[2], positions[0]));
+    const float face_length = sqrtf(vec3_dot(face_normal, face_normal));
+    if (face_length <= FLT_EPSILON)
+      continue;
+
+    face_normal = vec3_scale(face_normal, (vec3_dot(face_normal, vertex_normal_sum) < 0.0f ? -1.0f : 1.0f) / face_length);
+    face_normals[triangle_num] = face_normal;
+    face_valid[triangle_num] = true;
+    normal_sum = vec3_add(normal_sum, face_normal);
+  }
+
+  bounds->center = vec3_scale(vec3_add(bounds->min, bounds->max), 0.5f);
+  const vec3 diagonal = vec3_sub(bounds->max, bounds->min);
+  bounds->radius = 0.5f * sqrtf(vec3_dot(diagonal, diagonal));
+
+  const float normal_sum_length = sqrtf(vec3_dot(normal_sum, normal_sum));
+  if (normal_sum_length > FLT_EPSILON) {
+    bounds->cone_axis = vec3_scale(normal_sum, 1.0f / normal_sum_length);
+    float min_dot = 1.0f;
+    for (int triangle_num = 0; triangle_num < triangle_count; triangle_num++)
+      if (face_valid[triangle_num])
+        min_dot = MIN(min_dot, vec3_dot(face_normals[triangle_num], bounds->cone_axis));
+
+    bounds->cone_valid = min_dot > cosf(CULLING_MAX_CONE_ANGLE);
+    bounds->cone_cutoff = sqrtf(MAX(0.0f, 1.0f - (min_dot * min_dot)));
+  }
+
+  free(face_normals);
+  free(face_valid);
+}
+
+// Note: Box is refit around the transformed one. The cone axis is carried by the model as is, which only holds for uniform scale like every terrain model uses
+struct CullingBounds culling_bounds_transform(struct CullingBounds* bounds, mat4 model) {
+  struct CullingBounds transformed = *bounds;
+  const vec3 center = bounds->center;
+  const vec3 extent = vec3_scale(vec3_sub(bounds->max, bounds->min), 0.5f);
+  float max_scale = 0.0f;
+  for (int row = 0; row < 3; row++) {
+    transformed.center.data[row] = (model.vecs[0].data[row] * center.x) + (model.vecs[1].data[row] * center.y) + (model.vecs[2].data[row] * center.z) + model.vecs[3].data[row];
+    const float world_extent = (fabsf(model.vecs[0].data[row]) * extent.x) + (fabsf(model.vecs[1].data[row]) * extent.y) + (fabsf(model.vecs[2].data[row]) * extent.z);
+    transformed.min.data[row] = transformed.center.data[row] - world_extent;
+    transformed.max.data[row] = transformed.center.data[row] + world_extent;
+    transformed.cone_axis.data[row] = (model.vecs[0].data[row] * bounds->cone_axis.x) + (model.vecs[1].data[row] * bounds->cone_axis.y) + (model.vecs[2].data[row] * bounds->cone_axis.z);
+
+    const vec3 column = (vec3){.x = model.vecs[row].data[0], .y = model.vecs[row].data[1], .z = model.vecs[row].data[2]};
+    max_scale = MAX(max_scale, sqrtf(vec3_dot(column, column)));
+  }
+
+  transformed.radius = bounds->radius * max_scale;
+  const float axis_length = sqrtf(vec3_dot(transformed.cone_axis, transformed.cone_axis));
+  if (axis_length > FLT_EPSILON)
+    transformed.cone_axis = vec3_scale(transformed.cone_axis, 1.0f / axis_length);
+  else
+    transformed.cone_valid = false;
+
+  return transformed;
+}
+
+// Note: Returns false when the camera is behind the plane of every face in the cluster, the bounding sphere covers the faces being spread out from its center
+bool culling_test_cone(struct CullingBounds* bounds, vec3 camera_position) {
+  if (!bounds->cone_valid)
+    return true;
+
+  const vec3 to_center = vec3_sub(bounds->center, camera_position);
+  const float distance = sqrtf(vec3_dot(to_center, to_center));
+  return vec3_dot(to_center, bounds->cone_axis) < (bounds->cone_cutoff * distance) + bounds->radius;
+}
+
+// Note: Bounds are in mesh space and model moves them into the world, returns whether the cluster should be drawn and counts the result
+bool culling_test_bounds(struct Frustum* frustum, struct CullingBounds* bounds, mat4 model, struct CullingStats* stats) {
+  struct CullingBounds world_bounds = culling_bounds_transform(bounds, model);
+  stats->tested++;
+  if (!frustum_test_box(frustum, world_bounds.min, world_bounds.max)) {
+    stats->frustum_culled++;
+    return false;
+  }
+
+  if (!culling_test_cone(&world_bounds, frustum->camera_position)) {
+    stats->cone_culled++;
+    return false;
+  }
+
+  stats->drawn++;
+  return true;
+}
@@ -10,10 +10,10 @@ void fullscreen_quad_init(struct FullscreenQuad* fullscreen_quad, struct VulkanS
 
 void fullscreen_quad_delete(struct FullscreenQuad* fullscreen_quad, struct VulkanState* vulkan_renderer) {
   vkDestroyBuffer(vulkan_renderer->device, fullscreen_quad->index_buffer, NULL);
-  vkFreeMemory(vulkan_renderer->device, fullscreen_quad->index_buffer_memory, NULL);
+  gpu_allocator_free(vulkan_renderer->gpu_allocator, &fullscreen_quad->index_buffer_memory);
 
   vkDestroyBuffer(vulkan_renderer->device, fullscreen_quad->vertex_buffer, NULL);
-  vkFreeMemory(vulkan_renderer->device, fullscreen_quad->vertex_buffer_memory, NULL);
+  gpu_allocator_free(vulkan_renderer->gpu_allocator, &fullscreen_quad->vertex_buffer_memory);
 
   mesh_delete(fullscreen_quad->mesh);
   free(fullscreen_quad->mesh);
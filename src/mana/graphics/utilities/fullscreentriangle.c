@@ -10,10 +10,10 @@ void fullscreen_triangle_init(struct FullscreenTriangle* fullscreen_triangle, st
 
 void fullscreen_triangle_delete(struct FullscreenTriangle* fullscreen_triangle, struct GPUAPI* gpu_api) {
   vkDestroyBuffer(gpu_api->vulkan_state->device, fullscreen_triangle->index_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, fullscreen_triangle->index_buffer_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &fullscreen_triangle->index_buffer_memory);
 
   vkDestroyBuffer(gpu_api->vulkan_state->device, fullscreen_triangle->vertex_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, fullscreen_triangle->vertex_buffer_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &fullscreen_triangle->vertex_buffer_memory);
 
   mesh_delete(fullscreen_triangle->mesh);
   free(fullscreen_triangle->mesh);
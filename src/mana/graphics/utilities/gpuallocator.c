@@ -0,0 +1,312 @@
+#include "mana/graphics/utilities/gpuallocator.h"
+
+static inline VkDeviceSize gpu_allocator_order_size(int order) {
+  return (VkDeviceSize)1 << (GPU_ALLOCATOR_MIN_ORDER + order);
+}
+
+static inline VkDeviceSize gpu_allocator_align(VkDeviceSize offset, VkDeviceSize alignment) {
+  return (alignment > 1) ? ((offset + alignment - 1) / alignment) * alignment : offset;
+}
+
+static int gpu_allocator_find_memory_type(struct GPUAllocator* gpu_allocator, uint32_t type_filter, VkMemoryPropertyFlags properties) {
+  for (uint32_t memory_type = 0; memory_type < gpu_allocator->memory_properties.memoryTypeCount; memory_type++)
+    if ((type_filter & (1 << memory_type)) && (gpu_allocator->memory_properties.memoryTypes[memory_type].propertyFlags & properties) == properties)
+      return memory_type;
+
+  return -1;
+}
+
+static inline bool gpu_allocator_host_visible(struct GPUAllocator* gpu_allocator, uint32_t memory_type) {
+  return (gpu_allocator->memory_properties.memoryTypes[memory_type].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+}
+
+int gpu_allocator_init(struct GPUAllocator* gpu_allocator, VkDevice device, VkPhysicalDevice physical_device) {
+  gpu_allocator->device = device;
+  vkGetPhysicalDeviceMemoryProperties(physical_device, &gpu_allocator->memory_properties);
+  array_list_init(&gpu_allocator->blocks);
+  gpu_allocator->dedicated_bytes = 0;
+  gpu_allocator->dedicated_count = 0;
+  gpu_allocator->bytes_used = 0;
+  gpu_allocator->allocation_count = 0;
+
+  return GPU_ALLOCATOR_SUCCESS;
+}
+
+static void gpu_allocator_block_delete(struct GPUAllocator* gpu_allocator, struct GPUMemoryBlock* block) {
+  if (block->mapped_memory != NULL)
+    vkUnmapMemory(gpu_allocator->device, block->memory);
+  vkFreeMemory(gpu_allocator->device, block->memory, NULL);
+
+  for (int order = 0; order < GPU_ALLOCATOR_ORDERS; order++)
+    vector_delete(&block->free_lists[order]);
+  free(block->allocated_orders);
+  free(block);
+}
+
+// Note: Anything still allocated at this point leaked, the blocks go regardless since the device is about to go too
+void gpu_allocator_delete(struct GPUAllocator* gpu_allocator) {
+  if (gpu_allocator->allocation_count > 0)
+    fprintf(stderr, "GPU allocator deleted with %d allocations still live!\n", gpu_allocator->allocation_count);
+
+  for (int block_num = 0; block_num < array_list_size(&gpu_allocator->blocks); block_num++)
+    gpu_allocator_block_delete(gpu_allocator, (struct GPUMemoryBlock*)array_list_get(&gpu_allocator->blocks, block_num));
+  array_list_delete(&gpu_allocator->blocks);
+}
+
+static struct GPUMemoryBlock* gpu_allocator_block_create(struct GPUAllocator* gpu_allocator, uint32_t memory_type, enum GPUAllocationStrategy strategy, bool optimal_image) {
+  VkMemoryAllocateInfo alloc_info = {0};
+  alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+  alloc_info.allocationSize = GPU_ALLOCATOR_BLOCK_SIZE;
+  alloc_info.memoryTypeIndex = memory_type;
+
+  VkDeviceMemory memory = VK_NULL_HANDLE;
+  if (vkAllocateMemory(gpu_allocator->device, &alloc_info, NULL, &memory) != VK_SUCCESS) {
+    fprintf(stderr, "failed to allocate gpu memory block!\n");
+    return NULL;
+  }
+
+  struct GPUMemoryBlock* block = calloc(1, sizeof(struct GPUMemoryBlock));
+  block->memory = memory;
+  block->memory_type = memory_type;
+  block->strategy = strategy;
+  block->optimal_image = optimal_image;
+
+  // Note: Host visible blocks stay mapped, a VkDeviceMemory can only be mapped once at a time and every allocation in the block shares it
+  if (gpu_allocator_host_visible(gpu_allocator, memory_type)) {
+    void* mapped_memory = NULL;
+    if (vkMapMemory(gpu_allocator->device, memory, 0, VK_WHOLE_SIZE, 0, &mapped_memory) != VK_SUCCESS)
+      fprintf(stderr, "failed to map gpu memory block!\n");
+    block->mapped_memory = (char*)mapped_memory;
+  }
+
+  for (int order = 0; order < GPU_ALLOCATOR_ORDERS; order++)
+    vector_init(&block->free_lists[order], sizeof(VkDeviceSize));
+
+  if (strategy == GPU_ALLOCATION_BUDDY) {
+    block->allocated_orders = calloc(GPU_ALLOCATOR_BLOCK_SIZE >> GPU_ALLOCATOR_MIN_ORDER, sizeof(uint8_t));
+    VkDeviceSize start = 0;
+    vector_push_back(&block->free_lists[GPU_ALLOCATOR_ORDERS - 1], &start);
+  }
+
+  array_list_add(&gpu_allocator->blocks, block);
+
+  return block;
+}
+
+static bool gpu_allocator_block_allocate(struct GPUMemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize* offset) {
+  if (block->strategy == GPU_ALLOCATION_LINEAR) {
+    const VkDeviceSize linear_offset = gpu_allocator_align(block->linear_offset, alignment);
+    if (linear_offset + size > GPU_ALLOCATOR_BLOCK_SIZE)
+      return false;
+
+    *offset = linear_offset;
+    block->used += (linear_offset + size) - block->linear_offset;
+    block->linear_offset = linear_offset + size;
+    block->allocation_count++;
+    return true;
+  }
+
+  // Note: Buddy ranges are aligned to their own size so rounding up to the alignment is all it takes
+  const VkDeviceSize needed = MAX(size, alignment);
+  int order = 0;
+  while (order < GPU_ALLOCATOR_ORDERS && gpu_allocator_order_size(order) < needed)
+    order++;
+
+  int free_order = order;
+  while (free_order < GPU_ALLOCATOR_ORDERS && vector_size(&block->free_lists[free_order]) == 0)
+    free_order++;
+  if (free_order >= GPU_ALLOCATOR_ORDERS)
+    return false;
+
+  struct Vector* free_list = &block->free_lists[free_order];
+  VkDeviceSize range_offset = *(VkDeviceSize*)vector_get(free_list, vector_size(free_list) - 1);
+  vector_remove(free_list, vector_size(free_list) - 1);
+
+  // Note: Split down to the order needed, the upper half of each split goes back as a free buddy
+  while (free_order > order) {
+    free_order--;
+    VkDeviceSize buddy_offset = range_offset + gpu_allocator_order_size(free_order);
+    vector_push_back(&block->free_lists[free_order], &buddy_offset);
+  }
+
+  block->allocated_orders[range_offset >> GPU_ALLOCATOR_MIN_ORDER] = (uint8_t)(order + 1);
+  block->used += gpu_allocator_order_size(order);
+  block->allocation_count++;
+  *offset = range_offset;
+
+  return true;
+}
+
+static void gpu_allocator_block_free(struct GPUMemoryBlock* block, VkDeviceSize offset, VkDeviceSize size) {
+  block->allocation_count--;
+
+  if (block->strategy == GPU_ALLOCATION_LINEAR) {
+    // Note: Freed in reverse order the offset walks back, otherwise the space comes back all at once when the block empties
+    if (offset + size == block->linear_offset)
+      block->linear_offset = offset;
+    if (block->allocation_count == 0)
+      block->linear_offset = 0;
+    block->used = block->linear_offset;
+    return;
+  }
+
+  int order = block->allocated_orders[offset >> GPU_ALLOCATOR_MIN_ORDER] - 1;
+  block->allocated_orders[offset >> GPU_ALLOCATOR_MIN_ORDER] = 0;
+  block->used -= gpu_allocator_order_size(order);
+
+  // Note: Merge with the buddy for as long as it's free too
+  while (order < GPU_ALLOCATOR_ORDERS - 1) {
+    const VkDeviceSize buddy_offset = offset ^ gpu_allocator_order_size(order);
+    struct Vector* free_list = &block->free_lists[order];
+    int buddy_num = -1;
+    for (int free_num = 0; free_num < vector_size(free_list); free_num++) {
+      if (*(VkDeviceSize*)vector_get(free_list, free_num) == buddy_offset) {
+        buddy_num = free_num;
+        break;
+      }
+    }
+
+    if (buddy_num == -1)
+      break;
+
+    vector_remove(free_list, buddy_num);
+    offset = MIN(offset, buddy_offset);
+    order++;
+  }
+
+  vector_push_back(&block->free_lists[order], &offset);
+}
+
+int gpu_allocator_allocate(struct GPUAllocator* gpu_allocator, VkMemoryRequirements memory_requirements, VkMemoryPropertyFlags properties, enum GPUAllocationStrategy strategy, bool optimal_image, struct GPUAllocation* allocation) {
+  memset(allocation, 0, sizeof(struct GPUAllocation));
+  const int memory_type = gpu_allocator_find_memory_type(gpu_allocator, memory_requirements.memoryTypeBits, properties);
+  if (memory_type == -1) {
+    fprintf(stderr, "failed to find suitable memory type!\n");
+    return GPU_ALLOCATOR_NO_MEMORY_TYPE_ERROR;
+  }
+
+  allocation->size = memory_requirements.size;
+
+  if (MAX(memory_requirements.size, memory_requirements.alignment) > GPU_ALLOCATOR_DEDICATED_SIZE) {
+    VkMemoryAllocateInfo alloc_info = {0};
+    alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc_info.allocationSize = memory_requirements.size;
+    alloc_info.memoryTypeIndex = memory_type;
+
+    if (vkAllocateMemory(gpu_allocator->device, &alloc_info, NULL, &allocation->memory) != VK_SUCCESS) {
+      fprintf(stderr, "failed to allocate dedicated gpu memory!\n");
+      return GPU_ALLOCATOR_ALLOCATE_MEMORY_ERROR;
+    }
+
+    gpu_allocator->dedicated_bytes += memory_requirements.size;
+    gpu_allocator->dedicated_count++;
+  } else {
+    struct GPUMemoryBlock* found_block = NULL;
+    VkDeviceSize offset = 0;
+    for (int block_num = 0; block_num < array_list_size(&gpu_allocator->blocks) && found_block == NULL; block_num++) {
+      struct GPUMemoryBlock* block = (struct GPUMemoryBlock*)array_list_get(&gpu_allocator->blocks, block_num);
+      if (block->memory_type == memory_type && block->strategy == strategy && block->optimal_image == optimal_image && gpu_allocator_block_allocate(block, memory_requirements.size, memory_requirements.alignment, &offset))
+        found_block = block;
+    }
+
+    if (found_block == NULL) {
+      found_block = gpu_allocator_block_create(gpu_allocator, memory_type, strategy, optimal_image);
+      if (found_block == NULL)
+        return GPU_ALLOCATOR_ALLOCATE_MEMORY_ERROR;
+      gpu_allocator_block_allocate(found_block, memory_requirements.size, memory_requirements.alignment, &offset);
+    }
+
+    allocation->memory = found_block->memory;
+    allocation->offset = offset;
+    allocation->block = found_block;
+  }
+
+  gpu_allocator->bytes_used += memory_requirements.size;
+  gpu_allocator->allocation_count++;
+
+  return GPU_ALLOCATOR_SUCCESS;
+}
+
+// Note: Empty blocks are kept as one spare per kind so a load that frees and allocates in turn doesn't go back to the driver every time
+void gpu_allocator_free(struct GPUAllocator* gpu_allocator, struct GPUAllocation* allocation) {
+  if (allocation->memory == VK_NULL_HANDLE)
+    return;
+
+  struct GPUMemoryBlock* block = allocation->block;
+  if (block == NULL) {
+    vkFreeMemory(gpu_allocator->device, allocation->memory, NULL);
+    gpu_allocator->dedicated_bytes -= allocation->size;
+    gpu_allocator->dedicated_count--;
+  } else {
+    gpu_allocator_block_free(block, allocation->offset, allocation->size);
+
+    if (block->allocation_count == 0) {
+      for (int block_num = 0; block_num < array_list_size(&gpu_allocator->blocks); block_num++) {
+        struct GPUMemoryBlock* other_block = (struct GPUMemoryBlock*)array_list_get(&gpu_allocator->blocks, block_num);
+        if (other_block != block && other_block->allocation_count == 0 && other_block->memory_type == block->memory_type && other_block->strategy == block->strategy && other_block->optimal_image == block->optimal_image) {
+          for (int remove_num = 0; remove_num < array_list_size(&gpu_allocator->blocks); remove_num++) {
+            if (array_list_get(&gpu_allocator->blocks, remove_num) == block) {
+              array_list_remove(&gpu_allocator->blocks, remove_num);
+              break;
+            }
+          }
+          gpu_allocator_block_delete(gpu_allocator, block);
+          break;
+        }
+      }
+    }
+  }
+
+  gpu_allocator->bytes_used -= allocation->size;
+  gpu_allocator->allocation_count--;
+  memset(allocation, 0, sizeof(struct GPUAllocation));
+}
+
+// Note: Only valid for host visible memory, block allocations point into the block's persistent mapping so unmapping them does nothing
+void* gpu_allocator_map(struct GPUAllocator* gpu_allocator, struct GPUAllocation* allocation) {
+  if (allocation->block != NULL)
+    return (allocation->block->mapped_memory != NULL) ? allocation->block->mapped_memory + allocation->offset : NULL;
+
+  void* mapped_memory = NULL;
+  if (vkMapMemory(gpu_allocator->device, allocation->memory, 0, allocation->size, 0, &mapped_memory) != VK_SUCCESS)
+    fprintf(stderr, "failed to map gpu memory!\n");
+
+  return mapped_memory;
+}
+
+void gpu_allocator_unmap(struct GPUAllocator* gpu_allocator, struct GPUAllocation* allocation) {
+  if (allocation->block == NULL)
+    vkUnmapMemory(gpu_allocator->device, allocation->memory);
+}
+
+struct GPUAllocatorStats gpu_allocator_get_stats(struct GPUAllocator* gpu_allocator) {
+  struct GPUAllocatorStats stats = {0};
+  stats.bytes_used = gpu_allocator->bytes_used;
+  stats.bytes_reserved = gpu_allocator->dedicated_bytes;
+  stats.allocation_count = gpu_allocator->allocation_count;
+  stats.block_count = array_list_size(&gpu_allocator->blocks);
+  stats.device_allocation_count = stats.block_count + gpu_allocator->dedicated_count;
+
+  VkDeviceSize total_free = 0;
+  VkDeviceSize total_largest_free = 0;
+  for (int block_num = 0; block_num < stats.block_count; block_num++) {
+    struct GPUMemoryBlock* block = (struct GPUMemoryBlock*)array_list_get(&gpu_allocator->blocks, block_num);
+    stats.bytes_reserved += GPU_ALLOCATOR_BLOCK_SIZE;
+
+    VkDeviceSize largest_free = 0;
+    if (block->strategy == GPU_ALLOCATION_LINEAR)
+      largest_free = GPU_ALLOCATOR_BLOCK_SIZE - block->linear_offset;
+    else
+      for (int order = GPU_ALLOCATOR_ORDERS - 1; order >= 0 && largest_free == 0; order--)
+        if (vector_size(&block->free_lists[order]) > 0)
+          largest_free = gpu_allocator_order_size(order);
+
+    total_free += GPU_ALLOCATOR_BLOCK_SIZE - block->used;
+    total_largest_free += largest_free;
+    stats.largest_free_range = MAX(stats.largest_free_range, largest_free);
+  }
+
+  stats.fragmentation = (total_free > 0) ? 1.0f - ((float)total_largest_free / (float)total_free) : 0.0f;
+
+  return stats;
+}
@@ -0,0 +1,300 @@
+#include "mana/graphics/utilities/meshoptimize.h"
+
+static inline uint64_t mesh_optimize_hash(const void* bytes, size_t size) {
+  const unsigned char* data = bytes;
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t byte_num = 0; byte_num < size; byte_num++) {
+    hash ^= data[byte_num];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+static inline int mesh_optimize_table_size(int count) {
+  int table_size = 16;
+  while (table_size < count * 2)
+    table_size *= 2;
+
+  return table_size;
+}
+
+// Note: Drops triangles that repeat a corner and exact repeats of an earlier triangle. A repeat is the same corners in the same winding, the opposite winding is a different face and stays. Returns the new index count
+int mesh_optimize_remove_degenerates(uint32_t* indices, int index_count) {
+  const int triangle_count = index_count / 3;
+  const int table_size = mesh_optimize_table_size(triangle_count);
+  // Note: Each slot holds a kept triangle's first index + 1 so 0 means empty
+  int* table = calloc(table_size, sizeof(int));
+
+  int kept_count = 0;
+  for (int triangle_num = 0; triangle_num < triangle_count; triangle_num++) {
+    const uint32_t* triangle = &indices[triangle_num * 3];
+    if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2])
+      continue;
+
+    // Note: Rotated so the smallest index leads, winding is kept
+    const int lowest = (triangle[0] < triangle[1]) ? ((triangle[0] < triangle[2]) ? 0 : 2) : ((triangle[1] < triangle[2]) ? 1 : 2);
+    const uint32_t key[3] = {triangle[lowest], triangle[(lowest + 1) % 3], triangle[(lowest + 2) % 3]};
+
+    int slot = mesh_optimize_hash(key, sizeof(key)) & (table_size - 1);
+    bool repeat = false;
+    while (table[slot] != 0) {
+      const uint32_t* other = &indices[table[slot] - 1];
+      const int other_lowest = (other[0] < other[1]) ? ((other[0] < other[2]) ? 0 : 2) : ((other[1] < other[2]) ? 1 : 2);
+      if (other[other_lowest] == key[0] && other[(other_lowest + 1) % 3] == key[1] && other[(other_lowest + 2) % 3] == key[2]) {
+        repeat = true;
+        break;
+      }
+      slot = (slot + 1) & (table_size - 1);
+    }
+    if (repeat)
+      continue;
+
+    // Note: Kept triangles only ever move down so the ones in the table are never overwritten
+    uint32_t* kept = &indices[kept_count * 3];
+    kept[0] = key[(3 - lowest) % 3];
+    kept[1] = key[(4 - lowest) % 3];
+    kept[2] = key[(5 - lowest) % 3];
+    table[slot] = (kept_count * 3) + 1;
+    kept_count++;
+  }
+
+  free(table);
+  return kept_count * 3;
+}
+
+// Note: Merges vertices that are byte for byte the same, survivors keep their relative order. remap gets the new index of every old vertex and can be NULL. Returns the new vertex count
+int mesh_optimize_weld_vertices(struct Vector* vertices, uint32_t* indices, int index_count, uint32_t* remap) {
+  const int vertex_count = vector_size(vertices);
+  const size_t vertex_size = vertices->memory_size;
+  char* vertex_data = vertices->items;
+  uint32_t* weld_remap = (remap != NULL) ? remap : malloc(sizeof(uint32_t) * MAX(vertex_count, 1));
+  const int table_size = mesh_optimize_table_size(vertex_count);
+  // Note: Each slot holds a kept vertex's new index + 1 so 0 means empty
+  int* table = calloc(table_size, sizeof(int));
+
+  int kept_count = 0;
+  for (int vertex_num = 0; vertex_num < vertex_count; vertex_num++) {
+    const char* vertex = vertex_data + (vertex_num * vertex_size);
+    int slot = mesh_optimize_hash(vertex, vertex_size) & (table_size - 1);
+    while (table[slot] != 0 && memcmp(vertex_data + ((table[slot] - 1) * vertex_size), vertex, vertex_size) != 0)
+      slot = (slot + 1) & (table_size - 1);
+
+    if (table[slot] != 0) {
+      weld_remap[vertex_num] = table[slot] - 1;
+      continue;
+    }
+
+    if (kept_count != vertex_num)
+      memcpy(vertex_data + (kept_count * vertex_size), vertex, vertex_size);
+    weld_remap[vertex_num] = kept_count;
+    table[slot] = kept_count + 1;
+    kept_count++;
+  }
+
+  for (int index_num = 0; index_num < index_count; index_num++)
+    indices[index_num] = weld_remap[indices[index_num]];
+  vertices->size = kept_count;
+
+  free(table);
+  if (remap == NULL)
+    free(weld_remap);
+  return kept_count;
+}
+
+// Note: Tipsify from Sander, Nehab and Barczak, fans around one vertex at a time and moves on to whichever vertex the fan left in the cache that still has triangles.
+// Linear in the triangle count unlike Forsyth's scoring, and close enough to it on contoured grids
+void mesh_optimize_vertex_cache(uint32_t* indices, int index_count, int vertex_count, int cache_size) {
+  const int triangle_count = index_count / 3;
+  if (triangle_count == 0 || vertex_count == 0)
+    return;
+
+  // Note: Triangles of each vertex packed back to back, live_triangles counts the ones not emitted yet
+  int* live_triangles = calloc(vertex_count, sizeof(int));
+  int* adjacency_offsets = malloc(sizeof(int) * (vertex_count + 1));
+  int* adjacency = malloc(sizeof(int) * triangle_count * 3);
+  for (int index_num = 0; index_num < triangle_count * 3; index_num++)
+    live_triangles[indices[index_num]]++;
+  adjacency_offsets[0] = 0;
+  for (int vertex_num = 0; vertex_num < vertex_count; vertex_num++)
+    adjacency_offsets[vertex_num + 1] = adjacency_offsets[vertex_num] + live_triangles[vertex_num];
+  int* adjacency_fill = malloc(sizeof(int) * vertex_count);
+  memcpy(adjacency_fill, adjacency_offsets, sizeof(int) * vertex_count);
+  for (int index_num = 0; index_num < triangle_count * 3; index_num++)
+    adjacency[adjacency_fill[indices[index_num]]++] = index_num / 3;
+  free(adjacency_fill);
+
+  int* cache_time = calloc(vertex_count, sizeof(int));
+  bool* emitted = calloc(triangle_count, sizeof(bool));
+  int* dead_end = malloc(sizeof(int) * triangle_count * 3);
+  int dead_end_count = 0;
+  int* candidates = malloc(sizeof(int) * triangle_count * 3);
+  uint32_t* output = malloc(sizeof(uint32_t) * triangle_count * 3);
+  int output_count = 0;
+  int time = cache_size + 1;
+  int cursor = 0;
+
+  int fanning = 0;
+  while (fanning >= 0) {
+    int candidate_count = 0;
+    for (int adjacency_num = adjacency_offsets[fanning]; adjacency_num < adjacency_offsets[fanning + 1]; adjacency_num++) {
+      const int triangle_num = adjacency[adjacency_num];
+      if (emitted[triangle_num])
+        continue;
+
+      for (int corner = 0; corner < 3; corner++) {
+        const uint32_t vertex = indices[(triangle_num * 3) + corner];
+        output[output_count++] = vertex;
+        dead_end[dead_end_count++] = vertex;
+        candidates[candidate_count++] = vertex;
+        live_triangles[vertex]--;
+        if (time - cache_time[vertex] > cache_size)
+          cache_time[vertex] = time++;
+      }
+      emitted[triangle_num] = true;
+    }
+
+    // Note: Prefer the candidate that stays in the cache longest while its remaining triangles are emitted
+    int next = -1;
+    int best_priority = -1;
+    for (int candidate_num = 0; candidate_num < candidate_count; candidate_num++) {
+      const int vertex = candidates[candidate_num];
+      if (live_triangles[vertex] == 0)
+        continue;
+
+      int priority = 0;
+      if (time - cache_time[vertex] + (2 * live_triangles[vertex]) <= cache_size)
+        priority = time - cache_time[vertex];
+      if (priority > best_priority) {
+        best_priority = priority;
+        next = vertex;
+      }
+    }
+
+    // Note: Dead end, go back through recently used vertices first and only then scan for any vertex left
+    while (next == -1 && dead_end_count > 0) {
+      const int vertex = dead_end[--dead_end_count];
+      if (live_triangles[vertex] > 0)
+        next = vertex;
+    }
+    while (next == -1 && cursor < vertex_count) {
+      if (live_triangles[cursor] > 0)
+        next = cursor;
+      cursor++;
+    }
+    fanning = next;
+  }
+
+  memcpy(indices, output, sizeof(uint32_t) * output_count);
+
+  free(output);
+  free(candidates);
+  free(dead_end);
+  free(emitted);
+  free(cache_time);
+  free(adjacency);
+  free(adjacency_offsets);
+  free(live_triangles);
+}
+
+// Note: Vertices are put in the order the indices first use them so fetches walk the buffer forwards, unreferenced ones keep their order at the end. remap gets the new index of every old vertex and can be NULL
+void mesh_optimize_vertex_fetch(struct Vector* vertices, uint32_t* indices, int index_count, uint32_t* remap) {
+  const int vertex_count = vector_size(vertices);
+  if (vertex_count == 0)
+    return;
+
+  const size_t vertex_size = vertices->memory_size;
+  uint32_t* fetch_remap = (remap != NULL) ? remap : malloc(sizeof(uint32_t) * vertex_count);
+  memset(fetch_remap, 0xFF, sizeof(uint32_t) * vertex_count);
+
+  uint32_t next_vertex = 0;
+  for (int index_num = 0; index_num < index_count; index_num++) {
+    if (fetch_remap[indices[index_num]] == UINT32_MAX)
+      fetch_remap[indices[index_num]] = next_vertex++;
+    indices[index_num] = fetch_remap[indices[index_num]];
+  }
+  for (int vertex_num = 0; vertex_num < vertex_count; vertex_num++) {
+    if (fetch_remap[vertex_num] == UINT32_MAX)
+      fetch_remap[vertex_num] = next_vertex++;
+  }
+
+  char* reordered = malloc(vertex_size * vertex_count);
+  for (int vertex_num = 0; vertex_num < vertex_count; vertex_num++)
+    memcpy(reordered + (fetch_remap[vertex_num] * vertex_size), (char*)vertices->items + (vertex_num * vertex_size), vertex_size);
+  memcpy(vertices->items, reordered, vertex_size * vertex_count);
+
+  free(reordered);
+  if (remap == NULL)
+    free(fetch_remap);
+}
+
+// Note: FIFO like the hardware caches rather than LRU, so it's what the GPU would actually run
+float mesh_optimize_acmr(const uint32_t* indices, int index_count, int vertex_count, int cache_size) {
+  const int triangle_count = index_count / 3;
+  if (triangle_count == 0)
+    return 0.0f;
+
+  // Note: A vertex is in the cache while fewer than cache_size misses happened since it was loaded
+  int* loaded_at = malloc(sizeof(int) * MAX(vertex_count, 1));
+  for (int vertex_num = 0; vertex_num < vertex_count; vertex_num++)
+    loaded_at[vertex_num] = -cache_size - 1;
+
+  int misses = 0;
+  for (int index_num = 0; index_num < triangle_count * 3; index_num++) {
+    const uint32_t vertex = indices[index_num];
+    if (misses - loaded_at[vertex] > cache_size) {
+      loaded_at[vertex] = misses;
+      misses++;
+    }
+  }
+
+  free(loaded_at);
+  return (float)misses / (float)triangle_count;
+}
+
+// Note: Narrows the indices in place to 16 bits when every vertex fits, returns whether it did. Anything that appends to the mesh afterwards has to go through mesh_get_index_type
+bool mesh_optimize_compress_indices(struct Vector* indices, int vertex_count) {
+  if (indices->memory_size != sizeof(uint32_t) || vertex_count > MESH_OPTIMIZE_MAX_16_BIT_VERTICES)
+    return false;
+
+  const int index_count = vector_size(indices);
+  struct Vector compressed = {0};
+  vector_init(&compressed, sizeof(uint16_t));
+  if (index_count > 0) {
+    vector_resize(&compressed, index_count);
+    uint16_t* compressed_indices = compressed.items;
+    const uint32_t* wide_indices = indices->items;
+    for (int index_num = 0; index_num < index_count; index_num++)
+      compressed_indices[index_num] = (uint16_t)wide_indices[index_num];
+    compressed.size = index_count;
+  }
+
+  vector_delete(indices);
+  *indices = compressed;
+  return true;
+}
+
+// Note: Whole mesh pipeline for meshes that are built once and never patched, meshes with index ranges to keep run the stages per range themselves
+void mesh_optimize(struct Mesh* mesh, bool compress_indices, struct MeshOptimizeStats* stats) {
+  uint32_t* indices = mesh->indices->items;
+  int index_count = vector_size(mesh->indices);
+  struct MeshOptimizeStats optimize_stats = {0};
+  optimize_stats.vertices_before = vector_size(mesh->vertices);
+  optimize_stats.triangles_before = index_count / 3;
+  optimize_stats.acmr_before = mesh_optimize_acmr(indices, index_count, optimize_stats.vertices_before, MESH_OPTIMIZE_CACHE_SIZE);
+
+  index_count = mesh_optimize_remove_degenerates(indices, index_count);
+  mesh->indices->size = index_count;
+  const int vertex_count = mesh_optimize_weld_vertices(mesh->vertices, indices, index_count, NULL);
+  mesh_optimize_vertex_cache(indices, index_count, vertex_count, MESH_OPTIMIZE_CACHE_SIZE);
+  mesh_optimize_vertex_fetch(mesh->vertices, indices, index_count, NULL);
+
+  optimize_stats.vertices_after = vertex_count;
+  optimize_stats.triangles_after = index_count / 3;
+  optimize_stats.acmr_after = mesh_optimize_acmr(indices, index_count, vertex_count, MESH_OPTIMIZE_CACHE_SIZE);
+  if (compress_indices)
+    mesh_optimize_compress_indices(mesh->indices, vertex_count);
+
+  if (stats != NULL)
+    *stats = optimize_stats;
+}
@@ -13,6 +13,7 @@ int sprite_animation_init(struct SpriteAnimation* sprite_animation, struct GPUAP
   sprite_animation->direction = 1.0f;
   sprite_animation->animate = 1;
   sprite_animation->loop = 1;
+  sprite_animation->uniform_offset = UNIFORM_RING_FULL;
 
   sprite_animation->total_frames = frames;
   sprite_animation->frame_length = frame_length;
@@ -65,11 +66,10 @@ int sprite_animation_init(struct SpriteAnimation* sprite_animation, struct GPUAP
 
   graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, sprite_animation->image_mesh->vertices, &sprite_animation->vertex_buffer, &sprite_animation->vertex_buffer_memory);
   graphics_utils_setup_index_buffer(gpu_api->vulkan_state, sprite_animation->image_mesh->indices, &sprite_animation->index_buffer, &sprite_animation->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct SpriteAnimationUniformBufferObject), &sprite_animation->uniform_buffer, &sprite_animation->uniform_buffers_memory);
   graphics_utils_setup_descriptor(gpu_api->vulkan_state, shader->descriptor_set_layout, shader->descriptor_pool, &sprite_animation->descriptor_set);
 
   VkWriteDescriptorSet dcs[2] = {0};
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &sprite_animation->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct SpriteAnimationUniformBufferObject), &sprite_animation->uniform_buffer)});
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &sprite_animation->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct SpriteAnimationUniformBufferObject))});
   graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 1, &sprite_animation->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&sprite_animation->image_texture->texture_image_view, &sprite_animation->image_texture->texture_sampler)});
   vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
 
@@ -78,13 +78,10 @@ int sprite_animation_init(struct SpriteAnimation* sprite_animation, struct GPUAP
 
 static inline void sprite_animation_vulkan_cleanup(struct SpriteAnimation* sprite_animation, struct GPUAPI* gpu_api) {
   vkDestroyBuffer(gpu_api->vulkan_state->device, sprite_animation->index_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, sprite_animation->index_buffer_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &sprite_animation->index_buffer_memory);
 
   vkDestroyBuffer(gpu_api->vulkan_state->device, sprite_animation->vertex_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, sprite_animation->vertex_buffer_memory, NULL);
-
-  vkDestroyBuffer(gpu_api->vulkan_state->device, sprite_animation->uniform_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, sprite_animation->uniform_buffers_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &sprite_animation->vertex_buffer_memory);
 }
 
 void sprite_animation_delete(struct SpriteAnimation* sprite_animation, struct GPUAPI* gpu_api) {
@@ -94,13 +91,16 @@ void sprite_animation_delete(struct SpriteAnimation* sprite_animation, struct GP
 }
 
 void sprite_animation_render(struct SpriteAnimation* sprite_animation, struct GPUAPI* gpu_api) {
+  if (sprite_animation->uniform_offset == UNIFORM_RING_FULL)
+    return;
+
   vkCmdBindPipeline(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sprite_animation->shader->graphics_pipeline);
 
   VkBuffer vertex_buffers[] = {sprite_animation->vertex_buffer};
   VkDeviceSize offsets[] = {0};
   vkCmdBindVertexBuffers(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, 0, 1, vertex_buffers, offsets);
   vkCmdBindIndexBuffer(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, sprite_animation->index_buffer, 0, VK_INDEX_TYPE_UINT32);
-  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sprite_animation->shader->pipeline_layout, 0, 1, &sprite_animation->descriptor_set, 0, NULL);
+  vkCmdBindDescriptorSets(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, sprite_animation->shader->pipeline_layout, 0, 1, &sprite_animation->descriptor_set, 1, &sprite_animation->uniform_offset);
   vkCmdDrawIndexed(gpu_api->vulkan_state->gbuffer->gbuffer_command_buffer, sprite_animation->image_mesh->indices->size, 1, 0, 0, 0);
 }
 
@@ -117,10 +117,7 @@ void sprite_animation_update_uniforms(struct SpriteAnimation* sprite_animation,
 
   ubos.frame_pos = sprite_animation->frame_pos;
 
-  void* data;
-  vkMapMemory(gpu_api->vulkan_state->device, sprite_animation->uniform_buffers_memory, 0, sizeof(struct SpriteAnimationUniformBufferObject), 0, &data);
-  memcpy(data, &ubos, sizeof(struct SpriteAnimationUniformBufferObject));
-  vkUnmapMemory(gpu_api->vulkan_state->device, sprite_animation->uniform_buffers_memory);
+  sprite_animation->uniform_offset = uniform_ring_push(gpu_api->vulkan_state->uniform_ring, &ubos, sizeof(struct SpriteAnimationUniformBufferObject));
 }
 
 void sprite_animation_recreate(struct SpriteAnimation* sprite_animation, struct GPUAPI* gpu_api) {
@@ -128,12 +125,11 @@ void sprite_animation_recreate(struct SpriteAnimation* sprite_animation, struct
 
   graphics_utils_setup_vertex_buffer(gpu_api->vulkan_state, sprite_animation->image_mesh->vertices, &sprite_animation->vertex_buffer, &sprite_animation->vertex_buffer_memory);
   graphics_utils_setup_index_buffer(gpu_api->vulkan_state, sprite_animation->image_mesh->indices, &sprite_animation->index_buffer, &sprite_animation->index_buffer_memory);
-  graphics_utils_setup_uniform_buffer(gpu_api->vulkan_state, sizeof(struct SpriteAnimationUniformBufferObject), &sprite_animation->uniform_buffer, &sprite_animation->uniform_buffers_memory);
   graphics_utils_setup_descriptor(gpu_api->vulkan_state, sprite_animation->shader->descriptor_set_layout, sprite_animation->shader->descriptor_pool, &sprite_animation->descriptor_set);
 
   VkWriteDescriptorSet dcs[2] = {0};
 
-  graphics_utils_setup_descriptor_buffer(gpu_api->vulkan_state, dcs, 0, &sprite_animation->descriptor_set, (VkDescriptorBufferInfo[]){graphics_utils_setup_descriptor_buffer_info(sizeof(struct SpriteAnimationUniformBufferObject), &sprite_animation->uniform_buffer)});
+  graphics_utils_setup_descriptor_dynamic_buffer(gpu_api->vulkan_state, dcs, 0, &sprite_animation->descriptor_set, (VkDescriptorBufferInfo[]){uniform_ring_get_descriptor_buffer_info(gpu_api->vulkan_state->uniform_ring, sizeof(struct SpriteAnimationUniformBufferObject))});
   graphics_utils_setup_descriptor_image(gpu_api->vulkan_state, dcs, 1, &sprite_animation->descriptor_set, (VkDescriptorImageInfo[]){graphics_utils_setup_descriptor_image_info(&sprite_animation->image_texture->texture_image_view, &sprite_animation->image_texture->texture_sampler)});
 
   vkUpdateDescriptorSets(gpu_api->vulkan_state->device, 2, dcs, 0, NULL);
@@ -156,3 +152,13 @@ void sprite_animation_update(struct SpriteAnimation* sprite_animation, float del
     offset = 1.0f / sprite_animation->total_frames;
   sprite_animation->frame_pos = (vec3){.x = ((float)sprite_animation->current_frame / sprite_animation->total_frames) + offset, .y = 0.0f, .z = sprite_animation->direction};
 }
+
+// Note: Current frame as an offset and size into the sheet for the sprite batch's unit quad. Frames face the other way to the quad's uvs so a positive direction is the one that isn't mirrored
+vec4 sprite_animation_get_uv_rect(struct SpriteAnimation* sprite_animation) {
+  const float frame_width = 1.0f / sprite_animation->total_frames;
+  const float frame_start = (float)sprite_animation->current_frame * frame_width;
+
+  if (sprite_animation->direction > 0.0f)
+    return (vec4){.x = frame_start, .y = 0.0f, .z = frame_width, .w = 1.0f};
+  return (vec4){.x = frame_start + frame_width, .y = 0.0f, .z = -frame_width, .w = 1.0f};
+}
@@ -98,30 +98,15 @@ int texture_init(struct Texture *texture, struct GPUAPI *gpu_api, struct Texture
   //    }
   //  }
   //#endif
-  VkBuffer staging_buffer = {0};
-  VkDeviceMemory staging_buffer_memory = {0};
-  graphics_utils_create_buffer(gpu_api->vulkan_state->device, gpu_api->vulkan_state->physical_device, image_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &staging_buffer, &staging_buffer_memory);
-
-  void *data;
-  vkMapMemory(gpu_api->vulkan_state->device, staging_buffer_memory, 0, image_size, 0, &data);
-  memcpy(data, pixels, image_size);
-  vkUnmapMemory(gpu_api->vulkan_state->device, staging_buffer_memory);
-
-  stbi_image_free(pixels);
-
   uint32_t mip_levels = (uint32_t)(floor(log2(MAX(tex_width, tex_height))));
   if (texture_settings.mip_maps_enabled == 0)
     mip_levels = 1;
 
-  graphics_utils_create_image(gpu_api->vulkan_state->device, gpu_api->vulkan_state->physical_device, tex_width, tex_height, mip_levels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R16G16B16A16_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &texture->texture_image, &texture->texture_image_memory);
+  graphics_utils_create_image(gpu_api->vulkan_state, tex_width, tex_height, mip_levels, VK_SAMPLE_COUNT_1_BIT, VK_FORMAT_R16G16B16A16_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, &texture->texture_image, &texture->texture_image_memory);
 
-  graphics_utils_transition_image_layout(gpu_api->vulkan_state->device, gpu_api->vulkan_state->graphics_queue, gpu_api->vulkan_state->command_pool, texture->texture_image, VK_FORMAT_R16G16B16A16_UNORM, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mip_levels);
-  graphics_utils_copy_buffer_to_image(gpu_api->vulkan_state->device, gpu_api->vulkan_state->graphics_queue, gpu_api->vulkan_state->command_pool, &staging_buffer, &texture->texture_image, tex_width, tex_height);
-
-  vkDestroyBuffer(gpu_api->vulkan_state->device, staging_buffer, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, staging_buffer_memory, NULL);
-
-  graphics_utils_generate_mipmaps(gpu_api->vulkan_state->device, gpu_api->vulkan_state->physical_device, gpu_api->vulkan_state->graphics_queue, gpu_api->vulkan_state->command_pool, texture->texture_image, VK_FORMAT_R16G16B16A16_UNORM, tex_width, tex_height, mip_levels);
+  // Note: Transition, copy and mipmaps are recorded into the current upload batch and submitted with the next frame, the pixels are staged so they can be freed right away
+  upload_manager_upload_image(gpu_api->vulkan_state->upload_manager, gpu_api->vulkan_state, texture->texture_image, VK_FORMAT_R16G16B16A16_UNORM, tex_width, tex_height, mip_levels, pixels, image_size);
+  stbi_image_free(pixels);
 
   graphics_utils_create_image_view(gpu_api->vulkan_state->device, texture->texture_image, VK_FORMAT_R16G16B16A16_UNORM, VK_IMAGE_ASPECT_COLOR_BIT, mip_levels, &texture->texture_image_view);
   graphics_utils_create_sampler(gpu_api->vulkan_state->device, &texture->texture_sampler, (struct SamplerSettings){.mip_levels = mip_levels, .filter = filter, .address_mode = mode});
@@ -134,7 +119,7 @@ void texture_delete(struct Texture *texture, struct GPUAPI *gpu_api) {
   vkDestroyImageView(gpu_api->vulkan_state->device, texture->texture_image_view, NULL);
 
   vkDestroyImage(gpu_api->vulkan_state->device, texture->texture_image, NULL);
-  vkFreeMemory(gpu_api->vulkan_state->device, texture->texture_image_memory, NULL);
+  gpu_allocator_free(gpu_api->vulkan_state->gpu_allocator, &texture->texture_image_memory);
 
   free(texture->path);
   free(texture->name);
@@ -12,6 +12,9 @@ int mana_init(struct Mana* mana, struct EngineSettings engine_settings) {
     case (ENGINE_GPU_API_ERROR):
       fprintf(stderr, "Error setting up engine GPU API!\n");
       return MANA_ENGINE_ERROR;
+    case (ENGINE_JOB_SYSTEM_ERROR):
+      fprintf(stderr, "Error setting up engine job system!\n");
+      return MANA_ENGINE_ERROR;
     default:
       fprintf(stderr, "Unknown engine error! Error code: %d\n", engine_error);
       break;